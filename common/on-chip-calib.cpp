@@ -227,57 +227,19 @@ namespace rs2
 
         auto show_plane = _viewer.draw_plane;
 
-        auto on_frame = [sensor, &fill_rates, &rmses, this](
-            const std::vector<rs2::float3>& points,
-            const plane p,
-            const rs2::region_of_interest roi,
-            const float baseline_mm,
-            const float focal_length_pixels,
-            const int ground_thruth_mm,
+        auto on_frame = [&fill_rates, &rmses](
+            const rs2_depth_quality_metrics& metrics,
+            const int ground_truth_mm,
             const bool plane_fit,
-            const float plane_fit_to_ground_truth_mm,
-            const float distance_mm,
             bool record,
             std::vector<single_metric_data>& samples)
         {
-            static const float TO_MM = 1000.f;
-            static const float TO_PERCENT = 100.f;
-
-            // Calculate fill rate relative to the ROI
-            auto fill_rate = points.size() / float((roi.max_x - roi.min_x)*(roi.max_y - roi.min_y)) * TO_PERCENT;
-            fill_rates.push_back(fill_rate);
+            fill_rates.push_back(metrics.fill_rate);
 
             if (!plane_fit) return;
 
-            std::vector<rs2::float3> points_set = points;
-            std::vector<float> distances;
-
-            // Reserve memory for the data
-            distances.reserve(points.size());
-
-            // Convert Z values into Depth values by aligning the Fitted plane with the Ground Truth (GT) plane
-            // Calculate distance and disparity of Z values to the fitted plane.
-            // Use the rotated plane fit to calculate GT errors
-            for (auto point : points_set)
-            {
-                // Find distance from point to the reconstructed plane
-                auto dist2plane = p.a*point.x + p.b*point.y + p.c*point.z + p.d;
-
-                // Store distance, disparity and gt- error
-                distances.push_back(dist2plane * TO_MM);
-            }
-
-            // Remove outliers [below 1% and above 99%)
-            std::sort(points_set.begin(), points_set.end(), [](const rs2::float3& a, const rs2::float3& b) { return a.z < b.z; });
-            size_t outliers = points_set.size() / 50;
-            points_set.erase(points_set.begin(), points_set.begin() + outliers); // crop min 0.5% of the dataset
-            points_set.resize(points_set.size() - outliers); // crop max 0.5% of the dataset
-
-            // Calculate Plane Fit RMS  (Spatial Noise) mm
-            double plane_fit_err_sqr_sum = std::inner_product(distances.begin(), distances.end(), distances.begin(), 0.);
-            auto rms_error_val = static_cast<float>(std::sqrt(plane_fit_err_sqr_sum / distances.size()));
-            auto rms_error_val_per = TO_PERCENT * (rms_error_val / distance_mm);
-            rmses.push_back(rms_error_val_per);
+            // Plane Fit RMS (Spatial Noise) in percent of the distance
+            rmses.push_back(metrics.plane_fit_rms_error);
         };
 
         auto rms_std = 1000.f;
@@ -295,8 +257,9 @@ namespace rs2
             for (int i = 0; i < 31; i++)
             {
                 f = fetch_depth_frame(invoke);
-                auto res = depth_quality::analyze_depth_image(f, sensor.get_depth_scale(), sensor.get_stereo_baseline(),
-                    &intr, roi, 0, true, v, false, on_frame);
+                // The RMS is of all the points of the RoI, outliers included
+                auto res = depth_quality::analyze_depth_image(f, sensor.get_stereo_baseline(),
+                    &intr, roi, 0, true, v, false, on_frame, 0.f);
 
                 _viewer.draw_plane = true;
                 _viewer.roi_rect = res.plane_corners;
@@ -80,6 +80,49 @@ void rs2_context_remove_device(rs2_context* ctx, const char* file, rs2_error** e
  */
 void rs2_context_unload_tracking_module(rs2_context* ctx, rs2_error** error);
 
+/**
+* Set the number of worker threads of the processing thread pool. The pool is shared by the processing blocks of
+* all contexts in the process, so the last setting applies. Calls wait for processing in progress to finish.
+* \param[in] ctx       The context
+* \param[in] threads   Number of workers besides the thread that runs a processing block: 0 keeps all processing on
+*                      that thread, -1 (the default) uses one worker per core less one
+* \param[out] error    If non-null, receives any error that occurs during this call, otherwise, errors are ignored
+*/
+void rs2_context_set_processing_threads(rs2_context* ctx, int threads, rs2_error** error);
+
+/**
+* Get the number of worker threads of the processing thread pool
+* \param[in] ctx       The context
+* \param[out] error    If non-null, receives any error that occurs during this call, otherwise, errors are ignored
+* \return              Number of workers besides the thread that runs a processing block
+*/
+int rs2_context_get_processing_threads(const rs2_context* ctx, rs2_error** error);
+
+/**
+* Restrict the worker threads of the processing thread pool to a set of CPUs
+* \param[in] ctx       The context
+* \param[in] cpus      Indices of the CPUs the workers may run on
+* \param[in] count     Number of indices in cpus, 0 to lift the restriction
+* \param[out] error    If non-null, receives any error that occurs during this call, otherwise, errors are ignored
+*/
+void rs2_context_set_processing_affinity(rs2_context* ctx, const int* cpus, int count, rs2_error** error);
+
+/**
+* Set where the library threads of a role run, for all devices. Threads are placed when they start, so a new placement
+* applies to the capture and dispatch threads of sensors started afterwards and to the processing workers right away.
+* Each thread is also named after its role ("rs-uvc-*", "rs-hid-*", "rs-<stream>", "rs-proc-*") to help verify the placement.
+* \param[in] ctx               The context
+* \param[in] role              Role of the threads to place
+* \param[in] cpus              Indices of the CPUs the threads may run on
+* \param[in] cpu_count         Number of indices in cpus, 0 for no restriction, or for the CPUs of numa_node if one is given
+* \param[in] realtime_priority SCHED_FIFO priority between 1 and 99, 0 to keep the default scheduling. Meant for the capture
+*                              threads, and requires the CAP_SYS_NICE capability or an RLIMIT_RTPRIO limit on Linux
+* \param[in] numa_node         Memory node on which the threads prefer to allocate, -1 for none. Frame buffers are allocated
+*                              by the capture threads, so this places them near the CPUs that process them
+* \param[out] error            If non-null, receives any error that occurs during this call, otherwise, errors are ignored
+*/
+void rs2_context_set_thread_placement(rs2_context* ctx, rs2_thread_role role, const int* cpus, int cpu_count, int realtime_priority, int numa_node, rs2_error** error);
+
 /**
 * create a static snapshot of all connected devices at the time of the call
 * \param context     Object representing librealsense session
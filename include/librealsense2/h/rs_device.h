@@ -80,6 +80,20 @@ int rs2_supports_device_info(const rs2_device* device, rs2_camera_info info, rs2
  */
 void rs2_hardware_reset(const rs2_device * device, rs2_error ** error);
 
+/**
+* Set where the capture or dispatch threads of one device run, overriding the placement set on the context for that role.
+* The placement applies to the threads of sensors started afterwards. An empty placement (no CPUs, priority 0, node -1)
+* removes the override.
+* \param[in]  device            The RealSense device
+* \param[in]  role              RS2_THREAD_ROLE_CAPTURE or RS2_THREAD_ROLE_DISPATCH, processing threads are shared by all devices
+* \param[in]  cpus              Indices of the CPUs the threads may run on
+* \param[in]  cpu_count         Number of indices in cpus, 0 for no restriction, or for the CPUs of numa_node if one is given
+* \param[in]  realtime_priority SCHED_FIFO priority between 1 and 99, 0 to keep the default scheduling
+* \param[in]  numa_node         Memory node on which the threads prefer to allocate, -1 for none
+* \param[out] error             If non-null, receives any error that occurs during this call, otherwise, errors are ignored
+*/
+void rs2_set_device_thread_placement(const rs2_device* device, rs2_thread_role role, const int* cpus, int cpu_count, int realtime_priority, int numa_node, rs2_error** error);
+
 /**
 * Send raw data to device
 * \param[in]  device                    RealSense device to send data to
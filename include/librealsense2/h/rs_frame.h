@@ -70,6 +70,14 @@ typedef enum rs2_frame_metadata_value
 const char* rs2_frame_metadata_to_string(rs2_frame_metadata_value metadata);
 const char* rs2_frame_metadata_value_to_string(rs2_frame_metadata_value metadata);
 
+/** \brief Metadata attribute of a frame, as retrieved in bulk by rs2_get_frame_metadata_all. */
+typedef struct rs2_frame_metadata_entry
+{
+    rs2_frame_metadata_value id;    /**< The attribute */
+    rs2_metadata_type value;        /**< Value of the attribute, when valid */
+    int valid;                      /**< Non-zero if the frame carries the attribute */
+} rs2_frame_metadata_entry;
+
 /** \brief Calibration target type. */
 typedef enum rs2_calib_target_type
 {
@@ -78,6 +86,60 @@ typedef enum rs2_calib_target_type
 } rs2_calib_target_type;
 const char* rs2_calib_target_type_to_string(rs2_calib_target_type type);
 
+/** \brief Layout of the points produced by the pointcloud block, see RS2_OPTION_POINTS_LAYOUT. */
+typedef enum rs2_points_layout
+{
+    RS2_POINTS_LAYOUT_FULL,          /**< A float32 vertex and texture coordinate for every depth pixel, zero where the pixel has no depth */
+    RS2_POINTS_LAYOUT_FLOAT32,       /**< Only the points with depth, float32 vertices in meters */
+    RS2_POINTS_LAYOUT_FLOAT16,       /**< Only the points with depth, IEEE 754 half float vertices in meters */
+    RS2_POINTS_LAYOUT_INT16,         /**< Only the points with depth, int16 vertices in units of the frame's scale, millimeters unless the cloud does not fit */
+    RS2_POINTS_LAYOUT_COUNT          /**< Number of enumeration values. Not a valid input: intended to be used in for-loops. */
+} rs2_points_layout;
+const char* rs2_points_layout_to_string(rs2_points_layout layout);
+
+/** \brief Points of a frame in a compact layout, see rs2_get_compact_points. The arrays point into the frame data and stay valid while the frame is referenced. */
+typedef struct rs2_compact_points
+{
+    rs2_points_layout       layout;                         /**< Type of the vertices                                                                                */
+    int                     count;                          /**< Number of points                                                                                    */
+    int                     width;                          /**< Width of the depth frame the points come from                                                       */
+    int                     height;                         /**< Height of the depth frame the points come from                                                      */
+    const void*             vertices;                       /**< x, y and z of every point, of the type the layout names                                             */
+    float                   scale;                          /**< Meters per unit of the vertices, 1 but for RS2_POINTS_LAYOUT_INT16                                  */
+    const float*            texture_coordinates;            /**< u and v of every point in [0,1] range, null unless RS2_OPTION_POINTS_TEXTURE_COORDINATES was 1     */
+    const unsigned short*   normalized_texture_coordinates; /**< u and v of every point in [0,1] scaled to 65534, 65535 where off the texture, null unless the option was 2 */
+    const unsigned char*    valid_pixels;                   /**< One bit per depth pixel in row-major order, least significant first, set for the pixels with a point */
+} rs2_compact_points;
+
+/** \brief Region of a depth frame facing a flat target, and what is known of the target, to rate depth quality by, see rs2_analyze_depth_quality */
+typedef struct rs2_depth_quality_params
+{
+    int   roi_min_x;        /**< Left column of the region of interest                                                                     */
+    int   roi_min_y;        /**< Top row of the region of interest                                                                         */
+    int   roi_max_x;        /**< Column just right of the region of interest                                                               */
+    int   roi_max_y;        /**< Row just below the region of interest                                                                     */
+    float baseline_mm;      /**< Distance between the stereo imagers, for the subpixel RMS error; 0 for none                               */
+    int   ground_truth_mm;  /**< Distance of the target from the camera, for the Z accuracy; 0 when unknown                                 */
+    float outlier_percent;  /**< Percent of the points nearest to the camera, and again of the farthest, left out of the error metrics    */
+} rs2_depth_quality_params;
+
+/** \brief Depth quality of a region of a depth frame facing a flat target, measured against the plane that fits its points best */
+typedef struct rs2_depth_quality_metrics
+{
+    int   roi_pixels;                   /**< Number of pixels in the region of interest                                                  */
+    int   valid_pixels;                 /**< Number of pixels in the region with depth                                                   */
+    float fill_rate;                    /**< Percent of the pixels in the region with depth                                              */
+    int   plane_fit;                    /**< Non-zero when the points span a plane; the fields below are only set then                   */
+    float plane[4];                     /**< a, b, c and d of the plane ax + by + cz + d = 0 fit to the points, (a, b, c) of unit length */
+    float distance_mm;                  /**< Distance of the camera from the plane, along its normal                                     */
+    float angle;                        /**< Angle between the plane and the image plane, in degrees                                     */
+    float plane_fit_rms_error_mm;       /**< RMS of the distances of the points from the plane (spatial noise)                           */
+    float plane_fit_rms_error;          /**< The RMS error in percent of the distance of the plane                                       */
+    float subpixel_rms_error;           /**< RMS of the disparity of the points less that of their projection on the plane, in pixels   */
+    float plane_fit_to_ground_truth_mm; /**< Depth of the plane at the center of the image less the ground truth; 0 without one        */
+    float z_accuracy;                   /**< Median of the depth errors of the points against the ground truth, in percent of it         */
+} rs2_depth_quality_metrics;
+
 /**
 * retrieve metadata from frame handle
 * \param[in] frame      handle returned from a callback
@@ -96,6 +158,17 @@ rs2_metadata_type rs2_get_frame_metadata(const rs2_frame* frame, rs2_frame_metad
 */
 int rs2_supports_frame_metadata(const rs2_frame* frame, rs2_frame_metadata_value frame_metadata, rs2_error** error);
 
+/**
+* retrieve all metadata attributes of a frame in one call. Attributes the frame does not carry are marked invalid
+* rather than reported as errors
+* \param[in] frame          handle returned from a callback
+* \param[out] entries       array to fill, entry i with attribute i; RS2_FRAME_METADATA_COUNT entries hold every attribute
+* \param[in] count          number of entries in the array
+* \param[out] error         if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+* \return                   the number of valid entries
+*/
+int rs2_get_frame_metadata_all(const rs2_frame* frame, rs2_frame_metadata_entry* entries, int count, rs2_error** error);
+
 /**
 * retrieve timestamp domain from frame handle. timestamps can only be comparable if they are in common domain
 * (for example, depth timestamp might come from system time while color timestamp might come from the device)
@@ -168,6 +241,35 @@ int rs2_get_frame_height(const rs2_frame* frame, rs2_error** error);
 */
 float rs2_depth_frame_get_units( const rs2_frame* frame, rs2_error** error );
 
+/**
+* project many color pixels to the depth pixels that see the same points. Unlike rs2_project_color_pixel_to_depth_pixel,
+* which searches along a line per pixel, the depth frame is mapped onto the color image once and every pixel is
+* looked up in the map. The map is kept per pair of profiles and reused as long as the same depth frame is queried
+* \param[in] depth_frame     depth frame to project to
+* \param[in] color_profile   video stream profile of the color pixels, with extrinsics to the depth stream
+* \param[in] depth_min       nearest depth, in meters, considered
+* \param[in] depth_max       farthest depth, in meters, considered
+* \param[in] color_pixels    count (x, y) pairs of color pixels
+* \param[out] depth_pixels   count (x, y) pairs of depth pixels, (-1, -1) where no depth pixel sees the color pixel
+* \param[in] count           number of pixels
+* \param[out] error          if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+* \return                    the number of color pixels projected to a depth pixel
+*/
+int rs2_project_color_pixels_to_depth_pixels(const rs2_frame* depth_frame, const rs2_stream_profile* color_profile,
+    float depth_min, float depth_max, const float* color_pixels, float* depth_pixels, int count, rs2_error** error);
+
+/**
+* rate the depth quality of a region of a Z16 depth frame facing a flat target: the plane is fit to the points of the region
+* by least squares, and their errors measured against it. The points are accumulated on the processing threads rather than
+* collected, and the rays of the region's pixels are kept between frames of the same stream
+* \param[in] depth_frame    depth frame of a flat target
+* \param[in] params         region of interest and what is known of the target
+* \param[out] metrics       fill rate, plane fit and error metrics of the region
+* \param[out] error         if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+*/
+void rs2_analyze_depth_quality(const rs2_frame* depth_frame, const rs2_depth_quality_params* params,
+    rs2_depth_quality_metrics* metrics, rs2_error** error);
+
 /**
 * retrieve frame stride in bytes (number of bytes from start of line N to start of line N+1)
 * \param[in] frame      handle returned from a callback
@@ -242,6 +344,16 @@ rs2_pixel* rs2_get_frame_texture_coordinates(const rs2_frame* frame, rs2_error**
 */
 int rs2_get_frame_points_count(const rs2_frame* frame, rs2_error** error);
 
+/**
+* When called on a Points frame produced with RS2_OPTION_POINTS_LAYOUT set, retrieves its points.
+* rs2_get_frame_vertices and rs2_get_frame_texture_coordinates only accept compact points of float32 type
+* \param[in] frame       Points frame
+* \param[out] points     Pointer to a user allocated struct, which points at the frame data after a successful return. Untouched for frames of RS2_POINTS_LAYOUT_FULL
+* \param[out] error      If non-null, receives any error that occurs during this call, otherwise, errors are ignored
+* \return                1 if the frame holds compact points, 0 if it holds a point for every depth pixel
+*/
+int rs2_get_compact_points(const rs2_frame* frame, rs2_compact_points* points, rs2_error** error);
+
 /**
 * Returns the stream profile that was used to start the stream of this frame
 * \param[in] frame       frame reference, owned by the user
@@ -347,6 +459,16 @@ void rs2_synthetic_frame_ready(rs2_source* source, rs2_frame* frame, rs2_error**
 */
 void rs2_pose_frame_get_pose_data(const rs2_frame* frame, rs2_pose* pose, rs2_error** error);
 
+/**
+* When called on a Motion frame delivered with RS2_OPTION_MOTION_BATCH_SIZE set, retrieves all the samples it carries.
+* The frame data itself starts with the latest sample, so batched frames can still be read as regular motion frames
+* \param[in] frame       Motion frame
+* \param[out] batch      Pointer to a user allocated struct, which points at the samples after a successful return. Untouched for single sample frames
+* \param[out] error      If non-null, receives any error that occurs during this call, otherwise, errors are ignored
+* \return                1 if the frame carries a batch of samples, 0 if it holds a single sample
+*/
+int rs2_get_motion_batch(const rs2_frame* frame, rs2_motion_batch* batch, rs2_error** error);
+
 /**
 * Extract the target dimensions on the specific target
 * \param[in] frame            Left or right camera frame of specified size based on the target type
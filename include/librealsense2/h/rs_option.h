@@ -111,6 +111,12 @@ extern "C" {
         RS2_OPTION_AUTO_GAIN_LIMIT, /**< Set and get auto gain limits ranging from 16 to 248. Default is 0 which means full gain. If the requested gain limit is less than 16, it will be set to 16. If the requested gain limit is greater than 248, it will be set to 248. Setting will not take effect until next streaming session. */
         RS2_OPTION_AUTO_RX_SENSITIVITY, /**< Enable receiver sensitivity according to ambient light, bounded by the Receiver Gain control. */
         RS2_OPTION_TRANSMITTER_FREQUENCY, /**<changes the transmitter frequencies increasing effective range over sharpness. */
+        RS2_OPTION_CONVERSION_QUEUE_SIZE, /**< Number of raw frames allowed to wait for format conversion off the capture thread, per conversion block. 0 converts on the capture thread. Takes effect on the next streaming session. */
+        RS2_OPTION_MOTION_BATCH_SIZE, /**< Number of accel/gyro samples delivered together in one motion frame, see rs2_get_motion_batch. 0 delivers every sample in its own frame. Takes effect on the next streaming session. */
+        RS2_OPTION_MOTION_BATCH_INTERVAL, /**< Longest time, in milliseconds, a motion batch may collect samples before it is delivered even if not full. 0 waits for the batch to fill. Takes effect on the next streaming session. */
+        RS2_OPTION_POINTS_LAYOUT, /**< Layout of the points produced by the pointcloud block, see rs2_points_layout. Every layout but RS2_POINTS_LAYOUT_FULL holds only the points with depth, see rs2_get_compact_points. Those are computed straight into the frame, unless texture coordinates are mapped with occlusion removal on, which still goes through a full points frame. */
+        RS2_OPTION_POINTS_TEXTURE_COORDINATES, /**< Texture coordinates of compact points: 0 for none, 1 for float32 and 2 for uint16 normalized to 65534, with 65535 for a coordinate off the texture. Points in RS2_POINTS_LAYOUT_FULL always carry float32 coordinates. */
+        RS2_OPTION_FRAMES_POOL_SIZE, /**< Number of frames of each frame type the sensor preallocates; frames held beyond it are allocated on the heap. Takes effect the next time the sensor is opened. */
         RS2_OPTION_COUNT /**< Number of enumeration values. Not a valid input: intended to be used in for-loops. */
     } rs2_option;
 
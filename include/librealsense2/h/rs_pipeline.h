@@ -91,6 +91,15 @@ extern "C" {
     */
     int rs2_pipeline_try_wait_for_frames(rs2_pipeline* pipe, rs2_frame** output_frame, unsigned int timeout_ms, rs2_error ** error);
 
+    /**
+    * Make the frames sets waiting for rs2_pipeline_wait_for_frames and rs2_pipeline_poll_for_frames drop by age rather
+    * than by count, see rs2_set_frame_queue_latency_budget. Takes effect the next time the pipeline starts.
+    * \param[in] pipe        the pipeline
+    * \param[in] max_age_ms  latency budget in milliseconds, 0 to keep only the latest frames set
+    * \param[out] error      if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+    */
+    void rs2_pipeline_set_latency_budget(rs2_pipeline* pipe, float max_age_ms, rs2_error ** error);
+
     /**
     * Delete a pipeline instance.
     * Upon destruction, the pipeline will implicitly stop itself
@@ -35,6 +35,29 @@ rs2_processing_block* rs2_create_colorizer(rs2_error** error);
 */
 rs2_processing_block* rs2_create_sync_processing_block(rs2_error** error);
 
+/**
+* Creates a multi-device Sync processing block. This block accepts the frames of several devices and outputs composite
+* frames of the best matches of all of them: the frames of each device are synced as by the Sync processing block, and
+* the framesets of the devices are matched by the host time of their frames, which RS2_OPTION_GLOBAL_TIME_ENABLED makes
+* comparable across devices
+* A frameset waits for the devices missing from it until their frames are past it, or for max_latency ms since it arrived
+* \param[in] tolerance    largest difference in host time, in ms, of frames of different devices in one frameset; 0 for half the frame period of the slower device
+* \param[in] max_latency  longest time, in ms, a frameset waits for the devices missing from it
+* \param[out] error       if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+*/
+rs2_processing_block* rs2_create_multi_device_sync_processing_block(float tolerance, float max_latency, rs2_error** error);
+
+/**
+* Gets the clock of every device a multi-device Sync processing block received frames of, where the device has one, and the
+* offset of its frames from those of the first of them in the framesets matched
+* \param[in] block        multi-device Sync processing block
+* \param[out] skews       receives up to count skews, in the order the devices first sent frames
+* \param[in] count        size of skews
+* \param[out] error       if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+* \return                 number of devices, which may be more than count
+*/
+int rs2_get_device_clock_skews(const rs2_processing_block* block, rs2_device_clock_skew* skews, int count, rs2_error** error);
+
 /**
 * Creates Point-Cloud processing block. This block accepts depth frames and outputs Points frames
 * In addition, given non-depth frame, the block will align texture coordinate to the non-depth stream
@@ -190,6 +213,16 @@ int rs2_try_wait_for_frame(rs2_frame_queue* queue, unsigned int timeout_ms, rs2_
 */
 void rs2_enqueue_frame(rs2_frame* frame, void* queue);
 
+/**
+* Make a frame queue drop frames by age rather than by count. Frames that waited in the queue for longer than the budget
+* are dropped, and the queue keeps no more frames than the consumer can take within the budget at the rate
+* it was seen dequeuing. Drops are reported as RS2_NOTIFICATION_CATEGORY_FRAMES_DROPPED notifications of the sensor.
+* \param[in] queue       the frame queue data structure
+* \param[in] max_age_ms  latency budget in milliseconds, 0 to return to dropping by count with the capacity of the queue
+* \param[out] error      if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+*/
+void rs2_set_frame_queue_latency_budget(rs2_frame_queue* queue, float max_age_ms, rs2_error** error);
+
 /**
 * Creates Align processing block.
 * \param[in] align_to   stream type to be used as the target of frameset alignment
@@ -265,6 +298,17 @@ rs2_processing_block* rs2_create_hdr_merge_processing_block(rs2_error** error);
 */
 rs2_processing_block* rs2_create_sequence_id_filter(rs2_error** error);
 
+/**
+* Creates a depth post-processing block, which applies the given filters in order to every depth frame.
+* The filters keep their options and are configured as before. The recommended chain - decimation, threshold,
+* depth to disparity, spatial, temporal, disparity to depth and hole filling - is applied in a few passes over
+* one frame instead of a frame per filter, and any other chain as the filters would apply it one after another
+* \param[in] filters   The decimation, threshold, disparity transform, spatial, temporal and hole filling blocks to apply
+* \param[in] count     The number of filters
+* \param[out] error    if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+*/
+rs2_processing_block* rs2_create_depth_postprocess_block(rs2_processing_block** filters, int count, rs2_error** error);
+
 /**
 * Retrieve processing block specific information, like name.
 * \param[in]  block     The processing block
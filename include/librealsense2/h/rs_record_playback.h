@@ -103,6 +103,37 @@ unsigned long long int rs2_playback_get_duration(const rs2_device* device, rs2_e
  */
 void rs2_playback_seek(const rs2_device* device, long long int time, rs2_error** error);
 
+/**
+ * Set the playback to the time point of a frame of one of the played streams, found in O(log n) with an index of the frames of the file
+ * Files recorded by versions that did not store that index are indexed on first use, and their index kept next to them in "<file>.idx"
+ * Only video and motion streams can be sought in, and files of the first version of the format have no index
+ * \param[in] device        A playback device.
+ * \param[in] stream        A stream profile of a sensor of the playback device
+ * \param[in] frame_number  Frame number of the frame of the stream to seek to, as the playback publishes it
+ * \param[out] error        If non-null, receives any error that occurs during this call, otherwise, errors are ignored
+ */
+void rs2_playback_seek_to_frame(const rs2_device* device, const rs2_stream_profile* stream, unsigned long long int frame_number, rs2_error** error);
+
+/**
+ * Gets the number of frames of one of the played streams in the file (see rs2_playback_seek_to_frame)
+ * \param[in] device     A playback device.
+ * \param[in] stream     A stream profile of a sensor of the playback device
+ * \param[out] error     If non-null, receives any error that occurs during this call, otherwise, errors are ignored
+ * \return Number of frames of the stream in the file
+ */
+unsigned long long int rs2_playback_get_frame_count(const rs2_device* device, const rs2_stream_profile* stream, rs2_error** error);
+
+/**
+ * Reads a frame of one of the played streams out of playback order, by its position among the frames of the stream in the file (see rs2_playback_seek_to_frame)
+ * The position of the playback is not changed
+ * \param[in] device     A playback device.
+ * \param[in] stream     A stream profile of a sensor of the playback device
+ * \param[in] index      Position of the frame among the frames of the stream, from 0 to rs2_playback_get_frame_count - 1, in the order of their timestamps
+ * \param[out] error     If non-null, receives any error that occurs during this call, otherwise, errors are ignored
+ * \return The frame, to be released by rs2_release_frame
+ */
+rs2_frame* rs2_playback_get_frame_at(const rs2_device* device, const rs2_stream_profile* stream, unsigned long long int index, rs2_error** error);
+
 /**
  * Gets the current position of the playback in the file in terms of time. Units are expressed in nanoseconds
  * \param[in] device     A playback device
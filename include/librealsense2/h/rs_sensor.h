@@ -663,6 +663,96 @@ void rs2_set_motion_device_intrinsics(const rs2_sensor* sensor, const rs2_stream
 */
 float rs2_get_max_usable_depth_range(rs2_sensor const * sensor, rs2_error** error);
 
+/** \brief Checkpoints of the frame pipeline at which frame latency is sampled. Apart from the backend stage, latency is measured from the frame arrival on the host. */
+typedef enum rs2_latency_stage
+{
+    RS2_LATENCY_STAGE_BACKEND,          /**< Frame arrival on the host, relative to the backend timestamp */
+    RS2_LATENCY_STAGE_ARCHIVE,          /**< Frame allocated and filled in the frame archive */
+    RS2_LATENCY_STAGE_PROCESSING,       /**< Format conversion done, frame about to be passed to the sensor callback */
+    RS2_LATENCY_STAGE_SYNCER,           /**< Frame released by the syncer */
+    RS2_LATENCY_STAGE_CALLBACK_START,   /**< Sensor user callback invoked */
+    RS2_LATENCY_STAGE_CALLBACK_END,     /**< Sensor user callback returned */
+    RS2_LATENCY_STAGE_COUNT             /**< Number of enumeration values. Not a valid input: intended to be used in for-loops. */
+} rs2_latency_stage;
+const char* rs2_latency_stage_to_string(rs2_latency_stage stage);
+
+/** \brief Reasons for which the library drops frames on the host */
+typedef enum rs2_frame_drop_reason
+{
+    RS2_FRAME_DROP_REASON_ARCHIVE_FULL,     /**< The frame archive ran out of frames, the user holds on to too many frames */
+    RS2_FRAME_DROP_REASON_QUEUE_OVERFLOW,   /**< A bounded queue was full and dropped its oldest frame */
+    RS2_FRAME_DROP_REASON_SYNCER_DISCARD,   /**< The syncer discarded frames waiting for a match */
+    RS2_FRAME_DROP_REASON_LATENCY_BUDGET,   /**< A queue in latency budget mode dropped a frame that would have been consumed too late */
+    RS2_FRAME_DROP_REASON_COUNT             /**< Number of enumeration values. Not a valid input: intended to be used in for-loops. */
+} rs2_frame_drop_reason;
+const char* rs2_frame_drop_reason_to_string(rs2_frame_drop_reason reason);
+
+/** \brief Latency distribution of one stream at one stage of the frame pipeline, all values in milliseconds */
+typedef struct rs2_latency_stats
+{
+    unsigned long long count;   /**< Number of frames sampled */
+    float min;
+    float mean;
+    float max;
+    float p50;                  /**< Percentiles are taken from a log-linear histogram, within ~6% of the exact value */
+    float p90;
+    float p99;
+} rs2_latency_stats;
+
+/** \brief Statistics of one kind of task run on the processing thread pool */
+typedef struct rs2_processing_task_stats
+{
+    char name[32];                  /**< Task name, usually the processing block that submitted it */
+    unsigned long long chunks;      /**< Number of chunks the runs of the task were split into */
+    unsigned long long stolen;      /**< Number of those chunks run by pool workers rather than by the submitting thread */
+    rs2_latency_stats duration;     /**< Duration of a run, from submission until the last chunk is done; count is the number of runs */
+} rs2_processing_task_stats;
+
+/**
+* Enable or disable collection of frame pipeline latency and drop statistics. Statistics are process-wide and
+* cheap enough to be left enabled.
+* \param[in] enable     Non-zero to start collecting, zero to stop
+* \param[out] error     If non-null, receives any error that occurs during this call, otherwise, errors are ignored
+*/
+void rs2_enable_pipeline_stats(int enable, rs2_error** error);
+
+/**
+* Clear all collected pipeline statistics
+* \param[out] error     If non-null, receives any error that occurs during this call, otherwise, errors are ignored
+*/
+void rs2_reset_pipeline_stats(rs2_error** error);
+
+/**
+* Retrieve the latency distribution of a stream at a given pipeline stage
+* \param[in] stream     Stream type
+* \param[in] index      Stream index
+* \param[in] stage      Pipeline stage
+* \param[out] stats     Pointer to a user allocated struct, filled with the latency distribution
+* \param[out] error     If non-null, receives any error that occurs during this call, otherwise, errors are ignored
+* \return               Non-zero if any frame of this stream was sampled at this stage
+*/
+int rs2_get_pipeline_stats(rs2_stream stream, int index, rs2_latency_stage stage, rs2_latency_stats* stats, rs2_error** error);
+
+/**
+* Retrieve the number of frames of a stream dropped for a given reason
+* \param[in] stream     Stream type
+* \param[in] index      Stream index
+* \param[in] reason     Drop reason
+* \param[out] error     If non-null, receives any error that occurs during this call, otherwise, errors are ignored
+* \return               Number of dropped frames
+*/
+unsigned long long rs2_get_pipeline_frame_drops(rs2_stream stream, int index, rs2_frame_drop_reason reason, rs2_error** error);
+
+/**
+* Retrieve statistics of the tasks run on the processing thread pool, collected while pipeline statistics are
+* enabled and cleared with them
+* \param[out] stats     User allocated array, filled with the statistics of up to max_count tasks; may be null to only count them
+* \param[in] max_count  Number of elements in stats
+* \param[out] error     If non-null, receives any error that occurs during this call, otherwise, errors are ignored
+* \return               Number of tasks with statistics, which may exceed max_count
+*/
+int rs2_get_processing_task_stats(rs2_processing_task_stats* stats, int max_count, rs2_error** error);
+
 #ifdef __cplusplus
 }
 #endif
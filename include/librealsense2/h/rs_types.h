@@ -22,6 +22,7 @@ typedef enum rs2_notification_category{
     RS2_NOTIFICATION_CATEGORY_UNKNOWN_ERROR,                /**< Received unknown error from the device */
     RS2_NOTIFICATION_CATEGORY_FIRMWARE_UPDATE_RECOMMENDED,  /**< Current firmware version installed is not the latest available */
     RS2_NOTIFICATION_CATEGORY_POSE_RELOCALIZATION,          /**< A relocalization event has updated the pose provided by a pose sensor */
+    RS2_NOTIFICATION_CATEGORY_FRAMES_DROPPED,               /**< The host dropped frames on purpose, the type holds the rs2_frame_drop_reason */
     RS2_NOTIFICATION_CATEGORY_COUNT                         /**< Number of enumeration values. Not a valid input: intended to be used in for-loops. */
 } rs2_notification_category;
 const char* rs2_notification_category_to_string(rs2_notification_category category);
@@ -149,6 +150,31 @@ typedef struct rs2_pose
     unsigned int    mapper_confidence;    /**< Pose map confidence 0x0 - Failed, 0x1 - Low, 0x2 - Medium, 0x3 - High                                      */
 } rs2_pose;
 
+/** \brief Samples of a batched motion frame, see RS2_OPTION_MOTION_BATCH_SIZE. The arrays point into the frame data and stay valid while the frame is referenced. */
+typedef struct rs2_motion_batch
+{
+    int             count;                /**< Number of samples in the batch                                                                             */
+    const double*   timestamps;           /**< Timestamp of every sample, in milliseconds, in the timestamp domain of the frame                          */
+    const float*    x;                    /**< X values of every sample, in meters/sec^2 for accel or radians/sec for gyro                               */
+    const float*    y;                    /**< Y values of every sample                                                                                   */
+    const float*    z;                    /**< Z values of every sample                                                                                   */
+} rs2_motion_batch;
+
+/** \brief Clock of a device a multi-device syncer received frames of, and the offset of its frames from those of the first such device, see rs2_get_device_clock_skews */
+typedef struct rs2_device_clock_skew
+{
+    char                serial_number[32];   /**< Serial number of the device, empty if it has none                                                      */
+    int                 has_clock;           /**< Non-zero when the device maps its clock onto the host's (RS2_OPTION_GLOBAL_TIME_ENABLED), and the clock
+                                                  fields are valid. Software devices and recordings have no clock of their own                          */
+    double              clock_offset;        /**< Host clock less the device clock, in ms, as last estimated by the global time of the device            */
+    double              clock_drift;         /**< Rate of the device clock against the host's, less 1, in parts per million                              */
+    double              frameset_offset;     /**< Host time of the frames of the device less that of the first device in the framesets matched, in ms,
+                                                  averaged over recent framesets. This is the capture phase between the devices plus what is left of the
+                                                  clock offset, and is within the matching tolerance                                                     */
+    double              max_frameset_offset; /**< Largest absolute frameset offset of any frameset, in ms                                                */
+    unsigned long long  framesets;           /**< Number of framesets with frames of both devices                                                        */
+} rs2_device_clock_skew;
+
 /** \brief Severity of the librealsense logger. */
 typedef enum rs2_log_severity {
     RS2_LOG_SEVERITY_DEBUG, /**< Detailed information about ordinary operations */
@@ -253,6 +279,16 @@ typedef enum rs2_matchers
    RS2_MATCHER_COUNT
 }rs2_matchers;
 
+/** \brief Roles of the threads the library runs, for the purpose of placing them on CPUs and memory nodes */
+typedef enum rs2_thread_role
+{
+    RS2_THREAD_ROLE_CAPTURE,            /**< Backend threads that receive frames and motion samples from the device */
+    RS2_THREAD_ROLE_DISPATCH,           /**< Per-stream threads that convert raw frames and run the frame callbacks and the syncer */
+    RS2_THREAD_ROLE_PROCESSING,         /**< Worker threads of the processing thread pool */
+    RS2_THREAD_ROLE_COUNT               /**< Number of enumeration values. Not a valid input: intended to be used in for-loops. */
+} rs2_thread_role;
+const char* rs2_thread_role_to_string(rs2_thread_role role);
+
 typedef struct rs2_device_info rs2_device_info;
 typedef struct rs2_device rs2_device;
 typedef struct rs2_error rs2_error;
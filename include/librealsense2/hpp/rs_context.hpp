@@ -206,6 +206,49 @@ namespace rs2
             rs2::error::handle(e);
         }
 
+        /**
+         * Set the number of worker threads of the processing thread pool, shared by all processing blocks in the process
+         * @param threads  Number of workers besides the thread running a processing block, 0 for none, -1 for one per core less one
+         */
+        void set_processing_threads(int threads)
+        {
+            rs2_error* e = nullptr;
+            rs2_context_set_processing_threads(_context.get(), threads, &e);
+            rs2::error::handle(e);
+        }
+
+        int get_processing_threads() const
+        {
+            rs2_error* e = nullptr;
+            auto res = rs2_context_get_processing_threads(_context.get(), &e);
+            rs2::error::handle(e);
+            return res;
+        }
+
+        /**
+         * Restrict the worker threads of the processing thread pool to a set of CPUs, an empty set lifts the restriction
+         */
+        void set_processing_affinity(const std::vector<int>& cpus)
+        {
+            rs2_error* e = nullptr;
+            rs2_context_set_processing_affinity(_context.get(), cpus.data(), static_cast<int>(cpus.size()), &e);
+            rs2::error::handle(e);
+        }
+
+        /**
+         * Set where the library threads of a role run, for all devices, and name them after their role
+         * @param role               Role of the threads to place
+         * @param cpus               CPUs the threads may run on, none for no restriction
+         * @param realtime_priority  SCHED_FIFO priority between 1 and 99, 0 to keep the default scheduling
+         * @param numa_node          Memory node on which the threads prefer to allocate, -1 for none
+         */
+        void set_thread_placement(rs2_thread_role role, const std::vector<int>& cpus, int realtime_priority = 0, int numa_node = -1)
+        {
+            rs2_error* e = nullptr;
+            rs2_context_set_thread_placement(_context.get(), role, cpus.data(), static_cast<int>(cpus.size()), realtime_priority, numa_node, &e);
+            rs2::error::handle(e);
+        }
+
         context(std::shared_ptr<rs2_context> ctx)
             : _context(ctx)
         {}
@@ -95,6 +95,20 @@ namespace rs2
             error::handle(e);
         }
 
+        /**
+        * Place the capture or dispatch threads of this device, overriding the placement set on the context
+        * \param[in] role               Role of the threads to place, capture or dispatch
+        * \param[in] cpus               CPUs the threads may run on, none for no restriction
+        * \param[in] realtime_priority  SCHED_FIFO priority between 1 and 99, 0 to keep the default scheduling
+        * \param[in] numa_node          Memory node on which the threads prefer to allocate, -1 for none
+        */
+        void set_thread_placement(rs2_thread_role role, const std::vector<int>& cpus, int realtime_priority = 0, int numa_node = -1) const
+        {
+            rs2_error* e = nullptr;
+            rs2_set_device_thread_placement(_dev.get(), role, cpus.data(), static_cast<int>(cpus.size()), realtime_priority, numa_node, &e);
+            error::handle(e);
+        }
+
         device& operator=(const std::shared_ptr<rs2_device> dev)
         {
             _dev.reset();
@@ -514,6 +514,18 @@ namespace rs2
             return r != 0;
         }
 
+        /** retrieve all frame_metadata values in one call
+        * \return            an entry per frame_metadata, indexed by it, valid where the frame carries the frame_metadata
+        */
+        std::vector<rs2_frame_metadata_entry> get_frame_metadata_all() const
+        {
+            std::vector<rs2_frame_metadata_entry> entries(RS2_FRAME_METADATA_COUNT);
+            rs2_error* e = nullptr;
+            rs2_get_frame_metadata_all(frame_ref, entries.data(), static_cast<int>(entries.size()), &e);
+            error::handle(e);
+            return entries;
+        }
+
         /**
         * retrieve frame number (from frame handle)
         * \return               the frame number of the frame, in milliseconds since the device was started
@@ -797,6 +809,20 @@ namespace rs2
             return (const texture_coordinate*)res;
         }
 
+        /**
+        * Retrieve the points of a frame produced with RS2_OPTION_POINTS_LAYOUT set. size() is their count, and
+        * get_vertices() and get_texture_coordinates() only accept compact points of float32 type
+        * \return rs2_compact_points - the points, with null vertices for a frame holding a point for every depth pixel
+        */
+        rs2_compact_points get_compact_points() const
+        {
+            rs2_error* e = nullptr;
+            rs2_compact_points compact{};
+            rs2_get_compact_points(get(), &compact, &e);
+            error::handle(e);
+            return compact;
+        }
+
         size_t size() const
         {
             return _size;
@@ -849,6 +875,41 @@ namespace rs2
             error::handle( e );
             return r;
         }
+
+        /**
+        * Project color pixels to the depth pixels of this frame that see the same points, all at once
+        * \param[in] color          stream profile of the color pixels
+        * \param[in] color_pixels   (x, y) pairs of color pixels
+        * \param[in] depth_min      nearest depth, in meters, considered
+        * \param[in] depth_max      farthest depth, in meters, considered
+        * \return                   (x, y) pairs of depth pixels, (-1, -1) where no depth pixel sees the color pixel
+        */
+        std::vector<float> project_color_pixels(const stream_profile& color, const std::vector<float>& color_pixels,
+                                                float depth_min = 0.1f, float depth_max = 10.f) const
+        {
+            std::vector<float> depth_pixels(color_pixels.size());
+            if (depth_pixels.empty())
+                return depth_pixels;
+            rs2_error* e = nullptr;
+            rs2_project_color_pixels_to_depth_pixels(get(), color.get(), depth_min, depth_max,
+                color_pixels.data(), depth_pixels.data(), static_cast<int>(color_pixels.size() / 2), &e);
+            error::handle(e);
+            return depth_pixels;
+        }
+
+        /**
+        * Rate the depth quality of a region of this frame facing a flat target, against the plane that fits it best
+        * \param[in] params   region of interest and what is known of the target
+        * \return             fill rate, plane fit and error metrics of the region
+        */
+        rs2_depth_quality_metrics analyze_quality(const rs2_depth_quality_params& params) const
+        {
+            rs2_depth_quality_metrics metrics;
+            rs2_error* e = nullptr;
+            rs2_analyze_depth_quality(get(), &params, &metrics, &e);
+            error::handle(e);
+            return metrics;
+        }
     };
 
     class disparity_frame : public depth_frame
@@ -907,6 +968,19 @@ namespace rs2
             auto data = reinterpret_cast<const float*>(get_data());
             return rs2_vector{ data[0], data[1], data[2] };
         }
+        /**
+        * Retrieve all the samples of a frame delivered with RS2_OPTION_MOTION_BATCH_SIZE set.
+        * get_motion_data() returns the latest of them
+        * \return rs2_motion_batch - the samples, count is 0 for a frame holding a single sample
+        */
+        rs2_motion_batch get_motion_batch() const
+        {
+            rs2_error* e = nullptr;
+            rs2_motion_batch batch{};
+            rs2_get_motion_batch(get(), &batch, &e);
+            error::handle(e);
+            return batch;
+        }
     };
 
     class pose_frame : public frame
@@ -545,6 +545,19 @@ namespace rs2
             return res > 0;
         }
 
+        /**
+        * Drop the frames sets waiting for \c wait_for_frames() by age rather than keeping only the latest one. Sets older
+        * than the budget are dropped, and no more sets are kept than the application can take within the budget at the rate
+        * it was seen calling. Takes effect the next time the pipeline starts.
+        * \param[in] max_age_ms  latency budget in milliseconds, 0 to keep only the latest set
+        */
+        void set_latency_budget(float max_age_ms)
+        {
+            rs2_error* e = nullptr;
+            rs2_pipeline_set_latency_budget(_pipeline.get(), max_age_ms, &e);
+            error::handle(e);
+        }
+
         bool try_wait_for_frames(frameset* f, unsigned int timeout_ms = RS2_DEFAULT_TIMEOUT) const
         {
             if (!f)
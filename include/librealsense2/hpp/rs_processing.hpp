@@ -221,6 +221,18 @@ namespace rs2
         */
         bool keep_frames() const { return _keep; }
 
+        /**
+        * Drop frames by age rather than by count: frames older than the budget are dropped, and the queue keeps no more
+        * frames than the consumer can take within the budget at its observed rate
+        * \param[in] max_age_ms  latency budget in milliseconds, 0 to return to dropping by count
+        */
+        void set_latency_budget(float max_age_ms) const
+        {
+            rs2_error* e = nullptr;
+            rs2_set_frame_queue_latency_budget(_queue.get(), max_age_ms, &e);
+            error::handle(e);
+        }
+
     private:
         std::shared_ptr<rs2_frame_queue> _queue;
         size_t _capacity;
@@ -581,6 +593,11 @@ namespace rs2
         */
         asynchronous_syncer() : processing_block(init()) {}
 
+        /**
+        * Asynchronous syncer of an already created low level syncer, such as a multi-device one
+        */
+        explicit asynchronous_syncer(std::shared_ptr<rs2_processing_block> block) : processing_block(block) {}
+
     private:
         std::shared_ptr<rs2_processing_block> init()
         {
@@ -653,11 +670,76 @@ namespace rs2
         {
             _sync.invoke(std::move(f));
         }
-    private:
+
+        /**
+        * Drop the matched sets by age rather than by count, see frame_queue::set_latency_budget
+        * \param[in] max_age_ms  latency budget in milliseconds, 0 to return to the queue size of the syncer
+        */
+        void set_latency_budget(float max_age_ms) const
+        {
+            _results.set_latency_budget(max_age_ms);
+        }
+    protected:
+        syncer(std::shared_ptr<rs2_processing_block> block, int queue_size)
+            :_sync(block), _results(queue_size)
+        {
+            _sync.start(_results);
+        }
+
         asynchronous_syncer _sync;
+    private:
         frame_queue _results;
     };
 
+    class multi_device_syncer : public syncer
+    {
+    public:
+        /**
+        * Sync instance to align frames from the streams of several devices, see rs2_create_multi_device_sync_processing_block
+        * \param[in] tolerance_ms    largest difference in host time of frames of different devices in one frameset; 0 for half the frame period of the slower device
+        * \param[in] max_latency_ms  longest time a frameset waits for the devices missing from it
+        */
+        multi_device_syncer(float tolerance_ms = 0.f, float max_latency_ms = 100.f, int queue_size = 1)
+            : syncer(init(tolerance_ms, max_latency_ms), queue_size)
+        {
+        }
+
+        /**
+        * Get the clock of every device that sent frames so far, where it has one, and the offset of its frames from those
+        * of the first of them in the framesets matched, see rs2_device_clock_skew
+        * \return skews in the order the devices first sent frames
+        */
+        std::vector<rs2_device_clock_skew> get_clock_skews() const
+        {
+            rs2_error* e = nullptr;
+            std::vector<rs2_device_clock_skew> skews;
+            auto count = rs2_get_device_clock_skews(_sync.get(), nullptr, 0, &e);
+            error::handle(e);
+
+            // Devices matched between the calls are left for the next time
+            skews.resize(count);
+            if (count)
+            {
+                count = std::min(count, rs2_get_device_clock_skews(_sync.get(), skews.data(), count, &e));
+                error::handle(e);
+                skews.resize(count);
+            }
+            return skews;
+        }
+
+    private:
+        static std::shared_ptr<rs2_processing_block> init(float tolerance_ms, float max_latency_ms)
+        {
+            rs2_error* e = nullptr;
+            auto block = std::shared_ptr<rs2_processing_block>(
+                rs2_create_multi_device_sync_processing_block(tolerance_ms, max_latency_ms, &e),
+                rs2_delete_processing_block);
+
+            error::handle(e);
+            return block;
+        }
+    };
+
     /**
     Auxiliary processing block that performs image alignment using depth data and camera calibration
     */
@@ -1179,5 +1261,37 @@ namespace rs2
             return block;
         }
     };
+
+    class depth_postprocess : public filter
+    {
+    public:
+        /**
+        * Create a depth post-processing block, which applies the given filters in order to every depth frame
+        * The filters keep their options, so they are configured, and presets apply to them, as before. The
+        * recommended chain of decimation, threshold, depth to disparity, spatial, temporal, disparity to depth
+        * and hole filling is applied in a few passes over one frame, instead of a frame per filter.
+        * \param[in] filters - the decimation, threshold, disparity transform, spatial, temporal and hole filling
+        * filters to apply, in order
+        */
+        depth_postprocess(const std::vector<filter*>& filters) : filter(init(filters), 1) {}
+
+    private:
+        friend class context;
+
+        std::shared_ptr<rs2_processing_block> init(const std::vector<filter*>& filters)
+        {
+            std::vector<rs2_processing_block*> blocks;
+            for (auto f : filters)
+                blocks.push_back(f ? f->get() : nullptr);
+
+            rs2_error* e = nullptr;
+            auto block = std::shared_ptr<rs2_processing_block>(
+                rs2_create_depth_postprocess_block(blocks.data(), int(blocks.size()), &e),
+                rs2_delete_processing_block);
+            error::handle(e);
+
+            return block;
+        }
+    };
 }
 #endif // LIBREALSENSE_RS2_PROCESSING_HPP
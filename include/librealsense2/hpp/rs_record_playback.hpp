@@ -96,6 +96,45 @@ namespace rs2
             error::handle(e);
         }
 
+        /**
+        * Sets the playback to the time point of a frame of one of the played streams, found in O(log n) with an index of the frames of the file
+        * \param[in] stream        A stream profile of a sensor of the playback
+        * \param[in] frame_number  Frame number of the frame of the stream to seek to
+        */
+        void seek_to_frame(const stream_profile& stream, unsigned long long frame_number) const
+        {
+            rs2_error* e = nullptr;
+            rs2_playback_seek_to_frame(_dev.get(), stream.get(), frame_number, &e);
+            error::handle(e);
+        }
+
+        /**
+        * Retrieves the number of frames of one of the played streams in the file
+        * \param[in] stream  A stream profile of a sensor of the playback
+        * \return Number of frames of the stream in the file
+        */
+        unsigned long long get_frame_count(const stream_profile& stream) const
+        {
+            rs2_error* e = nullptr;
+            auto count = rs2_playback_get_frame_count(_dev.get(), stream.get(), &e);
+            error::handle(e);
+            return count;
+        }
+
+        /**
+        * Reads a frame of one of the played streams by its position among the frames of the stream in the file, without moving the playback
+        * \param[in] stream  A stream profile of a sensor of the playback
+        * \param[in] index   Position of the frame, from 0 to get_frame_count() - 1, in the order of the timestamps of the frames
+        * \return The frame
+        */
+        frame get_frame_at(const stream_profile& stream, unsigned long long index) const
+        {
+            rs2_error* e = nullptr;
+            auto f = rs2_playback_get_frame_at(_dev.get(), stream.get(), index, &e);
+            error::handle(e);
+            return frame(f);
+        }
+
         /**
         * Indicates if playback is in real time mode or non real time
         * \return True iff playback is in real time mode
@@ -106,6 +106,23 @@ const char * rs2_get_full_log_message( rs2_log_message const * msg, rs2_error**
  */
 void rs2_log(rs2_log_severity severity, const char * message, rs2_error ** error);
 
+/**
+ * Enable or disable the per-frame trace. Streaming events (frame arrival, user callbacks, syncer) are kept as
+ * fixed-size binary records in per-thread ring buffers, independently of the log severity, so the trace can
+ * stay enabled in production without affecting timing
+ * \param[in] enable  non-zero to start recording, zero to stop
+ * \param[out] error  if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+ */
+void rs2_enable_frame_trace(int enable, rs2_error ** error);
+
+/**
+ * Decode the frame trace records currently held in the ring buffers into a file
+ * \param[in] file_path     path of the file to create
+ * \param[in] chrome_trace  non-zero to write Chrome trace JSON (chrome://tracing), zero to write CSV text
+ * \param[out] error        if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+ */
+void rs2_dump_frame_trace(const char * file_path, int chrome_trace, rs2_error ** error);
+
 /**
 * Given the 2D depth coordinate (x,y) provide the corresponding depth in metric units
 * \param[in] frame_ref  2D depth pixel coordinates (Left-Upper corner origin)
@@ -51,6 +51,69 @@ namespace rs2
         error::handle( e );
     }
     
+    // Enable or disable the binary per-frame trace, see rs2_enable_frame_trace
+    inline void enable_frame_trace( bool enable )
+    {
+        rs2_error * e = nullptr;
+        rs2_enable_frame_trace( enable, &e );
+        error::handle( e );
+    }
+
+    // Write the frame trace records currently held into a file, as CSV text or Chrome trace JSON
+    inline void dump_frame_trace( const char * file_path, bool chrome_trace = false )
+    {
+        rs2_error * e = nullptr;
+        rs2_dump_frame_trace( file_path, chrome_trace, &e );
+        error::handle( e );
+    }
+
+    // Enable or disable collection of frame pipeline latency and drop statistics
+    inline void enable_pipeline_stats( bool enable )
+    {
+        rs2_error * e = nullptr;
+        rs2_enable_pipeline_stats( enable, &e );
+        error::handle( e );
+    }
+
+    inline void reset_pipeline_stats()
+    {
+        rs2_error * e = nullptr;
+        rs2_reset_pipeline_stats( &e );
+        error::handle( e );
+    }
+
+    // Latency distribution of a stream at a pipeline stage; count is zero when nothing was sampled
+    inline rs2_latency_stats get_pipeline_stats( rs2_stream stream, int index, rs2_latency_stage stage )
+    {
+        rs2_error * e = nullptr;
+        rs2_latency_stats stats = {};
+        rs2_get_pipeline_stats( stream, index, stage, &stats, &e );
+        error::handle( e );
+        return stats;
+    }
+
+    inline unsigned long long get_pipeline_frame_drops( rs2_stream stream, int index, rs2_frame_drop_reason reason )
+    {
+        rs2_error * e = nullptr;
+        auto res = rs2_get_pipeline_frame_drops( stream, index, reason, &e );
+        error::handle( e );
+        return res;
+    }
+
+    // Statistics of the tasks run on the processing thread pool
+    inline std::vector< rs2_processing_task_stats > get_processing_task_stats()
+    {
+        rs2_error * e = nullptr;
+        std::vector< rs2_processing_task_stats > res;
+        int count = rs2_get_processing_task_stats( nullptr, 0, &e );
+        error::handle( e );
+        res.resize( count );
+        count = rs2_get_processing_task_stats( res.data(), count, &e );
+        error::handle( e );
+        res.resize( std::min( res.size(), size_t( count ) ) );
+        return res;
+    }
+
     /*
         Interface to the log message data we expose.
     */
@@ -171,5 +234,8 @@ inline std::ostream & operator << (std::ostream & o, rs2_l500_visual_preset pres
 inline std::ostream & operator << (std::ostream & o, rs2_sensor_mode mode) { return o << rs2_sensor_mode_to_string(mode); }
 inline std::ostream & operator << (std::ostream & o, rs2_calibration_type mode) { return o << rs2_calibration_type_to_string(mode); }
 inline std::ostream & operator << (std::ostream & o, rs2_calibration_status mode) { return o << rs2_calibration_status_to_string(mode); }
+inline std::ostream & operator << (std::ostream & o, rs2_latency_stage stage) { return o << rs2_latency_stage_to_string(stage); }
+inline std::ostream & operator << (std::ostream & o, rs2_frame_drop_reason reason) { return o << rs2_frame_drop_reason_to_string(reason); }
+inline std::ostream & operator << (std::ostream & o, rs2_thread_role role) { return o << rs2_thread_role_to_string(role); }
 
 #endif // LIBREALSENSE_RS2_HPP
@@ -78,11 +78,12 @@ auto_exposure_mechanism::auto_exposure_mechanism(option& gain_option, option& ex
                 auto frame = std::move(f_holder);
 
                 double values[2] = {};
+                rs2_metadata_type md;
 
-                values[0] = frame->supports_frame_metadata(RS2_FRAME_METADATA_ACTUAL_EXPOSURE) ?
-                            static_cast<double>(frame->get_frame_metadata(RS2_FRAME_METADATA_ACTUAL_EXPOSURE)) : _exposure_option.query();
-                values[1] = frame->supports_frame_metadata(RS2_FRAME_METADATA_GAIN_LEVEL) ?
-                            static_cast<double>(frame->get_frame_metadata(RS2_FRAME_METADATA_GAIN_LEVEL)) : _gain_option.query();
+                values[0] = frame->find_frame_metadata(RS2_FRAME_METADATA_ACTUAL_EXPOSURE, md) ?
+                            static_cast<double>(md) : _exposure_option.query();
+                values[1] = frame->find_frame_metadata(RS2_FRAME_METADATA_GAIN_LEVEL, md) ?
+                            static_cast<double>(md) : _gain_option.query();
 
                 values[0] /= 1000.; // Fisheye exposure value by extension control-
                                     // is in units of MicroSeconds, from FW version 5.6.3.0
@@ -42,6 +42,8 @@ namespace librealsense
                                                  // if the recorder was configured to realtime mode or not
                                                  // if true, this will force any queue receiving this frame not to drop it
         uint32_t            raw_size = 0;   // The frame transmitted size (payload only)
+        bool                is_motion_batch = false; // the motion frame carries a batch of samples, see motion-batch.h
+        bool                is_compact_points = false; // the points frame holds only the points with depth, see compact-points.h
 
         frame_additional_data() {}
 
@@ -91,7 +93,8 @@ namespace librealsense
     std::shared_ptr<archive_interface> make_archive(rs2_extension type,
         std::atomic<uint32_t>* in_max_frame_queue_size,
         std::shared_ptr<platform::time_service> ts,
-        std::shared_ptr<metadata_parser_map> parsers);
+        std::shared_ptr<metadata_parser_map> parsers,
+        int published_pool_size = RS2_USER_QUEUE_SIZE);
 
     // Define a movable but explicitly noncopyable buffer type to hold our frame data
     class LRS_EXTENSION_API frame : public frame_interface
@@ -100,7 +103,7 @@ namespace librealsense
         std::vector<byte> data;
         frame_additional_data additional_data;
         std::shared_ptr<metadata_parser_map> metadata_parsers = nullptr;
-        explicit frame() : ref_count(0), owner(nullptr), on_release(),_kept(false) {}
+        explicit frame() : ref_count(0), owner(nullptr), on_release(),_kept(false) { reset_metadata_cache(); }
         frame(const frame& r) = delete;
         frame(frame&& r)
             : ref_count(r.ref_count.exchange(0)), owner(r.owner), on_release(), _kept(r._kept.exchange(false))
@@ -122,21 +125,32 @@ namespace librealsense
             r.owner.reset();
             if (owner) metadata_parsers = owner->get_md_parsers();
             if (r.metadata_parsers) metadata_parsers = std::move(r.metadata_parsers);
+            reset_metadata_cache();
             return *this;
         }
 
         virtual ~frame() { on_release.reset(); }
         rs2_metadata_type get_frame_metadata(const rs2_frame_metadata_value& frame_metadata) const override;
         bool supports_frame_metadata(const rs2_frame_metadata_value& frame_metadata) const override;
+        bool find_frame_metadata(const rs2_frame_metadata_value& frame_metadata, rs2_metadata_type& value) const override;
         int get_frame_data_size() const override;
         const byte* get_frame_data() const override;
         rs2_time_t get_frame_timestamp() const override;
         rs2_timestamp_domain get_frame_timestamp_domain() const override;
-        void set_timestamp(double new_ts) override { additional_data.timestamp = new_ts; }
+        void set_timestamp(double new_ts) override { additional_data.timestamp = new_ts; reset_metadata_cache(); }
         unsigned long long get_frame_number() const override;
         void set_timestamp_domain(rs2_timestamp_domain timestamp_domain) override
         {
             additional_data.timestamp_domain = timestamp_domain;
+            reset_metadata_cache();
+        }
+
+        // Metadata attributes are decoded once per frame, on first access. Code that changes the additional data
+        // of a frame after its metadata may have been read must reset the decoded attributes
+        void reset_metadata_cache()
+        {
+            for (auto& state : _md_state)
+                state.store(md_unknown, std::memory_order_relaxed);
         }
 
         rs2_time_t get_frame_system_time() const override;
@@ -172,6 +186,12 @@ namespace librealsense
         bool is_blocking() const override { return additional_data.is_blocking; }
 
     private:
+        bool decode_frame_metadata(rs2_frame_metadata_value frame_metadata, rs2_metadata_type& value) const;
+
+        enum md_state : uint8_t { md_unknown, md_decoding, md_absent, md_present };
+        mutable std::array<std::atomic<uint8_t>, ::RS2_FRAME_METADATA_COUNT> _md_state;
+        mutable std::array<rs2_metadata_type, ::RS2_FRAME_METADATA_COUNT> _md_values;
+
         // TODO: check boost::intrusive_ptr or an alternative
         std::atomic<int> ref_count; // the reference count is on how many times this placeholder has been observed (not lifetime, not content)
         std::shared_ptr<archive_interface> owner; // pointer to the owner to be returned to by last observe
@@ -234,6 +254,10 @@ namespace librealsense
         {
             return first()->supports_frame_metadata(frame_metadata);
         }
+        bool find_frame_metadata(const rs2_frame_metadata_value& frame_metadata, rs2_metadata_type& value) const override
+        {
+            return first()->find_frame_metadata(frame_metadata, value);
+        }
         int get_frame_data_size() const override
         {
             return first()->get_frame_data_size();
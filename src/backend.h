@@ -535,6 +535,21 @@ namespace librealsense
                     !list_changed(playback_devices, other.playback_devices);
             }
 
+            // Unique ids of the backend interfaces, in the order uvc, hid, usb and without repetitions
+            std::vector<std::string> get_unique_ids() const
+            {
+                std::vector<std::string> ids;
+                auto add = [&](const std::string& id)
+                {
+                    if (!id.empty() && std::find(ids.begin(), ids.end(), id) == ids.end())
+                        ids.push_back(id);
+                };
+                for (auto&& uvc : uvc_devices) add(uvc.unique_id);
+                for (auto&& hid : hid_devices) add(hid.unique_id);
+                for (auto&& usb : usb_devices) add(usb.unique_id);
+                return ids;
+            }
+
             operator std::string()
             {
                 std::string s;
@@ -8,13 +8,31 @@
 #include <thread>
 #include <atomic>
 #include <functional>
+#include <memory>
+#include <chrono>
 
 const int QUEUE_MAX_SIZE = 10;
+
+// Decides which items of a queue are dropped ahead of the consumer, on top of the capacity of the queue.
+// Called with the queue locked.
+template<class T>
+class queue_expiry_policy
+{
+public:
+    virtual ~queue_expiry_policy() = default;
+
+    // Whether the oldest item should be dropped, given when the queue received it and the number of items queued
+    virtual bool is_expired(T const & oldest, std::chrono::steady_clock::time_point arrival, size_t queued) = 0;
+    virtual void on_expired(T const & item) = 0;
+    virtual void on_dequeued(T const & item) = 0;
+};
+
 // Simplest implementation of a blocking concurrent queue for thread messaging
 template<class T>
 class single_consumer_queue
 {
     std::deque<T> _queue;
+    std::deque<std::chrono::steady_clock::time_point> _arrivals; // when each item of _queue was received
     std::mutex _mutex;
     std::condition_variable _deq_cv; // not empty signal
     std::condition_variable _enq_cv; // not empty signal
@@ -27,6 +45,37 @@ class single_consumer_queue
     std::atomic<bool> _need_to_flush;
     std::atomic<bool> _was_flushed;
     std::function<void(T const &)> _on_drop_callback;
+    std::shared_ptr<queue_expiry_policy<T>> _expiry;
+
+    // Called with the lock held
+    void push(T&& item)
+    {
+        _queue.push_back(std::move(item));
+        _arrivals.push_back(std::chrono::steady_clock::now());
+    }
+
+    void pop()
+    {
+        _queue.pop_front();
+        _arrivals.pop_front();
+    }
+
+    void drop_expired()
+    {
+        if (!_expiry)
+            return;
+        while (_queue.size() > 0 && _expiry->is_expired(_queue.front(), _arrivals.front(), _queue.size()))
+        {
+            _expiry->on_expired(_queue.front());
+            pop();
+        }
+    }
+
+    void on_dequeued(T const & item)
+    {
+        if (_expiry)
+            _expiry->on_dequeued(item);
+    }
 public:
     explicit single_consumer_queue<T>(unsigned int cap = QUEUE_MAX_SIZE, std::function<void(T const &)> on_drop_callback = nullptr)
         : _queue(), _mutex(), _deq_cv(), _enq_cv(), _cap(cap), _accepting(true), _need_to_flush(false), _was_flushed(false), _on_drop_callback(on_drop_callback)
@@ -37,15 +86,16 @@ public:
         std::unique_lock<std::mutex> lock(_mutex);
         if (_accepting)
         {
-            _queue.push_back(std::move(item));
+            push(std::move(item));
             if (_queue.size() > _cap)
             {
                 if (_on_drop_callback)
                 {
                     _on_drop_callback(_queue.front());
                 }
-                _queue.pop_front();
+                pop();
             }
+            drop_expired();
         }
         lock.unlock();
         _deq_cv.notify_one();
@@ -59,19 +109,37 @@ public:
         if (_accepting)
         {
             _enq_cv.wait(lock, pred);
-            _queue.push_back(std::move(item));
+            push(std::move(item));
+            drop_expired();
         }
         lock.unlock();
         _deq_cv.notify_one();
     }
 
+    // Capacity and expiry policy may change while the queue is in use. Items above a reduced capacity are kept
+    // until they are consumed.
+    void set_capacity(unsigned int cap)
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _cap = cap;
+        lock.unlock();
+        _enq_cv.notify_all();
+    }
+
+    void set_expiry_policy(std::shared_ptr<queue_expiry_policy<T>> expiry)
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _expiry = std::move(expiry);
+    }
+
 
     bool dequeue(T* item ,unsigned int timeout_ms)
     {
         std::unique_lock<std::mutex> lock(_mutex);
         _accepting = true;
         _was_flushed = false;
-        const auto ready = [this]() { return (_queue.size() > 0) || _need_to_flush; };
+        // Items may have expired while waiting for the consumer
+        const auto ready = [this]() { drop_expired(); return (_queue.size() > 0) || _need_to_flush; };
         if (!ready() && !_deq_cv.wait_for(lock, std::chrono::milliseconds(timeout_ms), ready))
         {
             return false;
@@ -82,7 +150,8 @@ public:
             return false;
         }
         *item = std::move(_queue.front());
-        _queue.pop_front();
+        pop();
+        on_dequeued(*item);
         _enq_cv.notify_one();
         return true;
     }
@@ -91,11 +160,13 @@ public:
     {
         std::unique_lock<std::mutex> lock(_mutex);
         _accepting = true;
+        drop_expired();
         if (_queue.size() > 0)
         {
             auto val = std::move(_queue.front());
-            _queue.pop_front();
+            pop();
             *item = std::move(val);
+            on_dequeued(*item);
             _enq_cv.notify_one();
             return true;
         }
@@ -125,7 +196,7 @@ public:
         while (_queue.size() > 0)
         {
             auto item = std::move(_queue.front());
-            _queue.pop_front();
+            pop();
         }
         _deq_cv.notify_all();
     }
@@ -150,7 +221,18 @@ class single_consumer_frame_queue
     single_consumer_queue<T> _queue;
 
 public:
-    single_consumer_frame_queue<T>(unsigned int cap = QUEUE_MAX_SIZE) : _queue(cap) {}
+    single_consumer_frame_queue<T>(unsigned int cap = QUEUE_MAX_SIZE, std::function<void(T const &)> on_drop_callback = nullptr)
+        : _queue(cap, on_drop_callback) {}
+
+    void set_capacity(unsigned int cap)
+    {
+        _queue.set_capacity(cap);
+    }
+
+    void set_expiry_policy(std::shared_ptr<queue_expiry_policy<T>> expiry)
+    {
+        _queue.set_expiry_policy(std::move(expiry));
+    }
 
     void enqueue(T&& item)
     {
@@ -214,14 +296,25 @@ public:
         dispatcher* _owner;
     };
     typedef std::function<void(cancellable_timer const &)> action;
-    dispatcher(unsigned int cap, std::function <void(action)> on_drop_callback = nullptr)
+    // on_thread_start runs on the dispatcher thread before any item, and unlike an invoked item is never dropped
+    dispatcher(unsigned int cap, std::function <void(action)> on_drop_callback = nullptr,
+               std::function<void()> on_thread_start = nullptr)
         : _queue(cap, on_drop_callback),
           _was_stopped(true),
           _was_flushed(false),
           _is_alive(true)
     {
-        _thread = std::thread([&]()
+        _thread = std::thread([this, on_thread_start]()
         {
+            if (on_thread_start)
+            {
+                try
+                {
+                    on_thread_start();
+                }
+                catch(...){}
+            }
+
             int timeout_ms = 5000;
             while (_is_alive)
             {
@@ -19,6 +19,7 @@
 #include "stream.h"
 #include "environment.h"
 #include "context.h"
+#include "thread-pool.h"
 #include "fw-update/fw-update-factory.h"
 
 #ifdef WITH_TRACKING
@@ -314,6 +315,9 @@ namespace librealsense
     context::~context()
     {
         _device_watcher->stop(); //ensure that the device watcher will stop before the _devices_changed_callback will be deleted
+
+        // Leaves no processing threads behind once the application is done with the library
+        thread_pool::get_instance().release_workers();
     }
 
     std::vector<std::shared_ptr<device_info>> context::query_devices(int mask) const
@@ -84,6 +84,8 @@ namespace librealsense
     public:
         virtual rs2_metadata_type get_frame_metadata(const rs2_frame_metadata_value& frame_metadata) const = 0;
         virtual bool supports_frame_metadata(const rs2_frame_metadata_value& frame_metadata) const = 0;
+        // Retrieves a metadata attribute without throwing: false when the frame does not carry it
+        virtual bool find_frame_metadata(const rs2_frame_metadata_value& frame_metadata, rs2_metadata_type& value) const = 0;
         virtual int get_frame_data_size() const = 0;
         virtual const byte* get_frame_data() const = 0;
         virtual rs2_time_t get_frame_timestamp() const = 0;
@@ -0,0 +1,113 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2021 Intel Corporation. All Rights Reserved.
+
+#include "cpu-dispatch.h"
+#include "types.h"
+
+#include <array>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define RS2_CPU_X86
+#ifdef _WIN32
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+namespace librealsense
+{
+    const char* get_string(simd_level value)
+    {
+        switch (value)
+        {
+        case simd_level::scalar: return "Scalar";
+        case simd_level::sse41:  return "SSE4.1";
+        case simd_level::avx2:   return "AVX2";
+        case simd_level::avx512: return "AVX-512";
+        case simd_level::neon:   return "NEON";
+        default:                 return UNKNOWN_VALUE;
+        }
+    }
+
+#ifdef RS2_CPU_X86
+    static void cpuid(int info[4], int leaf)
+    {
+#ifdef _WIN32
+        __cpuidex(info, leaf, 0);
+#else
+        __cpuid_count(leaf, 0, info[0], info[1], info[2], info[3]);
+#endif
+    }
+
+    // The OS must save the extended register state on context switch, or AVX is unusable even
+    // when the CPU reports it
+    static unsigned long long read_xcr0()
+    {
+#ifdef _WIN32
+        return _xgetbv(0);
+#else
+        unsigned int eax, edx;
+        __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+        return (static_cast<unsigned long long>(edx) << 32) | eax;
+#endif
+    }
+
+    static bool bit(int reg, int n) { return (reg & (1 << n)) != 0; }
+
+    static std::array<bool, size_t(simd_level::count)> detect()
+    {
+        std::array<bool, size_t(simd_level::count)> supported{};
+        supported[size_t(simd_level::scalar)] = true;
+
+        int info[4];
+        cpuid(info, 0);
+        auto max_leaf = info[0];
+        if (max_leaf < 1)
+            return supported;
+
+        cpuid(info, 1);
+        auto sse41 = bit(info[2], 19);
+        auto osxsave = bit(info[2], 27);
+        auto avx = bit(info[2], 28);
+        supported[size_t(simd_level::sse41)] = sse41;
+
+        if (max_leaf < 7 || !osxsave || !avx)
+            return supported;
+
+        auto xcr0 = read_xcr0();
+        auto os_avx = (xcr0 & 0x6) == 0x6;         // XMM and YMM state
+        auto os_avx512 = (xcr0 & 0xe6) == 0xe6;    // plus opmask and ZMM state
+
+        cpuid(info, 7);
+        supported[size_t(simd_level::avx2)] = os_avx && bit(info[1], 5);
+        supported[size_t(simd_level::avx512)] = os_avx512 && bit(info[1], 16) && bit(info[1], 30);
+        return supported;
+    }
+#else
+    static std::array<bool, size_t(simd_level::count)> detect()
+    {
+        std::array<bool, size_t(simd_level::count)> supported{};
+        supported[size_t(simd_level::scalar)] = true;
+#if defined(__aarch64__) || defined(_M_ARM64) || defined(__ARM_NEON) || defined(__ARM_NEON__)
+        // Mandatory on AArch64; on 32-bit ARM the library is only built with NEON enabled
+        supported[size_t(simd_level::neon)] = true;
+#endif
+        return supported;
+    }
+#endif
+
+    bool cpu_supports(simd_level level)
+    {
+        static const auto supported = detect();
+        return level < simd_level::count && supported[size_t(level)];
+    }
+
+    simd_level get_cpu_simd_level()
+    {
+        for (auto level : { simd_level::avx512, simd_level::avx2, simd_level::sse41, simd_level::neon })
+            if (cpu_supports(level))
+                return level;
+        return simd_level::scalar;
+    }
+}
@@ -0,0 +1,29 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2021 Intel Corporation. All Rights Reserved.
+
+#pragma once
+
+namespace librealsense
+{
+    // Instruction sets for which hand-written kernels exist, from the least to the most capable
+    // on each architecture. A level is usable only if the kernels were compiled in AND the CPU/OS
+    // running the library supports it.
+    enum class simd_level
+    {
+        scalar,
+        sse41,
+        avx2,
+        avx512,     // AVX-512 F + BW
+        neon,
+        count
+    };
+
+    const char* get_string(simd_level value);
+
+    // Whether the CPU (and the OS, for the wide register state) support the given level.
+    // Detected once, on first use.
+    bool cpu_supports(simd_level level);
+
+    // The most capable level the CPU supports, regardless of what kernels were compiled
+    simd_level get_cpu_simd_level();
+}
@@ -3,6 +3,7 @@
 #pragma once
 
 #include "archive.h"
+#include "frame-trace.h"
 
 namespace librealsense
 {
@@ -144,8 +145,7 @@ namespace librealsense
                 auto callback_warning_duration = 1000 / (frame->get_stream()->get_framerate() + 1);
                 auto callback_duration = callback_ended - frame->get_frame_callback_start_time_point();
 
-                LOG_DEBUG("CallbackFinished," << rs2_stream_to_string(frame->get_stream()->get_stream_type()) << "," << std::dec << frame->get_frame_number()
-                    << ",DispatchedAt," << callback_ended);
+                TRACE_FRAME_EVENT(callback_finished, *frame, callback_ended);
 
                 if (callback_duration > callback_warning_duration)
                 {
@@ -164,8 +164,10 @@ namespace librealsense
     public:
         explicit frame_archive(std::atomic<uint32_t>* in_max_frame_queue_size,
             std::shared_ptr<platform::time_service> ts,
-            std::shared_ptr<metadata_parser_map> parsers)
+            std::shared_ptr<metadata_parser_map> parsers,
+            int published_pool_size = RS2_USER_QUEUE_SIZE)
             : max_frame_queue_size(in_max_frame_queue_size),
+            published_frames(published_pool_size),
             recycle_frames(true), mutex(), _time_service(ts),
             _metadata_parsers(parsers)
         {
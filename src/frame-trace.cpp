@@ -0,0 +1,168 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2021 Intel Corporation. All Rights Reserved.
+
+#include "frame-trace.h"
+#include "types.h"
+
+#include <algorithm>
+#include <fstream>
+
+namespace librealsense
+{
+    const char* get_string(trace_event value)
+    {
+        switch (value)
+        {
+        case trace_event::frame_accepted:    return "FrameAccepted";
+        case trace_event::callback_started:  return "CallbackStarted";
+        case trace_event::callback_finished: return "CallbackFinished";
+        case trace_event::syncer_received:   return "SyncerReceived";
+        case trace_event::syncer_queued:     return "SyncerQueued";
+        case trace_event::syncer_ready:      return "SyncerReady";
+        case trace_event::composite_wrapped: return "CompositeWrapped";
+        default:                             return UNKNOWN_VALUE;
+        }
+    }
+
+    void trace_ring::snapshot(std::vector<trace_record>& out) const
+    {
+        // The slot of record head is the one the producer may be overwriting right now, so the oldest record
+        // that can be read whole is head - capacity + 1
+        auto head = _head.load(std::memory_order_acquire);
+        auto first = head >= capacity ? head - capacity + 1 : 0;
+
+        std::vector<trace_record> records;
+        records.reserve(static_cast<size_t>(head - first));
+        for (auto i = first; i < head; ++i)
+            records.push_back(_records[i % capacity]);
+
+        // Records the producer wrapped over while we were copying are unreliable
+        std::atomic_thread_fence(std::memory_order_acquire);
+        auto new_head = _head.load(std::memory_order_acquire);
+        auto valid_from = new_head >= capacity ? new_head - capacity + 1 : 0;
+        auto skip = valid_from > first ? std::min<uint64_t>(valid_from - first, records.size()) : 0;
+        out.insert(out.end(), records.begin() + static_cast<size_t>(skip), records.end());
+    }
+
+    frame_tracer& frame_tracer::get_instance()
+    {
+        static frame_tracer instance;
+        return instance;
+    }
+
+    trace_ring& frame_tracer::get_thread_ring()
+    {
+        // The ring outlives its thread so records can still be dumped; a new thread adopts
+        // a retired ring before a new one is allocated, keeping the registry bounded
+        struct ring_holder
+        {
+            std::shared_ptr<trace_ring> ring;
+            ~ring_holder() { if (ring) ring->retire(); }
+        };
+        static thread_local ring_holder holder;
+
+        if (!holder.ring)
+        {
+            std::lock_guard<std::mutex> lock(_rings_mutex);
+            for (auto&& r : _rings)
+            {
+                if (r->try_adopt())
+                {
+                    holder.ring = r;
+                    break;
+                }
+            }
+            if (!holder.ring)
+            {
+                holder.ring = std::make_shared<trace_ring>(static_cast<uint32_t>(_rings.size()));
+                _rings.push_back(holder.ring);
+            }
+        }
+        return *holder.ring;
+    }
+
+    std::vector<std::pair<uint32_t, trace_record>> frame_tracer::collect() const
+    {
+        std::vector<std::shared_ptr<trace_ring>> rings;
+        {
+            std::lock_guard<std::mutex> lock(_rings_mutex);
+            rings = _rings;
+        }
+
+        std::vector<std::pair<uint32_t, trace_record>> result;
+        std::vector<trace_record> records;
+        for (auto&& ring : rings)
+        {
+            records.clear();
+            ring->snapshot(records);
+            for (auto&& r : records)
+                result.emplace_back(ring->get_id(), r);
+        }
+
+        std::stable_sort(result.begin(), result.end(),
+            [](const std::pair<uint32_t, trace_record>& a, const std::pair<uint32_t, trace_record>& b)
+        {
+            return a.second.time_ns < b.second.time_ns;
+        });
+        return result;
+    }
+
+    void frame_tracer::dump_text(std::ostream& out) const
+    {
+        out << "TimeNs,Thread,Event,Stream,Index,Counter,TS,Value\n";
+        for (auto&& entry : collect())
+        {
+            auto&& r = entry.second;
+            out << r.time_ns << "," << entry.first << ","
+                << get_string(static_cast<trace_event>(r.event)) << ","
+                << get_string(static_cast<rs2_stream>(r.stream)) << ","
+                << int(r.stream_index) << "," << r.frame_number << ","
+                << std::fixed << r.frame_timestamp << "," << r.value << "\n";
+        }
+    }
+
+    void frame_tracer::dump_chrome_trace(std::ostream& out) const
+    {
+        // Callback start/end become duration events, everything else is a thread-scoped instant
+        out << "{\"traceEvents\":[";
+        bool first = true;
+        for (auto&& entry : collect())
+        {
+            auto&& r = entry.second;
+            auto event = static_cast<trace_event>(r.event);
+            std::string stream = get_string(static_cast<rs2_stream>(r.stream));
+
+            const char* phase = "i";
+            std::string name = std::string(get_string(event)) + " " + stream;
+            if (event == trace_event::callback_started || event == trace_event::callback_finished)
+            {
+                phase = (event == trace_event::callback_started) ? "B" : "E";
+                name = "Callback " + stream;
+            }
+
+            out << (first ? "" : ",") << "\n{\"name\":\"" << name << "\",\"ph\":\"" << phase << "\""
+                << ",\"ts\":" << std::fixed << std::setprecision(3) << r.time_ns / 1000.
+                << ",\"pid\":0,\"tid\":" << entry.first;
+            if (phase[0] == 'i')
+                out << ",\"s\":\"t\"";
+            out << ",\"args\":{\"index\":" << int(r.stream_index)
+                << ",\"counter\":" << r.frame_number
+                << ",\"timestamp\":" << r.frame_timestamp
+                << ",\"value\":" << r.value << "}}";
+            first = false;
+        }
+        out << "\n]}\n";
+    }
+
+    void frame_tracer::dump(const std::string& file_path, bool chrome_trace) const
+    {
+        std::ofstream out(file_path);
+        if (!out)
+            throw invalid_value_exception(to_string() << "Failed to open frame trace file " << file_path);
+
+        if (chrome_trace)
+            dump_chrome_trace(out);
+        else
+            dump_text(out);
+    }
+}
@@ -0,0 +1,132 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2021 Intel Corporation. All Rights Reserved.
+
+#pragma once
+
+#include "../include/librealsense2/h/rs_sensor.h"
+
+#include <atomic>
+#include <array>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <vector>
+
+namespace librealsense
+{
+    // Per-frame events that used to go through LOG_DEBUG on the streaming path
+    enum class trace_event : uint16_t
+    {
+        frame_accepted,     // backend frame handed to the sensor; value = backend timestamp
+        callback_started,   // user callback dispatched; value = dispatch time
+        callback_finished,  // user callback returned; value = dispatch time
+        syncer_received,    // frame entered the syncer
+        syncer_queued,      // frame(set) matched and queued by the syncer
+        syncer_ready,       // frame(set) handed out by the syncer
+        composite_wrapped,  // single frame wrapped with a composite by the identity matcher
+        count
+    };
+
+    const char* get_string(trace_event value);
+
+    // Fixed-size binary record, nothing is formatted on the streaming path
+    struct trace_record
+    {
+        uint64_t time_ns;           // steady clock, taken when the record is written
+        uint64_t frame_number;
+        double frame_timestamp;
+        double value;               // event specific, see trace_event
+        uint16_t event;
+        uint8_t stream;
+        uint8_t stream_index;
+        uint32_t reserved;
+    };
+
+    // Single-producer ring owned by one thread at a time. Readers take a snapshot and
+    // discard whatever the producer may have overwritten while the snapshot was taken.
+    class trace_ring
+    {
+    public:
+        static const size_t capacity = 4096;
+
+        explicit trace_ring(uint32_t id) : _id(id), _head(0), _owned(true) {}
+
+        void push(const trace_record& r)
+        {
+            auto head = _head.load(std::memory_order_relaxed);
+            _records[head % capacity] = r;
+            _head.store(head + 1, std::memory_order_release);
+        }
+
+        void snapshot(std::vector<trace_record>& out) const;
+
+        uint32_t get_id() const { return _id; }
+
+        bool try_adopt()
+        {
+            bool expected = false;
+            return _owned.compare_exchange_strong(expected, true);
+        }
+        void retire() { _owned = false; }
+
+    private:
+        uint32_t _id;
+        std::array<trace_record, capacity> _records;
+        std::atomic<uint64_t> _head;
+        std::atomic<bool> _owned;
+    };
+
+    class frame_tracer
+    {
+    public:
+        static frame_tracer& get_instance();
+
+        void enable(bool state) { _enabled = state; }
+        bool is_enabled() const { return _enabled.load(std::memory_order_relaxed); }
+
+        void record(trace_event event, rs2_stream stream, int stream_index,
+                    unsigned long long frame_number, double frame_timestamp, double value)
+        {
+            trace_record r;
+            r.time_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count();
+            r.frame_number = frame_number;
+            r.frame_timestamp = frame_timestamp;
+            r.value = value;
+            r.event = static_cast<uint16_t>(event);
+            r.stream = static_cast<uint8_t>(stream);
+            r.stream_index = static_cast<uint8_t>(stream_index);
+            r.reserved = 0;
+            get_thread_ring().push(r);
+        }
+
+        // Decode everything currently held in the per-thread rings
+        void dump_text(std::ostream& out) const;
+        void dump_chrome_trace(std::ostream& out) const;
+        void dump(const std::string& file_path, bool chrome_trace) const;
+
+    private:
+        frame_tracer() : _enabled(false) {}
+
+        trace_ring& get_thread_ring();
+        std::vector<std::pair<uint32_t, trace_record>> collect() const;
+
+        std::atomic<bool> _enabled;
+        mutable std::mutex _rings_mutex;    // taken only when a thread registers and when dumping
+        std::vector<std::shared_ptr<trace_ring>> _rings;
+    };
+
+#define TRACE_FRAME_EVENT( EVENT, FRAME, VALUE ) \
+    do \
+    { \
+        auto & tracer = librealsense::frame_tracer::get_instance(); \
+        if( tracer.is_enabled() && ( FRAME ).get_stream() ) \
+            tracer.record( librealsense::trace_event::EVENT, \
+                           ( FRAME ).get_stream()->get_stream_type(), \
+                           ( FRAME ).get_stream()->get_stream_index(), \
+                           ( FRAME ).get_frame_number(), \
+                           ( FRAME ).get_frame_timestamp(), \
+                           ( VALUE ) ); \
+    } while( false )
+}
@@ -124,6 +124,13 @@ namespace librealsense
         return y;
     }
 
+    void CLinearCoefficients::get_mapping(double x, double& offset, double& slope) const
+    {
+        double b;
+        get_a_b(x, slope, b);
+        offset = calc_value(x) - x;
+    }
+
     bool CLinearCoefficients::update_samples_base(double x)
     {
         static const double max_device_time(pow(2, 32) * TIMESTAMP_USEC_TO_MSEC);
@@ -269,6 +276,17 @@ namespace librealsense
             return crnt_hw_time;
     }
 
+    bool time_diff_keeper::get_clock_skew(double& offset_ms, double& drift_ppm) const
+    {
+        std::lock_guard<std::recursive_mutex> lock(_read_mtx);
+        if (!_is_ready)
+            return false;
+        double slope;
+        _coefs.get_mapping(_coefs.get_last_sample_time(), offset_ms, slope);
+        drift_ppm = (slope - 1) * 1e6;
+        return true;
+    }
+
     global_timestamp_reader::global_timestamp_reader(std::unique_ptr<frame_timestamp_reader> device_timestamp_reader,
                                                      std::shared_ptr<time_diff_keeper> timediff,
                                                      std::shared_ptr<global_time_option> enable_option) :
@@ -40,6 +40,9 @@ namespace librealsense
         bool update_samples_base(double x);
         void update_last_sample_time(double x);
         double calc_value(double x) const;
+        // Offset of y from x, and the slope of y against x, at x
+        void get_mapping(double x, double& offset, double& slope) const;
+        double get_last_sample_time() const { return _last_request_time; }
         bool is_full() const;
 
     private:
@@ -66,6 +69,9 @@ namespace librealsense
         void stop();
         ~time_diff_keeper();
         double get_system_hw_time(double crnt_hw_time, bool& is_ready);
+        // Offset of the host clock from the device clock in ms, and the drift of the device clock against the host's in ppm,
+        // at the device time of the latest frame. False until the first sample of the device time was taken
+        bool get_clock_skew(double& offset_ms, double& drift_ppm) const;
 
     private:
         bool update_diff_time();
@@ -112,6 +118,7 @@ namespace librealsense
         global_time_interface();
         ~global_time_interface() { _tf_keeper.reset(); }
         void enable_time_diff_keeper(bool is_enable);
+        bool get_clock_skew(double& offset_ms, double& drift_ppm) const { return _tf_keeper->get_clock_skew(offset_ms, drift_ppm); }
         virtual double get_device_time_ms() = 0; // Returns time in miliseconds.
         virtual void create_snapshot(std::shared_ptr<global_time_interface>& snapshot) const override {}
         virtual void enable_recording(std::function<void(const global_time_interface&)> record_action) override {}
@@ -117,6 +117,10 @@ namespace librealsense
         hid_ep->get_option(RS2_OPTION_GLOBAL_TIME_ENABLED).set(0);
         hid_ep->register_option(RS2_OPTION_GLOBAL_TIME_ENABLED, enable_global_time_option);
 
+        // Sample batching is done by the raw sensor, exposed on the motion module
+        for (auto opt : { RS2_OPTION_MOTION_BATCH_SIZE, RS2_OPTION_MOTION_BATCH_INTERVAL })
+            hid_ep->register_option(opt, raw_hid_ep->get_option_handler(opt));
+
         // register pre-processing
         std::shared_ptr<enable_motion_correction> mm_correct_opt = nullptr;
 
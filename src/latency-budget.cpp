@@ -0,0 +1,104 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2021 Intel Corporation. All Rights Reserved.
+
+#include "latency-budget.h"
+#include "pipeline-stats.h"
+#include "sensor.h"
+
+#include <algorithm>
+
+namespace librealsense
+{
+    latency_budget::latency_budget(double max_age_ms)
+        : _max_age_ms(max_age_ms), _consumer_interval_ms(0), _dequeued(false), _unreported(0)
+    {
+    }
+
+    size_t latency_budget::get_depth() const
+    {
+        auto interval = _consumer_interval_ms.load();
+        if (interval <= 0)
+            return max_depth;
+        auto depth = static_cast<size_t>(_max_age_ms / interval);
+        return std::min(std::max(depth, size_t(1)), size_t(max_depth));
+    }
+
+    bool latency_budget::is_expired(frame_holder const & oldest, std::chrono::steady_clock::time_point arrival, size_t queued)
+    {
+        if (!oldest.frame)
+            return false;
+
+        // The oldest frame would wait for the others ahead of the consumer, so a deeper queue than the consumer can
+        // drain within the budget only delivers frames that are late
+        if (queued > get_depth())
+            return true;
+
+        // Not the system time of the frame, which playback takes from the recording
+        auto waited = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - arrival).count();
+        return waited > _max_age_ms;
+    }
+
+    void latency_budget::on_expired(frame_holder const & f)
+    {
+        if (!f.frame)
+            return;
+        pipeline_stats::get_instance().on_drop(*f.frame, RS2_FRAME_DROP_REASON_LATENCY_BUDGET);
+        report(f);
+    }
+
+    void latency_budget::on_dequeued(frame_holder const &)
+    {
+        // Dequeues are serialized by the queue, so only the interval needs to be visible to other threads
+        auto now = std::chrono::steady_clock::now();
+        if (_dequeued)
+        {
+            auto interval = std::chrono::duration<double, std::milli>(now - _last_dequeue).count();
+            auto smoothed = _consumer_interval_ms.load();
+            _consumer_interval_ms = smoothed > 0 ? smoothed + (interval - smoothed) / 8 : interval;
+        }
+        _last_dequeue = now;
+        _dequeued = true;
+    }
+
+    void latency_budget::report(frame_holder const & f)
+    {
+        uint64_t dropped;
+        {
+            std::lock_guard<std::mutex> lock(_report_mutex);
+            ++_unreported;
+            auto now = std::chrono::steady_clock::now();
+            if (now - _last_report < std::chrono::seconds(1))
+                return;
+            _last_report = now;
+            dropped = _unreported;
+            _unreported = 0;
+        }
+
+        auto sensor = std::dynamic_pointer_cast<sensor_base>(f->get_sensor());
+        if (!sensor || !sensor->get_notifications_processor())
+            return;
+
+        std::string stream = f->get_stream() ? get_string(f->get_stream()->get_stream_type()) : "unknown";
+        notification n(RS2_NOTIFICATION_CATEGORY_FRAMES_DROPPED, RS2_FRAME_DROP_REASON_LATENCY_BUDGET, RS2_LOG_SEVERITY_INFO,
+                       to_string() << dropped << " " << stream << " frames dropped to stay within a latency budget of "
+                                   << _max_age_ms << " ms");
+        sensor->get_notifications_processor()->raise_notification(n);
+    }
+
+    void latency_budget::apply(single_consumer_frame_queue<frame_holder>& queue, double max_age_ms, unsigned capacity)
+    {
+        if (max_age_ms < 0)
+            throw invalid_value_exception(to_string() << "Invalid latency budget " << max_age_ms);
+
+        if (max_age_ms > 0)
+        {
+            queue.set_expiry_policy(std::make_shared<latency_budget>(max_age_ms));
+            queue.set_capacity(max_depth);
+        }
+        else
+        {
+            queue.set_expiry_policy(nullptr);
+            queue.set_capacity(capacity);
+        }
+    }
+}
@@ -0,0 +1,53 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2021 Intel Corporation. All Rights Reserved.
+
+#pragma once
+
+#include "core/streaming.h"
+#include "concurrency.h"
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+
+namespace librealsense
+{
+    // Expiry policy of a frame queue that drops by age rather than by count. A frame expires once it is older
+    // than the budget, measured from when the queue received it, or when more frames are queued than the consumer
+    // can take within the budget at the rate it was seen dequeuing. The queue depth thus follows the consumer.
+    //
+    // Drops are counted in the pipeline statistics and reported, at most once a second, as notifications of the
+    // sensor that produced the frames.
+    class latency_budget : public queue_expiry_policy<frame_holder>
+    {
+    public:
+        // Deepest a queue gets in budget mode, so that frames held by the queue do not exhaust the frame pool
+        static const unsigned max_depth = 16;
+
+        explicit latency_budget(double max_age_ms);
+
+        double get_max_age() const { return _max_age_ms; }
+
+        // Number of frames the consumer can take within the budget, max_depth until its rate is known
+        size_t get_depth() const;
+
+        bool is_expired(frame_holder const & oldest, std::chrono::steady_clock::time_point arrival, size_t queued) override;
+        void on_expired(frame_holder const & f) override;
+        void on_dequeued(frame_holder const & f) override;
+
+        // Set or clear the budget of a queue: 0 returns the queue to dropping by count with the given capacity
+        static void apply(single_consumer_frame_queue<frame_holder>& queue, double max_age_ms, unsigned capacity);
+
+    private:
+        void report(frame_holder const & f);
+
+        double _max_age_ms;
+        std::atomic<double> _consumer_interval_ms;  // smoothed time between dequeues, 0 until known
+        std::chrono::steady_clock::time_point _last_dequeue;
+        bool _dequeued;
+
+        std::mutex _report_mutex;
+        std::chrono::steady_clock::time_point _last_report;
+        uint64_t _unreported;
+    };
+}
@@ -5,6 +5,7 @@
 #include "backend-hid.h"
 #include "backend.h"
 #include "types.h"
+#include "thread-placement.h"
 
 #include <thread>
 #include <chrono>
@@ -150,12 +151,14 @@ namespace librealsense
             device_enabled_file.close();
         }
 
-        hid_custom_sensor::hid_custom_sensor(const std::string& device_path, const std::string& sensor_name)
+        hid_custom_sensor::hid_custom_sensor(const std::string& device_path, const std::string& sensor_name,
+                                             const std::string& unique_id)
             : _fd(0),
               _stop_pipe_fd{},
               _custom_device_path(device_path),
               _custom_sensor_name(sensor_name),
               _custom_device_name(""),
+              _unique_id(unique_id),
               _callback(nullptr),
               _is_capturing(false),
               _hid_thread(nullptr)
@@ -246,6 +249,7 @@ namespace librealsense
             _callback = sensor_callback;
             _is_capturing = true;
             _hid_thread = std::unique_ptr<std::thread>(new std::thread([this, read_device_path_str](){
+                thread_placement_registry::get_instance().apply(RS2_THREAD_ROLE_CAPTURE, "rs-hid-custom", _unique_id);
                 const uint32_t channel_size = 24; // TODO: why 24?
                 std::vector<uint8_t> raw_data(channel_size * hid_buf_len);
 
@@ -444,13 +448,14 @@ namespace librealsense
             }
         }
 
-        iio_hid_sensor::iio_hid_sensor(const std::string& device_path, uint32_t frequency)
+        iio_hid_sensor::iio_hid_sensor(const std::string& device_path, uint32_t frequency, const std::string& unique_id)
             : _stop_pipe_fd{},
               _fd(0),
               _iio_device_number(0),
               _iio_device_path(device_path),
               _sensor_name(""),
               _sampling_frequency_name(""),
+              _unique_id(unique_id),
               _callback(nullptr),
               _is_capturing(false),
               _pm_dispatcher(16)    // queue for async power management commands
@@ -527,6 +532,7 @@ namespace librealsense
             _callback = sensor_callback;
             _is_capturing = true;
             _hid_thread = std::unique_ptr<std::thread>(new std::thread([this](){
+                thread_placement_registry::get_instance().apply(RS2_THREAD_ROLE_CAPTURE, "rs-hid-" + _sensor_name, _unique_id);
                 const uint32_t channel_size = get_channel_size();
                 size_t raw_data_size = channel_size*hid_buf_len;
 
@@ -971,7 +977,8 @@ namespace librealsense
                     if (device_info.id == custom_id)
                     {
                         auto device = std::unique_ptr<hid_custom_sensor>(new hid_custom_sensor(device_info.device_path,
-                                                                                               device_info.id));
+                                                                                               device_info.id,
+                                                                                               device_info.unique_id));
                         _hid_custom_sensors.push_back(std::move(device));
                     }
                     else
@@ -989,7 +996,7 @@ namespace librealsense
                         if (frequency == 0)
                             continue;
 
-                        auto device = std::unique_ptr<iio_hid_sensor>(new iio_hid_sensor(device_info.device_path, frequency));
+                        auto device = std::unique_ptr<iio_hid_sensor>(new iio_hid_sensor(device_info.device_path, frequency, device_info.unique_id));
                         _iio_hid_sensors.push_back(std::move(device));
                     }
                 }
@@ -97,7 +97,7 @@ namespace librealsense
 
         class hid_custom_sensor {
         public:
-            hid_custom_sensor(const std::string& device_path, const std::string& sensor_name);
+            hid_custom_sensor(const std::string& device_path, const std::string& sensor_name, const std::string& unique_id = "");
 
             ~hid_custom_sensor();
 
@@ -124,6 +124,7 @@ namespace librealsense
             std::string _custom_device_path;
             std::string _custom_sensor_name;
             std::string _custom_device_name;
+            std::string _unique_id;     // of the device, selects the placement of the capture thread
             hid_callback _callback;
             std::atomic<bool> _is_capturing;
             std::unique_ptr<std::thread> _hid_thread;
@@ -132,7 +133,7 @@ namespace librealsense
         // declare device sensor with all of its inputs.
         class iio_hid_sensor {
         public:
-            iio_hid_sensor(const std::string& device_path, uint32_t frequency);
+            iio_hid_sensor(const std::string& device_path, uint32_t frequency, const std::string& unique_id = "");
 
             ~iio_hid_sensor();
 
@@ -177,6 +178,7 @@ namespace librealsense
             std::string _iio_device_path;
             std::string _sensor_name;
             std::string _sampling_frequency_name;
+            std::string _unique_id;     // of the device, selects the placement of the capture thread
             std::list<hid_input*> _inputs;
             std::list<hid_input*> _channels;
             hid_callback _callback;
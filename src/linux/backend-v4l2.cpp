@@ -5,6 +5,7 @@
 #include "backend-hid.h"
 #include "backend.h"
 #include "types.h"
+#include "thread-placement.h"
 #include "usb/usb-enumerator.h"
 #include "usb/usb-device.h"
 
@@ -801,7 +802,12 @@ namespace librealsense
                 streamon();
 
                 _is_capturing = true;
-                _thread = std::unique_ptr<std::thread>(new std::thread([this](){ capture_loop(); }));
+                _thread = std::unique_ptr<std::thread>(new std::thread([this](){
+                    // Placed before the first frame, so that the frame buffers are allocated on its memory node
+                    thread_placement_registry::get_instance().apply(RS2_THREAD_ROLE_CAPTURE,
+                        to_string() << "rs-uvc-" << _info.mi, _info.unique_id);
+                    capture_loop();
+                }));
             }
         }
 
@@ -222,40 +222,123 @@ void playback_device::seek_to_time(std::chrono::nanoseconds time)
     {
         LOG_INFO("Seek to time: " << time.count());
         m_reader->seek_to_time(time);
-        m_device_description = m_reader->query_device_description(time);
-        update_extensions(m_device_description);
-        m_prev_timestamp = time; //Updating prev timestamp to make get_position return true indication even when playbakc is paused
-        catch_up();
-        if (m_is_paused)
+        update_after_seek(time);
+    });
+    if ((*m_read_thread)->flush() == false)
+    {
+        LOG_ERROR("Error - timeout waiting for seek_to_time, possible deadlock detected");
+        assert(0); //Detect this immediately in debug
+    }
+}
+
+void playback_device::seek_to_frame(const stream_interface& stream, unsigned long long frame_number)
+{
+    auto stream_id = get_stream_identifier(stream);
+    LOG_INFO("Request to seek to frame " << frame_number << " of " << stream_id.stream_type << " " << stream_id.stream_index);
+    invoke_on_reader([this, stream_id, frame_number]()
+    {
+        auto time = m_reader->seek_to_frame(stream_id, frame_number);
+        LOG_INFO("Seek to time: " << time.count());
+        update_after_seek(time);
+    });
+}
+
+size_t playback_device::get_frame_count(const stream_interface& stream)
+{
+    auto stream_id = get_stream_identifier(stream);
+    auto count = std::make_shared<size_t>(0);
+    invoke_on_reader([this, stream_id, count]()
+    {
+        *count = m_reader->query_frame_count(stream_id);
+    });
+    return *count;
+}
+
+frame_holder playback_device::get_frame_at(const stream_interface& stream, size_t index)
+{
+    auto stream_id = get_stream_identifier(stream);
+    auto data = std::make_shared<std::shared_ptr<serialized_frame>>();
+    invoke_on_reader([this, stream_id, index, data]()
+    {
+        *data = m_reader->read_frame_at(stream_id, index);
+    });
+    if ((*data)->is<serialized_invalid_frame>())
+    {
+        throw io_exception(to_string() << "Frame " << index << " of " << stream_id.stream_type << " " << stream_id.stream_index << " could not be read");
+    }
+    auto frame = std::move((*data)->frame);
+    m_sensors.at(stream_id.sensor_index)->adopt_frame(frame);
+    return frame;
+}
+
+void playback_device::update_after_seek(device_serializer::nanoseconds time)
+{
+    m_device_description = m_reader->query_device_description(time);
+    update_extensions(m_device_description);
+    m_prev_timestamp = time; //Updating prev timestamp to make get_position return true indication even when playbakc is paused
+    catch_up();
+    if (m_is_paused)
+    {
+        //raise_last_frames(time);
+        auto current_frames = m_reader->fetch_last_frames(time);
+        for (auto&& f : current_frames)
         {
-            //raise_last_frames(time);
-            auto current_frames = m_reader->fetch_last_frames(time);
-            for (auto&& f : current_frames)
+            if (auto frame = f->as<serialized_frame>())
             {
-                if (auto frame = f->as<serialized_frame>())
+                if (frame->stream_id.device_index != get_device_index() || frame->stream_id.sensor_index >= m_sensors.size())
                 {
-                    if (frame->stream_id.device_index != get_device_index() || frame->stream_id.sensor_index >= m_sensors.size())
-                    {
-                        std::string error_msg = to_string() << "Unexpected sensor index while playing file (Read index = " << frame->stream_id.sensor_index << ")";
-                        LOG_ERROR(error_msg);
-                    }
-                    //push frame to the sensor (see handle_frame definition for more details)
-                    m_sensors.at(frame->stream_id.sensor_index)->handle_frame(std::move(frame->frame), m_real_time,
-                        []() { return device_serializer::nanoseconds(0); },
-                        []() { return false; },
-                        [this, time]()
-                        {
-                            std::lock_guard<std::mutex> locker(m_last_published_timestamp_mutex);
-                            m_last_published_timestamp = time;
-                        });
+                    std::string error_msg = to_string() << "Unexpected sensor index while playing file (Read index = " << frame->stream_id.sensor_index << ")";
+                    LOG_ERROR(error_msg);
                 }
+                //push frame to the sensor (see handle_frame definition for more details)
+                m_sensors.at(frame->stream_id.sensor_index)->handle_frame(std::move(frame->frame), m_real_time,
+                    []() { return device_serializer::nanoseconds(0); },
+                    []() { return false; },
+                    [this, time]()
+                    {
+                        std::lock_guard<std::mutex> locker(m_last_published_timestamp_mutex);
+                        m_last_published_timestamp = time;
+                    });
             }
         }
+    }
+}
+
+device_serializer::stream_identifier playback_device::get_stream_identifier(const stream_interface& stream) const
+{
+    for (auto&& sensor : m_sensors)
+    {
+        for (auto&& profile : sensor.second->get_stream_profiles())
+        {
+            if (profile->get_unique_id() == stream.get_unique_id())
+                return { get_device_index(), sensor.first, stream.get_stream_type(), static_cast<uint32_t>(stream.get_stream_index()) };
+        }
+    }
+    throw invalid_value_exception(to_string() << "Stream " << stream.get_stream_type() << " " << stream.get_stream_index() << " is not a stream of " << get_file_name());
+}
+
+void playback_device::invoke_on_reader(std::function<void()> op)
+{
+    //The reader is only used from the reading thread; what op throws is handed back to the caller
+    auto error = std::make_shared<std::exception_ptr>();
+    (*m_read_thread)->invoke([op, error](dispatcher::cancellable_timer t)
+    {
+        try
+        {
+            op();
+        }
+        catch (...)
+        {
+            *error = std::current_exception();
+        }
     });
     if ((*m_read_thread)->flush() == false)
     {
-        LOG_ERROR("Error - timeout waiting for seek_to_time, possible deadlock detected");
-        assert(0); //Detect this immediately in debug
+        throw io_exception("Timeout waiting for the playback reading thread");
+    }
+    if (*error)
+    {
+        std::rethrow_exception(*error);
     }
 }
 
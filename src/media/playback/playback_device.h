@@ -33,6 +33,9 @@ namespace librealsense
 
         void set_frame_rate(double rate);
         void seek_to_time(std::chrono::nanoseconds time);
+        void seek_to_frame(const stream_interface& stream, unsigned long long frame_number);
+        size_t get_frame_count(const stream_interface& stream);
+        frame_holder get_frame_at(const stream_interface& stream, size_t index);
         rs2_playback_status get_current_status() const;
         uint64_t get_duration() const;
         void pause();
@@ -73,6 +76,9 @@ namespace librealsense
         void register_extrinsics(const device_serializer::device_snapshot& device_description);
         void update_extensions(const device_serializer::device_snapshot& device_description);
         bool prefetch_done();
+        void update_after_seek(device_serializer::nanoseconds time);
+        device_serializer::stream_identifier get_stream_identifier(const stream_interface& stream) const;
+        void invoke_on_reader(std::function<void()> op);
 
     private:
         lazy<std::shared_ptr<dispatcher>> m_read_thread;
@@ -90,6 +90,16 @@ namespace librealsense
         const unsigned int _default_queue_size;
 
     public:
+        //Makes a frame read from the file one of the sensor's, with the stream profile its frames are published with
+        void adopt_frame(frame_holder& frame)
+        {
+            frame->get_owner()->set_sensor(shared_from_this());
+            auto type = frame->get_stream()->get_stream_type();
+            auto index = static_cast<uint32_t>(frame->get_stream()->get_stream_index());
+            frame->set_stream(m_streams[std::make_pair(type, index)]);
+            frame->set_sensor(shared_from_this());
+        }
+
         //handle frame use 3 lambda functions that determines if and when a frame should be published.
         //calc_sleep - calculates the duration that the sensor should wait before publishing the frame,
         // the start point for this calculation is the last playback resume.
@@ -105,11 +115,7 @@ namespace librealsense
             }
             if (m_is_started)
             {
-                frame->get_owner()->set_sensor(shared_from_this());
-                auto type = frame->get_stream()->get_stream_type();
-                auto index = static_cast<uint32_t>(frame->get_stream()->get_stream_index());
-                frame->set_stream(m_streams[std::make_pair(type, index)]);
-                frame->set_sensor(shared_from_this());
+                adopt_frame(frame);
                 auto stream_id = frame.frame->get_stream()->get_unique_id();
                 //TODO: Ziv, remove usage of shared_ptr when frame_holder is cpoyable
                 auto pf = std::make_shared<frame_holder>(std::move(frame));
@@ -12,6 +12,7 @@
 #include "std_msgs/UInt32.h"
 #include "std_msgs/Float32.h"
 #include "std_msgs/Float32MultiArray.h"
+#include "std_msgs/UInt64MultiArray.h"
 #include "std_msgs/String.h"
 #include "realsense_msgs/StreamInfo.h"
 #include "realsense_msgs/ImuIntrinsic.h"
@@ -347,6 +348,12 @@ namespace librealsense
             return create_from({ stream_full_prefix(stream_id), stream_to_ros_type(stream_id.stream_type), "data" });
         }
 
+        // Frame numbers of the frames of an image or imu stream, in the order of their data topic
+        static std::string frame_index_topic(const device_serializer::stream_identifier& stream_id)
+        {
+            return create_from({ stream_full_prefix(stream_id), stream_to_ros_type(stream_id.stream_type), "frame_index" });
+        }
+
         static std::string frame_metadata_topic(const device_serializer::stream_identifier& stream_id)
         {
             return create_from({ stream_full_prefix(stream_id), stream_to_ros_type(stream_id.stream_type), "metadata" });
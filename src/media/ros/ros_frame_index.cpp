@@ -0,0 +1,258 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2021 Intel Corporation. All Rights Reserved.
+
+#include <fstream>
+#include <numeric>
+#include <sys/stat.h>
+#include "ros_frame_index.h"
+#include "rosbag/view.h"
+#include "std_msgs/UInt64MultiArray.h"
+
+namespace librealsense
+{
+    namespace
+    {
+        const char cache_magic[4] = { 'R', 'S', 'F', 'I' };
+        const uint32_t cache_version = 2;
+
+        template <typename T>
+        bool read_value(std::istream& in, T& value)
+        {
+            return bool(in.read(reinterpret_cast<char*>(&value), sizeof(value)));
+        }
+
+        template <typename T>
+        void write_value(std::ostream& out, const T& value)
+        {
+            out.write(reinterpret_cast<const char*>(&value), sizeof(value));
+        }
+
+        // Seconds since the epoch, or 0 if unknown
+        uint64_t modification_time(const std::string& file_path)
+        {
+            struct stat info;
+            if (stat(file_path.c_str(), &info) != 0)
+                return 0;
+            return static_cast<uint64_t>(info.st_mtime);
+        }
+
+        // FNV-1a of where the frames of a stream are, as the index records of the bag have them
+        uint64_t hash_positions(const std::vector<rosbag::IndexEntry>& positions)
+        {
+            uint64_t hash = 14695981039346656037ull;
+            auto add = [&hash](uint64_t value) {
+                for (int i = 0; i < 8; ++i, value >>= 8)
+                    hash = (hash ^ (value & 0xff)) * 1099511628211ull;
+            };
+            for (auto&& position : positions)
+            {
+                add(position.time.sec);
+                add(position.time.nsec);
+                add(position.chunk_pos);
+                add(position.offset);
+            }
+            return hash;
+        }
+    }
+
+    ros_frame_index::ros_frame_index(const rosbag::Bag& file, const std::string& file_path)
+        : _file(file), _file_path(file_path)
+    {
+        rosbag::View frames_view(file, FrameQuery());
+        for (auto&& connection : frames_view.getConnections())
+        {
+            if (connection->datatype != rs2rosinternal::message_traits::DataType<sensor_msgs::Image>::value()
+                && connection->datatype != rs2rosinternal::message_traits::DataType<sensor_msgs::Imu>::value())
+                continue;
+
+            // Walking a View only reads the index of the bag, the messages stay where they are
+            auto& positions = _streams[connection->topic].positions;
+            rosbag::View view(file, rosbag::TopicQuery(connection->topic));
+            positions.reserve(view.size());
+            for (auto&& msg : view)
+                positions.push_back(msg.getIndexEntry());
+        }
+    }
+
+    const std::vector<rosbag::IndexEntry>* ros_frame_index::get_frames(const std::string& topic) const
+    {
+        auto it = _streams.find(topic);
+        return it == _streams.end() ? nullptr : &it->second.positions;
+    }
+
+    bool ros_frame_index::find_last_frame(const std::string& topic, const rs2rosinternal::Time& time, size_t& position) const
+    {
+        auto frames = get_frames(topic);
+        if (!frames)
+            return false;
+
+        auto it = std::upper_bound(frames->begin(), frames->end(), time, rosbag::IndexEntryCompare());
+        if (it == frames->begin())
+            return false;
+        position = std::distance(frames->begin(), it) - 1;
+        return true;
+    }
+
+    bool ros_frame_index::find_frame(const std::string& topic, unsigned long long frame_number, size_t& position)
+    {
+        auto it = _streams.find(topic);
+        if (it == _streams.end())
+            return false;
+
+        read_frame_numbers();
+        auto& stream = it->second;
+        auto found = std::lower_bound(stream.by_frame_number.begin(), stream.by_frame_number.end(), frame_number,
+            [&stream](uint32_t i, unsigned long long n) { return stream.frame_numbers[i] < n; });
+        if (found == stream.by_frame_number.end() || stream.frame_numbers[*found] != frame_number)
+            return false;
+        position = *found;
+        return true;
+    }
+
+    void ros_frame_index::read_frame_numbers()
+    {
+        if (_frame_numbers_read)
+            return;
+
+        std::set<std::string> unrecorded;
+        for (auto&& stream : _streams)
+        {
+            if (!read_recorded_frame_numbers(stream.first, stream.second))
+                unrecorded.insert(stream.first);
+        }
+
+        if (!unrecorded.empty())
+        {
+            auto cached = read_cache();
+            bool read_frames = false;
+            for (auto&& topic : unrecorded)
+            {
+                if (cached.count(topic))
+                    continue;
+                if (!read_frames)
+                    LOG_INFO("Indexing the frames of " << _file_path << ", recorded without an index");
+                read_frame_numbers_of_frames(topic, _streams.at(topic));
+                read_frames = true;
+            }
+            if (read_frames)
+                write_cache(unrecorded);
+        }
+
+        for (auto&& stream : _streams)
+        {
+            auto& s = stream.second;
+            s.by_frame_number.resize(s.positions.size());
+            std::iota(s.by_frame_number.begin(), s.by_frame_number.end(), 0);
+            std::stable_sort(s.by_frame_number.begin(), s.by_frame_number.end(),
+                [&s](uint32_t a, uint32_t b) { return s.frame_numbers[a] < s.frame_numbers[b]; });
+        }
+        _frame_numbers_read = true;
+    }
+
+    bool ros_frame_index::read_recorded_frame_numbers(const std::string& topic, stream_frames& stream) const
+    {
+        auto index_topic = ros_topic::frame_index_topic(ros_topic::get_stream_identifier(topic));
+        rosbag::View view(_file, rosbag::TopicQuery(index_topic));
+        if (view.size() != 1)
+            return false;
+
+        auto msg = view.begin()->instantiate<std_msgs::UInt64MultiArray>();
+        if (!msg || msg->data.size() != stream.positions.size())
+        {
+            LOG_WARNING("Ignoring the frame index of " << topic << ", which does not match its frames");
+            return false;
+        }
+        stream.frame_numbers.assign(msg->data.begin(), msg->data.end());
+        return true;
+    }
+
+    void ros_frame_index::read_frame_numbers_of_frames(const std::string& topic, stream_frames& stream) const
+    {
+        stream.frame_numbers.clear();
+        stream.frame_numbers.reserve(stream.positions.size());
+        for (auto&& position : stream.positions)
+        {
+            // Same frame number as the reader gives the frame
+            auto msg = _file.getMessage(topic, position);
+            if (auto image = msg.instantiate<sensor_msgs::Image>())
+                stream.frame_numbers.push_back(image->header.seq);
+            else if (auto imu = msg.instantiate<sensor_msgs::Imu>())
+                stream.frame_numbers.push_back(imu->header.seq);
+            else
+                throw io_exception(to_string() << "Invalid file format, unexpected " << msg.getDataType() << " message (Topic: " << topic << ")");
+        }
+    }
+
+    std::set<std::string> ros_frame_index::read_cache()
+    {
+        // Frame numbers of a stream are only taken if the file has the same size and modification time, and the
+        // frames of the stream are where they were
+        std::set<std::string> cached;
+        std::ifstream in(cache_file_name(_file_path), std::ios::binary);
+        if (!in)
+            return cached;
+
+        char magic[sizeof(cache_magic)];
+        uint32_t version = 0, streams = 0;
+        uint64_t file_size = 0, file_time = 0;
+        if (!in.read(magic, sizeof(magic)) || !std::equal(magic, magic + sizeof(magic), cache_magic)
+            || !read_value(in, version) || version != cache_version
+            || !read_value(in, file_size) || file_size != _file.getSize()
+            || !read_value(in, file_time) || file_time != modification_time(_file_path)
+            || !read_value(in, streams))
+        {
+            LOG_WARNING("Ignoring " << cache_file_name(_file_path) << ", which is not an index of " << _file_path);
+            return cached;
+        }
+
+        for (uint32_t i = 0; i < streams; ++i)
+        {
+            uint32_t topic_size = 0;
+            uint64_t positions_hash = 0, count = 0;
+            if (!read_value(in, topic_size))
+                break;
+            std::string topic(topic_size, '\0');
+            if (!in.read(&topic[0], topic_size) || !read_value(in, positions_hash) || !read_value(in, count))
+                break;
+
+            std::vector<unsigned long long> frame_numbers(count);
+            if (count && !in.read(reinterpret_cast<char*>(frame_numbers.data()), count * sizeof(unsigned long long)))
+                break;
+
+            auto it = _streams.find(topic);
+            if (it != _streams.end() && it->second.positions.size() == count && hash_positions(it->second.positions) == positions_hash)
+            {
+                it->second.frame_numbers = std::move(frame_numbers);
+                cached.insert(topic);
+            }
+        }
+        return cached;
+    }
+
+    void ros_frame_index::write_cache(const std::set<std::string>& topics) const
+    {
+        // Files are often read from places they cannot be written to, where every playback indexes them again
+        auto cache_file = cache_file_name(_file_path);
+        std::ofstream out(cache_file, std::ios::binary | std::ios::trunc);
+        if (out)
+        {
+            out.write(cache_magic, sizeof(cache_magic));
+            write_value(out, cache_version);
+            write_value(out, static_cast<uint64_t>(_file.getSize()));
+            write_value(out, modification_time(_file_path));
+            write_value(out, static_cast<uint32_t>(topics.size()));
+            for (auto&& topic : topics)
+            {
+                auto& stream = _streams.at(topic);
+                auto& frame_numbers = stream.frame_numbers;
+                write_value(out, static_cast<uint32_t>(topic.size()));
+                out.write(topic.data(), topic.size());
+                write_value(out, hash_positions(stream.positions));
+                write_value(out, static_cast<uint64_t>(frame_numbers.size()));
+                out.write(reinterpret_cast<const char*>(frame_numbers.data()), frame_numbers.size() * sizeof(unsigned long long));
+            }
+        }
+        if (!out)
+            LOG_WARNING("Failed to write the frame index of " << _file_path << " to " << cache_file);
+    }
+}
@@ -0,0 +1,51 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2021 Intel Corporation. All Rights Reserved.
+
+#pragma once
+#include "rosbag/bag.h"
+#include "ros_file_format.h"
+
+namespace librealsense
+{
+    // Index of the frames of the image and imu streams of a file, for the reader to reach any frame without iterating
+    // a rosbag::View from the start of the file. Where the frames are is taken from the index the bag keeps of every
+    // topic. Their frame numbers are only read when first asked for: from the index the writer leaves in the file
+    // (see ros_topic::frame_index_topic), or else, for files recorded before it did, from the frames themselves, once,
+    // after which they are cached next to the file (see cache_file_name), until the file changes.
+    class ros_frame_index
+    {
+    public:
+        // file is expected to stay open, at file_path, for as long as the index is used
+        ros_frame_index(const rosbag::Bag& file, const std::string& file_path);
+
+        // Positions of the frames of a frame data topic in the order of their time, or nullptr if it is not indexed
+        const std::vector<rosbag::IndexEntry>* get_frames(const std::string& topic) const;
+
+        // Finds, in O(log n), the position in get_frames(topic) of the last frame at or before time
+        bool find_last_frame(const std::string& topic, const rs2rosinternal::Time& time, size_t& position) const;
+
+        // Finds, in O(log n), the position in get_frames(topic) of the first frame numbered frame_number
+        bool find_frame(const std::string& topic, unsigned long long frame_number, size_t& position);
+
+        static std::string cache_file_name(const std::string& file_path) { return file_path + ".idx"; }
+
+    private:
+        struct stream_frames
+        {
+            std::vector<rosbag::IndexEntry> positions;
+            std::vector<unsigned long long> frame_numbers;  // of positions, once read
+            std::vector<uint32_t> by_frame_number;          // indices of positions, sorted by their frame numbers
+        };
+
+        void read_frame_numbers();
+        bool read_recorded_frame_numbers(const std::string& topic, stream_frames& stream) const;
+        void read_frame_numbers_of_frames(const std::string& topic, stream_frames& stream) const;
+        std::set<std::string> read_cache();
+        void write_cache(const std::set<std::string>& topics) const;
+
+        const rosbag::Bag& _file;
+        std::string _file_path;
+        std::map<std::string, stream_frames> _streams;
+        bool _frame_numbers_read = false;
+    };
+}
@@ -99,8 +99,11 @@ namespace librealsense
             throw invalid_value_exception(to_string() << "Requested time is out of playback length. (Requested = " << seek_time.count() << ", Duration = " << m_total_duration.count() << ")");
         }
         auto seek_time_as_secs = std::chrono::duration_cast<std::chrono::duration<double>>(seek_time);
-        auto seek_time_as_rostime = rs2rosinternal::Time(seek_time_as_secs.count());
+        seek_samples_view(rs2rosinternal::Time(seek_time_as_secs.count()));
+    }
 
+    void ros_reader::seek_samples_view(const rs2rosinternal::Time& seek_time_as_rostime)
+    {
         m_samples_view.reset(new rosbag::View(m_file, FalseQuery()));
 
         //Using cached topics here and not querying them (before reseting) since a previous call to seek
@@ -116,8 +119,20 @@ namespace librealsense
     std::vector<std::shared_ptr<serialized_data>> ros_reader::fetch_last_frames(const nanoseconds& seek_time)
     {
         std::vector<std::shared_ptr<serialized_data>> result;
-        rosbag::View view(m_file, FalseQuery());
         auto as_rostime = to_rostime(seek_time);
+        if (m_version != legacy_file_format::file_version())
+        {
+            auto& index = get_frame_index();
+            for (auto&& topic : m_enabled_streams_topics)
+            {
+                size_t position;
+                if (index.find_last_frame(topic, as_rostime, position))
+                    result.push_back(create_frame(m_file.getMessage(topic, index.get_frames(topic)->at(position))));
+            }
+            return result;
+        }
+
+        rosbag::View view(m_file, FalseQuery());
         auto start_time = to_rostime(get_static_file_info_timestamp());
 
         for (auto topic : m_enabled_streams_topics)
@@ -143,6 +158,53 @@ namespace librealsense
         }
         return result;
     }
+
+    nanoseconds ros_reader::seek_to_frame(const stream_identifier& stream_id, unsigned long long frame_number)
+    {
+        auto topic = ros_topic::frame_data_topic(stream_id);
+        size_t position;
+        if (!get_frame_index().find_frame(topic, frame_number, position))
+        {
+            throw invalid_value_exception(to_string() << "Frame " << frame_number << " of " << topic << " is not in the file");
+        }
+        auto frame_time = get_frame_index().get_frames(topic)->at(position).time;
+        seek_samples_view(frame_time);
+        return to_nanoseconds(frame_time);
+    }
+
+    size_t ros_reader::query_frame_count(const stream_identifier& stream_id)
+    {
+        auto frames = get_frame_index().get_frames(ros_topic::frame_data_topic(stream_id));
+        if (!frames)
+        {
+            throw invalid_value_exception(to_string() << "Stream " << stream_id.stream_type << " " << stream_id.stream_index << " has no indexed frames in the file");
+        }
+        return frames->size();
+    }
+
+    std::shared_ptr<serialized_frame> ros_reader::read_frame_at(const stream_identifier& stream_id, size_t index)
+    {
+        auto topic = ros_topic::frame_data_topic(stream_id);
+        auto count = query_frame_count(stream_id);
+        if (index >= count)
+        {
+            throw invalid_value_exception(to_string() << "Frame index " << index << " is out of the " << count << " frames of " << topic);
+        }
+        return create_frame(m_file.getMessage(topic, get_frame_index().get_frames(topic)->at(index)));
+    }
+
+    ros_frame_index& ros_reader::get_frame_index()
+    {
+        if (m_version == legacy_file_format::file_version())
+        {
+            throw not_implemented_exception("Random access to frames is not supported for files of version 1");
+        }
+        // The index only refers to the file, so it is kept through reset()
+        if (!m_frame_index)
+            m_frame_index.reset(new ros_frame_index(m_file, m_file_path));
+        return *m_frame_index;
+    }
+
     nanoseconds ros_reader::query_duration() const
     {
         return m_total_duration;
@@ -5,6 +5,7 @@
 #include <core/serialization.h>
 #include "rosbag/view.h"
 #include "ros_file_format.h"
+#include "ros_frame_index.h"
 
 namespace librealsense
 {
@@ -23,8 +24,13 @@ namespace librealsense
         virtual void enable_stream(const std::vector<device_serializer::stream_identifier>& stream_ids) override;
         virtual void disable_stream(const std::vector<device_serializer::stream_identifier>& stream_ids) override;
         const std::string& get_file_name() const override;
+        nanoseconds seek_to_frame(const stream_identifier& stream_id, unsigned long long frame_number) override;
+        size_t query_frame_count(const stream_identifier& stream_id) override;
+        std::shared_ptr<serialized_frame> read_frame_at(const stream_identifier& stream_id, size_t index) override;
 
     private:
+        void seek_samples_view(const rs2rosinternal::Time& time);
+        ros_frame_index& get_frame_index();
 
         template <typename ROS_TYPE>
         static typename ROS_TYPE::ConstPtr instantiate_msg(const rosbag::MessageInstance& msg)
@@ -143,5 +149,6 @@ namespace librealsense
         std::vector<std::string>                m_enabled_streams_topics;
         std::shared_ptr<context>                m_context;
         uint32_t                                m_version;
+        std::unique_ptr<ros_frame_index>        m_frame_index;
     };
 }
@@ -11,6 +11,7 @@
 #include "proc/depth-decompress.h"
 #include "proc/hdr-merge.h"
 #include "proc/sequence-id-filter.h"
+#include "proc/motion-batch.h"
 #include "ros_writer.h"
 #include "l500/l500-motion.h"
 #include "l500/l500-depth.h"
@@ -30,6 +31,18 @@ namespace librealsense
         write_file_version();
     }
 
+    ros_writer::~ros_writer()
+    {
+        try
+        {
+            write_frame_indices();
+        }
+        catch (const std::exception& e)
+        {
+            LOG_WARNING("Failed to write the frame index of " << m_file_path << ": " << e.what());
+        }
+    }
+
     void ros_writer::write_device_description(const librealsense::device_snapshot& device_description)
     {
         for (auto&& device_extension_snapshot : device_description.get_device_extensions_snapshots().get_snapshots())
@@ -192,35 +205,52 @@ namespace librealsense
         image.header.frame_id = TODO_CORRECT_ME;
         auto image_topic = ros_topic::frame_data_topic(stream_id);
         write_message(image_topic, timestamp, image);
+        m_frame_numbers[stream_id].emplace_back(to_rostime(timestamp), image.header.seq);
         write_additional_frame_messages(stream_id, timestamp, frame);
     }
 
     void ros_writer::write_motion_frame(const stream_identifier& stream_id, const nanoseconds& timestamp, frame_holder&& frame)
     {
-        sensor_msgs::Imu imu_msg;
         if (!frame)
         {
             throw io_exception("Null frame passed to write_motion_frame");
         }
 
-        imu_msg.header.seq = static_cast<uint32_t>(frame.frame->get_frame_number());
-        std::chrono::duration<double, std::milli> timestamp_ms(frame.frame->get_frame_timestamp());
+        auto frame_number = frame.frame->get_frame_number();
+        if (is_motion_batch(frame.frame))
+        {
+            // Batches are stored as their individual samples, so that the file reads the same as a
+            // non-batched recording; all of them share the batch metadata
+            motion_batch batch(frame.frame->get_frame_data());
+            auto count = batch.count();
+            for (uint32_t i = 0; i < count; ++i)
+                write_imu_message(stream_id, timestamp, frame_number - (count - 1 - i), batch.timestamps()[i],
+                    { batch.x()[i], batch.y()[i], batch.z()[i] });
+        }
+        else
+        {
+            auto data_ptr = reinterpret_cast<const float*>(frame.frame->get_frame_data());
+            write_imu_message(stream_id, timestamp, frame_number, frame.frame->get_frame_timestamp(), { data_ptr[0], data_ptr[1], data_ptr[2] });
+        }
+        write_additional_frame_messages(stream_id, timestamp, frame);
+    }
+
+    void ros_writer::write_imu_message(const stream_identifier& stream_id, const nanoseconds& timestamp,
+        unsigned long long frame_number, double sample_timestamp, const float3& sample)
+    {
+        sensor_msgs::Imu imu_msg;
+        imu_msg.header.seq = static_cast<uint32_t>(frame_number);
+        std::chrono::duration<double, std::milli> timestamp_ms(sample_timestamp);
         imu_msg.header.stamp = rs2rosinternal::Time(std::chrono::duration<double>(timestamp_ms).count());
         std::string TODO_CORRECT_ME = "0";
         imu_msg.header.frame_id = TODO_CORRECT_ME;
-        auto data_ptr = reinterpret_cast<const float*>(frame.frame->get_frame_data());
         if (stream_id.stream_type == RS2_STREAM_ACCEL)
         {
-            imu_msg.linear_acceleration.x = data_ptr[0];
-            imu_msg.linear_acceleration.y = data_ptr[1];
-            imu_msg.linear_acceleration.z = data_ptr[2];
+            imu_msg.linear_acceleration = to_vector3(sample);
         }
-
         else if (stream_id.stream_type == RS2_STREAM_GYRO)
         {
-            imu_msg.angular_velocity.x = data_ptr[0];
-            imu_msg.angular_velocity.y = data_ptr[1];
-            imu_msg.angular_velocity.z = data_ptr[2];
+            imu_msg.angular_velocity = to_vector3(sample);
         }
         else
         {
@@ -229,7 +259,27 @@ namespace librealsense
 
         auto topic = ros_topic::frame_data_topic(stream_id);
         write_message(topic, timestamp, imu_msg);
-        write_additional_frame_messages(stream_id, timestamp, frame);
+        m_frame_numbers[stream_id].emplace_back(to_rostime(timestamp), imu_msg.header.seq);
+    }
+
+    void ros_writer::write_frame_indices()
+    {
+        for (auto&& stream : m_frame_numbers)
+        {
+            // In the order the bag keeps the messages of a topic: by time, then as written
+            auto& frames = stream.second;
+            std::stable_sort(frames.begin(), frames.end(), [](const std::pair<rs2rosinternal::Time, uint32_t>& a, const std::pair<rs2rosinternal::Time, uint32_t>& b)
+            {
+                return a.first < b.first;
+            });
+
+            std_msgs::UInt64MultiArray frame_index;
+            frame_index.data.reserve(frames.size());
+            for (auto&& frame : frames)
+                frame_index.data.push_back(frame.second);
+            write_message(ros_topic::frame_index_topic(stream.first), get_static_file_info_timestamp(), frame_index);
+        }
+        m_frame_numbers.clear();
     }
 
     inline geometry_msgs::Vector3 ros_writer::to_vector3(const float3& f)
@@ -13,6 +13,7 @@ namespace librealsense
     {
     public:
         explicit ros_writer(const std::string& file, bool compress_while_record);
+        ~ros_writer();
         void write_device_description(const librealsense::device_snapshot& device_description) override;
         void write_frame(const stream_identifier& stream_id, const nanoseconds& timestamp, frame_holder&& frame) override;
         void write_snapshot(uint32_t device_index, const nanoseconds& timestamp, rs2_extension type, const std::shared_ptr<extension_snapshot>& snapshot) override;
@@ -21,6 +22,7 @@ namespace librealsense
 
     private:
         void write_file_version();
+        void write_frame_indices();
         void write_frame_metadata(const stream_identifier& stream_id, const nanoseconds& timestamp, frame_interface* frame);
         void write_extrinsics(const stream_identifier& stream_id, frame_interface* frame);
         realsense_msgs::Notification to_notification_msg(const notification& n);
@@ -28,6 +30,8 @@ namespace librealsense
         void write_additional_frame_messages(const stream_identifier& stream_id, const nanoseconds& timestamp, frame_interface* frame);
         void write_video_frame(const stream_identifier& stream_id, const nanoseconds& timestamp, frame_holder&& frame);
         void write_motion_frame(const stream_identifier& stream_id, const nanoseconds& timestamp, frame_holder&& frame);
+        void write_imu_message(const stream_identifier& stream_id, const nanoseconds& timestamp,
+            unsigned long long frame_number, double sample_timestamp, const float3& sample);
         inline geometry_msgs::Vector3 to_vector3(const float3& f);
         inline geometry_msgs::Quaternion to_quaternion(const float4& f);
         void write_pose_frame(const stream_identifier& stream_id, const nanoseconds& timestamp, frame_holder&& frame);
@@ -77,5 +81,6 @@ namespace librealsense
         std::string m_file_path;
         rosbag::Bag m_bag;
         std::map<uint32_t, std::set<rs2_option>> m_written_options_descriptions;
+        std::map<stream_identifier, std::vector<std::pair<rs2rosinternal::Time, uint32_t>>> m_frame_numbers; // of the image and imu messages written, for write_frame_indices
     };
 }
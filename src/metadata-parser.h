@@ -23,12 +23,27 @@ namespace librealsense
         RS2_FRAME_METADATA_COUNT
     };
 
-    /**\brief Base class that establishes the interface for retrieving metadata attributes*/
+    /**\brief Base class that establishes the interface for retrieving metadata attributes.
+     *  Parsers report an attribute the frame does not carry by returning false from try_get, which is what the
+     *  frame uses to decode its attributes; get throws instead, for callers that require the attribute*/
     class md_attribute_parser_base
     {
     public:
-        virtual rs2_metadata_type get(const frame& frm) const = 0;
-        virtual bool supports(const frame& frm) const = 0;
+        virtual bool try_get(const frame& frm, rs2_metadata_type& value) const = 0;
+
+        virtual rs2_metadata_type get(const frame& frm) const
+        {
+            rs2_metadata_type value;
+            if (!try_get(frm, value))
+                throw invalid_value_exception("metadata not available");
+            return value;
+        }
+
+        virtual bool supports(const frame& frm) const
+        {
+            rs2_metadata_type value;
+            return try_get(frm, value);
+        }
 
         virtual ~md_attribute_parser_base() = default;
     };
@@ -38,20 +53,6 @@ namespace librealsense
     {
     public:
         md_constant_parser(rs2_frame_metadata_value type) : _type(type) {}
-        rs2_metadata_type get(const frame& frm) const override
-        {
-            rs2_metadata_type v;
-            if (try_get(frm, v) == false)
-            {
-                throw invalid_value_exception("Frame does not support this type of metadata");
-            }
-            return v;
-        }
-        bool supports(const frame& frm) const override
-        {
-            rs2_metadata_type v;
-            return try_get(frm, v);
-        }
 
         static std::shared_ptr<metadata_parser_map> create_metadata_parser_map()
         {
@@ -63,8 +64,8 @@ namespace librealsense
             }
             return md_parser_map;
         }
-    private:
-        bool try_get(const frame& frm, rs2_metadata_type& result) const
+
+        bool try_get(const frame& frm, rs2_metadata_type& result) const override
         {
             const uint8_t* pos = frm.additional_data.metadata_blob.data();
             while (pos <= frm.additional_data.metadata_blob.data() + frm.additional_data.metadata_blob.size())
@@ -81,6 +82,8 @@ namespace librealsense
             }
             return false;
         }
+
+    private:
         rs2_frame_metadata_value _type;
     };
 
@@ -92,9 +95,10 @@ namespace librealsense
     class md_time_of_arrival_parser : public md_attribute_parser_base
     {
     public:
-        rs2_metadata_type get(const frame& frm) const override
+        bool try_get(const frame& frm, rs2_metadata_type& value) const override
         {
-            return (rs2_metadata_type)frm.get_frame_system_time();
+            value = (rs2_metadata_type)frm.get_frame_system_time();
+            return true;
         }
 
         bool supports(const frame& frm) const override
@@ -114,16 +118,16 @@ namespace librealsense
         md_attribute_parser(Attribute S::* attribute_name, Flag flag, unsigned long long offset, attrib_modifyer mod) :
             _md_attribute(attribute_name), _md_flag(flag), _offset(offset), _modifyer(mod) {};
 
-        rs2_metadata_type get(const librealsense::frame & frm) const override
+        bool try_get(const librealsense::frame & frm, rs2_metadata_type& value) const override
         {
             auto s = reinterpret_cast<const S*>(((const uint8_t*)frm.additional_data.metadata_blob.data()) + _offset);
 
             if (!is_attribute_valid(s))
-                throw invalid_value_exception("metadata not available");
+                return false;
 
-            auto attrib = static_cast<rs2_metadata_type>((*s).*_md_attribute);
-            if (_modifyer) attrib = _modifyer(attrib);
-            return attrib;
+            value = static_cast<rs2_metadata_type>((*s).*_md_attribute);
+            if (_modifyer) value = _modifyer(value);
+            return true;
         }
 
         // Verifies that the parameter is both supported and available
@@ -188,14 +192,14 @@ namespace librealsense
         md_uvc_header_parser(Attribute St::* attribute_name, attrib_modifyer mod) :
             _md_attribute(attribute_name), _modifyer(mod){};
 
-        rs2_metadata_type get(const librealsense::frame & frm) const override
+        bool try_get(const librealsense::frame & frm, rs2_metadata_type& value) const override
         {
             if (!supports(frm))
-                throw invalid_value_exception("UVC header is not available");
+                return false;
 
-            auto attrib =  static_cast<rs2_metadata_type>((*reinterpret_cast<const St*>((const uint8_t*)frm.additional_data.metadata_blob.data())).*_md_attribute);
-            if (_modifyer) attrib = _modifyer(attrib);
-            return attrib;
+            value = static_cast<rs2_metadata_type>((*reinterpret_cast<const St*>((const uint8_t*)frm.additional_data.metadata_blob.data())).*_md_attribute);
+            if (_modifyer) value = _modifyer(value);
+            return true;
         }
 
         bool supports(const librealsense::frame & frm) const override
@@ -225,15 +229,15 @@ namespace librealsense
         md_hid_header_parser(Attribute St::* attribute_name, attrib_modifyer mod) :
             _md_attribute(attribute_name), _modifyer(mod) {};
 
-        rs2_metadata_type get(const librealsense::frame & frm) const override
+        bool try_get(const librealsense::frame & frm, rs2_metadata_type& value) const override
         {
             if (!supports(frm))
-                throw invalid_value_exception("HID header is not available");
+                return false;
 
-            auto attrib = static_cast<rs2_metadata_type>((*reinterpret_cast<const St*>((const uint8_t*)frm.additional_data.metadata_blob.data())).*_md_attribute);
-            attrib &= 0x00000000ffffffff;
-            if (_modifyer) attrib = _modifyer(attrib);
-            return attrib;
+            value = static_cast<rs2_metadata_type>((*reinterpret_cast<const St*>((const uint8_t*)frm.additional_data.metadata_blob.data())).*_md_attribute);
+            value &= 0x00000000ffffffff;
+            if (_modifyer) value = _modifyer(value);
+            return true;
         }
 
         bool supports(const librealsense::frame & frm) const override
@@ -265,9 +269,10 @@ namespace librealsense
         md_additional_parser(Attribute St::* attribute_name) :
             _md_attribute(attribute_name) {};
 
-        rs2_metadata_type get(const librealsense::frame & frm) const override
+        bool try_get(const librealsense::frame & frm, rs2_metadata_type& value) const override
         {
-            return static_cast<rs2_metadata_type>(frm.additional_data.*_md_attribute);
+            value = static_cast<rs2_metadata_type>(frm.additional_data.*_md_attribute);
+            return true;
         }
 
         bool supports(const librealsense::frame & frm) const override
@@ -303,9 +308,13 @@ namespace librealsense
 
         // The sensor's timestamp is defined as the middle of exposure time. Sensor_ts= Frame_ts - (Actual_Exposure/2)
         // For RS4xx the metadata payload holds only the (Actual_Exposure/2) offset, and the actual value needs to be calculated
-        rs2_metadata_type get(const librealsense::frame & frm) const override
+        bool try_get(const librealsense::frame & frm, rs2_metadata_type& value) const override
         {
-            return _frame_ts_parser->get(frm) - _sensor_ts_parser->get(frm);
+            rs2_metadata_type frame_ts, sensor_ts;
+            if (!_frame_ts_parser->try_get(frm, frame_ts) || !_sensor_ts_parser->try_get(frm, sensor_ts))
+                return false;
+            value = frame_ts - sensor_ts;
+            return true;
         };
 
         bool supports(const librealsense::frame & frm) const override
@@ -342,9 +351,10 @@ namespace librealsense
             : _fps_values{ 6, 15, 30, 60, 90 } , _exposure_modifyer(exposure_mod), _discrete(discrete)
         {}
 
-        rs2_metadata_type get(const librealsense::frame & frm) const override
+        bool try_get(const librealsense::frame & frm, rs2_metadata_type& value) const override
         {
-            if (frm.supports_frame_metadata(RS2_FRAME_METADATA_ACTUAL_EXPOSURE))
+            rs2_metadata_type exp;
+            if (frm.find_frame_metadata(RS2_FRAME_METADATA_ACTUAL_EXPOSURE, exp))
             {
                 if (frm.get_stream()->get_format() == RS2_FORMAT_Y16 &&
                     frm.get_stream()->get_stream_type() == RS2_STREAM_INFRARED) //calibration mode
@@ -357,8 +367,6 @@ namespace librealsense
 
                 }
 
-                auto exp = frm.get_frame_metadata(RS2_FRAME_METADATA_ACTUAL_EXPOSURE);
-
                 auto exp_in_micro = _exposure_modifyer(exp);
                 if (exp_in_micro > 0)
                 {
@@ -382,12 +390,13 @@ namespace librealsense
                             }
                         }
                     }
-                    return std::min((int)fps, (int)frm.get_stream()->get_framerate());
+                    value = std::min((int)fps, (int)frm.get_stream()->get_framerate());
+                    return true;
                 }
             }
 
-            return (rs2_metadata_type)_fps_calculator.get_fps(frm);
-
+            value = (rs2_metadata_type)_fps_calculator.get_fps(frm);
+            return true;
         }
 
         bool supports(const librealsense::frame & frm) const override
@@ -418,18 +427,17 @@ namespace librealsense
         md_sr300_attribute_parser(Attribute S::* attribute_name, unsigned long long offset, attrib_modifyer mod) :
             _md_attribute(attribute_name), _offset(offset), _modifyer(mod){};
 
-        rs2_metadata_type get(const librealsense::frame & frm) const override
+        bool try_get(const librealsense::frame & frm, rs2_metadata_type& value) const override
         {
             if (!supports(frm))
-                throw invalid_value_exception("Metadata is not available");
+                return false;
 
             auto s = reinterpret_cast<const S*>((frm.additional_data.metadata_blob.data()) + _offset);
 
-            auto param = static_cast<rs2_metadata_type>((*s).*_md_attribute);
+            value = static_cast<rs2_metadata_type>((*s).*_md_attribute);
             if (_modifyer)
-                param = _modifyer(param);
-
-            return param;
+                value = _modifyer(value);
+            return true;
         }
 
         bool supports(const librealsense::frame & frm) const override
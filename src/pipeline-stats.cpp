@@ -0,0 +1,209 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2021 Intel Corporation. All Rights Reserved.
+
+#include "pipeline-stats.h"
+#include "environment.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace librealsense
+{
+    int latency_histogram::bucket_of(uint64_t usec)
+    {
+        if (usec < sub_buckets)
+            return static_cast<int>(usec);
+
+        int magnitude = sub_bucket_bits;
+        while (magnitude < 63 && (usec >> (magnitude + 1)))
+            ++magnitude;
+        if (magnitude > max_magnitude)
+            return bucket_count - 1;
+
+        auto group = magnitude - sub_bucket_bits + 1;
+        auto sub = static_cast<int>((usec >> (magnitude - sub_bucket_bits)) & (sub_buckets - 1));
+        return group * sub_buckets + sub;
+    }
+
+    uint64_t latency_histogram::bucket_lower_bound(int bucket)
+    {
+        auto group = bucket / sub_buckets;
+        auto sub = bucket % sub_buckets;
+        if (group == 0)
+            return sub;
+        return uint64_t(sub_buckets + sub) << (group - 1);
+    }
+
+    uint64_t latency_histogram::bucket_width(int bucket)
+    {
+        auto group = bucket / sub_buckets;
+        return group == 0 ? 1 : uint64_t(1) << (group - 1);
+    }
+
+    void latency_histogram::record(uint64_t usec)
+    {
+        _buckets[bucket_of(usec)].fetch_add(1, std::memory_order_relaxed);
+        _count.fetch_add(1, std::memory_order_relaxed);
+        _sum.fetch_add(usec, std::memory_order_relaxed);
+
+        auto prev = _min.load(std::memory_order_relaxed);
+        while (usec < prev && !_min.compare_exchange_weak(prev, usec, std::memory_order_relaxed));
+        prev = _max.load(std::memory_order_relaxed);
+        while (usec > prev && !_max.compare_exchange_weak(prev, usec, std::memory_order_relaxed));
+    }
+
+    bool latency_histogram::get_stats(rs2_latency_stats& stats) const
+    {
+        stats = {};
+        // Buckets are read one by one while frames keep arriving, so use their sum as the count
+        std::array<uint64_t, bucket_count> buckets;
+        uint64_t count = 0;
+        for (int i = 0; i < bucket_count; ++i)
+        {
+            buckets[i] = _buckets[i].load(std::memory_order_relaxed);
+            count += buckets[i];
+        }
+        if (!count)
+            return false;
+
+        auto min = _min.load(std::memory_order_relaxed);
+        auto max = _max.load(std::memory_order_relaxed);
+        auto to_ms = [](double usec) { return static_cast<float>(usec / 1000.); };
+
+        auto percentile = [&](double p) {
+            auto target = static_cast<uint64_t>(std::ceil(p * count));
+            uint64_t seen = 0;
+            for (int i = 0; i < bucket_count; ++i)
+            {
+                seen += buckets[i];
+                if (seen >= target)
+                {
+                    auto mid = bucket_lower_bound(i) + bucket_width(i) / 2;
+                    return to_ms(double(std::min(std::max(mid, min), max)));
+                }
+            }
+            return to_ms(double(max));
+        };
+
+        stats.count = count;
+        stats.min = to_ms(double(min));
+        stats.max = to_ms(double(max));
+        stats.mean = to_ms(double(_sum.load(std::memory_order_relaxed)) / _count.load(std::memory_order_relaxed));
+        stats.p50 = percentile(0.5);
+        stats.p90 = percentile(0.9);
+        stats.p99 = percentile(0.99);
+        return true;
+    }
+
+    void latency_histogram::reset()
+    {
+        for (auto&& b : _buckets)
+            b = 0;
+        _count = 0;
+        _sum = 0;
+        _min = std::numeric_limits<uint64_t>::max();
+        _max = 0;
+    }
+
+    void stream_pipeline_stats::reset()
+    {
+        for (auto&& s : stages)
+            s.reset();
+        for (auto&& d : drops)
+            d = 0;
+    }
+
+    pipeline_stats& pipeline_stats::get_instance()
+    {
+        static pipeline_stats instance;
+        return instance;
+    }
+
+    pipeline_stats::pipeline_stats()
+        : _enabled(false)
+    {
+        for (auto&& s : _slots)
+            s = nullptr;
+    }
+
+    pipeline_stats::~pipeline_stats()
+    {
+        for (auto&& s : _slots)
+            delete s.load();
+    }
+
+    stream_pipeline_stats* pipeline_stats::get_slot(rs2_stream stream, int index, bool create)
+    {
+        if (stream < 0 || stream >= RS2_STREAM_COUNT || index < 0 || index >= max_stream_index)
+            return nullptr;
+
+        auto&& slot = _slots[stream * max_stream_index + index];
+        auto stats = slot.load(std::memory_order_acquire);
+        if (stats || !create)
+            return stats;
+
+        // Several threads may race on the first frame of a stream, only one allocation survives
+        auto created = new stream_pipeline_stats();
+        if (slot.compare_exchange_strong(stats, created, std::memory_order_acq_rel))
+            return created;
+        delete created;
+        return stats;
+    }
+
+    const stream_pipeline_stats* pipeline_stats::get_slot(rs2_stream stream, int index) const
+    {
+        if (stream < 0 || stream >= RS2_STREAM_COUNT || index < 0 || index >= max_stream_index)
+            return nullptr;
+        return _slots[stream * max_stream_index + index].load(std::memory_order_acquire);
+    }
+
+    void pipeline_stats::record_latency(rs2_stream stream, int index, rs2_latency_stage stage, double latency_ms)
+    {
+        if (auto slot = get_slot(stream, index, true))
+            slot->stages[stage].record(latency_ms > 0 ? static_cast<uint64_t>(latency_ms * 1000.) : 0);
+    }
+
+    void pipeline_stats::record_drop(rs2_stream stream, int index, rs2_frame_drop_reason reason)
+    {
+        if (auto slot = get_slot(stream, index, true))
+            slot->drops[reason].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void pipeline_stats::record_frame_latency(const frame_interface& f, rs2_latency_stage stage)
+    {
+        auto stream = f.get_stream();
+        if (!stream)
+            return;
+
+        record_frame_latency(stream->get_stream_type(), stream->get_stream_index(), f.get_frame_system_time(), stage);
+    }
+
+    void pipeline_stats::record_frame_latency(rs2_stream stream, int index, double frame_system_time, rs2_latency_stage stage)
+    {
+        auto now = environment::get_instance().get_time_service()->get_time();
+        record_latency(stream, index, stage, now - frame_system_time);
+    }
+
+    bool pipeline_stats::get_stats(rs2_stream stream, int index, rs2_latency_stage stage, rs2_latency_stats& stats) const
+    {
+        stats = {};
+        auto slot = get_slot(stream, index);
+        return slot ? slot->stages[stage].get_stats(stats) : false;
+    }
+
+    uint64_t pipeline_stats::get_drops(rs2_stream stream, int index, rs2_frame_drop_reason reason) const
+    {
+        auto slot = get_slot(stream, index);
+        return slot ? slot->drops[reason].load(std::memory_order_relaxed) : 0;
+    }
+
+    void pipeline_stats::reset()
+    {
+        for (auto&& s : _slots)
+        {
+            if (auto stats = s.load(std::memory_order_acquire))
+                stats->reset();
+        }
+    }
+}
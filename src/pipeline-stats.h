@@ -0,0 +1,103 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2021 Intel Corporation. All Rights Reserved.
+
+#pragma once
+
+#include "../include/librealsense2/h/rs_sensor.h"
+#include "core/streaming.h"
+
+#include <array>
+#include <atomic>
+
+namespace librealsense
+{
+    // Log-linear (HDR-style) histogram of latencies in microseconds: every power of two is split
+    // into 16 linear sub-buckets, so any recorded value is known within 1/16 of its magnitude.
+    // Recording is a handful of relaxed atomic operations and never allocates.
+    class latency_histogram
+    {
+    public:
+        static const int sub_bucket_bits = 4;
+        static const int sub_buckets = 1 << sub_bucket_bits;
+        static const int max_magnitude = 31;    // ~35 minutes
+        static const int bucket_count = sub_buckets * (max_magnitude - sub_bucket_bits + 2);
+
+        latency_histogram() { reset(); }
+
+        void record(uint64_t usec);
+        bool get_stats(rs2_latency_stats& stats) const;
+        void reset();
+
+        static int bucket_of(uint64_t usec);
+        static uint64_t bucket_lower_bound(int bucket);
+        static uint64_t bucket_width(int bucket);
+
+    private:
+        std::array<std::atomic<uint64_t>, bucket_count> _buckets;
+        std::atomic<uint64_t> _count;
+        std::atomic<uint64_t> _sum;
+        std::atomic<uint64_t> _min;
+        std::atomic<uint64_t> _max;
+    };
+
+    struct stream_pipeline_stats
+    {
+        std::array<latency_histogram, RS2_LATENCY_STAGE_COUNT> stages;
+        std::array<std::atomic<uint64_t>, RS2_FRAME_DROP_REASON_COUNT> drops;
+
+        stream_pipeline_stats() { reset(); }
+        void reset();
+    };
+
+    // Process-wide latency and drop statistics of the frame pipeline, per stream type and index
+    class pipeline_stats
+    {
+    public:
+        static const int max_stream_index = 8;
+
+        static pipeline_stats& get_instance();
+        ~pipeline_stats();
+
+        void enable(bool state) { _enabled = state; }
+        bool is_enabled() const { return _enabled.load(std::memory_order_relaxed); }
+
+        void record_latency(rs2_stream stream, int index, rs2_latency_stage stage, double latency_ms);
+        void record_drop(rs2_stream stream, int index, rs2_frame_drop_reason reason);
+
+        // Latency of the frame relative to its arrival on the host
+        void on_frame(const frame_interface& f, rs2_latency_stage stage)
+        {
+            if (is_enabled())
+                record_frame_latency(f, stage);
+        }
+
+        // Same, for a frame the caller may no longer hold, from what was taken of it while it did
+        void on_frame(rs2_stream stream, int index, double frame_system_time, rs2_latency_stage stage)
+        {
+            if (is_enabled())
+                record_frame_latency(stream, index, frame_system_time, stage);
+        }
+
+        void on_drop(const frame_interface& f, rs2_frame_drop_reason reason)
+        {
+            if (is_enabled() && f.get_stream())
+                record_drop(f.get_stream()->get_stream_type(), f.get_stream()->get_stream_index(), reason);
+        }
+
+        bool get_stats(rs2_stream stream, int index, rs2_latency_stage stage, rs2_latency_stats& stats) const;
+        uint64_t get_drops(rs2_stream stream, int index, rs2_frame_drop_reason reason) const;
+        void reset();
+
+    private:
+        pipeline_stats();
+
+        void record_frame_latency(const frame_interface& f, rs2_latency_stage stage);
+        void record_frame_latency(rs2_stream stream, int index, double frame_system_time, rs2_latency_stage stage);
+        stream_pipeline_stats* get_slot(rs2_stream stream, int index, bool create);
+        const stream_pipeline_stats* get_slot(rs2_stream stream, int index) const;
+
+        std::atomic<bool> _enabled;
+        // Slots are allocated on first use and live as long as the process
+        std::array<std::atomic<stream_pipeline_stats*>, RS2_STREAM_COUNT * max_stream_index> _slots;
+    };
+}
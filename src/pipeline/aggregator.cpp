@@ -4,6 +4,7 @@
 #include <algorithm>
 #include "stream.h"
 #include "aggregator.h"
+#include "latency-budget.h"
 
 namespace librealsense
 {
@@ -112,6 +113,12 @@ namespace librealsense
             return _queue->try_dequeue(item);
         }
 
+        void aggregator::set_latency_budget(double max_age_ms)
+        {
+            // Without a budget only the latest set is kept
+            latency_budget::apply(*_queue, max_age_ms, 1);
+        }
+
         void aggregator::start()
         {
             _accepting = true;
@@ -24,6 +24,7 @@ namespace librealsense
             aggregator(const std::vector<int>& streams_to_aggregate, const std::vector<int>& streams_to_sync);
             bool dequeue(frame_holder* item, unsigned int timeout_ms);
             bool try_dequeue(frame_holder* item);
+            void set_latency_budget(double max_age_ms);
             void start();
             void stop();
         };
@@ -15,7 +15,8 @@ namespace librealsense
             _ctx(ctx),
             _dispatcher(10),
             _hub(ctx, RS2_PRODUCT_LINE_ANY_INTEL),
-            _synced_streams({ RS2_STREAM_COLOR, RS2_STREAM_DEPTH, RS2_STREAM_INFRARED, RS2_STREAM_FISHEYE })
+            _synced_streams({ RS2_STREAM_COLOR, RS2_STREAM_DEPTH, RS2_STREAM_INFRARED, RS2_STREAM_FISHEYE }),
+            _latency_budget_ms(0)
         {}
 
         pipeline::~pipeline()
@@ -187,6 +188,7 @@ namespace librealsense
 
             _syncer = std::unique_ptr<syncer_process_unit>(new syncer_process_unit());
             _aggregator = std::unique_ptr<aggregator>(new aggregator(_streams_to_aggregate_ids, _streams_to_sync_ids));
+            _aggregator->set_latency_budget(_latency_budget_ms);
 
             if (_streams_callback)
                 _aggregator->set_output_callback(_streams_callback);
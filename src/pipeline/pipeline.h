@@ -30,6 +30,9 @@ namespace librealsense
             bool poll_for_frames(frame_holder* frame);
             bool try_wait_for_frames(frame_holder* frame, unsigned int timeout_ms);
 
+            // Age limit of the frames sets waiting for wait_for_frames, 0 for none. Applies from the next start.
+            void set_latency_budget(double max_age_ms) { _latency_budget_ms = max_age_ms; }
+
             //Non top level API
             std::shared_ptr<device_interface> wait_for_device(const std::chrono::milliseconds& timeout = std::chrono::hours::max(),
                 const std::string& serial = "");
@@ -59,6 +62,7 @@ namespace librealsense
 
             frame_callback_ptr _streams_callback;
             std::vector<rs2_stream> _synced_streams;
+            std::atomic<double> _latency_budget_ms;
         };
     }
 }
@@ -0,0 +1,118 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2021 Intel Corporation. All Rights Reserved.
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// The binary PLY files of points::export_to_ply(). Header only and standard C++ only, so that the tools that make
+// such files in memory (rs-convert) write the same bytes
+
+namespace librealsense
+{
+    namespace ply
+    {
+        // Points closer to the origin than this have no depth
+        static const float min_distance = 1e-6f;
+        // Neighbours farther apart in depth than this are not joined by a face
+        static const float face_threshold = 0.05f;
+
+        // RGB of the texture pixel nearest to u, v in [0,1] range, clamped to the texture
+        inline void sample_texture(const uint8_t* data, int width, int height, int bytes_per_pixel, int stride,
+            float u, float v, uint8_t rgb[3])
+        {
+            int x = std::min(std::max(int(u * width + .5f), 0), width - 1);
+            int y = std::min(std::max(int(v * height + .5f), 0), height - 1);
+            auto pixel = data + x * bytes_per_pixel + y * stride;
+            std::copy(pixel, pixel + 3, rgb);
+        }
+
+        // Writes the x, y, z vertices of the points of a width x height depth frame: the points with depth,
+        // flipped to y up and z towards the viewer, and two faces for every 2x2 pixels whose depths are close.
+        // color, if set, gives the RGB of the point of a pixel
+        inline void write(std::ostream& out, const float* vertices, size_t width, size_t height,
+            const std::function<void(size_t pixel, uint8_t rgb[3])>& color)
+        {
+            // Little endian, as the header says
+            auto append = [](std::string& data, const void* value, size_t size) {
+                data.append(static_cast<const char*>(value), size);
+            };
+
+            auto pixels = width * height;
+            // Index of the vertex of every pixel among the ones written, -1 when it has none
+            std::vector<int> reduced_index(pixels, -1);
+            std::string body;
+            body.reserve(pixels * (3 * sizeof(float) + (color ? 3 : 0)));
+            int vertex_count = 0;
+            for (size_t i = 0; i < pixels; ++i)
+            {
+                auto v = vertices + 3 * i;
+                if (std::fabs(v[0]) < min_distance && std::fabs(v[1]) < min_distance && std::fabs(v[2]) < min_distance)
+                    continue;
+
+                reduced_index[i] = vertex_count++;
+                const float xyz[] = { v[0], -1 * v[1], -1 * v[2] };
+                append(body, xyz, sizeof(xyz));
+                if (color)
+                {
+                    uint8_t rgb[3];
+                    color(i, rgb);
+                    append(body, rgb, sizeof(rgb));
+                }
+            }
+
+            std::string faces;
+            int face_count = 0;
+            auto add_face = [&](int a, int b, int c) {
+                const uint8_t three = 3;
+                const int indices[] = { a, b, c };
+                append(faces, &three, sizeof(three));
+                append(faces, indices, sizeof(indices));
+                ++face_count;
+            };
+            auto z = [vertices](size_t i) { return vertices[3 * i + 2]; };
+            for (size_t x = 0; x + 1 < width; ++x)
+            {
+                for (size_t y = 0; y + 1 < height; ++y)
+                {
+                    auto a = y * width + x, b = y * width + x + 1, c = (y + 1) * width + x, d = (y + 1) * width + x + 1;
+                    if (z(a) && z(b) && z(c) && z(d)
+                        && std::fabs(z(a) - z(b)) < face_threshold && std::fabs(z(a) - z(c)) < face_threshold
+                        && std::fabs(z(b) - z(d)) < face_threshold && std::fabs(z(c) - z(d)) < face_threshold)
+                    {
+                        if (reduced_index[a] < 0 || reduced_index[b] < 0 || reduced_index[c] < 0 || reduced_index[d] < 0)
+                            continue;
+
+                        add_face(reduced_index[a], reduced_index[d], reduced_index[b]);
+                        add_face(reduced_index[d], reduced_index[a], reduced_index[c]);
+                    }
+                }
+            }
+
+            out << "ply\n";
+            out << "format binary_little_endian 1.0\n";
+            out << "comment pointcloud saved from Realsense Viewer\n";
+            out << "element vertex " << vertex_count << "\n";
+            out << "property float" << sizeof(float) * 8 << " x\n";
+            out << "property float" << sizeof(float) * 8 << " y\n";
+            out << "property float" << sizeof(float) * 8 << " z\n";
+            if (color)
+            {
+                out << "property uchar red\n";
+                out << "property uchar green\n";
+                out << "property uchar blue\n";
+            }
+            out << "element face " << face_count << "\n";
+            out << "property list uchar int vertex_indices\n";
+            out << "end_header\n";
+            out.write(body.data(), body.size());
+            out.write(faces.data(), faces.size());
+        }
+    }
+}
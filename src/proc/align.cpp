@@ -10,6 +10,7 @@
 #include "environment.h"
 #include "align.h"
 #include "stream.h"
+#include "thread-pool.h"
 
 namespace librealsense
 {
@@ -17,48 +18,57 @@ namespace librealsense
 
     template<class GET_DEPTH, class TRANSFER_PIXEL>
     void align_images(const rs2_intrinsics& depth_intrin, const rs2_extrinsics& depth_to_other,
-        const rs2_intrinsics& other_intrin, GET_DEPTH get_depth, TRANSFER_PIXEL transfer_pixel)
+        const rs2_intrinsics& other_intrin, GET_DEPTH get_depth, TRANSFER_PIXEL transfer_pixel, bool parallel)
     {
         // Iterate over the pixels of the depth image
-#pragma omp parallel for schedule(dynamic)
-        for (int depth_y = 0; depth_y < depth_intrin.height; ++depth_y)
+        auto align_rows = [&](int y_begin, int y_end)
         {
-            int depth_pixel_index = depth_y * depth_intrin.width;
-            for (int depth_x = 0; depth_x < depth_intrin.width; ++depth_x, ++depth_pixel_index)
+            for (int depth_y = y_begin; depth_y < y_end; ++depth_y)
             {
-                // Skip over depth pixels with the value of zero, we have no depth data so we will not write anything into our aligned images
-                if (float depth = get_depth(depth_pixel_index))
+                int depth_pixel_index = depth_y * depth_intrin.width;
+                for (int depth_x = 0; depth_x < depth_intrin.width; ++depth_x, ++depth_pixel_index)
                 {
-                    // Map the top-left corner of the depth pixel onto the other image
-                    float depth_pixel[2] = { depth_x - 0.5f, depth_y - 0.5f }, depth_point[3], other_point[3], other_pixel[2];
-                    rs2_deproject_pixel_to_point(depth_point, &depth_intrin, depth_pixel, depth);
-                    rs2_transform_point_to_point(other_point, &depth_to_other, depth_point);
-                    rs2_project_point_to_pixel(other_pixel, &other_intrin, other_point);
-                    const int other_x0 = static_cast<int>(other_pixel[0] + 0.5f);
-                    const int other_y0 = static_cast<int>(other_pixel[1] + 0.5f);
-
-                    // Map the bottom-right corner of the depth pixel onto the other image
-                    depth_pixel[0] = depth_x + 0.5f; depth_pixel[1] = depth_y + 0.5f;
-                    rs2_deproject_pixel_to_point(depth_point, &depth_intrin, depth_pixel, depth);
-                    rs2_transform_point_to_point(other_point, &depth_to_other, depth_point);
-                    rs2_project_point_to_pixel(other_pixel, &other_intrin, other_point);
-                    const int other_x1 = static_cast<int>(other_pixel[0] + 0.5f);
-                    const int other_y1 = static_cast<int>(other_pixel[1] + 0.5f);
-
-                    if (other_x0 < 0 || other_y0 < 0 || other_x1 >= other_intrin.width || other_y1 >= other_intrin.height)
-                        continue;
-
-                    // Transfer between the depth pixels and the pixels inside the rectangle on the other image
-                    for (int y = other_y0; y <= other_y1; ++y)
+                    // Skip over depth pixels with the value of zero, we have no depth data so we will not write anything into our aligned images
+                    if (float depth = get_depth(depth_pixel_index))
                     {
-                        for (int x = other_x0; x <= other_x1; ++x)
+                        // Map the top-left corner of the depth pixel onto the other image
+                        float depth_pixel[2] = { depth_x - 0.5f, depth_y - 0.5f }, depth_point[3], other_point[3], other_pixel[2];
+                        rs2_deproject_pixel_to_point(depth_point, &depth_intrin, depth_pixel, depth);
+                        rs2_transform_point_to_point(other_point, &depth_to_other, depth_point);
+                        rs2_project_point_to_pixel(other_pixel, &other_intrin, other_point);
+                        const int other_x0 = static_cast<int>(other_pixel[0] + 0.5f);
+                        const int other_y0 = static_cast<int>(other_pixel[1] + 0.5f);
+
+                        // Map the bottom-right corner of the depth pixel onto the other image
+                        depth_pixel[0] = depth_x + 0.5f; depth_pixel[1] = depth_y + 0.5f;
+                        rs2_deproject_pixel_to_point(depth_point, &depth_intrin, depth_pixel, depth);
+                        rs2_transform_point_to_point(other_point, &depth_to_other, depth_point);
+                        rs2_project_point_to_pixel(other_pixel, &other_intrin, other_point);
+                        const int other_x1 = static_cast<int>(other_pixel[0] + 0.5f);
+                        const int other_y1 = static_cast<int>(other_pixel[1] + 0.5f);
+
+                        if (other_x0 < 0 || other_y0 < 0 || other_x1 >= other_intrin.width || other_y1 >= other_intrin.height)
+                            continue;
+
+                        // Transfer between the depth pixels and the pixels inside the rectangle on the other image
+                        for (int y = other_y0; y <= other_y1; ++y)
                         {
-                            transfer_pixel(depth_pixel_index, y * other_intrin.width + x);
+                            for (int x = other_x0; x <= other_x1; ++x)
+                            {
+                                transfer_pixel(depth_pixel_index, y * other_intrin.width + x);
+                            }
                         }
                     }
                 }
             }
-        }
+        };
+
+        // Several depth pixels may map to the same pixel of the other image, so only transfers that
+        // write to the depth pixel itself can run in parallel
+        if (parallel)
+            parallel_for_rows("Align", depth_intrin.height, align_rows);
+        else
+            align_rows(0, depth_intrin.height);
     }
 
     align::align(rs2_stream to_stream) : align(to_stream, "Align")
@@ -87,7 +97,7 @@ namespace librealsense
             out_z[other_pixel_index] = out_z[other_pixel_index] ?
                 std::min((int)out_z[other_pixel_index], (int)z_pixels[z_pixel_index]) :
                 z_pixels[z_pixel_index];
-        });
+        }, false);
     }
 
     template<int N, class GET_DEPTH>
@@ -96,7 +106,7 @@ namespace librealsense
         auto in_other = (const bytes<N> *)(other_pixels);
         auto out_other = (bytes<N> *)(other_aligned_to_depth);
         align_images(depth_intrin, depth_to_other, other_intrin, get_depth,
-            [out_other, in_other](int depth_pixel_index, int other_pixel_index) { out_other[depth_pixel_index] = in_other[other_pixel_index]; });
+            [out_other, in_other](int depth_pixel_index, int other_pixel_index) { out_other[depth_pixel_index] = in_other[other_pixel_index]; }, true);
     }
 
     template<class GET_DEPTH>
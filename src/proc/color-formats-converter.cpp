@@ -6,6 +6,7 @@
 #include "option.h"
 #include "image-avx.h"
 #include "image.h"
+#include "cpu-dispatch.h"
 
 #define STB_IMAGE_STATIC
 #define STB_IMAGE_IMPLEMENTATION
@@ -18,32 +19,6 @@
 #include <tmmintrin.h> // For SSSE3 intrinsics
 #endif
 
-#if defined (ANDROID) || (defined (__linux__) && !defined (__x86_64__))
-
-bool has_avx() { return false; }
-
-#else
-
-#ifdef _WIN32
-#include <intrin.h>
-#define cpuid(info, x)    __cpuidex(info, x, 0)
-#else
-#include <cpuid.h>
-void cpuid(int info[4], int info_type) {
-    __cpuid_count(info_type, 0, info[0], info[1], info[2], info[3]);
-}
-#endif
-
-bool has_avx()
-{
-    int info[4];
-    cpuid(info, 0);
-    cpuid(info, 0x80000000);
-    return (info[2] & ((int)1 << 28)) != 0;
-}
-
-#endif
-
 namespace librealsense 
 {
     /////////////////////////////
@@ -60,7 +35,7 @@ namespace librealsense
         return;
 #endif
 #if defined __SSSE3__ && ! defined ANDROID
-        static bool do_avx = has_avx();
+        static bool do_avx = cpu_supports(simd_level::avx2);
 #ifdef __AVX2__
 
         if (do_avx)
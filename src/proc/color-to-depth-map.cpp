@@ -0,0 +1,181 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2021 Intel Corporation. All Rights Reserved.
+
+#include "../include/librealsense2/rsutil.h"
+
+#include "color-to-depth-map.h"
+#include "thread-pool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+
+namespace librealsense
+{
+    // Maps are kept for this many pairs of profiles, the least recently used being dropped beyond
+    static const size_t max_cached_maps = 8;
+
+    void color_to_depth_map::build_rays(const rs2_intrinsics& depth_intrin, const rs2_extrinsics& depth_to_color)
+    {
+        if (!memcmp(&_rays_intrin, &depth_intrin, sizeof(depth_intrin)) && !memcmp(&_rays_extrin, &depth_to_color, sizeof(depth_to_color)))
+            return;
+
+        // The rays through the depth pixels, in the orientation of the color camera. Deprojection is iterative
+        // with distortion, so this is done once per pair of profiles and frames only scale the rays by depth
+        _rays.resize(3 * size_t(depth_intrin.width) * depth_intrin.height);
+        for (int y = 0, i = 0; y < depth_intrin.height; ++y)
+        {
+            for (int x = 0; x < depth_intrin.width; ++x, ++i)
+            {
+                float pixel[2] = { float(x), float(y) }, point[3];
+                rs2_deproject_pixel_to_point(point, &depth_intrin, pixel, 1.f);
+                auto& r = depth_to_color.rotation;
+                for (int k = 0; k < 3; ++k)
+                    _rays[3 * i + k] = r[k] * point[0] + r[3 + k] * point[1] + r[6 + k] * point[2];
+            }
+        }
+        _rays_intrin = depth_intrin;
+        _rays_extrin = depth_to_color;
+    }
+
+    void color_to_depth_map::build(const uint16_t* depth, float depth_scale, float depth_min, float depth_max,
+                                   const rs2_intrinsics& depth_intrin, const rs2_intrinsics& color_intrin,
+                                   const rs2_extrinsics& depth_to_color)
+    {
+        build_rays(depth_intrin, depth_to_color);
+        _depth_width = depth_intrin.width;
+        _color_width = color_intrin.width;
+        _color_height = color_intrin.height;
+        _footprints.resize(size_t(depth_intrin.width) * depth_intrin.height);
+        _depth_index.assign(size_t(_color_width) * _color_height, -1);
+        _z.assign(size_t(_color_width) * _color_height, 0);
+
+        bool pinhole = color_intrin.model == RS2_DISTORTION_NONE;
+        if (!pinhole)
+        {
+            pinhole = true;
+            for (auto c : color_intrin.coeffs)
+                pinhole = pinhole && c == 0;
+            pinhole = pinhole && color_intrin.model != RS2_DISTORTION_FTHETA && color_intrin.model != RS2_DISTORTION_KANNALA_BRANDT4;
+        }
+        auto& t = depth_to_color.translation;
+        const float scale_x = 0.5f * color_intrin.fx / depth_intrin.fx;
+        const float scale_y = 0.5f * color_intrin.fy / depth_intrin.fy;
+
+        // The color pixels covered by every depth pixel: its center is projected onto the color image, and its
+        // footprint there scaled by the ratio of focal lengths and of the depths from either camera
+        parallel_for_rows("Color to depth", depth_intrin.height, [&](int y_begin, int y_end)
+        {
+            for (int depth_pixel_index = y_begin * depth_intrin.width; depth_pixel_index < y_end * depth_intrin.width; ++depth_pixel_index)
+            {
+                auto& f = _footprints[depth_pixel_index];
+                f.x0 = 1; f.x1 = 0;
+                auto z = depth_scale * depth[depth_pixel_index];
+                if (!depth[depth_pixel_index] || z < depth_min || z > depth_max)
+                    continue;
+
+                // The point seen by the color camera, divided by the depth from the depth camera
+                auto ray = &_rays[3 * size_t(depth_pixel_index)];
+                auto inv_z = 1.f / z;
+                float point[3] = { ray[0] + t[0] * inv_z, ray[1] + t[1] * inv_z, ray[2] + t[2] * inv_z };
+                if (point[2] <= 0)
+                    continue;
+
+                float pixel[2];
+                auto inv_color_z = 1.f / point[2];
+                if (pinhole)
+                {
+                    pixel[0] = point[0] * inv_color_z * color_intrin.fx + color_intrin.ppx;
+                    pixel[1] = point[1] * inv_color_z * color_intrin.fy + color_intrin.ppy;
+                }
+                else
+                    rs2_project_point_to_pixel(pixel, &color_intrin, point);
+
+                auto half_x = scale_x * inv_color_z, half_y = scale_y * inv_color_z;
+                int x0 = std::max(static_cast<int>(std::floor(pixel[0] - half_x + 0.5f)), 0);
+                int y0 = std::max(static_cast<int>(std::floor(pixel[1] - half_y + 0.5f)), 0);
+                int x1 = std::min(static_cast<int>(std::floor(pixel[0] + half_x + 0.5f)), _color_width - 1);
+                int y1 = std::min(static_cast<int>(std::floor(pixel[1] + half_y + 0.5f)), _color_height - 1);
+                if (x0 > x1 || y0 > y1)
+                    continue;
+                f.x0 = int16_t(x0); f.y0 = int16_t(y0); f.x1 = int16_t(x1); f.y1 = int16_t(y1);
+            }
+        });
+
+        // Several depth pixels may cover the same color pixel, so the depth test makes this a serial pass,
+        // as when aligning depth to color
+        for (int depth_pixel_index = 0; depth_pixel_index < int(_footprints.size()); ++depth_pixel_index)
+        {
+            auto& f = _footprints[depth_pixel_index];
+            if (f.x0 > f.x1)
+                continue;
+
+            auto raw = depth[depth_pixel_index];
+            for (int y = f.y0; y <= f.y1; ++y)
+            {
+                for (int x = f.x0, color_pixel_index = y * _color_width + f.x0; x <= f.x1; ++x, ++color_pixel_index)
+                {
+                    if (_depth_index[color_pixel_index] < 0 || raw < _z[color_pixel_index])
+                    {
+                        _depth_index[color_pixel_index] = depth_pixel_index;
+                        _z[color_pixel_index] = raw;
+                    }
+                }
+            }
+        }
+    }
+
+    int color_to_depth_map::project(const float* color_pixels, float* depth_pixels, int count) const
+    {
+        std::atomic<int> found(0);
+        parallel_for_rows("Color to depth", count, [&](int begin, int end)
+        {
+            int strip_found = 0;
+            for (int i = begin; i < end; ++i)
+            {
+                auto x = static_cast<int>(std::floor(color_pixels[2 * i] + 0.5f));
+                auto y = static_cast<int>(std::floor(color_pixels[2 * i + 1] + 0.5f));
+                int depth_pixel_index = -1;
+                if (x >= 0 && y >= 0 && x < _color_width && y < _color_height)
+                    depth_pixel_index = _depth_index[y * _color_width + x];
+
+                if (depth_pixel_index < 0)
+                {
+                    depth_pixels[2 * i] = depth_pixels[2 * i + 1] = -1.f;
+                    continue;
+                }
+                depth_pixels[2 * i] = static_cast<float>(depth_pixel_index % _depth_width);
+                depth_pixels[2 * i + 1] = static_cast<float>(depth_pixel_index / _depth_width);
+                ++strip_found;
+            }
+            found += strip_found;
+        }, 256);
+        return found;
+    }
+
+    std::shared_ptr<color_to_depth_map> color_to_depth_map::get(int depth_profile_id, int color_profile_id)
+    {
+        static std::mutex mutex;
+        static std::map<std::pair<int, int>, std::shared_ptr<color_to_depth_map>> maps;
+        static std::vector<std::pair<int, int>> recently_used;
+
+        std::lock_guard<std::mutex> lock(mutex);
+        auto key = std::make_pair(depth_profile_id, color_profile_id);
+        auto it = std::find(recently_used.begin(), recently_used.end(), key);
+        if (it != recently_used.end())
+            recently_used.erase(it);
+        recently_used.push_back(key);
+
+        auto& map = maps[key];
+        if (!map)
+            map = std::make_shared<color_to_depth_map>();
+
+        if (recently_used.size() > max_cached_maps)
+        {
+            maps.erase(recently_used.front());
+            recently_used.erase(recently_used.begin());
+        }
+        return map;
+    }
+}
@@ -0,0 +1,72 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2021 Intel Corporation. All Rights Reserved.
+
+#pragma once
+
+#include "types.h"
+#include "core/streaming.h"
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace librealsense
+{
+    // Correspondence from the pixels of a color image to the depth pixels that see the same points. The footprint
+    // of every depth pixel is projected onto the color image once, so that any number of color pixels can then be
+    // projected to depth with a lookup, instead of a search along the epipolar line of each.
+    class color_to_depth_map
+    {
+    public:
+        // Map the depth image; depth out of [depth_min, depth_max] meters is ignored, and where several depth
+        // pixels cover a color pixel the closest one, which occludes the others, is kept
+        void build(const uint16_t* depth, float depth_scale, float depth_min, float depth_max,
+                   const rs2_intrinsics& depth_intrin, const rs2_intrinsics& color_intrin,
+                   const rs2_extrinsics& depth_to_color);
+
+        // Project count (x, y) color pixels to depth pixels, (-1, -1) where no depth pixel covers the color pixel.
+        // Returns the number of color pixels with a depth pixel
+        int project(const float* color_pixels, float* depth_pixels, int count) const;
+
+        // Whether the map was built from this depth frame, within this range. The map holds on to the frame it was
+        // built from, so that its buffer cannot come back as another frame, such as a processed copy that keeps the
+        // frame number and timestamp
+        bool is_built_from(const frame_interface* depth, float depth_min, float depth_max) const
+        {
+            return _source.frame && _source.frame == depth && _depth_min == depth_min && _depth_max == depth_max;
+        }
+
+        void set_source(frame_interface* depth, float depth_min, float depth_max)
+        {
+            depth->acquire();
+            _source = frame_holder(depth);
+            _depth_min = depth_min;
+            _depth_max = depth_max;
+        }
+
+        std::mutex& get_mutex() { return _mutex; }
+
+        // Map shared by all callers projecting between these depth and color profiles, one per pair of profiles
+        static std::shared_ptr<color_to_depth_map> get(int depth_profile_id, int color_profile_id);
+
+    private:
+        struct footprint { int16_t x0, y0, x1, y1; };
+
+        void build_rays(const rs2_intrinsics& depth_intrin, const rs2_extrinsics& depth_to_color);
+
+        rs2_intrinsics _rays_intrin = {};
+        rs2_extrinsics _rays_extrin = {};
+        std::vector<float> _rays;           // per depth pixel, its ray at a depth of 1, rotated to the color camera
+        std::vector<footprint> _footprints; // per depth pixel, the color pixels it covers, empty when x0 > x1
+
+        int _depth_width = 0;
+        int _color_width = 0, _color_height = 0;
+        std::vector<int32_t> _depth_index;  // per color pixel, the depth pixel that covers it or -1
+        std::vector<uint16_t> _z;           // per color pixel, the depth of that depth pixel
+
+        std::mutex _mutex;
+        frame_holder _source;
+        float _depth_min = 0, _depth_max = 0;
+    };
+}
@@ -0,0 +1,268 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2021 Intel Corporation. All Rights Reserved.
+
+#include "compact-points.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace librealsense
+{
+    // Millimeters, the unit of int16 vertices unless a component is farther than 32.767m
+    static const float int16_scale = 0.001f;
+
+    uint16_t float_to_half(float value)
+    {
+        uint32_t bits;
+        memcpy(&bits, &value, sizeof(bits));
+        auto sign = uint16_t((bits >> 16) & 0x8000);
+        auto exponent = int((bits >> 23) & 0xff);
+        auto mantissa = bits & 0x7fffff;
+
+        if (exponent == 0xff)
+            return uint16_t(sign | 0x7c00 | (mantissa ? 0x200 : 0));
+        exponent -= 127 - 15;
+        if (exponent >= 0x1f)
+            return uint16_t(sign | 0x7c00);
+        if (exponent <= 0)
+        {
+            // Subnormal, or zero below half the smallest subnormal
+            if (exponent < -10)
+                return sign;
+            mantissa |= 0x800000;
+            auto shift = 14 - exponent;
+            auto half = mantissa >> shift;
+            auto rest = mantissa & ((1u << shift) - 1);
+            auto halfway = 1u << (shift - 1);
+            if (rest > halfway || (rest == halfway && (half & 1)))
+                ++half;
+            return uint16_t(sign | half);
+        }
+        // A carry out of the mantissa moves on to the exponent, and up to infinity
+        auto half = uint32_t(exponent << 10) | (mantissa >> 13);
+        auto rest = mantissa & 0x1fff;
+        if (rest > 0x1000 || (rest == 0x1000 && (half & 1)))
+            ++half;
+        return uint16_t(sign | half);
+    }
+
+    float half_to_float(uint16_t value)
+    {
+        auto sign = uint32_t(value & 0x8000) << 16;
+        auto exponent = (value >> 10) & 0x1f;
+        auto mantissa = uint32_t(value & 0x3ff);
+        uint32_t bits;
+        if (exponent == 0x1f)
+            bits = sign | 0x7f800000 | (mantissa << 13);
+        else if (exponent)
+            bits = sign | (uint32_t(exponent + 127 - 15) << 23) | (mantissa << 13);
+        else if (mantissa)
+        {
+            // Subnormal: normalize the mantissa
+            exponent = 127 - 15 + 1;
+            while (!(mantissa & 0x400))
+            {
+                mantissa <<= 1;
+                --exponent;
+            }
+            bits = sign | (uint32_t(exponent) << 23) | ((mantissa & 0x3ff) << 13);
+        }
+        else
+            bits = sign;
+        float result;
+        memcpy(&result, &bits, sizeof(result));
+        return result;
+    }
+
+    size_t compact_points::vertex_size(rs2_points_layout layout)
+    {
+        switch (layout)
+        {
+        case RS2_POINTS_LAYOUT_FLOAT32: return 3 * sizeof(float);
+        case RS2_POINTS_LAYOUT_FLOAT16:
+        case RS2_POINTS_LAYOUT_INT16: return 3 * sizeof(uint16_t);
+        default: throw invalid_value_exception(to_string() << "points layout " << layout << " is not compact");
+        }
+    }
+
+    static size_t texture_coordinate_size(compact_texture_coordinates texture)
+    {
+        switch (texture)
+        {
+        case texture_coordinates_none: return 0;
+        case texture_coordinates_float32: return 2 * sizeof(float);
+        case texture_coordinates_uint16: return 2 * sizeof(uint16_t);
+        default: throw invalid_value_exception(to_string() << "unsupported texture coordinates " << int(texture));
+        }
+    }
+
+    size_t compact_points::data_size(rs2_points_layout layout, compact_texture_coordinates texture,
+        uint32_t count, uint32_t width, uint32_t height)
+    {
+        return sizeof(header) + align(mask_size(width, height)) + align(vertex_size(layout) * count)
+            + texture_coordinate_size(texture) * count;
+    }
+
+    float3 compact_points::get_vertex(uint32_t i) const
+    {
+        switch (layout())
+        {
+        case RS2_POINTS_LAYOUT_FLOAT32:
+            return static_cast<const float3*>(vertices())[i];
+        case RS2_POINTS_LAYOUT_FLOAT16:
+        {
+            auto v = static_cast<const uint16_t*>(vertices()) + 3 * i;
+            return { half_to_float(v[0]), half_to_float(v[1]), half_to_float(v[2]) };
+        }
+        default:
+        {
+            auto v = static_cast<const int16_t*>(vertices()) + 3 * i;
+            return { v[0] * scale(), v[1] * scale(), v[2] * scale() };
+        }
+        }
+    }
+
+    static float normalized_to_texture_coordinate(uint16_t value)
+    {
+        return value == compact_points::texture_coordinate_out_of_range ? -1.f : value / 65534.f;
+    }
+
+    float2 compact_points::get_texture_coordinate(uint32_t i) const
+    {
+        switch (texture())
+        {
+        case texture_coordinates_float32:
+            return static_cast<const float2*>(texture_coordinates())[i];
+        case texture_coordinates_uint16:
+        {
+            auto uv = static_cast<const uint16_t*>(texture_coordinates()) + 2 * i;
+            return { normalized_to_texture_coordinate(uv[0]), normalized_to_texture_coordinate(uv[1]) };
+        }
+        default:
+            return { 0.f, 0.f };
+        }
+    }
+
+    uint32_t compact_points::count_valid(const float3* vertices, size_t pixels)
+    {
+        uint32_t count = 0;
+        for (size_t i = 0; i < pixels; ++i)
+            count += vertices[i].z != 0;
+        return count;
+    }
+
+    static int16_t quantize(float value, float inverse_scale)
+    {
+        return int16_t(std::min(std::max(std::lround(value * inverse_scale), -32767l), 32767l));
+    }
+
+    static uint16_t normalize_texture_coordinate(float value)
+    {
+        // Not clamped: a point off the texture would otherwise take the color of its edge
+        if (!(value >= 0.f && value <= 1.f))
+            return compact_points::texture_coordinate_out_of_range;
+        return uint16_t(value * 65534.f + 0.5f);
+    }
+
+    float compact_points::get_int16_scale(float farthest)
+    {
+        return std::max(int16_scale, farthest / 32767.f);
+    }
+
+    void compact_points::begin(rs2_points_layout layout, compact_texture_coordinates texture, uint32_t width, uint32_t height,
+        uint32_t count, float int16_scale)
+    {
+        auto h = get_header();
+        h->count = count;
+        h->width = width;
+        h->height = height;
+        h->scale = layout == RS2_POINTS_LAYOUT_INT16 ? int16_scale : 1.f;
+        h->layout = uint8_t(layout);
+        h->texture = uint8_t(texture);
+        h->reserved = 0;
+        _inverse_scale = 1.f / h->scale;
+        memset(valid_pixels(), 0, align(mask_size(width, height)));
+    }
+
+    void compact_points::set_point(uint32_t n, size_t i, const float3& v, const float2& uv)
+    {
+        valid_pixels()[i >> 3] |= uint8_t(1 << (i & 7));
+        switch (layout())
+        {
+        case RS2_POINTS_LAYOUT_FLOAT32:
+            static_cast<float3*>(vertices())[n] = v;
+            break;
+        case RS2_POINTS_LAYOUT_FLOAT16:
+        {
+            auto u16 = static_cast<uint16_t*>(vertices()) + 3 * n;
+            u16[0] = float_to_half(v.x);
+            u16[1] = float_to_half(v.y);
+            u16[2] = float_to_half(v.z);
+            break;
+        }
+        default:
+        {
+            auto i16 = static_cast<int16_t*>(vertices()) + 3 * n;
+            i16[0] = quantize(v.x, _inverse_scale);
+            i16[1] = quantize(v.y, _inverse_scale);
+            i16[2] = quantize(v.z, _inverse_scale);
+            break;
+        }
+        }
+        switch (texture())
+        {
+        case texture_coordinates_float32:
+            static_cast<float2*>(texture_coordinates())[n] = uv;
+            break;
+        case texture_coordinates_uint16:
+        {
+            auto uv16 = static_cast<uint16_t*>(texture_coordinates()) + 2 * n;
+            uv16[0] = normalize_texture_coordinate(uv.x);
+            uv16[1] = normalize_texture_coordinate(uv.y);
+            break;
+        }
+        default:
+            break;
+        }
+    }
+
+    void compact_points::pack(rs2_points_layout layout, compact_texture_coordinates texture, uint32_t width, uint32_t height,
+        uint32_t count, const float3* vertices, const float2* texcoords)
+    {
+        size_t pixels = size_t(width) * height;
+        float farthest = 0.f;
+        if (layout == RS2_POINTS_LAYOUT_INT16)
+            for (size_t i = 0; i < pixels; ++i)
+                if (vertices[i].z != 0)
+                    farthest = std::max({ farthest, std::fabs(vertices[i].x), std::fabs(vertices[i].y), std::fabs(vertices[i].z) });
+
+        begin(layout, texcoords ? texture : texture_coordinates_none, width, height, count, get_int16_scale(farthest));
+        uint32_t n = 0;
+        for (size_t i = 0; i < pixels && n < count; ++i)
+            if (vertices[i].z != 0)
+                set_point(n++, i, vertices[i], texcoords ? texcoords[i] : float2{ 0.f, 0.f });
+        get_header()->count = n;
+    }
+
+    void compact_points::unpack(float3* vertices, float2* texcoords) const
+    {
+        size_t pixels = size_t(width()) * height();
+        auto mask = valid_pixels();
+        uint32_t n = 0;
+        for (size_t i = 0; i < pixels; ++i)
+        {
+            bool valid = n < count() && (mask[i >> 3] >> (i & 7)) & 1;
+            vertices[i] = valid ? get_vertex(n) : float3{ 0.f, 0.f, 0.f };
+            if (texcoords)
+                texcoords[i] = valid ? get_texture_coordinate(n) : float2{ 0.f, 0.f };
+            n += valid;
+        }
+    }
+
+    bool is_compact_points(const frame_interface* f)
+    {
+        auto fr = dynamic_cast<const frame*>(f);
+        return fr && fr->additional_data.is_compact_points;
+    }
+}
@@ -0,0 +1,110 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2021 Intel Corporation. All Rights Reserved.
+
+#pragma once
+
+#include "../archive.h"
+
+namespace librealsense
+{
+    // Texture coordinates of compact points, the values of RS2_OPTION_POINTS_TEXTURE_COORDINATES
+    enum compact_texture_coordinates : uint8_t
+    {
+        texture_coordinates_none,
+        texture_coordinates_float32,
+        texture_coordinates_uint16,
+        texture_coordinates_count
+    };
+
+    // Data of a points frame holding only the points with depth (see RS2_OPTION_POINTS_LAYOUT): a short header,
+    // a bit per depth pixel telling which pixels have a point, the vertices of the points, three components of
+    // the layout's type each, and their texture coordinates, if any, two components each.
+    // Every array starts on a 4-byte boundary.
+    class compact_points
+    {
+    public:
+        // Uint16 texture coordinates scale [0,1] to [0,65534]; a component out of that range, where the point is
+        // off the texture, is stored as this value and read back as -1
+        static const uint16_t texture_coordinate_out_of_range = 65535;
+
+        // Frame data size needed for count points of a width x height depth frame
+        static size_t data_size(rs2_points_layout layout, compact_texture_coordinates texture,
+            uint32_t count, uint32_t width, uint32_t height);
+
+        // Wraps existing frame data; the data must stay alive while the object is used
+        explicit compact_points(byte* data) : _data(data) {}
+        explicit compact_points(const byte* data) : _data(const_cast<byte*>(data)) {}
+
+        rs2_points_layout layout() const { return static_cast<rs2_points_layout>(get_header()->layout); }
+        compact_texture_coordinates texture() const { return static_cast<compact_texture_coordinates>(get_header()->texture); }
+        uint32_t count() const { return get_header()->count; }
+        uint32_t width() const { return get_header()->width; }
+        uint32_t height() const { return get_header()->height; }
+        float scale() const { return get_header()->scale; }
+
+        byte* valid_pixels() { return _data + sizeof(header); }
+        void* vertices() { return valid_pixels() + align(mask_size(width(), height())); }
+        void* texture_coordinates() { return (byte*)vertices() + align(vertex_size(layout()) * count()); }
+
+        const byte* valid_pixels() const { return const_cast<compact_points*>(this)->valid_pixels(); }
+        const void* vertices() const { return const_cast<compact_points*>(this)->vertices(); }
+        const void* texture_coordinates() const { return const_cast<compact_points*>(this)->texture_coordinates(); }
+
+        // The vertex and the texture coordinates of point i in meters and in [0,1] range, or out of it where the
+        // point is off the texture
+        float3 get_vertex(uint32_t i) const;
+        float2 get_texture_coordinate(uint32_t i) const;
+
+        // Number of the points with depth, whose z is not 0, among a vertex per pixel
+        static uint32_t count_valid(const float3* vertices, size_t pixels);
+
+        // Packs the count points with depth out of a vertex and a texture coordinate per pixel of a width x height
+        // frame into data of data_size() bytes; texcoords may be null when the layout has no texture coordinates.
+        // Int16 vertices are in millimeters, or in the smallest unit that fits the farthest component
+        void pack(rs2_points_layout layout, compact_texture_coordinates texture, uint32_t width, uint32_t height,
+            uint32_t count, const float3* vertices, const float2* texcoords);
+
+        // Writing the points one at a time instead: begin() writes the header and clears the bit mask of data
+        // of data_size() bytes, then set_point() stores each of the count points in pixel order. int16_scale is
+        // the unit of int16 vertices, see get_int16_scale()
+        void begin(rs2_points_layout layout, compact_texture_coordinates texture, uint32_t width, uint32_t height,
+            uint32_t count, float int16_scale);
+        // Stores point n, the point of pixel i; uv is ignored when the points have no texture coordinates
+        void set_point(uint32_t n, size_t i, const float3& vertex, const float2& uv);
+
+        // Unit of int16 vertices whose farthest component is farthest meters away
+        static float get_int16_scale(float farthest);
+
+        // Spreads the points back to a vertex and a texture coordinate per pixel, zero for the pixels without
+        // a point; texcoords may be null, and are all zero when the points have no texture coordinates
+        void unpack(float3* vertices, float2* texcoords) const;
+
+    private:
+        struct header
+        {
+            uint32_t count;
+            uint32_t width;
+            uint32_t height;
+            float scale;
+            uint8_t layout;
+            uint8_t texture;
+            uint16_t reserved;
+        };
+
+        static size_t align(size_t size) { return (size + 3) & ~size_t(3); }
+        static size_t mask_size(uint32_t width, uint32_t height) { return (size_t(width) * height + 7) / 8; }
+        static size_t vertex_size(rs2_points_layout layout);
+
+        header* get_header() const { return reinterpret_cast<header*>(_data); }
+
+        byte* _data;
+        float _inverse_scale = 1.f;
+    };
+
+    // True for the points frames produced while RS2_OPTION_POINTS_LAYOUT selects a compact layout
+    bool is_compact_points(const frame_interface* f);
+
+    // IEEE 754 half floats, rounded to nearest even
+    uint16_t float_to_half(float value);
+    float half_to_float(uint16_t value);
+}
@@ -356,17 +356,24 @@ namespace librealsense
 
     void decimation_filter::decimate_depth(const uint16_t * frame_data_in, uint16_t * frame_data_out,
         size_t width_in, size_t height_in, size_t scale)
+    {
+        decimate_depth_rows(frame_data_in, frame_data_out, width_in, scale, 0, _padded_height);
+    }
+
+    void decimation_filter::decimate_depth_rows(const uint16_t * frame_data_in, uint16_t * frame_data_out,
+        size_t width_in, size_t scale, size_t row_begin, size_t row_end)
     {
         // Use median filtering
         std::vector<uint16_t> working_kernel(_kernel_size);
         auto wk_begin = working_kernel.data();
         auto wk_itr = wk_begin;
         std::vector<uint16_t*> pixel_raws(scale);
-        uint16_t* block_start = const_cast<uint16_t*>(frame_data_in);
+        uint16_t* block_start = const_cast<uint16_t*>(frame_data_in) + row_begin * width_in * scale;
+        auto real_end = std::min(row_end, size_t(_real_height));
 
         if (scale == 2 || scale == 3)
         {
-            for (int j = 0; j < _real_height; j++)
+            for (auto j = row_begin; j < real_end; j++)
             {
                 uint16_t *p{};
                 // Mark the beginning of each of the N lines that the filter will run upon
@@ -438,7 +445,7 @@ namespace librealsense
         }
         else
         {
-            for (int j = 0; j < _real_height; j++)
+            for (auto j = row_begin; j < real_end; j++)
             {
                 uint16_t *p{};
                 // Mark the beginning of each of the N lines that the filter will run upon
@@ -478,7 +485,7 @@ namespace librealsense
         }
 
         // Fill-in the padded rows with zeros
-        for (auto v = _real_height; v < _padded_height; ++v)
+        for (auto v = std::max(row_begin, size_t(_real_height)); v < row_end; ++v)
         {
             for (auto u = 0; u < _padded_width; ++u)
                 *frame_data_out++ = 0;
@@ -21,11 +21,17 @@ namespace librealsense
         void decimate_depth(const uint16_t * frame_data_in, uint16_t * frame_data_out,
             size_t width_in, size_t height_in, size_t scale);
 
+        // Decimate the output rows [row_begin, row_end), padding included, to frame_data_out, which points to row_begin
+        void decimate_depth_rows(const uint16_t * frame_data_in, uint16_t * frame_data_out,
+            size_t width_in, size_t scale, size_t row_begin, size_t row_end);
+
         void decimate_others(rs2_format format, const void * frame_data_in, void * frame_data_out,
             size_t width_in, size_t height_in, size_t scale);
         rs2::frame process_frame(const rs2::frame_source& source, const rs2::frame& f) override;
 
     private:
+        friend class depth_postprocess;
+
         void    update_output_profile(const rs2::frame& f);
 
         uint8_t                 _decimation_factor;
@@ -1,9 +1,8 @@
 // License: Apache 2.0. See LICENSE file in root directory.
 // Copyright(c) 2019 Intel Corporation. All Rights Reserved.
 
-#include <fstream>
-#include "../common/decompress-huffman.h"
 #include "proc/depth-decompress.h"
+#include "proc/z16h-codec.h"
 #include "environment.h"
 
 namespace librealsense
@@ -17,7 +16,7 @@ namespace librealsense
 
     void depth_decompression_huffman::process_function(byte* const dest[], const byte* source, int width, int height, int actual_size, int input_size)
     {
-        if (!unhuffimage4(reinterpret_cast<uint32_t*>(const_cast<byte*>(source)), uint32_t(input_size >> 2), width << 1, height, const_cast<byte*>(*dest)))
+        if (!z16h::decode(reinterpret_cast<const uint32_t*>(source), size_t(input_size >> 2), size_t(width) << 1, size_t(height), *dest))
         {
             LOG_INFO("Depth decompression failed, ts: " << static_cast<uint64_t>(environment::get_instance().get_time_service()->get_time())
                         << " , compressed size: " << input_size);
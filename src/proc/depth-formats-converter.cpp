@@ -4,6 +4,7 @@
 #include "depth-formats-converter.h"
 
 #include "stream.h"
+#include "simd/unpack-kernels.h"
 
 #ifdef RS2_USE_CUDA
 #include "cuda/cuda-conversion.cuh"
@@ -20,7 +21,8 @@ namespace librealsense
         rscuda::unpack_z16_y8_from_sr300_inzi_cuda(out_ir, in, count);
         in += count;
 #else
-        for (int i = 0; i < count; ++i) *out_ir++ = *in++ >> 2;
+        get_unpack_kernels().narrow_y10_to_y8(in, out_ir, count);
+        in += count;
 #endif
         librealsense::copy(dest[0], in, count * 2);
     }
@@ -34,7 +36,8 @@ namespace librealsense
         rscuda::unpack_z16_y16_from_sr300_inzi_cuda(out_ir, in, count);
         in += count;
 #else
-        for (int i = 0; i < count; ++i) *out_ir++ = *in++ << 6;
+        get_unpack_kernels().expand_y10_to_y16(in, out_ir, count);
+        in += count;
 #endif
         librealsense::copy(dest[0], in, count * 2);
     }
@@ -55,14 +58,8 @@ namespace librealsense
         }
     }
 
-    template<class SOURCE, class UNPACK> void unpack_pixels(byte * const dest[], int count, const SOURCE * source, UNPACK unpack, int actual_size)
-    {
-        auto out = reinterpret_cast<decltype(unpack(SOURCE())) *>(dest[0]);
-        for (int i = 0; i < count; ++i) *out++ = unpack(*source++);
-    }
-
-    void unpack_y16_from_y16_10(byte * const d[], const byte * s, int width, int height, int actual_size) { unpack_pixels(d, width * height, reinterpret_cast<const uint16_t*>(s), [](uint16_t pixel) -> uint16_t { return pixel << 6; }, actual_size); }
-    void unpack_y8_from_y16_10(byte * const d[], const byte * s, int width, int height, int actual_size) { unpack_pixels(d, width * height, reinterpret_cast<const uint16_t*>(s), [](uint16_t pixel) -> uint8_t { return pixel >> 2; }, actual_size); }
+    void unpack_y16_from_y16_10(byte * const d[], const byte * s, int width, int height, int actual_size) { get_unpack_kernels().expand_y10_to_y16(reinterpret_cast<const uint16_t*>(s), reinterpret_cast<uint16_t*>(d[0]), width * height); }
+    void unpack_y8_from_y16_10(byte * const d[], const byte * s, int width, int height, int actual_size) { get_unpack_kernels().narrow_y10_to_y8(reinterpret_cast<const uint16_t*>(s), d[0], width * height); }
 
     void unpack_invi(rs2_format dst_format, byte * const d[], const byte * s, int width, int height, int actual_size)
     {
@@ -88,18 +85,8 @@ namespace librealsense
 
     void unpack_y10bpack(byte * const dest[], const byte * source, int width, int height, int actual_size)
     {
-        auto count = width * height / 4; // num of pixels
-        uint8_t  * from = (uint8_t*)(source);
-        uint16_t * to = (uint16_t*)(dest[0]);
-
         // Put the 10 bit into the msb of uint16_t
-        for (int i = 0; i < count; i++, from += 5) // traverse macro-pixels
-        {
-            *to++ = ((from[0] << 2) | (from[4] & 3)) << 6;
-            *to++ = ((from[1] << 2) | ((from[4] >> 2) & 3)) << 6;
-            *to++ = ((from[2] << 2) | ((from[4] >> 4) & 3)) << 6;
-            *to++ = ((from[3] << 2) | ((from[4] >> 6) & 3)) << 6;
-        }
+        get_unpack_kernels().unpack_y10bpack(source, reinterpret_cast<uint16_t*>(dest[0]), width * height);
     }
 
     void unpack_w10(rs2_format dst_format, byte * const d[], const byte * s, int width, int height, int actual_size)
@@ -0,0 +1,484 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2021 Intel Corporation. All Rights Reserved.
+
+#include "../include/librealsense2/hpp/rs_sensor.hpp"
+#include "../include/librealsense2/hpp/rs_processing.hpp"
+
+#include "option.h"
+#include "environment.h"
+#include "context.h"
+#include "core/video.h"
+#include "proc/synthetic-stream.h"
+#include "proc/decimation-filter.h"
+#include "proc/threshold.h"
+#include "proc/disparity-transform.h"
+#include "proc/spatial-filter.h"
+#include "proc/temporal-filter.h"
+#include "proc/hole-filling-filter.h"
+#include "proc/depth-postprocess.h"
+
+#include <cmath>
+#include <cstring>
+
+namespace librealsense
+{
+    // The first pass works on bands of rows whose input, output and disparity fit in this much cache
+    static const size_t band_bytes = 256 * 1024;
+
+    // Positive for positive floats only, as the spatial filter tells valid disparities, and 0 for holes
+    static inline int32_t float_bits(float x)
+    {
+        int32_t bits;
+        memcpy(&bits, &x, sizeof(bits));
+        return bits;
+    }
+
+    // One step of the spatial filter's recursion along a line, as in spatial_filter::recursive_filter_horizontal_fp.
+    // The state and the previous value only matter while the line is valid, which makes the step branch free and
+    // lets the compiler vectorize it across columns
+    static inline void recursive_step(float& x, float& state, float& previous, uint8_t& valid, float alpha, float delta_z)
+    {
+        float innovation = x;
+        float delta = previous - innovation;
+        bool positive = float_bits(innovation) > 0;
+        bool smooth = bool(valid) & positive & (delta < delta_z) & (delta > -delta_z);
+        float filtered = innovation * alpha + state * (1.0f - alpha);
+        x = state = smooth ? filtered : innovation;
+        previous = innovation;
+        valid = positive;
+    }
+
+    // The horizontal pass of the spatial filter over one row: left to right, then right to left
+    static void recursive_filter_row(float* row, size_t width, float alpha, float delta_z)
+    {
+        float state = row[0], previous = state;
+        uint8_t valid = float_bits(state) > 0;
+        for (size_t u = 1; u < width; ++u)
+            recursive_step(row[u], state, previous, valid, alpha, delta_z);
+
+        state = previous = row[width - 1];
+        valid = float_bits(state) > 0;
+        for (size_t u = width - 1; u-- > 0;)
+            recursive_step(row[u], state, previous, valid, alpha, delta_z);
+    }
+
+    // The vertical pass of the spatial filter, one row at a time: the first row of a pass starts the recursion
+    // down every column, and the rows after it are filtered against it
+    static void recursive_seed_columns(const float* row, size_t width, float* state, float* previous, uint8_t* valid)
+    {
+        for (size_t u = 0; u < width; ++u)
+        {
+            state[u] = previous[u] = row[u];
+            valid[u] = float_bits(row[u]) > 0;
+        }
+    }
+
+    static void recursive_filter_columns(float* row, size_t width, float* state, float* previous, uint8_t* valid,
+                                         float alpha, float delta_z)
+    {
+        for (size_t u = 0; u < width; ++u)
+            recursive_step(row[u], state[u], previous[u], valid[u], alpha, delta_z);
+    }
+
+    // spatial_filter::intertial_holes_fill over one row. Filling right to left, the filter takes the last pixel
+    // of a row from the first pixel of the next one, which is next_first; the last row has no next one
+    static void inertial_holes_fill_row(float* row, size_t width, float next_first, uint8_t radius)
+    {
+        size_t cur_fill = 0;
+        for (size_t i = 1; i < width; ++i)
+        {
+            if (!float_bits(row[i]))
+            {
+                if (++cur_fill < radius)
+                    row[i] = row[i - 1];
+            }
+            else
+                cur_fill = 0;
+        }
+
+        cur_fill = 0;
+        for (size_t i = width - 1; i > 0; --i)
+        {
+            if (!float_bits(row[i]))
+            {
+                if (++cur_fill < radius)
+                    row[i] = i + 1 < width ? row[i + 1] : next_first;
+            }
+            else
+                cur_fill = 0;
+        }
+    }
+
+    template<class T>
+    rs2::frame depth_postprocess::process_stage(T* filter, const rs2::frame_source& source, const rs2::frame& f)
+    {
+        if (!filter->should_process(f))
+            return f;
+        auto res = filter->process_frame(source, f);
+        return res ? res : f;
+    }
+
+    depth_postprocess::depth_postprocess(std::vector<std::shared_ptr<processing_block>> filters)
+        : stream_filter_processing_block("Depth Post-Processing"),
+        _stereoscopic_depth(false),
+        _d2d_convert_factor(0.f)
+    {
+        _stream_filter.stream = RS2_STREAM_DEPTH;
+        _stream_filter.format = RS2_FORMAT_Z16;
+
+        for (auto& filter : filters)
+        {
+            if (!filter)
+                throw invalid_value_exception("null filter in the depth post-processing chain");
+            for (auto& s : _stages)
+                if (s.block == filter)
+                    throw invalid_value_exception(to_string() << filter->get_info(RS2_CAMERA_INFO_NAME)
+                        << " appears twice in the depth post-processing chain");
+
+            stage s{ filter, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr };
+            using namespace std::placeholders;
+            if ((s.decimation = dynamic_cast<decimation_filter*>(filter.get())))
+            {
+                s.mutex = &s.decimation->_mutex;
+                s.process = std::bind(&process_stage<decimation_filter>, s.decimation, _1, _2);
+            }
+            else if ((s.thresholding = dynamic_cast<threshold*>(filter.get())))
+            {
+                s.mutex = &s.thresholding->_mutex;
+                s.process = std::bind(&process_stage<threshold>, s.thresholding, _1, _2);
+            }
+            else if ((s.disparity = dynamic_cast<disparity_transform*>(filter.get())))
+            {
+                s.mutex = &s.disparity->_mutex;
+                s.process = std::bind(&process_stage<disparity_transform>, s.disparity, _1, _2);
+            }
+            else if ((s.spatial = dynamic_cast<spatial_filter*>(filter.get())))
+            {
+                s.mutex = &s.spatial->_mutex;
+                s.process = std::bind(&process_stage<spatial_filter>, s.spatial, _1, _2);
+            }
+            else if ((s.temporal = dynamic_cast<temporal_filter*>(filter.get())))
+            {
+                s.mutex = &s.temporal->_mutex;
+                s.process = std::bind(&process_stage<temporal_filter>, s.temporal, _1, _2);
+            }
+            else if ((s.holes = dynamic_cast<hole_filling_filter*>(filter.get())))
+            {
+                s.mutex = &s.holes->_mutex;
+                s.process = std::bind(&process_stage<hole_filling_filter>, s.holes, _1, _2);
+            }
+            else
+                throw invalid_value_exception(to_string() << filter->get_info(RS2_CAMERA_INFO_NAME)
+                    << " is not a depth post-processing filter");
+            _stages.push_back(s);
+        }
+    }
+
+    rs2::frame depth_postprocess::process_frame(const rs2::frame_source& source, const rs2::frame& f)
+    {
+        // Hold the options of every filter for the whole frame, always locking in the order of the chain
+        std::vector<std::unique_lock<std::mutex>> locks;
+        locks.reserve(_stages.size());
+        for (auto& s : _stages)
+            locks.emplace_back(*s.mutex);
+
+        fused_chain chain;
+        if (f.is<rs2::depth_frame>() && !f.is<rs2::disparity_frame>() && get_fused_chain(chain))
+        {
+            if (auto res = process_fused(source, f, chain))
+                return res;
+        }
+        return process_chained(source, f);
+    }
+
+    bool depth_postprocess::get_fused_chain(fused_chain& chain) const
+    {
+        // The filters in the order of the recommended chain, hole filling on either side of disparity to depth
+        enum { decimation, thresholding, to_disparity, spatial, temporal, last };
+        int rank = -1;
+        bool has_to_disparity = false, has_to_depth = false;
+        for (auto& s : _stages)
+        {
+            int r;
+            if (s.decimation)
+            {
+                r = decimation;
+                chain.decimation = s.decimation;
+            }
+            else if (s.thresholding)
+            {
+                r = thresholding;
+                chain.thresholding = s.thresholding;
+            }
+            else if (s.disparity && s.disparity->_transform_to_disparity)
+            {
+                r = to_disparity;
+                has_to_disparity = true;
+            }
+            else if (s.spatial)
+            {
+                r = spatial;
+                chain.spatial = s.spatial;
+            }
+            else if (s.temporal)
+            {
+                r = temporal;
+                chain.temporal = s.temporal;
+            }
+            else if (s.disparity)
+            {
+                if (has_to_depth)
+                    return false;
+                r = last;
+                has_to_depth = true;
+            }
+            else
+            {
+                if (chain.holes)
+                    return false;
+                r = last;
+                chain.holes = s.holes;
+                chain.holes_in_disparity = !has_to_depth;
+            }
+
+            if (r < rank || (r == rank && r != last))
+                return false;
+            rank = r;
+        }
+        return has_to_disparity && has_to_depth;
+    }
+
+    rs2::frame depth_postprocess::process_chained(const rs2::frame_source& source, const rs2::frame& f)
+    {
+        rs2::frame res = f;
+        for (auto& s : _stages)
+            res = s.process(source, res);
+        return res;
+    }
+
+    rs2::frame depth_postprocess::process_fused(const rs2::frame_source& source, const rs2::frame& f, const fused_chain& chain)
+    {
+        auto input = f.as<rs2::video_frame>();
+        size_t in_width = input.get_width();
+        size_t width = in_width;
+        size_t height = input.get_height();
+        size_t scale = 1;
+        auto decimated = f.get_profile();
+        if (chain.decimation)
+        {
+            chain.decimation->update_output_profile(f);
+            decimated = chain.decimation->_target_stream_profile;
+            width = chain.decimation->_padded_width;
+            height = chain.decimation->_padded_height;
+            scale = chain.decimation->_patch_size;
+        }
+
+        bool profile_changed = f.get_profile().get() != _source_stream_profile.get() || decimated.get() != _decimated_profile.get();
+        if (profile_changed)
+        {
+            _source_stream_profile = f.get_profile();
+            _decimated_profile = decimated;
+
+            // Disparity is taken at the focal length of the decimated frame, as the chained filters do
+            auto info = disparity_info::update_info_from_frame(f, decimated);
+            _stereoscopic_depth = info.stereoscopic_depth;
+            _d2d_convert_factor = info.d2d_convert_factor;
+
+            _target_stream_profile = decimated.clone(RS2_STREAM_DEPTH, 0, RS2_FORMAT_Z16);
+            auto src_vspi = dynamic_cast<video_stream_profile_interface*>(decimated.get()->profile);
+            auto tgt_vspi = dynamic_cast<video_stream_profile_interface*>(_target_stream_profile.get()->profile);
+            rs2_intrinsics src_intrin = src_vspi->get_intrinsics();
+
+            tgt_vspi->set_intrinsics([src_intrin]() { return src_intrin; });
+            tgt_vspi->set_dims(src_intrin.width, src_intrin.height);
+        }
+
+        // Without a stereo baseline the disparity filters pass the frame as is, and the spatial filter needs
+        // a couple of rows and columns
+        if (!_stereoscopic_depth || width < 3 || height < 3)
+            return rs2::frame();
+
+        auto tgt = source.allocate_video_frame(_target_stream_profile, f, sizeof(uint16_t), int(width), int(height),
+            int(width * sizeof(uint16_t)), RS2_EXTENSION_DEPTH_FRAME);
+        if (!tgt)
+            return tgt;
+
+        auto orig = dynamic_cast<librealsense::depth_frame*>((librealsense::frame_interface*)f.get());
+        auto in = static_cast<const uint16_t*>(input.get_data());
+        auto out = static_cast<uint16_t*>(const_cast<void*>(tgt.get_data()));
+        auto pixels = width * height;
+
+        _disparity.resize(pixels);
+        auto disparity = _disparity.data();
+        auto factor = _d2d_convert_factor;
+
+        if (chain.temporal && (profile_changed || chain.temporal->_last_frame.size() != pixels * sizeof(float)))
+            chain.temporal->reset_history(pixels, sizeof(float));
+
+        float alpha = 0.f, delta_z = 0.f;
+        int iterations = 0;
+        if (chain.spatial)
+        {
+            alpha = chain.spatial->_spatial_alpha_param;
+            delta_z = float(chain.spatial->_spatial_delta_param);
+            iterations = chain.spatial->_spatial_iterations;
+            _column_state.resize(width);
+            _column_previous.resize(width);
+            _column_valid.resize(width);
+        }
+        auto state = _column_state.data();
+        auto previous = _column_previous.data();
+        auto valid = _column_valid.data();
+
+        bool hole_rows = chain.holes && chain.holes->_hole_filling_mode == hf_fill_from_left;
+        bool hole_pass = chain.holes && !hole_rows;
+
+        // Threshold the depth of a row and take its disparity
+        auto depth = chain.decimation ? out : in;
+        float units = chain.thresholding ? orig->get_units() : 0.f;
+        auto to_disparity = [&](size_t v)
+        {
+            auto d = depth + v * width;
+            auto x = disparity + v * width;
+            for (size_t u = 0; u < width; ++u)
+            {
+                uint16_t value = d[u];
+                if (chain.thresholding)
+                {
+                    auto dist = units * value;
+                    if (!(dist >= chain.thresholding->_min && dist <= chain.thresholding->_max))
+                        value = 0;
+                }
+                float input = value;
+                x[u] = std::isnormal(input) ? factor / input : 0.f;
+            }
+        };
+
+        auto to_depth = [&](size_t v)
+        {
+            auto x = disparity + v * width;
+            auto d = out + v * width;
+            for (size_t u = 0; u < width; ++u)
+            {
+                float input = x[u];
+                d[u] = std::isnormal(input) ? static_cast<uint16_t>((factor / input) + 0.5f) : 0;
+            }
+        };
+
+        // Everything past the spatial filter's recursion, which only depends on the row
+        auto finish_row = [&](size_t v, float next_first)
+        {
+            auto x = disparity + v * width;
+            if (chain.spatial && chain.spatial->_holes_filling_mode)
+                inertial_holes_fill_row(x, width, next_first, chain.spatial->_holes_filling_radius);
+            if (chain.temporal)
+                chain.temporal->temp_jw_smooth_pixels(x, reinterpret_cast<float*>(chain.temporal->_last_frame.data()) + v * width,
+                    chain.temporal->_history.data() + v * width, width);
+            if (hole_rows && chain.holes_in_disparity)
+                chain.holes->holes_fill_left(x, width, 1, width * sizeof(float));
+            if (hole_pass && chain.holes_in_disparity)
+                return;
+            to_depth(v);
+            if (hole_rows && !chain.holes_in_disparity)
+                chain.holes->holes_fill_left(out + v * width, width, 1, width * sizeof(uint16_t));
+        };
+
+        // Top to bottom: decimate a band, then threshold, take the disparity of and start filtering every row in it
+        size_t row_bytes = in_width * scale * sizeof(uint16_t) + width * (sizeof(uint16_t) + sizeof(float));
+        size_t band_rows = std::max(size_t(1), band_bytes / row_bytes);
+        for (size_t band = 0; band < height; band += band_rows)
+        {
+            auto band_end = std::min(height, band + band_rows);
+            if (chain.decimation)
+                chain.decimation->decimate_depth_rows(in, out + band * width, in_width, scale, band, band_end);
+
+            for (auto v = band; v < band_end; ++v)
+            {
+                to_disparity(v);
+                auto x = disparity + v * width;
+                if (!chain.spatial)
+                {
+                    finish_row(v, 0.f);
+                    continue;
+                }
+                recursive_filter_row(x, width, alpha, delta_z);
+                if (v == 0)
+                    recursive_seed_columns(x, width, state, previous, valid);
+                else
+                    recursive_filter_columns(x, width, state, previous, valid, alpha, delta_z);
+            }
+        }
+
+        // Every iteration of the spatial filter ends bottom to top, running the next iteration's horizontal pass
+        // on the rows it is done with, or after the last one, the rest of the chain. The next iteration then
+        // goes down again
+        for (int i = 1; i <= iterations; ++i)
+        {
+            float next_first = 0.f;
+            for (auto v = height; v-- > 0;)
+            {
+                auto x = disparity + v * width;
+                if (v == height - 1)
+                    recursive_seed_columns(x, width, state, previous, valid);
+                else
+                    recursive_filter_columns(x, width, state, previous, valid, alpha, delta_z);
+
+                if (i < iterations)
+                {
+                    recursive_filter_row(x, width, alpha, delta_z);
+                }
+                else
+                {
+                    float first = x[0];
+                    finish_row(v, next_first);
+                    next_first = first;
+                }
+            }
+
+            if (i < iterations)
+            {
+                for (size_t v = 0; v < height; ++v)
+                {
+                    auto x = disparity + v * width;
+                    if (v == 0)
+                        recursive_seed_columns(x, width, state, previous, valid);
+                    else
+                        recursive_filter_columns(x, width, state, previous, valid, alpha, delta_z);
+                }
+            }
+        }
+
+        // Filling from around reads the rows above and below the hole, so it runs as a pass of its own: in
+        // disparity a row is final once the one below it is filled
+        if (hole_pass && chain.holes_in_disparity)
+        {
+            bool farest = chain.holes->_hole_filling_mode == hf_farest_from_around;
+            for (size_t v = 1; v < height; ++v)
+            {
+                if (v + 1 < height)
+                {
+                    auto above = disparity + (v - 1) * width;
+                    if (farest)
+                        chain.holes->holes_fill_farest(above, width, 3, width * sizeof(float));
+                    else
+                        chain.holes->holes_fill_nearest(above, width, 3, width * sizeof(float));
+                }
+                to_depth(v - 1);
+            }
+            to_depth(height - 1);
+        }
+        else if (hole_pass)
+        {
+            if (chain.holes->_hole_filling_mode == hf_farest_from_around)
+                chain.holes->holes_fill_farest(out, width, height, width * sizeof(uint16_t));
+            else
+                chain.holes->holes_fill_nearest(out, width, height, width * sizeof(uint16_t));
+        }
+
+        // The temporal filter's history moves on once per frame, as at the end of temporal_filter::temp_jw_smooth
+        if (chain.temporal)
+            chain.temporal->_cur_frame_index = (chain.temporal->_cur_frame_index + 1) % 8;
+
+        return tgt;
+    }
+}
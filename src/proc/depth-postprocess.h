@@ -0,0 +1,84 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2021 Intel Corporation. All Rights Reserved.
+
+#pragma once
+
+#include "synthetic-stream.h"
+
+#include <functional>
+#include <vector>
+
+namespace librealsense
+{
+    class decimation_filter;
+    class threshold;
+    class disparity_transform;
+    class spatial_filter;
+    class temporal_filter;
+    class hole_filling_filter;
+
+    // Applies a chain of the depth post-processing filters to each frame, with the options and state the filters
+    // themselves hold, so the chain is configured (and presets are loaded) through the filters as before.
+    //
+    // The recommended chain - decimation, threshold, depth to disparity, spatial, temporal, disparity to depth and
+    // hole filling, any of them but the disparity pair optional - is fused into passes over a single disparity
+    // buffer at the output resolution, instead of a frame allocated, written and read again by every filter:
+    // the first pass decimates bands of rows sized to stay in L2 and runs every filter up to the first spatial
+    // pass on them, and then every pass runs in the opposite direction of the one before, starting on the rows
+    // that are still cached. The spatial filter is recursive down the columns, so instead of overlapping halos
+    // every pass carries the filter's state from one row to the next. The output is that of the chained filters,
+    // but for the spatial filter's hole filling at the end of the last row, where the filter reads past the frame.
+    // Other chains, and frames the chain cannot be fused for, go through the filters in turn.
+    class depth_postprocess : public stream_filter_processing_block
+    {
+    public:
+        explicit depth_postprocess(std::vector<std::shared_ptr<processing_block>> filters);
+
+    protected:
+        rs2::frame process_frame(const rs2::frame_source& source, const rs2::frame& f) override;
+
+    private:
+        struct stage
+        {
+            std::shared_ptr<processing_block> block;
+            std::mutex* mutex;
+            std::function<rs2::frame(const rs2::frame_source&, const rs2::frame&)> process;
+
+            decimation_filter* decimation;
+            threshold* thresholding;
+            disparity_transform* disparity;
+            spatial_filter* spatial;
+            temporal_filter* temporal;
+            hole_filling_filter* holes;
+        };
+
+        // The stages of the fused chain, null where the chain has none
+        struct fused_chain
+        {
+            decimation_filter* decimation = nullptr;
+            threshold* thresholding = nullptr;
+            spatial_filter* spatial = nullptr;
+            temporal_filter* temporal = nullptr;
+            hole_filling_filter* holes = nullptr;
+            bool holes_in_disparity = false;
+        };
+
+        template<class T>
+        static rs2::frame process_stage(T* filter, const rs2::frame_source& source, const rs2::frame& f);
+
+        bool get_fused_chain(fused_chain& chain) const;
+        rs2::frame process_chained(const rs2::frame_source& source, const rs2::frame& f);
+        rs2::frame process_fused(const rs2::frame_source& source, const rs2::frame& f, const fused_chain& chain);
+
+        std::vector<stage>      _stages;
+        rs2::stream_profile     _source_stream_profile;     // The profile of the fused chain's input before this frame's
+        rs2::stream_profile     _target_stream_profile;
+        rs2::stream_profile     _decimated_profile;         // The profile the target was derived from
+        bool                    _stereoscopic_depth;
+        float                   _d2d_convert_factor;
+        std::vector<float>      _disparity;                 // The frame being filtered
+        std::vector<float>      _column_state;              // The spatial filter's state down every column
+        std::vector<float>      _column_previous;
+        std::vector<uint8_t>    _column_valid;
+    };
+}
@@ -0,0 +1,347 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2021 Intel Corporation. All Rights Reserved.
+
+#include "../include/librealsense2/rsutil.h"
+
+#include "depth-quality-metrics.h"
+#include "thread-pool.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <map>
+
+namespace librealsense
+{
+    // The points are summed in up to a strip of rows per processing thread, and at most this many strips
+    static const int max_strips = 8;
+    static const int min_strip_rows = 16;
+    // Analyzers are kept for this many depth profiles, the least recently used being dropped beyond
+    static const size_t max_cached_analyzers = 8;
+    // The median distance from the plane is taken from a histogram of bins this wide, centered on the plane. The
+    // bins span +-327 mm, and the median distance from a least squares plane is within about the RMS error of it
+    static const double distance_bin_mm = 0.01;
+    static const int distance_bins = 1 << 16;
+
+    float4 plane_from_moments(const double centroid[3], double xx, double xy, double xz, double yy, double yz, double zz)
+    {
+        double det_x = yy * zz - yz * yz;
+        double det_y = xx * zz - xz * xz;
+        double det_z = xx * yy - xy * xy;
+
+        double det_max = std::max({ det_x, det_y, det_z });
+        if (det_max <= 0)
+            return { 0, 0, 0, 0 };
+
+        double dir[3];
+        if (det_max == det_x)
+        {
+            dir[0] = 1;
+            dir[1] = (xz * yz - xy * zz) / det_x;
+            dir[2] = (xy * yz - xz * yy) / det_x;
+        }
+        else if (det_max == det_y)
+        {
+            dir[0] = (yz * xz - xy * zz) / det_y;
+            dir[1] = 1;
+            dir[2] = (xy * xz - yz * xx) / det_y;
+        }
+        else
+        {
+            dir[0] = (yz * xy - xz * yy) / det_z;
+            dir[1] = (xz * xy - yz * xx) / det_z;
+            dir[2] = 1;
+        }
+
+        auto length = std::sqrt(dir[0] * dir[0] + dir[1] * dir[1] + dir[2] * dir[2]);
+        for (auto& d : dir)
+            d /= length;
+        return { float(dir[0]), float(dir[1]), float(dir[2]),
+                 float(-(dir[0] * centroid[0] + dir[1] * centroid[1] + dir[2] * centroid[2])) };
+    }
+
+    void depth_quality_analyzer::accumulator::reset()
+    {
+        count = 0;
+        x = y = z = xx = xy = xz = yy = yz = zz = 0;
+        min_depth = std::numeric_limits<uint16_t>::max();
+        max_depth = 0;
+        kept = 0;
+        sq_distance = sq_disparity = 0;
+        min_bin = distance_bins;
+        max_bin = -1;
+    }
+
+    void depth_quality_analyzer::build_rays(const rs2_intrinsics& intrin, int min_x, int min_y, int max_x, int max_y)
+    {
+        int roi[4] = { min_x, min_y, max_x, max_y };
+        if (!memcmp(&_rays_intrin, &intrin, sizeof(intrin)) && !memcmp(_rays_roi, roi, sizeof(roi)))
+            return;
+
+        // Deprojection scales with depth, and is iterative with some distortion models, so it is done once for
+        // a depth of 1 and frames only scale the rays
+        _rays.resize(size_t(max_x - min_x) * (max_y - min_y));
+        for (int y = min_y, i = 0; y < max_y; ++y)
+        {
+            for (int x = min_x; x < max_x; ++x, ++i)
+            {
+                float pixel[2] = { float(x), float(y) }, point[3];
+                rs2_deproject_pixel_to_point(point, &intrin, pixel, 1.f);
+                _rays[i] = { point[0], point[1] };
+            }
+        }
+        _rays_intrin = intrin;
+        memcpy(_rays_roi, roi, sizeof(roi));
+    }
+
+    void depth_quality_analyzer::for_each_strip(const char* name, int strips, const std::function<void(accumulator&, int, int)>& body)
+    {
+        auto min_y = _rays_roi[1];
+        thread_pool::get_instance().parallel_for(name, 0, strips, 1, [&](int begin, int end)
+        {
+            for (int s = begin; s < end; ++s)
+                body(_strips[s], min_y + s * _rows / strips, min_y + (s + 1) * _rows / strips);
+        });
+    }
+
+    void depth_quality_analyzer::analyze(const uint16_t* depth, int stride, float depth_scale, const rs2_intrinsics& intrin,
+                                         const rs2_depth_quality_params& params, rs2_depth_quality_metrics& metrics)
+    {
+        memset(&metrics, 0, sizeof(metrics));
+        const int min_x = params.roi_min_x, max_x = params.roi_max_x, width = max_x - min_x;
+        build_rays(intrin, min_x, params.roi_min_y, max_x, params.roi_max_y);
+        _rows = params.roi_max_y - params.roi_min_y;
+        metrics.roi_pixels = width * _rows;
+
+        // A strip per thread, each with sums of its own, so the threads never share a point or a lock
+        int strips = std::min({ thread_pool::get_instance().get_threads() + 1, max_strips, std::max(_rows / min_strip_rows, 1) });
+        if (int(_strips.size()) < strips)
+            _strips.resize(strips);
+        bool trim = params.outlier_percent > 0;
+        for (int s = 0; s < strips; ++s)
+        {
+            _strips[s].reset();
+            if (trim)
+                _strips[s].histogram.resize(std::numeric_limits<uint16_t>::max() + 1);
+        }
+
+        // First pass: the sums the plane is fit from, and the spread of depth the outliers are cut by
+        for_each_strip("Depth Quality Plane Fit", strips, [&](accumulator& acc, int y_begin, int y_end)
+        {
+            for (int y = y_begin; y < y_end; ++y)
+            {
+                auto row = depth + size_t(y) * stride + min_x;
+                auto rays = _rays.data() + size_t(y - params.roi_min_y) * width;
+                for (int x = 0; x < width; ++x)
+                {
+                    auto raw = row[x];
+                    if (!raw)
+                        continue;
+
+                    float z = raw * depth_scale;
+                    double px = rays[x].x * z, py = rays[x].y * z;
+                    ++acc.count;
+                    acc.x += px;
+                    acc.y += py;
+                    acc.z += z;
+                    acc.xx += px * px;
+                    acc.xy += px * py;
+                    acc.xz += px * z;
+                    acc.yy += py * py;
+                    acc.yz += py * z;
+                    acc.zz += double(z) * z;
+                    acc.min_depth = std::min(acc.min_depth, raw);
+                    acc.max_depth = std::max(acc.max_depth, raw);
+                    if (trim)
+                        ++acc.histogram[raw];
+                }
+            }
+        });
+
+        accumulator total;
+        total.reset();
+        for (int s = 0; s < strips; ++s)
+        {
+            auto& acc = _strips[s];
+            total.count += acc.count;
+            total.x += acc.x; total.y += acc.y; total.z += acc.z;
+            total.xx += acc.xx; total.xy += acc.xy; total.xz += acc.xz;
+            total.yy += acc.yy; total.yz += acc.yz; total.zz += acc.zz;
+            total.min_depth = std::min(total.min_depth, acc.min_depth);
+            total.max_depth = std::max(total.max_depth, acc.max_depth);
+        }
+
+        metrics.valid_pixels = int(total.count);
+        metrics.fill_rate = metrics.roi_pixels ? 100.f * total.count / metrics.roi_pixels : 0.f;
+
+        // The outliers are the points of the lowest and the highest depths, outlier_percent of the points each;
+        // points as deep as the last one out are kept
+        uint16_t low = total.min_depth, high = total.max_depth;
+        if (trim && total.count)
+        {
+            auto outliers = uint64_t(total.count * double(params.outlier_percent) / 100.);
+            uint64_t below = 0, above = 0;
+            for (int d = total.min_depth; d <= total.max_depth; ++d)
+            {
+                for (int s = 0; s < strips; ++s)
+                    below += _strips[s].histogram[d];
+                if (below > outliers)
+                {
+                    low = uint16_t(d);
+                    break;
+                }
+            }
+            for (int d = total.max_depth; d >= total.min_depth; --d)
+            {
+                for (int s = 0; s < strips; ++s)
+                    above += _strips[s].histogram[d];
+                if (above > outliers)
+                {
+                    high = uint16_t(d);
+                    break;
+                }
+            }
+            // Only the depths seen were counted, so only they are cleared for the next frame
+            for (int s = 0; s < strips; ++s)
+                if (_strips[s].count)
+                    std::fill(_strips[s].histogram.begin() + _strips[s].min_depth, _strips[s].histogram.begin() + _strips[s].max_depth + 1, 0);
+        }
+
+        if (total.count < 3)
+            return;
+
+        double n = double(total.count);
+        double centroid[3] = { total.x / n, total.y / n, total.z / n };
+        auto p = plane_from_moments(centroid,
+            total.xx - total.x * centroid[0], total.xy - total.x * centroid[1], total.xz - total.x * centroid[2],
+            total.yy - total.y * centroid[1], total.yz - total.y * centroid[2], total.zz - total.z * centroid[2]);
+        if (p.x == 0 && p.y == 0 && p.z == 0)
+            return;
+
+        metrics.plane_fit = 1;
+        metrics.plane[0] = p.x;
+        metrics.plane[1] = p.y;
+        metrics.plane[2] = p.z;
+        metrics.plane[3] = p.w;
+        // d of the plane is the distance of the origin, the camera, from it along its normal
+        metrics.distance_mm = -p.w * 1000.f;
+        metrics.angle = float(std::acos(std::abs(p.z)) / M_PI * 180.);
+
+        // The depth of the plane along the ray through the center of the image, against the ground truth
+        if (params.ground_truth_mm > 0)
+        {
+            float pixel[2] = { intrin.width / 2.f, intrin.height / 2.f }, ray[3];
+            rs2_deproject_pixel_to_point(ray, &intrin, pixel, 1.f);
+            auto along_ray = p.x * ray[0] + p.y * ray[1] + p.z;
+            auto z = std::abs(along_ray) > 1e-6f ? -p.w / along_ray : 0.f;
+            metrics.plane_fit_to_ground_truth_mm = z * 1000.f - params.ground_truth_mm;
+        }
+
+        // Second pass: the errors of the points left against the plane, in disparity too for stereo depth
+        const double bf = params.baseline_mm / 1000. * intrin.fx;
+        const bool ground_truth = params.ground_truth_mm > 0;
+        for_each_strip("Depth Quality Errors", strips, [&](accumulator& acc, int y_begin, int y_end)
+        {
+            if (ground_truth)
+                acc.distance_histogram.resize(distance_bins);
+            for (int y = y_begin; y < y_end; ++y)
+            {
+                auto row = depth + size_t(y) * stride + min_x;
+                auto rays = _rays.data() + size_t(y - params.roi_min_y) * width;
+                for (int x = 0; x < width; ++x)
+                {
+                    auto raw = row[x];
+                    if (!raw || raw < low || raw > high)
+                        continue;
+
+                    float z = raw * depth_scale;
+                    double px = rays[x].x * z, py = rays[x].y * z;
+                    double distance = p.x * px + p.y * py + p.z * z + p.w;
+                    ++acc.kept;
+                    acc.sq_distance += distance * distance * 1e6;
+                    if (bf != 0)
+                    {
+                        // Projection of the point on the plane
+                        double ix = px - distance * p.x, iy = py - distance * p.y, iz = z - distance * p.z;
+                        double disparity = bf / std::sqrt(px * px + py * py + double(z) * z) - bf / std::sqrt(ix * ix + iy * iy + iz * iz);
+                        acc.sq_disparity += disparity * disparity;
+                    }
+                    if (ground_truth)
+                    {
+                        // Distances beyond the range count in its end bins, which leaves the median in place
+                        auto bin = int(std::floor(distance * 1000 / distance_bin_mm)) + distance_bins / 2;
+                        bin = std::min(std::max(bin, 0), distance_bins - 1);
+                        ++acc.distance_histogram[bin];
+                        acc.min_bin = std::min(acc.min_bin, bin);
+                        acc.max_bin = std::max(acc.max_bin, bin);
+                    }
+                }
+            }
+        });
+
+        for (int s = 0; s < strips; ++s)
+        {
+            auto& acc = _strips[s];
+            total.kept += acc.kept;
+            total.sq_distance += acc.sq_distance;
+            total.sq_disparity += acc.sq_disparity;
+            total.min_bin = std::min(total.min_bin, acc.min_bin);
+            total.max_bin = std::max(total.max_bin, acc.max_bin);
+        }
+
+        // The points closer to the camera than the plane are behind the ground truth by as much
+        if (ground_truth && total.kept)
+        {
+            // The median is the middle point's bin, as for the point at kept / 2 of the sorted distances
+            uint64_t below = 0;
+            for (int bin = total.min_bin; bin <= total.max_bin; ++bin)
+            {
+                for (int s = 0; s < strips; ++s)
+                    below += _strips[s].distance_histogram[bin];
+                if (below > total.kept / 2)
+                {
+                    auto median = (bin - distance_bins / 2 + 0.5) * distance_bin_mm;
+                    metrics.z_accuracy = float(100. * (metrics.plane_fit_to_ground_truth_mm + median) / params.ground_truth_mm);
+                    break;
+                }
+            }
+        }
+        // Only the bins seen were counted, so only they are cleared for the next frame
+        if (ground_truth)
+            for (int s = 0; s < strips; ++s)
+                if (_strips[s].max_bin >= 0)
+                    std::fill(_strips[s].distance_histogram.begin() + _strips[s].min_bin,
+                              _strips[s].distance_histogram.begin() + _strips[s].max_bin + 1, 0);
+        if (!total.kept)
+            return;
+
+        metrics.plane_fit_rms_error_mm = float(std::sqrt(total.sq_distance / total.kept));
+        metrics.plane_fit_rms_error = metrics.distance_mm ? 100.f * metrics.plane_fit_rms_error_mm / metrics.distance_mm : 0.f;
+        metrics.subpixel_rms_error = float(std::sqrt(total.sq_disparity / total.kept));
+    }
+
+    std::shared_ptr<depth_quality_analyzer> depth_quality_analyzer::get(int depth_profile_id)
+    {
+        static std::mutex mutex;
+        static std::map<int, std::shared_ptr<depth_quality_analyzer>> analyzers;
+        static std::vector<int> recently_used;
+
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = std::find(recently_used.begin(), recently_used.end(), depth_profile_id);
+        if (it != recently_used.end())
+            recently_used.erase(it);
+        recently_used.push_back(depth_profile_id);
+
+        auto& analyzer = analyzers[depth_profile_id];
+        if (!analyzer)
+            analyzer = std::make_shared<depth_quality_analyzer>();
+
+        if (recently_used.size() > max_cached_analyzers)
+        {
+            analyzers.erase(recently_used.front());
+            recently_used.erase(recently_used.begin());
+        }
+        return analyzer;
+    }
+}
@@ -0,0 +1,66 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2021 Intel Corporation. All Rights Reserved.
+
+#pragma once
+
+#include "types.h"
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace librealsense
+{
+    // Plane fit depth quality of a region of a depth frame facing a flat target (see rs2_analyze_depth_quality).
+    // The points of the region are never collected: strips of rows are deprojected on the processing threads into
+    // sums of their coordinates and of their products, which give the least squares plane in closed form, and a
+    // second pass sums the errors of the points against that plane.
+    class depth_quality_analyzer
+    {
+    public:
+        // stride is in pixels; the rays of the region's pixels are kept for the next frames of the same intrinsics
+        void analyze(const uint16_t* depth, int stride, float depth_scale, const rs2_intrinsics& intrin,
+                     const rs2_depth_quality_params& params, rs2_depth_quality_metrics& metrics);
+
+        std::mutex& get_mutex() { return _mutex; }
+
+        // Analyzer shared by all callers rating frames of this depth profile
+        static std::shared_ptr<depth_quality_analyzer> get(int depth_profile_id);
+
+    private:
+        // Sums over the points of a strip of rows, merged once every strip is done
+        struct accumulator
+        {
+            uint64_t count;
+            double x, y, z, xx, xy, xz, yy, yz, zz;
+            uint16_t min_depth, max_depth;
+            std::vector<uint32_t> histogram;    // points per raw depth, zero outside [min_depth, max_depth]
+
+            uint64_t kept;                      // points left once the outliers are out
+            double sq_distance;                 // of the kept points from the plane, in mm
+            double sq_disparity;                // disparity errors, in pixels
+            std::vector<uint32_t> distance_histogram;   // kept points per bin of distance from the plane, when there
+            int min_bin, max_bin;                       // is a ground truth; zero outside [min_bin, max_bin]
+
+            void reset();
+        };
+
+        void build_rays(const rs2_intrinsics& intrin, int min_x, int min_y, int max_x, int max_y);
+        void for_each_strip(const char* name, int strips, const std::function<void(accumulator&, int, int)>& body);
+
+        std::mutex _mutex;
+
+        rs2_intrinsics _rays_intrin = {};
+        int _rays_roi[4] = {};
+        std::vector<float2> _rays;              // per pixel of the region, its point at a depth of 1
+
+        int _rows = 0;
+        std::vector<accumulator> _strips;
+    };
+
+    // The plane a*x + b*y + c*z + d = 0, as (a, b, c, d), that fits points best by least squares, from their centroid
+    // and the sums of the products of their coordinates about it; (a, b, c) is of unit length, or all zero when the
+    // points do not span a plane. Follows http://www.ilikebigbits.com/blog/2015/3/2/plane-from-points
+    float4 plane_from_moments(const double centroid[3], double xx, double xy, double xz, double yy, double yz, double zz);
+}
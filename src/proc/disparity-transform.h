@@ -48,6 +48,8 @@ namespace librealsense
         }
 
     private:
+        friend class depth_postprocess;
+
         void    update_transformation_profile(const rs2::frame& f);
 
         void    on_set_mode(bool to_disparity);
@@ -75,6 +77,12 @@ namespace librealsense
         };
 
         static info update_info_from_frame(const rs2::frame& f)
+        {
+            return update_info_from_frame(f, f.get_profile());
+        }
+
+        // The same, for a frame of the given profile that was derived from f, whose sensor it shares
+        static info update_info_from_frame(const rs2::frame& f, const rs2::stream_profile& profile)
         {
             // Check if the new frame originated from stereo-based depth sensor
             // and retrieve the stereo baseline parameter that will be used in transformations
@@ -107,7 +115,7 @@ namespace librealsense
 
             if (info.stereoscopic_depth)
             {
-                auto vp = f.get_profile().as<rs2::video_stream_profile>();
+                auto vp = profile.as<rs2::video_stream_profile>();
                 auto focal_lenght_mm = vp.get_intrinsics().fx;
                 const uint8_t fractional_bits = 5;
                 const uint8_t fractions = 1 << fractional_bits;
@@ -2,14 +2,23 @@
 // Copyright(c) 2020 Intel Corporation. All Rights Reserved.
 
 #include "hdr-merge.h"
+#include "simd/unpack-kernels.h"
+#include "thread-pool.h"
 
 namespace librealsense
 {
     hdr_merge::hdr_merge()
         : generic_processing_block("HDR Merge"),
         _previous_depth_frame_counter(0),
-        _frames_without_requested_metadata_counter(0)
-    {}
+        _frames_without_requested_metadata_counter(0),
+        _sequence_size(2.f),
+        _collected(0),
+        _depth_merged_frame_counter(0)
+    {
+        auto sequence_size = std::make_shared<ptr_option<float>>(2.f, float(MAX_SEQUENCE_SIZE), 1.f, 2.f,
+            &_sequence_size, "Number of HDR sequence entries merged into one depth frame. Must match the sequence size streamed by the device");
+        register_option(RS2_OPTION_SEQUENCE_SIZE, sequence_size);
+    }
 
     // processing only framesets
     bool hdr_merge::should_process(const rs2::frame& frame)
@@ -42,7 +51,7 @@ namespace librealsense
         }
 
         auto depth_seq_size = depth_frame.get_frame_metadata(RS2_FRAME_METADATA_SEQUENCE_SIZE);
-        if (depth_seq_size != 2)
+        if (depth_seq_size != static_cast<int>(_sequence_size))
             return false;
 
         return true;
@@ -63,75 +72,77 @@ namespace librealsense
     {
         // steps:
         // 1. get depth frame from incoming frameset
-        // 2. add the frameset to vector of framesets
-        // 3. check if size of this vector is at least 2 (if not - return latest merge frame)
-        // 4. pop out both framesets from the vector
-        // 5. apply merge algo
-        // 6. save merge frame as latest merge frame
-        // 7. return the merge frame
+        // 2. store the frameset in the slot of its sequence id
+        // 3. check if the whole sequence was collected (if not - return latest merge frame)
+        // 4. apply merge algo
+        // 5. save merge frame as latest merge frame and release the sequence
+        // 6. return the merge frame
 
         // 1. get depth frame from incoming frameset
         auto fs = f.as<rs2::frameset>();
         auto depth_frame = fs.get_depth_frame();
-
-        // 2. add the frameset to vector of framesets
-        auto depth_seq_id = depth_frame.get_frame_metadata(RS2_FRAME_METADATA_SEQUENCE_ID);
-
-        // condition added to ensure that frames are saved in the right order
-        // to prevent for example the saving of frame with sequence id 1 before
-        // saving frame of sequence id 0
-        // so that the merging with be deterministic - always done with frame n and n+1
-        // with frame n as basis
-        if (_framesets.size() == depth_seq_id)
+        auto depth_seq_id = static_cast<int>(depth_frame.get_frame_metadata(RS2_FRAME_METADATA_SEQUENCE_ID));
+        auto frame_counter = depth_frame.get_frame_metadata(RS2_FRAME_METADATA_FRAME_COUNTER);
+        auto sequence_size = static_cast<int>(_sequence_size);
+
+        // 2. store the frameset in the slot of its sequence id
+        // framesets are only collected in order, so that the merging is deterministic - always done
+        // with frames n to n+size-1 with frame n as basis; the start of a new sequence drops whatever
+        // was collected of the previous one
+        if (depth_seq_id == 0)
+            _collected = 0;
+        if (depth_seq_id == _collected && _collected < sequence_size)
         {
-            _framesets[(int)depth_seq_id] = fs;
+            auto& entry = _sequence[_collected++];
+            entry.frames = fs;
+            entry.depth = depth_frame;
+            entry.ir = fs.get_infrared_frame();
+            entry.frame_counter = frame_counter;
         }
 
         // discard merged frame if not relevant
-        discard_depth_merged_frame_if_needed(f);
+        discard_depth_merged_frame_if_needed(f, frame_counter);
 
-        // 3. check if size of this vector is at least 2 (if not - return latest merge frame)
-        if (_framesets.size() >= 2)
+        // 3. check if the whole sequence was collected (if not - return latest merge frame)
+        if (_collected >= sequence_size)
         {
-            // 4. pop out both framesets from the vector
-            rs2::frameset fs_0 = _framesets[0];
-            rs2::frameset fs_1 = _framesets[1];
-            _framesets.clear();
-
             bool use_ir = false;
-            if (check_frames_mergeability(fs_0, fs_1, use_ir))
+            if (check_frames_mergeability(use_ir))
             {
-                // 5. apply merge algo
-                rs2::frame new_frame = merging_algorithm(source, fs_0, fs_1, use_ir);
+                // 4. apply merge algo
+                rs2::frame new_frame = merging_algorithm(source, use_ir);
                 if (new_frame)
                 {
-                    // 6. save merge frame as latest merge frame
+                    // 5. save merge frame as latest merge frame
                     _depth_merged_frame = new_frame;
+                    _depth_merged_frame_counter = _sequence[0].frame_counter;
                 }
             }
+
+            // the collected frames go back to their pools right away
+            for (auto& entry : _sequence)
+                entry = sequence_entry();
+            _collected = 0;
         }
 
-        // 7. return the merge frame
+        // 6. return the merge frame
         if (_depth_merged_frame)
             return _depth_merged_frame;
 
         return f;
     }
 
-    void hdr_merge::discard_depth_merged_frame_if_needed(const rs2::frame& f)
+    void hdr_merge::discard_depth_merged_frame_if_needed(const rs2::frame& f, rs2_metadata_type frame_counter)
     {
         if (_depth_merged_frame)
         {
             // criteria for discarding saved merged_depth_frame:
             // 1 - frame counter for merged depth is greater than the input frame
             // 2 - resolution change
-            auto depth_merged_frame_counter = _depth_merged_frame.get_frame_metadata(RS2_FRAME_METADATA_FRAME_COUNTER);
-            auto input_frame_counter = f.get_frame_metadata(RS2_FRAME_METADATA_FRAME_COUNTER);
-
             auto merged_d_profile = _depth_merged_frame.get_profile().as<rs2::video_stream_profile>();
             auto new_d_profile = f.get_profile().as<rs2::video_stream_profile>();
 
-            bool restart_pipe_detected = (depth_merged_frame_counter > input_frame_counter);
+            bool restart_pipe_detected = (_depth_merged_frame_counter > frame_counter);
             bool resolution_change_detected = (merged_d_profile.width() != new_d_profile.width()) ||
                 (merged_d_profile.height() != new_d_profile.height());
 
@@ -142,156 +153,113 @@ namespace librealsense
         }
     }
 
-    bool hdr_merge::check_frames_mergeability(const rs2::frameset first_fs, const rs2::frameset second_fs,
-        bool& use_ir) const
+    bool hdr_merge::check_frames_mergeability(bool& use_ir) const
     {
-        auto first_depth = first_fs.get_depth_frame();
-        auto second_depth = second_fs.get_depth_frame();
-        auto first_ir = first_fs.get_infrared_frame();
-        auto second_ir = second_fs.get_infrared_frame();
-
-        auto first_fs_frame_counter = first_depth.get_frame_metadata(RS2_FRAME_METADATA_FRAME_COUNTER);
-        auto second_fs_frame_counter = second_depth.get_frame_metadata(RS2_FRAME_METADATA_FRAME_COUNTER);
-
-        // The aim of this checking is that the output merged frame will have frame counter n and
-        // frame counter n and will be created by frames n and n+1
-        if (first_fs_frame_counter + 1 != second_fs_frame_counter)
-            return false;
-        // Depth dimensions must align
-        if ((first_depth.get_height() != second_depth.get_height()) ||
-            (first_depth.get_width() != second_depth.get_width()))
-            return false;
+        auto& first = _sequence[0];
+        for (int i = 1; i < _collected; i++)
+        {
+            auto& entry = _sequence[i];
+
+            // The aim of this checking is that the output merged frame will have frame counter n and
+            // will be created by frames n to n+size-1
+            if (_sequence[i - 1].frame_counter + 1 != entry.frame_counter)
+                return false;
+            // Depth dimensions must align
+            if ((first.depth.get_height() != entry.depth.get_height()) ||
+                (first.depth.get_width() != entry.depth.get_width()))
+                return false;
+        }
 
-        use_ir = should_ir_be_used_for_merging(first_depth, first_ir, second_depth, second_ir);
+        use_ir = should_ir_be_used_for_merging();
 
         return true;
     }
 
-    rs2::frame hdr_merge::merging_algorithm(const rs2::frame_source& source, const rs2::frameset first_fs, const rs2::frameset second_fs, const bool use_ir) const
+    rs2::frame hdr_merge::merging_algorithm(const rs2::frame_source& source, const bool use_ir) const
     {
-        auto first = first_fs;
-        auto second = second_fs;
-
-        auto first_depth = first.get_depth_frame();
-        auto second_depth = second.get_depth_frame();
-        auto first_ir = first.get_infrared_frame();
-        auto second_ir = second.get_infrared_frame();
+        auto first_depth = _sequence[0].depth;
 
         // new frame allocation
-        auto vf = first_depth.as<rs2::depth_frame>();
-        auto width = vf.get_width();
-        auto height = vf.get_height();
+        auto width = first_depth.get_width();
+        auto height = first_depth.get_height();
         auto new_f = source.allocate_video_frame(first_depth.get_profile(), first_depth,
-            vf.get_bytes_per_pixel(), width, height, vf.get_stride_in_bytes(), RS2_EXTENSION_DEPTH_FRAME);
-
-        if (new_f)
-        {
-            auto ptr = dynamic_cast<librealsense::depth_frame*>((librealsense::frame_interface*)new_f.get());
-            auto orig = dynamic_cast<librealsense::depth_frame*>((librealsense::frame_interface*)first_depth.get());
+            first_depth.get_bytes_per_pixel(), width, height, first_depth.get_stride_in_bytes(), RS2_EXTENSION_DEPTH_FRAME);
 
-            auto d0 = (uint16_t*)first_depth.get_data();
-            auto d1 = (uint16_t*)second_depth.get_data();
+        if (!new_f)
+            return _sequence[0].frames;
 
-            auto new_data = (uint16_t*)ptr->get_frame_data();
+        auto ptr = dynamic_cast<librealsense::depth_frame*>((librealsense::frame_interface*)new_f.get());
+        auto orig = dynamic_cast<librealsense::depth_frame*>((librealsense::frame_interface*)first_depth.get());
+        ptr->set_sensor(orig->get_sensor());
 
-            ptr->set_sensor(orig->get_sensor());
+        auto new_data = (uint16_t*)ptr->get_frame_data();
 
-            memset(new_data, 0, width * height * sizeof(uint16_t));
+        // IR formats other than Y8 and Y16 fall back to merging by depth only
+        auto ir_format = use_ir ? _sequence[0].ir.get_profile().format() : RS2_FORMAT_ANY;
+        const uint16_t* depth[MAX_SEQUENCE_SIZE];
+        const void* ir[MAX_SEQUENCE_SIZE];
+        for (int i = 0; i < _collected; i++)
+        {
+            depth[i] = (const uint16_t*)_sequence[i].depth.get_data();
+            ir[i] = use_ir ? _sequence[i].ir.get_data() : nullptr;
+        }
 
-            int width_height_product = width * height;
+        // The image is merged in strips of rows, each strip going through all the entries while it
+        // is still in cache; a pixel keeps the depth of the first entry that has a valid one
+        auto& kernels = get_unpack_kernels();
+        const int entries = _collected;
 
-            if (use_ir)
+        parallel_for_rows("HDR Merge", height, [&](int y_begin, int y_end)
+        {
+            int begin = y_begin * width;
+            int count = (y_end - y_begin) * width;
+            auto out = new_data + begin;
+            std::fill(out, out + count, uint16_t(0));
+            for (int i = 0; i < entries; i++)
             {
-                if (first_ir.get_profile().format() == RS2_FORMAT_Y8)
-                {
-                    merge_frames_using_ir<uint8_t>(new_data, d0, d1, first_ir, second_ir, width_height_product);
-                }
-                else if (first_ir.get_profile().format() == RS2_FORMAT_Y16)
-                {
-                    merge_frames_using_ir<uint16_t>(new_data, d0, d1, first_ir, second_ir, width_height_product);
-                }
+                if (ir_format == RS2_FORMAT_Y8)
+                    kernels.hdr_merge_depth_ir8(out, depth[i] + begin, (const uint8_t*)ir[i] + begin, count);
+                else if (ir_format == RS2_FORMAT_Y16)
+                    kernels.hdr_merge_depth_ir16(out, depth[i] + begin, (const uint16_t*)ir[i] + begin, count);
                 else
-                {
-                    merge_frames_using_only_depth(new_data, d0, d1, width_height_product);
-                }
-            }
-            else
-            {
-                merge_frames_using_only_depth(new_data, d0, d1, width_height_product);
+                    kernels.hdr_merge_depth(out, depth[i] + begin, count);
             }
+        });
 
-            return new_f;
-        }
-        return first_fs;
+        return new_f;
     }
 
-    void hdr_merge::merge_frames_using_only_depth(uint16_t* new_data, uint16_t* d0, uint16_t* d1, int width_height_prod) const
+    bool hdr_merge::should_ir_be_used_for_merging() const
     {
-        for (int i = 0; i < width_height_prod; i++)
+        auto& first = _sequence[0];
+        for (int i = 0; i < _collected; i++)
         {
-            if (d0[i])
-                new_data[i] = d0[i];
-            else if (d1[i])
-                new_data[i] = d1[i];
-            else
-                new_data[i] = 0;
-        }
-    }
+            auto& entry = _sequence[i];
 
-    bool hdr_merge::should_ir_be_used_for_merging(const rs2::depth_frame& first_depth, const rs2::video_frame& first_ir,
-        const rs2::depth_frame& second_depth, const rs2::video_frame& second_ir) const
-    {
-        // checking ir frames are not null
-        bool use_ir = (first_ir && second_ir);
+            // checking ir frames are not null
+            if (!entry.ir)
+                return false;
 
-        if (use_ir)
-        {
             // IR and Depth dimensions must be aligned
-            if ((first_depth.get_height() != first_ir.get_height()) ||
-                (first_depth.get_width() != first_ir.get_width()) ||
-                (second_ir.get_height() != first_ir.get_height()) ||
-                (second_ir.get_width() != first_ir.get_width()))
-                use_ir = false;
+            if ((entry.depth.get_height() != entry.ir.get_height()) ||
+                (entry.depth.get_width() != entry.ir.get_width()))
+                return false;
+
+            // checking frame counter of depth and ir are the same
+            auto ir_frame_counter = entry.ir.get_frame_metadata(RS2_FRAME_METADATA_FRAME_COUNTER);
+            if (entry.frame_counter != ir_frame_counter)
+                return false;
+
+            // checking sequence id of depth and ir are the same - the depth one is the slot index
+            auto ir_seq_id = entry.ir.get_frame_metadata(RS2_FRAME_METADATA_SEQUENCE_ID);
+            if (ir_seq_id != i)
+                return false;
+
+            // checking all ir have the same format
+            if (entry.ir.get_profile().format() != first.ir.get_profile().format())
+                return false;
         }
 
-        // checking frame counter of first depth and ir are the same
-        if (use_ir)
-        {
-            int depth_frame_counter = static_cast<int>(first_depth.get_frame_metadata(RS2_FRAME_METADATA_FRAME_COUNTER));
-            int ir_frame_counter = static_cast<int>(first_ir.get_frame_metadata(RS2_FRAME_METADATA_FRAME_COUNTER));
-            use_ir = (depth_frame_counter == ir_frame_counter);
-
-            // checking frame counter of second depth and ir are the same
-            if (use_ir)
-            {
-                depth_frame_counter = static_cast<int>(second_depth.get_frame_metadata(RS2_FRAME_METADATA_FRAME_COUNTER));
-                ir_frame_counter = static_cast<int>(second_ir.get_frame_metadata(RS2_FRAME_METADATA_FRAME_COUNTER));
-                use_ir = (depth_frame_counter == ir_frame_counter);
-
-                // checking sequence id of first depth and ir are the same
-                if (use_ir)
-                {
-                    auto depth_seq_id = first_depth.get_frame_metadata(RS2_FRAME_METADATA_SEQUENCE_ID);
-                    auto ir_seq_id = first_ir.get_frame_metadata(RS2_FRAME_METADATA_SEQUENCE_ID);
-                    use_ir = (depth_seq_id == ir_seq_id);
-
-                    // checking sequence id of second depth and ir are the same
-                    if (use_ir)
-                    {
-                        depth_seq_id = second_depth.get_frame_metadata(RS2_FRAME_METADATA_SEQUENCE_ID);
-                        ir_seq_id = second_ir.get_frame_metadata(RS2_FRAME_METADATA_SEQUENCE_ID);
-                        use_ir = (depth_seq_id == ir_seq_id);
-
-                        // checking both ir have the same format
-                        if (use_ir)
-                        {
-                            use_ir = (first_ir.get_profile().format() == second_ir.get_profile().format());
-                        }
-                    }
-                }
-            }
-        }
-
-        return use_ir;
+        return true;
     }
 }
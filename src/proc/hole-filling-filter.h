@@ -157,6 +157,7 @@ namespace librealsense
         }
 
     private:
+        friend class depth_postprocess;
 
         size_t                  _width, _height, _stride;
         size_t                  _bpp;
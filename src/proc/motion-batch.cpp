@@ -0,0 +1,82 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2021 Intel Corporation. All Rights Reserved.
+
+#include "motion-batch.h"
+
+#ifdef __SSSE3__
+#include <tmmintrin.h> // For SSE3 intrinsic used in calibrate_motion_samples
+#endif
+
+namespace librealsense
+{
+    size_t motion_batch::data_size(uint32_t capacity)
+    {
+        return sizeof(header) + capacity * (sizeof(double) + 3 * sizeof(float));
+    }
+
+    void motion_batch::reset(uint32_t capacity)
+    {
+        auto h = get_header();
+        h->latest = { 0, 0, 0 };
+        h->count = 0;
+        h->capacity = capacity;
+        h->reserved = 0;
+    }
+
+    void motion_batch::append(double timestamp, const float3& sample)
+    {
+        auto i = get_header()->count++;
+        timestamps()[i] = timestamp;
+        x()[i] = sample.x;
+        y()[i] = sample.y;
+        z()[i] = sample.z;
+        latest() = sample;
+    }
+
+    void motion_batch::copy_layout(const motion_batch& other)
+    {
+        if (other.capacity() != capacity())
+            throw invalid_value_exception("motion batches of different capacities");
+        get_header()->count = other.count();
+        std::copy(other.timestamps(), other.timestamps() + other.count(), timestamps());
+    }
+
+    bool is_motion_batch(const frame_interface* f)
+    {
+        auto fr = dynamic_cast<const frame*>(f);
+        return fr && fr->additional_data.is_motion_batch;
+    }
+
+    void calibrate_motion_samples(const float3x3& m, const float3& bias,
+        const float* x, const float* y, const float* z,
+        float* out_x, float* out_y, float* out_z, uint32_t count)
+    {
+        uint32_t i = 0;
+#ifdef __SSSE3__
+        // Four samples per iteration, one matrix element broadcast per register
+        const __m128 m00 = _mm_set1_ps(m.x.x), m01 = _mm_set1_ps(m.y.x), m02 = _mm_set1_ps(m.z.x);
+        const __m128 m10 = _mm_set1_ps(m.x.y), m11 = _mm_set1_ps(m.y.y), m12 = _mm_set1_ps(m.z.y);
+        const __m128 m20 = _mm_set1_ps(m.x.z), m21 = _mm_set1_ps(m.y.z), m22 = _mm_set1_ps(m.z.z);
+        const __m128 bx = _mm_set1_ps(bias.x), by = _mm_set1_ps(bias.y), bz = _mm_set1_ps(bias.z);
+        for (; i + 4 <= count; i += 4)
+        {
+            auto vx = _mm_loadu_ps(x + i);
+            auto vy = _mm_loadu_ps(y + i);
+            auto vz = _mm_loadu_ps(z + i);
+            auto rx = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m00, vx), _mm_mul_ps(m01, vy)), _mm_mul_ps(m02, vz));
+            auto ry = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m10, vx), _mm_mul_ps(m11, vy)), _mm_mul_ps(m12, vz));
+            auto rz = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m20, vx), _mm_mul_ps(m21, vy)), _mm_mul_ps(m22, vz));
+            _mm_storeu_ps(out_x + i, _mm_sub_ps(rx, bx));
+            _mm_storeu_ps(out_y + i, _mm_sub_ps(ry, by));
+            _mm_storeu_ps(out_z + i, _mm_sub_ps(rz, bz));
+        }
+#endif
+        for (; i < count; ++i)
+        {
+            auto r = m * float3{ x[i], y[i], z[i] } - bias;
+            out_x[i] = r.x;
+            out_y[i] = r.y;
+            out_z[i] = r.z;
+        }
+    }
+}
@@ -0,0 +1,69 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2021 Intel Corporation. All Rights Reserved.
+
+#pragma once
+
+#include "../archive.h"
+
+namespace librealsense
+{
+    // Data of a motion frame carrying a batch of accel/gyro samples (see RS2_OPTION_MOTION_BATCH_SIZE).
+    // The latest sample comes first, so the frame still reads as a regular XYZ motion frame, followed
+    // by the sample count and the samples themselves as separate timestamp, x, y and z arrays.
+    // Raw batches hold the sensor counts as floats, converted batches hold m/s^2 or rad/s.
+    class motion_batch
+    {
+    public:
+        // Frame data size needed for a batch of up to capacity samples
+        static size_t data_size(uint32_t capacity);
+
+        // Wraps existing frame data; the data must stay alive while the object is used
+        explicit motion_batch(byte* data) : _data(data) {}
+        explicit motion_batch(const byte* data) : _data(const_cast<byte*>(data)) {}
+
+        // Starts an empty batch
+        void reset(uint32_t capacity);
+        // Appends a sample, the caller makes sure the batch is not full
+        void append(double timestamp, const float3& sample);
+        // Copies the count and the timestamps of another batch of the same capacity
+        void copy_layout(const motion_batch& other);
+
+        uint32_t count() const { return get_header()->count; }
+        uint32_t capacity() const { return get_header()->capacity; }
+        bool full() const { return count() == capacity(); }
+
+        float3& latest() { return get_header()->latest; }
+        double* timestamps() { return reinterpret_cast<double*>(_data + sizeof(header)); }
+        float* x() { return reinterpret_cast<float*>(timestamps() + capacity()); }
+        float* y() { return x() + capacity(); }
+        float* z() { return y() + capacity(); }
+
+        const double* timestamps() const { return const_cast<motion_batch*>(this)->timestamps(); }
+        const float* x() const { return const_cast<motion_batch*>(this)->x(); }
+        const float* y() const { return const_cast<motion_batch*>(this)->y(); }
+        const float* z() const { return const_cast<motion_batch*>(this)->z(); }
+
+    private:
+        // 24 bytes, so the timestamps that follow stay 8-byte aligned
+        struct header
+        {
+            float3 latest;
+            uint32_t count;
+            uint32_t capacity;
+            uint32_t reserved;
+        };
+
+        header* get_header() const { return reinterpret_cast<header*>(_data); }
+
+        byte* _data;
+    };
+
+    // True for the motion frames produced while RS2_OPTION_MOTION_BATCH_SIZE is set
+    bool is_motion_batch(const frame_interface* f);
+
+    // out = m * in - bias for count samples held as separate x, y and z arrays, which lets the
+    // whole batch go through the vector unit; the output arrays may be the input ones
+    void calibrate_motion_samples(const float3x3& m, const float3& bias,
+        const float* x, const float* y, const float* z,
+        float* out_x, float* out_y, float* out_z, uint32_t count);
+}
@@ -5,9 +5,19 @@
 #include "ds5/ds5-motion.h"
 #include "synthetic-stream.h"
 #include "motion-transform.h"
+#include "motion-batch.h"
 
 namespace librealsense
 {
+    // The Accelerometer input format: signed int 16bit. data units 1LSB=0.001g;
+    // Librealsense output format: floating point 32bit. units m/s^2,
+    static constexpr float gravity = 9.80665f;          // Standard Gravitation Acceleration
+    static constexpr double accelerator_transform_factor = 0.001*gravity;
+
+    // The Gyro input format: signed int 16bit. data units 1LSB=0.1deg/sec;
+    // Librealsense output format: floating point 32bit. units rad/sec,
+    static const double gyro_transform_factor = deg2rad(0.1);
+
     template<rs2_format FORMAT> void copy_hid_axes(byte * const dest[], const byte * source, double factor)
     {
         using namespace librealsense;
@@ -18,22 +28,13 @@ namespace librealsense
         librealsense::copy(dest[0], &res, sizeof(float3));
     }
 
-    // The Accelerometer input format: signed int 16bit. data units 1LSB=0.001g;
-    // Librealsense output format: floating point 32bit. units m/s^2,
     template<rs2_format FORMAT> void unpack_accel_axes(byte * const dest[], const byte * source, int width, int height, int output_size)
     {
-        static constexpr float gravity = 9.80665f;          // Standard Gravitation Acceleration
-        static constexpr double accelerator_transform_factor = 0.001*gravity;
-
         copy_hid_axes<FORMAT>(dest, source, accelerator_transform_factor);
     }
 
-    // The Gyro input format: signed int 16bit. data units 1LSB=0.1deg/sec;
-    // Librealsense output format: floating point 32bit. units rad/sec,
     template<rs2_format FORMAT> void unpack_gyro_axes(byte * const dest[], const byte * source, int width, int height, int output_size)
     {
-        static const double gyro_transform_factor = deg2rad(0.1);
-
         copy_hid_axes<FORMAT>(dest, source, gyro_transform_factor);
     }
 
@@ -43,9 +44,9 @@ namespace librealsense
     {}
 
     motion_transform::motion_transform(const char* name, rs2_format target_format, rs2_stream target_stream,
-        std::shared_ptr<mm_calib_handler> mm_calib, std::shared_ptr<enable_motion_correction> mm_correct_opt)
+        std::shared_ptr<mm_calib_handler> mm_calib, std::shared_ptr<enable_motion_correction> mm_correct_opt, float raw_to_units)
         : functional_processing_block(name, target_format, target_stream, RS2_EXTENSION_MOTION_FRAME),
-        _mm_correct_opt(mm_correct_opt)
+        _mm_correct_opt(mm_correct_opt), _raw_to_units(raw_to_units)
     {
         if (mm_calib)
         {
@@ -68,6 +69,9 @@ namespace librealsense
 
     rs2::frame motion_transform::process_frame(const rs2::frame_source& source, const rs2::frame& f)
     {
+        if (is_motion_batch((frame_interface*)f.get()))
+            return process_batch(source, f);
+
         auto&& ret = functional_processing_block::process_frame(source, f);
         correct_motion(&ret);
 
@@ -97,12 +101,48 @@ namespace librealsense
         }
     }
 
+    rs2::frame motion_transform::process_batch(const rs2::frame_source& source, const rs2::frame& f)
+    {
+        auto&& ret = prepare_frame(source, f);
+        motion_batch in((const byte*)f.get_data());
+        motion_batch out((byte*)ret.get_data());
+        out.reset(in.capacity());
+        out.copy_layout(in);
+
+        // Unit conversion, alignment and calibration folded into one matrix for the whole batch
+        float3x3 m = _imu2depth_cs_alignment_matrix;
+        m.x = m.x * _raw_to_units;
+        m.y = m.y * _raw_to_units;
+        m.z = m.z * _raw_to_units;
+        float3 bias{ 0, 0, 0 };
+        if (_mm_correct_opt && _mm_correct_opt->query() > 0.f)
+        {
+            auto&& s = ret.get_profile().stream_type();
+            if (s == RS2_STREAM_ACCEL)
+            {
+                m = _accel_sensitivity * m;
+                bias = _accel_bias;
+            }
+            if (s == RS2_STREAM_GYRO)
+            {
+                m = _gyro_sensitivity * m;
+                bias = _gyro_bias;
+            }
+        }
+
+        calibrate_motion_samples(m, bias, in.x(), in.y(), in.z(), out.x(), out.y(), out.z(), in.count());
+        if (auto n = out.count())
+            out.latest() = { out.x()[n - 1], out.y()[n - 1], out.z()[n - 1] };
+
+        return ret;
+    }
+
     acceleration_transform::acceleration_transform(std::shared_ptr<mm_calib_handler> mm_calib, std::shared_ptr<enable_motion_correction> mm_correct_opt)
         : acceleration_transform("Acceleration Transform", mm_calib, mm_correct_opt)
     {}
 
     acceleration_transform::acceleration_transform(const char * name, std::shared_ptr<mm_calib_handler> mm_calib, std::shared_ptr<enable_motion_correction> mm_correct_opt)
-        : motion_transform(name, RS2_FORMAT_MOTION_XYZ32F, RS2_STREAM_ACCEL, mm_calib, mm_correct_opt)
+        : motion_transform(name, RS2_FORMAT_MOTION_XYZ32F, RS2_STREAM_ACCEL, mm_calib, mm_correct_opt, float(accelerator_transform_factor))
     {}
 
     void acceleration_transform::process_function(byte * const dest[], const byte * source, int width, int height, int output_size, int actual_size)
@@ -115,7 +155,7 @@ namespace librealsense
     {}
 
     gyroscope_transform::gyroscope_transform(const char * name, std::shared_ptr<mm_calib_handler> mm_calib, std::shared_ptr<enable_motion_correction> mm_correct_opt)
-        : motion_transform(name, RS2_FORMAT_MOTION_XYZ32F, RS2_STREAM_GYRO, mm_calib, mm_correct_opt)
+        : motion_transform(name, RS2_FORMAT_MOTION_XYZ32F, RS2_STREAM_GYRO, mm_calib, mm_correct_opt, float(gyro_transform_factor))
     {}
 
     void gyroscope_transform::process_function(byte * const dest[], const byte * source, int width, int height, int output_size, int actual_size)
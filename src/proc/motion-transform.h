@@ -17,15 +17,20 @@ namespace librealsense
             std::shared_ptr<enable_motion_correction> mm_correct_opt = nullptr);
 
     protected:
+        // raw_to_units is the factor from the raw sensor counts to the output units, applied to batched samples
         motion_transform(const char* name, rs2_format target_format, rs2_stream target_stream,
             std::shared_ptr<mm_calib_handler> mm_calib,
-            std::shared_ptr<enable_motion_correction> mm_correct_opt);
+            std::shared_ptr<enable_motion_correction> mm_correct_opt,
+            float raw_to_units = 1.f);
         rs2::frame process_frame(const rs2::frame_source& source, const rs2::frame& f) override;
 
     private:
         void correct_motion(rs2::frame* f);
+        // Converts all the samples of a batched frame in one pass, see motion-batch.h
+        rs2::frame process_batch(const rs2::frame_source& source, const rs2::frame& f);
 
         std::shared_ptr<enable_motion_correction> _mm_correct_opt = nullptr;
+        float               _raw_to_units;
         float3x3            _accel_sensitivity;
         float3              _accel_bias;
         float3x3            _gyro_sensitivity;
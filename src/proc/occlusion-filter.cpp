@@ -5,9 +5,11 @@
 #include "../include/librealsense2/rsutil.h"
 #include "proc/synthetic-stream.h"
 #include "proc/occlusion-filter.h"
+#include "thread-pool.h"
 //#include  "../../common/tiny-profiler.h"
 #include <vector>
 #include <cmath>
+#include <algorithm>
 
 
 namespace librealsense
@@ -62,49 +64,6 @@ namespace librealsense
            }
 
        return res;
-   }
-   template<size_t SIZE>
-   void rotate_image_optimized(byte* dest[], const byte* source, int width, int height)
-   {
-
-       auto width_out = height;
-       auto height_out = width;
-
-       auto out = dest[0];
-       auto buffer_size = maxDivisorRange(height, width, 1, ROTATION_BUFFER_SIZE); 
-
-       byte** buffer = new byte * [buffer_size];
-       for (int i = 0; i < buffer_size; ++i)
-           buffer[i] = new byte[buffer_size * SIZE];
-
-
-       for (int i = 0; i <= height - buffer_size; i = i + buffer_size)
-       {
-           for (int j = 0; j <= width - buffer_size; j = j + buffer_size)
-           {
-               for (int ii = 0; ii < buffer_size; ++ii)
-               {
-                   for (int jj = 0; jj < buffer_size; ++jj)
-                   {
-                       auto source_index = ((j + jj) + (width * (i + ii))) * SIZE;
-                       memcpy((void*)&(buffer[(buffer_size-1 - jj)][(buffer_size-1 - ii) * SIZE]), &source[source_index], SIZE);
-                   }
-               }
-
-               for (int ii = 0; ii < buffer_size; ++ii)
-               {
-                   auto out_index = (((height_out - buffer_size - j + 1) * width_out) - i - buffer_size + (ii)*width_out);
-                   memcpy(&out[(out_index)*SIZE], (buffer[ii]), buffer_size * SIZE);
-               }
-           }
-       }
-
-       for (int i = 0; i < buffer_size; ++i)
-       {
-           delete[] buffer[i];
-       }
-       delete[] buffer;
- 
    }
     // IMPORTANT! This implementation is based on the assumption that the RGB sensor is positioned strictly to the left of the depth sensor.
     // namely D415/D435 and SR300. The implementation WILL NOT work properly for different setups
@@ -120,100 +79,88 @@ namespace librealsense
        int occDilationSz = 1;
        auto points_width = _depth_intrinsics->width;
        auto points_height = _depth_intrinsics->height;
-       auto pixels_ptr = pix_coord.data();
-       auto points_ptr = points;
-       auto uv_map_ptr = uv_map;
-       float maxInLine = -1;
-       float maxZ = 0;
 
        if (_occlusion_scanning == horizontal)
        {
-           for( int y = 0; y < points_height; ++y )
+           // Lines are independent of each other
+           parallel_for_rows("Occlusion Filter", points_height, [&](int y_begin, int y_end)
            {
-               maxInLine = -1;
-               maxZ = 0;
-               int occDilationLeft = 0;
-
-               for(int x = 0; x < points_width; ++x )
+               for( int y = y_begin; y < y_end; ++y )
                {
-                   if( points_ptr->z )
+                   auto pixels_ptr = pix_coord.data() + y * points_width;
+                   auto points_ptr = points + y * points_width;
+                   float maxInLine = -1;
+                   float maxZ = 0;
+                   int occDilationLeft = 0;
+
+                   for(int x = 0; x < points_width; ++x )
                    {
-                       // Occlusion detection
-                       if( pixels_ptr->x < maxInLine
-                           || ( pixels_ptr->x == maxInLine && ( points_ptr->z - maxZ ) > occZTh ) )
+                       if( points_ptr->z )
                        {
-                           *points_ptr = { 0, 0, 0 };
-                           occDilationLeft = occDilationSz;
-                       }
-                       else
-                       {
-                           maxInLine = pixels_ptr->x;
-                           maxZ = points_ptr->z;
-                           if( occDilationLeft > 0 )
+                           // Occlusion detection
+                           if( pixels_ptr->x < maxInLine
+                               || ( pixels_ptr->x == maxInLine && ( points_ptr->z - maxZ ) > occZTh ) )
                            {
                                *points_ptr = { 0, 0, 0 };
-                               occDilationLeft--;
+                               occDilationLeft = occDilationSz;
+                           }
+                           else
+                           {
+                               maxInLine = pixels_ptr->x;
+                               maxZ = points_ptr->z;
+                               if( occDilationLeft > 0 )
+                               {
+                                   *points_ptr = { 0, 0, 0 };
+                                   occDilationLeft--;
+                               }
                            }
                        }
+                       ++points_ptr;
+                       ++pixels_ptr;
                    }
-                   ++points_ptr;
-                   ++uv_map_ptr;
-                   ++pixels_ptr;
                }
-           }
+           });
        }
        else if (_occlusion_scanning == vertical)
        {
-           auto rotated_depth_width = _depth_intrinsics->height;
-           auto rotated_depth_height = _depth_intrinsics->width;
-           auto depth_ptr = (byte*)(depth.get_data());
-           std::vector< byte > alloc( depth.get_bytes_per_pixel() * points_width * points_height );
-           byte* depth_planes[1];
-           depth_planes[0] = alloc.data();
-
-           rotate_image_optimized<2>(depth_planes, (const byte*)(depth.get_data()), points_width, points_height);
-
-           // scan depth frame after rotation: check if there is a noticed jump between adjacen pixels in Z-axis (depth), it means there could be occlusion.
-           // save suspected points and run occlusion-invalidation vertical scan only on them
-           // after rotation : height = points_width , width = points_height
-           for (int i = 0; i < rotated_depth_height; i++)
+           // Scan the depth frame in place, top to bottom: a noticeable jump in Z between a pixel and the one above it
+           // means there could be occlusion, and only the points below such a jump are checked.
+           // Columns are processed in strips so each strip owns the points it invalidates and reads whole cache lines.
+           auto depth_ptr = (const uint16_t*)(depth.get_data());
+           float scaled_threshold = DEPTH_OCCLUSION_THRESHOLD / _depth_units;
+           auto scan_win_size = maxDivisorRange(points_width, points_height, 1, VERTICAL_SCAN_WINDOW_SIZE);
+           const int strip_width = 64;
+
+           thread_pool::get_instance().parallel_for("Occlusion Filter", 0, points_width, strip_width, [&](int x_begin, int x_end)
            {
-               for (int j = 0; j < rotated_depth_width; j++)
+               // The first line has no pixel above it, and the window must fit in the frame
+               for (int y = 1; y < points_height - scan_win_size; y++)
                {
-                   // before depth frame rotation: occlusion detected in the positive direction of Y
-                   // after rotation : scan from right to left (positive direction of X) to detect occlusion
-                   // compare depth each pixel only with the pixel on its right (i,j+1)
-                   auto index = (j + (rotated_depth_width * i));
-                   auto uv_index = ((rotated_depth_height - i - 1) + (rotated_depth_width - j - 1) * rotated_depth_height);
-                   auto index_right = index + 1;
-                   uint16_t* diff_depth_ptr = (uint16_t*)depth_planes[0];
-                   uint16_t diff_right = abs((uint16_t)(*(diff_depth_ptr + index)) - (uint16_t)(*(diff_depth_ptr + index_right)));
-                   float scaled_threshold = DEPTH_OCCLUSION_THRESHOLD / _depth_units;
-                   if (diff_right > scaled_threshold)
+                   auto depth_line = depth_ptr + y * points_width;
+                   auto depth_above = depth_line - points_width;
+                   for (int x = x_begin; x < x_end; x++)
                    {
-                       points_ptr = points + uv_index;
-                       uv_map_ptr = uv_map + uv_index;
-                       auto scan_win_size = maxDivisorRange(rotated_depth_height, rotated_depth_width, 1, VERTICAL_SCAN_WINDOW_SIZE);
-
-                       if (j >= scan_win_size) {
-                           maxInLine = (uv_map_ptr - 1 * points_width)->y;
-                           for (int y = 0; y <= scan_win_size; ++y)
+                       uint16_t diff_above = abs(depth_line[x] - depth_above[x]);
+                       if (diff_above > scaled_threshold)
+                       {
+                           auto index = y * points_width + x;
+                           float maxInLine = uv_map[index - points_width].y;
+                           for (int i = 0; i <= scan_win_size; ++i)
                            {
-                               if (((uv_map_ptr + y * points_width)->y < maxInLine))
+                               auto scan_index = index + i * points_width;
+                               if (uv_map[scan_index].y < maxInLine)
                                {
-                                   *(points_ptr + y * points_width) = { 0.f, 0.f };
+                                   points[scan_index] = { 0.f, 0.f, 0.f };
                                }
                                else
                                {
                                    break;
                                }
-
                            }
-
                        }
                    }
                }
-           }
+           });
        }
    }
     // Prepare texture map without occlusion that for every texture coordinate there no more than one depth point that is mapped to it
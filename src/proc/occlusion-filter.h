@@ -5,7 +5,6 @@
 #include <librealsense2/hpp/rs_frame.hpp>
 #include "rotation-transform.h"
 
-#define ROTATION_BUFFER_SIZE 32 // minimum limit that could be divided by all resolutions
 #define VERTICAL_SCAN_WINDOW_SIZE 16
 #define DEPTH_OCCLUSION_THRESHOLD 0.5f //meters
 
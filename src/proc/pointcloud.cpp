@@ -12,6 +12,8 @@
 #include "../device.h"
 #include "../stream.h"
 #include <iostream>
+#include <algorithm>
+#include <cmath>
 #include "device-calibration.h"
 
 #ifdef RS2_USE_CUDA
@@ -251,6 +253,27 @@ namespace librealsense
 
     rs2::frame pointcloud::process_depth_frame(const rs2::frame_source& source, const rs2::depth_frame& depth)
     {
+        rs2_intrinsics mapped_intr = {};
+        rs2_extrinsics extr = {};
+        // Read once, as the options may change while the frame is processed
+        auto layout = static_cast<rs2_points_layout>(_points_layout);
+        auto texture = static_cast<compact_texture_coordinates>(_texture_coordinates);
+        bool map_texture = false;
+        {
+            // Compact points without texture coordinates skip the mapping altogether
+            bool texture_wanted = layout == RS2_POINTS_LAYOUT_FULL || texture != texture_coordinates_none;
+            if (texture_wanted && _extrinsics && _other_intrinsics)
+            {
+                mapped_intr = *_other_intrinsics;
+                extr = *_extrinsics;
+                map_texture = true;
+            }
+        }
+
+        // The occlusion filter works on the full grid of points and texture coordinates
+        if (layout != RS2_POINTS_LAYOUT_FULL && !(map_texture && run__occlusion_filter(extr)))
+            return make_compact_points(depth, layout, map_texture ? texture : texture_coordinates_none, mapped_intr, extr);
+
         auto res = allocate_points(source, depth);
         auto pframe = (librealsense::points*)(res.get());
 
@@ -260,17 +283,6 @@ namespace librealsense
 
         // Pixels calculated in the mapped texture. Used in post-processing filters
         float2* pixels_ptr = _pixels_map.data();
-        rs2_intrinsics mapped_intr;
-        rs2_extrinsics extr;
-        bool map_texture = false;
-        {
-            if (_extrinsics && _other_intrinsics)
-            {
-                mapped_intr = *_other_intrinsics;
-                extr = *_extrinsics;
-                map_texture = true;
-            }
-        }
 
         if (map_texture)
         {
@@ -289,6 +301,85 @@ namespace librealsense
                 _occlusion_filter->process(pframe->get_vertices(), pframe->get_texture_coordinates(), _pixels_map, depth);
             }
         }
+
+        if (layout != RS2_POINTS_LAYOUT_FULL)
+        {
+            // The full points are only the input of the packing: return them to the pool right away
+            auto compact = pack_compact_points(res, layout, map_texture ? texture : texture_coordinates_none);
+            res = rs2::points();
+            return compact;
+        }
+        return res;
+    }
+
+    rs2::frame pointcloud::make_compact_points(const rs2::depth_frame& depth, rs2_points_layout layout, compact_texture_coordinates texture,
+        const rs2_intrinsics& other_intrinsics, const rs2_extrinsics& extr)
+    {
+        const auto& intrin = *_depth_intrinsics;
+        auto width = uint32_t(intrin.width);
+        auto height = uint32_t(intrin.height);
+        auto pixels = size_t(width) * height;
+        auto depth_data = static_cast<const uint16_t*>(depth.get_data());
+        auto depth_scale = *_depth_units;
+        auto deproject = [&](size_t i) {
+            const float pixel[] = { float(i % width), float(i / width) };
+            float3 point;
+            rs2_deproject_pixel_to_point(&point.x, &intrin, pixel, depth_scale * depth_data[i]);
+            return point;
+        };
+
+        // Count the points first, to write them straight into a frame of their size. Int16 points also need the
+        // farthest component for their unit
+        uint32_t count = 0;
+        float farthest = 0.f;
+        for (size_t i = 0; i < pixels; ++i)
+        {
+            if (!depth_data[i])
+                continue;
+            ++count;
+            if (layout == RS2_POINTS_LAYOUT_INT16)
+            {
+                auto v = deproject(i);
+                farthest = std::max({ farthest, std::fabs(v.x), std::fabs(v.y), std::fabs(v.z) });
+            }
+        }
+
+        auto profile = std::dynamic_pointer_cast<stream_profile_interface>(
+            _output_stream.get()->profile->shared_from_this());
+        rs2::frame res{ (rs2_frame*)_source_wrapper.allocate_compact_points(profile, (frame_interface*)depth.get(),
+            compact_points::data_size(layout, texture, count, width, height)) };
+        compact_points points(const_cast<byte*>(static_cast<const byte*>(res.get_data())));
+        points.begin(layout, texture, width, height, count, compact_points::get_int16_scale(farthest));
+
+        uint32_t n = 0;
+        for (size_t i = 0; i < pixels; ++i)
+        {
+            if (!depth_data[i])
+                continue;
+            auto v = deproject(i);
+            float2 uv = { 0.f, 0.f };
+            if (texture != texture_coordinates_none)
+                uv = pixel_to_texcoord(&other_intrinsics, project(&other_intrinsics, transform(&extr, v)));
+            points.set_point(n++, i, v, uv);
+        }
+        return res;
+    }
+
+    rs2::frame pointcloud::pack_compact_points(const rs2::points& points, rs2_points_layout layout, compact_texture_coordinates texture)
+    {
+        auto width = uint32_t(_depth_intrinsics->width);
+        auto height = uint32_t(_depth_intrinsics->height);
+
+        auto vertices = reinterpret_cast<const float3*>(points.get_vertices());
+        auto texcoords = texture != texture_coordinates_none ? reinterpret_cast<const float2*>(points.get_texture_coordinates()) : nullptr;
+        auto count = compact_points::count_valid(vertices, size_t(width) * height);
+
+        auto profile = std::dynamic_pointer_cast<stream_profile_interface>(
+            _output_stream.get()->profile->shared_from_this());
+        rs2::frame res{ (rs2_frame*)_source_wrapper.allocate_compact_points(profile, (frame_interface*)points.get(),
+            compact_points::data_size(layout, texture, count, width, height)) };
+        auto data = const_cast<byte*>(static_cast<const byte*>(res.get_data()));
+        compact_points(data).pack(layout, texture, width, height, count, vertices, texcoords);
         return res;
     }
 
@@ -319,6 +410,27 @@ namespace librealsense
         occlusion_invalidation->set_description(1.f, "Off");
         occlusion_invalidation->set_description(2.f, "On");
         register_option(RS2_OPTION_FILTER_MAGNITUDE, occlusion_invalidation);
+
+        _points_layout = RS2_POINTS_LAYOUT_FULL;
+        auto points_layout = std::make_shared<ptr_option<int>>(
+            RS2_POINTS_LAYOUT_FULL, RS2_POINTS_LAYOUT_COUNT - 1, 1, RS2_POINTS_LAYOUT_FULL, &_points_layout,
+            "Points layout. Compact layouts compute the points with depth straight into a frame of their size. Texture "
+            "coordinates mapped while occlusion removal is on, as it is by default, need the full grid: those points are "
+            "still computed into a full points frame, and packed from it");
+        points_layout->set_description(RS2_POINTS_LAYOUT_FULL, "Full");
+        points_layout->set_description(RS2_POINTS_LAYOUT_FLOAT32, "Valid Float32");
+        points_layout->set_description(RS2_POINTS_LAYOUT_FLOAT16, "Valid Float16");
+        points_layout->set_description(RS2_POINTS_LAYOUT_INT16, "Valid Int16");
+        register_option(RS2_OPTION_POINTS_LAYOUT, points_layout);
+
+        _texture_coordinates = texture_coordinates_float32;
+        auto texture_coordinates = std::make_shared<ptr_option<int>>(
+            texture_coordinates_none, texture_coordinates_count - 1, 1, texture_coordinates_float32, &_texture_coordinates,
+            "Texture coordinates of compact points");
+        texture_coordinates->set_description(texture_coordinates_none, "None");
+        texture_coordinates->set_description(texture_coordinates_float32, "Float32");
+        texture_coordinates->set_description(texture_coordinates_uint16, "UInt16");
+        register_option(RS2_OPTION_POINTS_TEXTURE_COORDINATES, texture_coordinates);
     }
 
     bool pointcloud::should_process(const rs2::frame& frame)
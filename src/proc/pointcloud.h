@@ -3,6 +3,7 @@
 
 #pragma once
 #include "synthetic-stream.h"
+#include "compact-points.h"
 
 namespace librealsense
 {
@@ -54,9 +55,18 @@ namespace librealsense
         void inspect_depth_frame(const rs2::frame& depth);
         void inspect_other_frame(const rs2::frame& other);
         rs2::frame process_depth_frame(const rs2::frame_source& source, const rs2::depth_frame& depth);
+        // Computes the points with depth of the depth frame into a frame of the selected compact layout; the
+        // intrinsics and extrinsics of the texture are only used when the points have texture coordinates
+        rs2::frame make_compact_points(const rs2::depth_frame& depth, rs2_points_layout layout, compact_texture_coordinates texture,
+            const rs2_intrinsics& other_intrinsics, const rs2_extrinsics& extr);
+        // Packs the points with depth of full points into a frame of the selected compact layout
+        rs2::frame pack_compact_points(const rs2::points& points, rs2_points_layout layout, compact_texture_coordinates texture);
         void set_extrinsics();
 
         stream_filter _prev_stream_filter;
         std::shared_ptr< pointcloud > _registered_auto_calib_cb;
+
+        int _points_layout;
+        int _texture_coordinates;
     };
 }
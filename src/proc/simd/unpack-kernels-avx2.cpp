@@ -0,0 +1,186 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2021 Intel Corporation. All Rights Reserved.
+
+// Compiled with AVX2 code generation enabled: keep this file free of anything that could be
+// inlined into, or shared with, code running on CPUs without it.
+
+#include "unpack-kernels.h"
+
+#ifdef __AVX2__
+#include <immintrin.h>
+
+namespace librealsense
+{
+    namespace simd
+    {
+        static inline __m256i load_lanes(const uint8_t* lo, const uint8_t* hi)
+        {
+            return _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128((const __m128i*)lo)),
+                                           _mm_loadu_si128((const __m128i*)hi), 1);
+        }
+
+        static void split_y8i_avx2(const uint8_t* src, uint8_t* left, uint8_t* right, int count)
+        {
+            const __m256i deinterleave = _mm256_setr_epi8(0, 2, 4, 6, 8, 10, 12, 14, 1, 3, 5, 7, 9, 11, 13, 15,
+                                                          0, 2, 4, 6, 8, 10, 12, 14, 1, 3, 5, 7, 9, 11, 13, 15);
+            int i = 0;
+            for (; i + 32 <= count; i += 32)
+            {
+                __m256i a = _mm256_shuffle_epi8(_mm256_loadu_si256((const __m256i*)(src + 2 * i)), deinterleave);
+                __m256i b = _mm256_shuffle_epi8(_mm256_loadu_si256((const __m256i*)(src + 2 * i + 32)), deinterleave);
+                // Unpacking works within 128-bit lanes, so the quadwords come out as 0, 2, 1, 3
+                __m256i l = _mm256_permute4x64_epi64(_mm256_unpacklo_epi64(a, b), _MM_SHUFFLE(3, 1, 2, 0));
+                __m256i r = _mm256_permute4x64_epi64(_mm256_unpackhi_epi64(a, b), _MM_SHUFFLE(3, 1, 2, 0));
+                _mm256_storeu_si256((__m256i*)(left + i), l);
+                _mm256_storeu_si256((__m256i*)(right + i), r);
+            }
+            split_y8i_scalar(src + 2 * i, left + i, right + i, count - i);
+        }
+
+        static void split_y12i_avx2(const uint8_t* src, uint16_t* left, uint16_t* right, int count)
+        {
+            const __m256i gather = _mm256_setr_epi8(0, 1, 3, 4, 6, 7, 9, 10, 1, 2, 4, 5, 7, 8, 10, 11,
+                                                    0, 1, 3, 4, 6, 7, 9, 10, 1, 2, 4, 5, 7, 8, 10, 11);
+            const __m256i low12 = _mm256_set1_epi16(0x0fff);
+            int i = 0;
+            // Four pixels per 128-bit load, arranged so each lane ends up holding 8 consecutive pixels;
+            // each iteration reads 52 bytes for 16 pixels
+            for (; i + 18 <= count; i += 16)
+            {
+                auto p = src + 3 * i;
+                __m256i a = _mm256_shuffle_epi8(load_lanes(p, p + 24), gather);
+                __m256i b = _mm256_shuffle_epi8(load_lanes(p + 12, p + 36), gather);
+                __m256i r = _mm256_and_si256(_mm256_unpacklo_epi64(a, b), low12);
+                __m256i l = _mm256_srli_epi16(_mm256_unpackhi_epi64(a, b), 4);
+                _mm256_storeu_si256((__m256i*)(left + i), _mm256_or_si256(_mm256_slli_epi16(l, 6), _mm256_srli_epi16(l, 4)));
+                _mm256_storeu_si256((__m256i*)(right + i), _mm256_or_si256(_mm256_slli_epi16(r, 6), _mm256_srli_epi16(r, 4)));
+            }
+            split_y12i_scalar(src + 3 * i, left + i, right + i, count - i);
+        }
+
+        static void expand_y10_to_y16_avx2(const uint16_t* src, uint16_t* dst, int count)
+        {
+            int i = 0;
+            for (; i + 16 <= count; i += 16)
+                _mm256_storeu_si256((__m256i*)(dst + i), _mm256_slli_epi16(_mm256_loadu_si256((const __m256i*)(src + i)), 6));
+            expand_y10_to_y16_scalar(src + i, dst + i, count - i);
+        }
+
+        static void narrow_y10_to_y8_avx2(const uint16_t* src, uint8_t* dst, int count)
+        {
+            const __m256i low8 = _mm256_set1_epi16(0x00ff);
+            int i = 0;
+            for (; i + 32 <= count; i += 32)
+            {
+                __m256i a = _mm256_and_si256(_mm256_srli_epi16(_mm256_loadu_si256((const __m256i*)(src + i)), 2), low8);
+                __m256i b = _mm256_and_si256(_mm256_srli_epi16(_mm256_loadu_si256((const __m256i*)(src + i + 16)), 2), low8);
+                __m256i packed = _mm256_permute4x64_epi64(_mm256_packus_epi16(a, b), _MM_SHUFFLE(3, 1, 2, 0));
+                _mm256_storeu_si256((__m256i*)(dst + i), packed);
+            }
+            narrow_y10_to_y8_scalar(src + i, dst + i, count - i);
+        }
+
+        static void unpack_y10bpack_avx2(const uint8_t* src, uint16_t* dst, int count)
+        {
+            const __m256i gather = _mm256_setr_epi8(4, 0, 4, 1, 4, 2, 4, 3, 9, 5, 9, 6, 9, 7, 9, 8,
+                                                    4, 0, 4, 1, 4, 2, 4, 3, 9, 5, 9, 6, 9, 7, 9, 8);
+            const __m256i lsb_shift = _mm256_setr_epi16(64, 16, 4, 1, 64, 16, 4, 1, 64, 16, 4, 1, 64, 16, 4, 1);
+            const __m256i high = _mm256_set1_epi16(int16_t(0xff00));
+            const __m256i low8 = _mm256_set1_epi16(0x00ff);
+            const __m256i lsb_bits = _mm256_set1_epi16(0x00c0);
+            const int total = count / 4 * 5;
+            int i = 0;
+            // Each iteration reads 26 bytes for 16 pixels (20 bytes)
+            for (; i / 4 * 5 + 26 <= total; i += 16)
+            {
+                auto p = src + i / 4 * 5;
+                __m256i v = _mm256_shuffle_epi8(load_lanes(p, p + 10), gather);
+                __m256i lsb = _mm256_and_si256(_mm256_mullo_epi16(_mm256_and_si256(v, low8), lsb_shift), lsb_bits);
+                _mm256_storeu_si256((__m256i*)(dst + i), _mm256_or_si256(_mm256_and_si256(v, high), lsb));
+            }
+            unpack_y10bpack_scalar(src + i / 4 * 5, dst + i, count - i);
+        }
+
+        // Same scheme as the SSE4.1 kernels, 16 pixels at a time
+        static inline __m256i hdr_merge_step(__m256i out, __m256i depth, __m256i valid)
+        {
+            __m256i take = _mm256_and_si256(_mm256_cmpeq_epi16(out, _mm256_setzero_si256()), valid);
+            return _mm256_or_si256(out, _mm256_and_si256(depth, take));
+        }
+
+        static inline __m256i ir_in_range(__m256i ir, __m256i low, __m256i high)
+        {
+            return _mm256_and_si256(_mm256_cmpgt_epi16(ir, low), _mm256_cmpgt_epi16(high, ir));
+        }
+
+        static void hdr_merge_depth_avx2(uint16_t* out, const uint16_t* depth, int count)
+        {
+            const __m256i all = _mm256_set1_epi16(-1);
+            int i = 0;
+            for (; i + 16 <= count; i += 16)
+            {
+                __m256i o = _mm256_loadu_si256((const __m256i*)(out + i));
+                __m256i d = _mm256_loadu_si256((const __m256i*)(depth + i));
+                _mm256_storeu_si256((__m256i*)(out + i), hdr_merge_step(o, d, all));
+            }
+            hdr_merge_depth_scalar(out + i, depth + i, count - i);
+        }
+
+        static void hdr_merge_depth_ir8_avx2(uint16_t* out, const uint16_t* depth, const uint8_t* ir, int count)
+        {
+            const __m256i low = _mm256_set1_epi16(5), high = _mm256_set1_epi16(250);
+            int i = 0;
+            for (; i + 16 <= count; i += 16)
+            {
+                __m256i o = _mm256_loadu_si256((const __m256i*)(out + i));
+                __m256i d = _mm256_loadu_si256((const __m256i*)(depth + i));
+                __m256i v = _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i*)(ir + i)));
+                _mm256_storeu_si256((__m256i*)(out + i), hdr_merge_step(o, d, ir_in_range(v, low, high)));
+            }
+            hdr_merge_depth_ir8_scalar(out + i, depth + i, ir + i, count - i);
+        }
+
+        static void hdr_merge_depth_ir16_avx2(uint16_t* out, const uint16_t* depth, const uint16_t* ir, int count)
+        {
+            const __m256i low = _mm256_set1_epi16(20), high = _mm256_set1_epi16(1003);
+            int i = 0;
+            for (; i + 16 <= count; i += 16)
+            {
+                __m256i o = _mm256_loadu_si256((const __m256i*)(out + i));
+                __m256i d = _mm256_loadu_si256((const __m256i*)(depth + i));
+                __m256i v = _mm256_loadu_si256((const __m256i*)(ir + i));
+                _mm256_storeu_si256((__m256i*)(out + i), hdr_merge_step(o, d, ir_in_range(v, low, high)));
+            }
+            hdr_merge_depth_ir16_scalar(out + i, depth + i, ir + i, count - i);
+        }
+
+        static const unpack_kernels avx2_kernels = {
+            simd_level::avx2,
+            split_y8i_avx2,
+            split_y12i_avx2,
+            expand_y10_to_y16_avx2,
+            narrow_y10_to_y8_avx2,
+            unpack_y10bpack_avx2,
+            rotate_8_sse41,
+            rotate_16_sse41,
+            rotate_confidence_sse41,
+            hdr_merge_depth_avx2,
+            hdr_merge_depth_ir8_avx2,
+            hdr_merge_depth_ir16_avx2,
+        };
+
+        const unpack_kernels* avx2_unpack_kernels() { return &avx2_kernels; }
+    }
+}
+
+#else
+
+namespace librealsense
+{
+    namespace simd
+    {
+        const unpack_kernels* avx2_unpack_kernels() { return nullptr; }
+    }
+}
+
+#endif
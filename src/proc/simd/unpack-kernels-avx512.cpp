@@ -0,0 +1,170 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2021 Intel Corporation. All Rights Reserved.
+
+// Compiled with AVX-512 (F + BW) code generation enabled: keep this file free of anything that
+// could be inlined into, or shared with, code running on CPUs without it.
+
+#include "unpack-kernels.h"
+
+#if defined(__AVX512F__) && defined(__AVX512BW__)
+#include <immintrin.h>
+
+namespace librealsense
+{
+    namespace simd
+    {
+        static inline __m512i load_lanes(const uint8_t* p0, const uint8_t* p1, const uint8_t* p2, const uint8_t* p3)
+        {
+            __m512i v = _mm512_castsi128_si512(_mm_loadu_si128((const __m128i*)p0));
+            v = _mm512_inserti32x4(v, _mm_loadu_si128((const __m128i*)p1), 1);
+            v = _mm512_inserti32x4(v, _mm_loadu_si128((const __m128i*)p2), 2);
+            return _mm512_inserti32x4(v, _mm_loadu_si128((const __m128i*)p3), 3);
+        }
+
+        static inline __m512i per_lane(__m128i v) { return _mm512_broadcast_i32x4(v); }
+
+        static void split_y8i_avx512(const uint8_t* src, uint8_t* left, uint8_t* right, int count)
+        {
+            const __m512i deinterleave = per_lane(_mm_setr_epi8(0, 2, 4, 6, 8, 10, 12, 14, 1, 3, 5, 7, 9, 11, 13, 15));
+            // After the in-lane shuffle even quadwords hold left pixels and odd ones right pixels
+            const __m512i even = _mm512_set_epi64(14, 12, 10, 8, 6, 4, 2, 0);
+            const __m512i odd = _mm512_set_epi64(15, 13, 11, 9, 7, 5, 3, 1);
+            int i = 0;
+            for (; i + 64 <= count; i += 64)
+            {
+                __m512i a = _mm512_shuffle_epi8(_mm512_loadu_si512(src + 2 * i), deinterleave);
+                __m512i b = _mm512_shuffle_epi8(_mm512_loadu_si512(src + 2 * i + 64), deinterleave);
+                _mm512_storeu_si512(left + i, _mm512_permutex2var_epi64(a, even, b));
+                _mm512_storeu_si512(right + i, _mm512_permutex2var_epi64(a, odd, b));
+            }
+            split_y8i_scalar(src + 2 * i, left + i, right + i, count - i);
+        }
+
+        static void split_y12i_avx512(const uint8_t* src, uint16_t* left, uint16_t* right, int count)
+        {
+            const __m512i gather = per_lane(_mm_setr_epi8(0, 1, 3, 4, 6, 7, 9, 10, 1, 2, 4, 5, 7, 8, 10, 11));
+            const __m512i low12 = _mm512_set1_epi16(0x0fff);
+            int i = 0;
+            // Four pixels per 128-bit load, arranged so each lane ends up holding 8 consecutive pixels;
+            // each iteration reads 100 bytes for 32 pixels
+            for (; i + 34 <= count; i += 32)
+            {
+                auto p = src + 3 * i;
+                __m512i a = _mm512_shuffle_epi8(load_lanes(p, p + 24, p + 48, p + 72), gather);
+                __m512i b = _mm512_shuffle_epi8(load_lanes(p + 12, p + 36, p + 60, p + 84), gather);
+                __m512i r = _mm512_and_si512(_mm512_unpacklo_epi64(a, b), low12);
+                __m512i l = _mm512_srli_epi16(_mm512_unpackhi_epi64(a, b), 4);
+                _mm512_storeu_si512(left + i, _mm512_or_si512(_mm512_slli_epi16(l, 6), _mm512_srli_epi16(l, 4)));
+                _mm512_storeu_si512(right + i, _mm512_or_si512(_mm512_slli_epi16(r, 6), _mm512_srli_epi16(r, 4)));
+            }
+            split_y12i_scalar(src + 3 * i, left + i, right + i, count - i);
+        }
+
+        static void expand_y10_to_y16_avx512(const uint16_t* src, uint16_t* dst, int count)
+        {
+            int i = 0;
+            for (; i + 32 <= count; i += 32)
+                _mm512_storeu_si512(dst + i, _mm512_slli_epi16(_mm512_loadu_si512(src + i), 6));
+            expand_y10_to_y16_scalar(src + i, dst + i, count - i);
+        }
+
+        static void narrow_y10_to_y8_avx512(const uint16_t* src, uint8_t* dst, int count)
+        {
+            // The word-to-byte conversion truncates, exactly like the scalar cast
+            int i = 0;
+            for (; i + 32 <= count; i += 32)
+                _mm256_storeu_si256((__m256i*)(dst + i), _mm512_cvtepi16_epi8(_mm512_srli_epi16(_mm512_loadu_si512(src + i), 2)));
+            narrow_y10_to_y8_scalar(src + i, dst + i, count - i);
+        }
+
+        static void unpack_y10bpack_avx512(const uint8_t* src, uint16_t* dst, int count)
+        {
+            const __m512i gather = per_lane(_mm_setr_epi8(4, 0, 4, 1, 4, 2, 4, 3, 9, 5, 9, 6, 9, 7, 9, 8));
+            const __m512i lsb_shift = per_lane(_mm_setr_epi16(64, 16, 4, 1, 64, 16, 4, 1));
+            const __m512i high = _mm512_set1_epi16(int16_t(0xff00));
+            const __m512i low8 = _mm512_set1_epi16(0x00ff);
+            const __m512i lsb_bits = _mm512_set1_epi16(0x00c0);
+            const int total = count / 4 * 5;
+            int i = 0;
+            // Each iteration reads 46 bytes for 32 pixels (40 bytes)
+            for (; i / 4 * 5 + 46 <= total; i += 32)
+            {
+                auto p = src + i / 4 * 5;
+                __m512i v = _mm512_shuffle_epi8(load_lanes(p, p + 10, p + 20, p + 30), gather);
+                __m512i lsb = _mm512_and_si512(_mm512_mullo_epi16(_mm512_and_si512(v, low8), lsb_shift), lsb_bits);
+                _mm512_storeu_si512(dst + i, _mm512_or_si512(_mm512_and_si512(v, high), lsb));
+            }
+            unpack_y10bpack_scalar(src + i / 4 * 5, dst + i, count - i);
+        }
+
+        // 32 pixels at a time; the comparisons give bit masks, so the merge is a masked move
+        static void hdr_merge_depth_avx512(uint16_t* out, const uint16_t* depth, int count)
+        {
+            int i = 0;
+            for (; i + 32 <= count; i += 32)
+            {
+                __m512i o = _mm512_loadu_si512(out + i);
+                __mmask32 empty = _mm512_testn_epi16_mask(o, o);
+                _mm512_mask_storeu_epi16(out + i, empty, _mm512_loadu_si512(depth + i));
+            }
+            hdr_merge_depth_scalar(out + i, depth + i, count - i);
+        }
+
+        static void hdr_merge_depth_ir8_avx512(uint16_t* out, const uint16_t* depth, const uint8_t* ir, int count)
+        {
+            const __m512i low = _mm512_set1_epi16(5), high = _mm512_set1_epi16(250);
+            int i = 0;
+            for (; i + 32 <= count; i += 32)
+            {
+                __m512i o = _mm512_loadu_si512(out + i);
+                __m512i v = _mm512_cvtepu8_epi16(_mm256_loadu_si256((const __m256i*)(ir + i)));
+                __mmask32 take = _mm512_testn_epi16_mask(o, o) & _mm512_cmpgt_epu16_mask(v, low) & _mm512_cmplt_epu16_mask(v, high);
+                _mm512_mask_storeu_epi16(out + i, take, _mm512_loadu_si512(depth + i));
+            }
+            hdr_merge_depth_ir8_scalar(out + i, depth + i, ir + i, count - i);
+        }
+
+        static void hdr_merge_depth_ir16_avx512(uint16_t* out, const uint16_t* depth, const uint16_t* ir, int count)
+        {
+            const __m512i low = _mm512_set1_epi16(20), high = _mm512_set1_epi16(1003);
+            int i = 0;
+            for (; i + 32 <= count; i += 32)
+            {
+                __m512i o = _mm512_loadu_si512(out + i);
+                __m512i v = _mm512_loadu_si512(ir + i);
+                __mmask32 take = _mm512_testn_epi16_mask(o, o) & _mm512_cmpgt_epu16_mask(v, low) & _mm512_cmplt_epu16_mask(v, high);
+                _mm512_mask_storeu_epi16(out + i, take, _mm512_loadu_si512(depth + i));
+            }
+            hdr_merge_depth_ir16_scalar(out + i, depth + i, ir + i, count - i);
+        }
+
+        static const unpack_kernels avx512_kernels = {
+            simd_level::avx512,
+            split_y8i_avx512,
+            split_y12i_avx512,
+            expand_y10_to_y16_avx512,
+            narrow_y10_to_y8_avx512,
+            unpack_y10bpack_avx512,
+            rotate_8_sse41,
+            rotate_16_sse41,
+            rotate_confidence_sse41,
+            hdr_merge_depth_avx512,
+            hdr_merge_depth_ir8_avx512,
+            hdr_merge_depth_ir16_avx512,
+        };
+
+        const unpack_kernels* avx512_unpack_kernels() { return &avx512_kernels; }
+    }
+}
+
+#else
+
+namespace librealsense
+{
+    namespace simd
+    {
+        const unpack_kernels* avx512_unpack_kernels() { return nullptr; }
+    }
+}
+
+#endif
@@ -0,0 +1,166 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2021 Intel Corporation. All Rights Reserved.
+
+#include "unpack-kernels.h"
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+
+namespace librealsense
+{
+    namespace simd
+    {
+        static void split_y8i_neon(const uint8_t* src, uint8_t* left, uint8_t* right, int count)
+        {
+            int i = 0;
+            for (; i + 16 <= count; i += 16)
+            {
+                uint8x16x2_t v = vld2q_u8(src + 2 * i);
+                vst1q_u8(left + i, v.val[0]);
+                vst1q_u8(right + i, v.val[1]);
+            }
+            split_y8i_scalar(src + 2 * i, left + i, right + i, count - i);
+        }
+
+        static inline uint16x8_t expand_y12(uint16x8_t v)
+        {
+            return vorrq_u16(vshlq_n_u16(v, 6), vshrq_n_u16(v, 4));
+        }
+
+        static void split_y12i_neon(const uint8_t* src, uint16_t* left, uint16_t* right, int count)
+        {
+            int i = 0;
+            for (; i + 16 <= count; i += 16)
+            {
+                // De-interleave the 3 bytes of 16 pixels, then rebuild the 12-bit words
+                uint8x16x3_t v = vld3q_u8(src + 3 * i);
+                uint8x16_t r_high = vandq_u8(v.val[1], vdupq_n_u8(0x0f));
+                uint8x16_t l_low = vshrq_n_u8(v.val[1], 4);
+
+                uint16x8_t r0 = vorrq_u16(vmovl_u8(vget_low_u8(v.val[0])), vshlq_n_u16(vmovl_u8(vget_low_u8(r_high)), 8));
+                uint16x8_t r1 = vorrq_u16(vmovl_u8(vget_high_u8(v.val[0])), vshlq_n_u16(vmovl_u8(vget_high_u8(r_high)), 8));
+                uint16x8_t l0 = vorrq_u16(vshlq_n_u16(vmovl_u8(vget_low_u8(v.val[2])), 4), vmovl_u8(vget_low_u8(l_low)));
+                uint16x8_t l1 = vorrq_u16(vshlq_n_u16(vmovl_u8(vget_high_u8(v.val[2])), 4), vmovl_u8(vget_high_u8(l_low)));
+
+                vst1q_u16(left + i, expand_y12(l0));
+                vst1q_u16(left + i + 8, expand_y12(l1));
+                vst1q_u16(right + i, expand_y12(r0));
+                vst1q_u16(right + i + 8, expand_y12(r1));
+            }
+            split_y12i_scalar(src + 3 * i, left + i, right + i, count - i);
+        }
+
+        static void expand_y10_to_y16_neon(const uint16_t* src, uint16_t* dst, int count)
+        {
+            int i = 0;
+            for (; i + 8 <= count; i += 8)
+                vst1q_u16(dst + i, vshlq_n_u16(vld1q_u16(src + i), 6));
+            expand_y10_to_y16_scalar(src + i, dst + i, count - i);
+        }
+
+        static void narrow_y10_to_y8_neon(const uint16_t* src, uint8_t* dst, int count)
+        {
+            // Shift-right-and-narrow truncates, exactly like the scalar cast
+            int i = 0;
+            for (; i + 16 <= count; i += 16)
+                vst1q_u8(dst + i, vcombine_u8(vshrn_n_u16(vld1q_u16(src + i), 2), vshrn_n_u16(vld1q_u16(src + i + 8), 2)));
+            narrow_y10_to_y8_scalar(src + i, dst + i, count - i);
+        }
+
+#ifdef __aarch64__
+        static void unpack_y10bpack_neon(const uint8_t* src, uint16_t* dst, int count)
+        {
+            // Same scheme as the x86 kernels: MSBs to the high byte, the shared LSB byte to the
+            // low byte, then each lane shifts its own 2 bits into bits 7:6
+            static const uint8_t gather_bytes[16] = { 4, 0, 4, 1, 4, 2, 4, 3, 9, 5, 9, 6, 9, 7, 9, 8 };
+            static const int16_t lsb_shift_values[8] = { 6, 4, 2, 0, 6, 4, 2, 0 };
+            const uint8x16_t gather = vld1q_u8(gather_bytes);
+            const int16x8_t lsb_shift = vld1q_s16(lsb_shift_values);
+            const int total = count / 4 * 5;
+            int i = 0;
+            // Each iteration reads 16 bytes for 8 pixels (10 bytes)
+            for (; i / 4 * 5 + 16 <= total; i += 8)
+            {
+                uint16x8_t v = vreinterpretq_u16_u8(vqtbl1q_u8(vld1q_u8(src + i / 4 * 5), gather));
+                uint16x8_t lsb = vandq_u16(vshlq_u16(vandq_u16(v, vdupq_n_u16(0x00ff)), lsb_shift), vdupq_n_u16(0x00c0));
+                vst1q_u16(dst + i, vorrq_u16(vandq_u16(v, vdupq_n_u16(0xff00)), lsb));
+            }
+            unpack_y10bpack_scalar(src + i / 4 * 5, dst + i, count - i);
+        }
+#else
+        // 32-bit NEON lacks a full 16-byte table lookup
+        static void unpack_y10bpack_neon(const uint8_t* src, uint16_t* dst, int count)
+        {
+            unpack_y10bpack_scalar(src, dst, count);
+        }
+#endif
+
+        // out | (depth & take), with take set where out is 0 and the IR pixel is usable
+        static inline uint16x8_t hdr_merge_step(uint16x8_t out, uint16x8_t depth, uint16x8_t valid)
+        {
+            uint16x8_t take = vandq_u16(vceqq_u16(out, vdupq_n_u16(0)), valid);
+            return vorrq_u16(out, vandq_u16(depth, take));
+        }
+
+        static void hdr_merge_depth_neon(uint16_t* out, const uint16_t* depth, int count)
+        {
+            int i = 0;
+            for (; i + 8 <= count; i += 8)
+                vst1q_u16(out + i, hdr_merge_step(vld1q_u16(out + i), vld1q_u16(depth + i), vdupq_n_u16(0xffff)));
+            hdr_merge_depth_scalar(out + i, depth + i, count - i);
+        }
+
+        static void hdr_merge_depth_ir8_neon(uint16_t* out, const uint16_t* depth, const uint8_t* ir, int count)
+        {
+            int i = 0;
+            for (; i + 8 <= count; i += 8)
+            {
+                uint16x8_t v = vmovl_u8(vld1_u8(ir + i));
+                uint16x8_t valid = vandq_u16(vcgtq_u16(v, vdupq_n_u16(5)), vcltq_u16(v, vdupq_n_u16(250)));
+                vst1q_u16(out + i, hdr_merge_step(vld1q_u16(out + i), vld1q_u16(depth + i), valid));
+            }
+            hdr_merge_depth_ir8_scalar(out + i, depth + i, ir + i, count - i);
+        }
+
+        static void hdr_merge_depth_ir16_neon(uint16_t* out, const uint16_t* depth, const uint16_t* ir, int count)
+        {
+            int i = 0;
+            for (; i + 8 <= count; i += 8)
+            {
+                uint16x8_t v = vld1q_u16(ir + i);
+                uint16x8_t valid = vandq_u16(vcgtq_u16(v, vdupq_n_u16(20)), vcltq_u16(v, vdupq_n_u16(1003)));
+                vst1q_u16(out + i, hdr_merge_step(vld1q_u16(out + i), vld1q_u16(depth + i), valid));
+            }
+            hdr_merge_depth_ir16_scalar(out + i, depth + i, ir + i, count - i);
+        }
+
+        static const unpack_kernels neon_kernels = {
+            simd_level::neon,
+            split_y8i_neon,
+            split_y12i_neon,
+            expand_y10_to_y16_neon,
+            narrow_y10_to_y8_neon,
+            unpack_y10bpack_neon,
+            rotate_8_scalar,
+            rotate_16_scalar,
+            rotate_confidence_scalar,
+            hdr_merge_depth_neon,
+            hdr_merge_depth_ir8_neon,
+            hdr_merge_depth_ir16_neon,
+        };
+
+        const unpack_kernels* neon_unpack_kernels() { return &neon_kernels; }
+    }
+}
+
+#else
+
+namespace librealsense
+{
+    namespace simd
+    {
+        const unpack_kernels* neon_unpack_kernels() { return nullptr; }
+    }
+}
+
+#endif
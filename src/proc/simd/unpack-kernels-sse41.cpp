@@ -0,0 +1,266 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2021 Intel Corporation. All Rights Reserved.
+
+// Compiled with SSE4.1 code generation enabled: keep this file free of anything that could be
+// inlined into, or shared with, code running on CPUs without it.
+
+#include "unpack-kernels.h"
+
+#ifdef __SSE4_1__
+#include <smmintrin.h>
+
+namespace librealsense
+{
+    namespace simd
+    {
+        static void split_y8i_sse41(const uint8_t* src, uint8_t* left, uint8_t* right, int count)
+        {
+            const __m128i deinterleave = _mm_setr_epi8(0, 2, 4, 6, 8, 10, 12, 14, 1, 3, 5, 7, 9, 11, 13, 15);
+            int i = 0;
+            for (; i + 16 <= count; i += 16)
+            {
+                __m128i a = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(src + 2 * i)), deinterleave);
+                __m128i b = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(src + 2 * i + 16)), deinterleave);
+                _mm_storeu_si128((__m128i*)(left + i), _mm_unpacklo_epi64(a, b));
+                _mm_storeu_si128((__m128i*)(right + i), _mm_unpackhi_epi64(a, b));
+            }
+            split_y8i_scalar(src + 2 * i, left + i, right + i, count - i);
+        }
+
+        static void split_y12i_sse41(const uint8_t* src, uint16_t* left, uint16_t* right, int count)
+        {
+            // Four pixels (12 bytes) per load: right words in the low half, left words in the high half
+            const __m128i gather = _mm_setr_epi8(0, 1, 3, 4, 6, 7, 9, 10, 1, 2, 4, 5, 7, 8, 10, 11);
+            const __m128i low12 = _mm_set1_epi16(0x0fff);
+            int i = 0;
+            // Each iteration reads 28 bytes for 8 pixels
+            for (; i + 10 <= count; i += 8)
+            {
+                __m128i a = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(src + 3 * i)), gather);
+                __m128i b = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(src + 3 * i + 12)), gather);
+                __m128i r = _mm_and_si128(_mm_unpacklo_epi64(a, b), low12);
+                __m128i l = _mm_srli_epi16(_mm_unpackhi_epi64(a, b), 4);
+                _mm_storeu_si128((__m128i*)(left + i), _mm_or_si128(_mm_slli_epi16(l, 6), _mm_srli_epi16(l, 4)));
+                _mm_storeu_si128((__m128i*)(right + i), _mm_or_si128(_mm_slli_epi16(r, 6), _mm_srli_epi16(r, 4)));
+            }
+            split_y12i_scalar(src + 3 * i, left + i, right + i, count - i);
+        }
+
+        static void expand_y10_to_y16_sse41(const uint16_t* src, uint16_t* dst, int count)
+        {
+            int i = 0;
+            for (; i + 8 <= count; i += 8)
+                _mm_storeu_si128((__m128i*)(dst + i), _mm_slli_epi16(_mm_loadu_si128((const __m128i*)(src + i)), 6));
+            expand_y10_to_y16_scalar(src + i, dst + i, count - i);
+        }
+
+        static void narrow_y10_to_y8_sse41(const uint16_t* src, uint8_t* dst, int count)
+        {
+            // Mask before packing, since the pack saturates where the scalar cast truncates
+            const __m128i low8 = _mm_set1_epi16(0x00ff);
+            int i = 0;
+            for (; i + 16 <= count; i += 16)
+            {
+                __m128i a = _mm_and_si128(_mm_srli_epi16(_mm_loadu_si128((const __m128i*)(src + i)), 2), low8);
+                __m128i b = _mm_and_si128(_mm_srli_epi16(_mm_loadu_si128((const __m128i*)(src + i + 8)), 2), low8);
+                _mm_storeu_si128((__m128i*)(dst + i), _mm_packus_epi16(a, b));
+            }
+            narrow_y10_to_y8_scalar(src + i, dst + i, count - i);
+        }
+
+        static void unpack_y10bpack_sse41(const uint8_t* src, uint16_t* dst, int count)
+        {
+            // Each word gets its 8 MSBs in the high byte and the shared LSB byte in the low byte,
+            // whose relevant 2 bits are then moved to bits 7:6 by a per-lane multiply
+            const __m128i gather = _mm_setr_epi8(4, 0, 4, 1, 4, 2, 4, 3, 9, 5, 9, 6, 9, 7, 9, 8);
+            const __m128i lsb_shift = _mm_setr_epi16(64, 16, 4, 1, 64, 16, 4, 1);
+            const __m128i high = _mm_set1_epi16(int16_t(0xff00));
+            const __m128i low8 = _mm_set1_epi16(0x00ff);
+            const __m128i lsb_bits = _mm_set1_epi16(0x00c0);
+            const int total = count / 4 * 5;
+            int i = 0;
+            // Each iteration reads 16 bytes for 8 pixels (10 bytes)
+            for (; i / 4 * 5 + 16 <= total; i += 8)
+            {
+                __m128i v = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(src + i / 4 * 5)), gather);
+                __m128i lsb = _mm_and_si128(_mm_mullo_epi16(_mm_and_si128(v, low8), lsb_shift), lsb_bits);
+                _mm_storeu_si128((__m128i*)(dst + i), _mm_or_si128(_mm_and_si128(v, high), lsb));
+            }
+            unpack_y10bpack_scalar(src + i / 4 * 5, dst + i, count - i);
+        }
+
+        // In-register transposes: interleave pairs of rows at growing element sizes. Pairing rows
+        // (2i, 2i + 1) into registers i and i + n/2 leaves register k holding the source column whose
+        // index is k with its bits reversed, which the stores below account for.
+        static inline void transpose_16x16_epi8(__m128i r[16])
+        {
+            __m128i t[16];
+            for (int i = 0; i < 8; ++i) { t[i] = _mm_unpacklo_epi8(r[2 * i], r[2 * i + 1]); t[i + 8] = _mm_unpackhi_epi8(r[2 * i], r[2 * i + 1]); }
+            for (int i = 0; i < 8; ++i) { r[i] = _mm_unpacklo_epi16(t[2 * i], t[2 * i + 1]); r[i + 8] = _mm_unpackhi_epi16(t[2 * i], t[2 * i + 1]); }
+            for (int i = 0; i < 8; ++i) { t[i] = _mm_unpacklo_epi32(r[2 * i], r[2 * i + 1]); t[i + 8] = _mm_unpackhi_epi32(r[2 * i], r[2 * i + 1]); }
+            for (int i = 0; i < 8; ++i) { r[i] = _mm_unpacklo_epi64(t[2 * i], t[2 * i + 1]); r[i + 8] = _mm_unpackhi_epi64(t[2 * i], t[2 * i + 1]); }
+        }
+
+        static inline void transpose_8x8_epi16(__m128i r[8])
+        {
+            __m128i t[8];
+            for (int i = 0; i < 4; ++i) { t[i] = _mm_unpacklo_epi16(r[2 * i], r[2 * i + 1]); t[i + 4] = _mm_unpackhi_epi16(r[2 * i], r[2 * i + 1]); }
+            for (int i = 0; i < 4; ++i) { r[i] = _mm_unpacklo_epi32(t[2 * i], t[2 * i + 1]); r[i + 4] = _mm_unpackhi_epi32(t[2 * i], t[2 * i + 1]); }
+            for (int i = 0; i < 4; ++i) { t[i] = _mm_unpacklo_epi64(r[2 * i], r[2 * i + 1]); t[i + 4] = _mm_unpackhi_epi64(r[2 * i], r[2 * i + 1]); }
+            for (int i = 0; i < 8; ++i) r[i] = t[i];
+        }
+
+        static const int bit_reversed_16[16] = { 0, 8, 4, 12, 2, 10, 6, 14, 1, 9, 5, 13, 3, 11, 7, 15 };
+        static const int bit_reversed_8[8] = { 0, 4, 2, 6, 1, 5, 3, 7 };
+
+        // Rotate whole B x B blocks, then let the scalar region code finish the right columns and
+        // the bottom rows. Rows are loaded bottom-up so every transposed register comes out reversed.
+        template<int B, class T, class F, class S>
+        static void rotate_blocks(const T* src, T* dst, int width, int height, F region, S block)
+        {
+            const int full_w = width / B * B, full_h = height / B * B;
+            for (int y = 0; y < full_h; y += B)
+                for (int x = 0; x < full_w; x += B)
+                    block(src, dst, width, height, x, y);
+            region(src, dst, width, height, full_w, width, 0, full_h);
+            region(src, dst, width, height, 0, width, full_h, height);
+        }
+
+        template<int B>
+        static inline void load_rows_bottom_up(const void* src, int stride, int x, int y, int bytes_per_pixel, __m128i r[B])
+        {
+            auto bottom = (const uint8_t*)src + ((y + B - 1) * stride + x) * bytes_per_pixel;
+            for (int m = 0; m < B; ++m)
+                r[m] = _mm_loadu_si128((const __m128i*)(bottom - m * stride * bytes_per_pixel));
+        }
+
+        void rotate_8_sse41(const uint8_t* src, uint8_t* dst, int width, int height)
+        {
+            rotate_blocks<16>(src, dst, width, height, rotate_8_region,
+                [](const uint8_t* src, uint8_t* dst, int width, int height, int x, int y)
+            {
+                __m128i r[16];
+                load_rows_bottom_up<16>(src, width, x, y, 1, r);
+                transpose_16x16_epi8(r);
+                for (int k = 0; k < 16; ++k)
+                    _mm_storeu_si128((__m128i*)(dst + (width - 1 - x - bit_reversed_16[k]) * height + (height - 16 - y)), r[k]);
+            });
+        }
+
+        void rotate_16_sse41(const uint16_t* src, uint16_t* dst, int width, int height)
+        {
+            rotate_blocks<8>(src, dst, width, height, rotate_16_region,
+                [](const uint16_t* src, uint16_t* dst, int width, int height, int x, int y)
+            {
+                __m128i r[8];
+                load_rows_bottom_up<8>(src, width, x, y, 2, r);
+                transpose_8x8_epi16(r);
+                for (int k = 0; k < 8; ++k)
+                    _mm_storeu_si128((__m128i*)(dst + (width - 1 - x - bit_reversed_8[k]) * height + (height - 8 - y)), r[k]);
+            });
+        }
+
+        void rotate_confidence_sse41(const uint8_t* src, uint8_t* dst, int width, int height)
+        {
+            rotate_blocks<16>(src, dst, width, height, rotate_confidence_region,
+                [](const uint8_t* src, uint8_t* dst, int width, int height, int x, int y)
+            {
+                const __m128i low4 = _mm_set1_epi8(0x0f);
+                const __m128i high4 = _mm_set1_epi8(int8_t(0xf0));
+                __m128i r[16];
+                load_rows_bottom_up<16>(src, width, x, y, 1, r);
+                transpose_16x16_epi8(r);
+                for (int k = 0; k < 16; ++k)
+                {
+                    auto out = dst + 2 * (width - 1 - x - bit_reversed_16[k]) * height + (height - 16 - y);
+                    // There is no byte shift, but the 16-bit one is exact once the nibbles are masked
+                    _mm_storeu_si128((__m128i*)out, _mm_slli_epi16(_mm_and_si128(r[k], low4), 4));
+                    _mm_storeu_si128((__m128i*)(out + height), _mm_and_si128(r[k], high4));
+                }
+            });
+        }
+
+        // out | (depth & take): where out is 0 this is the depth if taken, 0 otherwise
+        static inline __m128i hdr_merge_step(__m128i out, __m128i depth, __m128i valid)
+        {
+            __m128i take = _mm_and_si128(_mm_cmpeq_epi16(out, _mm_setzero_si128()), valid);
+            return _mm_or_si128(out, _mm_and_si128(depth, take));
+        }
+
+        // Signed compares are enough: IR values that read as negative fail the lower bound
+        static inline __m128i ir_in_range(__m128i ir, __m128i low, __m128i high)
+        {
+            return _mm_and_si128(_mm_cmpgt_epi16(ir, low), _mm_cmplt_epi16(ir, high));
+        }
+
+        static void hdr_merge_depth_sse41(uint16_t* out, const uint16_t* depth, int count)
+        {
+            const __m128i all = _mm_set1_epi16(-1);
+            int i = 0;
+            for (; i + 8 <= count; i += 8)
+            {
+                __m128i o = _mm_loadu_si128((const __m128i*)(out + i));
+                __m128i d = _mm_loadu_si128((const __m128i*)(depth + i));
+                _mm_storeu_si128((__m128i*)(out + i), hdr_merge_step(o, d, all));
+            }
+            hdr_merge_depth_scalar(out + i, depth + i, count - i);
+        }
+
+        static void hdr_merge_depth_ir8_sse41(uint16_t* out, const uint16_t* depth, const uint8_t* ir, int count)
+        {
+            const __m128i low = _mm_set1_epi16(5), high = _mm_set1_epi16(250);
+            int i = 0;
+            for (; i + 8 <= count; i += 8)
+            {
+                __m128i o = _mm_loadu_si128((const __m128i*)(out + i));
+                __m128i d = _mm_loadu_si128((const __m128i*)(depth + i));
+                __m128i v = _mm_cvtepu8_epi16(_mm_loadl_epi64((const __m128i*)(ir + i)));
+                _mm_storeu_si128((__m128i*)(out + i), hdr_merge_step(o, d, ir_in_range(v, low, high)));
+            }
+            hdr_merge_depth_ir8_scalar(out + i, depth + i, ir + i, count - i);
+        }
+
+        static void hdr_merge_depth_ir16_sse41(uint16_t* out, const uint16_t* depth, const uint16_t* ir, int count)
+        {
+            const __m128i low = _mm_set1_epi16(20), high = _mm_set1_epi16(1003);
+            int i = 0;
+            for (; i + 8 <= count; i += 8)
+            {
+                __m128i o = _mm_loadu_si128((const __m128i*)(out + i));
+                __m128i d = _mm_loadu_si128((const __m128i*)(depth + i));
+                __m128i v = _mm_loadu_si128((const __m128i*)(ir + i));
+                _mm_storeu_si128((__m128i*)(out + i), hdr_merge_step(o, d, ir_in_range(v, low, high)));
+            }
+            hdr_merge_depth_ir16_scalar(out + i, depth + i, ir + i, count - i);
+        }
+
+        static const unpack_kernels sse41_kernels = {
+            simd_level::sse41,
+            split_y8i_sse41,
+            split_y12i_sse41,
+            expand_y10_to_y16_sse41,
+            narrow_y10_to_y8_sse41,
+            unpack_y10bpack_sse41,
+            rotate_8_sse41,
+            rotate_16_sse41,
+            rotate_confidence_sse41,
+            hdr_merge_depth_sse41,
+            hdr_merge_depth_ir8_sse41,
+            hdr_merge_depth_ir16_sse41,
+        };
+
+        const unpack_kernels* sse41_unpack_kernels() { return &sse41_kernels; }
+    }
+}
+
+#else
+
+namespace librealsense
+{
+    namespace simd
+    {
+        const unpack_kernels* sse41_unpack_kernels() { return nullptr; }
+    }
+}
+
+#endif
@@ -0,0 +1,179 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2021 Intel Corporation. All Rights Reserved.
+
+#include "unpack-kernels.h"
+
+#include <algorithm>
+#include <initializer_list>
+
+namespace librealsense
+{
+    namespace simd
+    {
+        void split_y8i_scalar(const uint8_t* src, uint8_t* left, uint8_t* right, int count)
+        {
+            for (int i = 0; i < count; ++i)
+            {
+                left[i] = src[2 * i];
+                right[i] = src[2 * i + 1];
+            }
+        }
+
+        void split_y12i_scalar(const uint8_t* src, uint16_t* left, uint16_t* right, int count)
+        {
+            // Byte layout per pixel: right[7:0], left[3:0] << 4 | right[11:8], left[11:4]
+            for (int i = 0; i < count; ++i, src += 3)
+            {
+                uint16_t l = uint16_t(src[2] << 4 | src[1] >> 4);
+                uint16_t r = uint16_t((src[1] & 0x0f) << 8 | src[0]);
+                left[i] = uint16_t(l << 6 | l >> 4);
+                right[i] = uint16_t(r << 6 | r >> 4);
+            }
+        }
+
+        void expand_y10_to_y16_scalar(const uint16_t* src, uint16_t* dst, int count)
+        {
+            for (int i = 0; i < count; ++i)
+                dst[i] = uint16_t(src[i] << 6);
+        }
+
+        void narrow_y10_to_y8_scalar(const uint16_t* src, uint8_t* dst, int count)
+        {
+            for (int i = 0; i < count; ++i)
+                dst[i] = uint8_t(src[i] >> 2);
+        }
+
+        void unpack_y10bpack_scalar(const uint8_t* src, uint16_t* dst, int count)
+        {
+            // Put the 10 bit into the msb of uint16_t
+            for (int i = 0; i < count / 4; i++, src += 5)
+            {
+                *dst++ = uint16_t(((src[0] << 2) | (src[4] & 3)) << 6);
+                *dst++ = uint16_t(((src[1] << 2) | ((src[4] >> 2) & 3)) << 6);
+                *dst++ = uint16_t(((src[2] << 2) | ((src[4] >> 4) & 3)) << 6);
+                *dst++ = uint16_t(((src[3] << 2) | ((src[4] >> 6) & 3)) << 6);
+            }
+        }
+
+        template<class T>
+        static void rotate_region(const T* src, T* dst, int width, int height, int x_begin, int x_end, int y_begin, int y_end)
+        {
+            for (int y = y_begin; y < y_end; ++y)
+                for (int x = x_begin; x < x_end; ++x)
+                    dst[(width - 1 - x) * height + (height - 1 - y)] = src[y * width + x];
+        }
+
+        void rotate_8_region(const uint8_t* src, uint8_t* dst, int width, int height, int x_begin, int x_end, int y_begin, int y_end)
+        {
+            rotate_region(src, dst, width, height, x_begin, x_end, y_begin, y_end);
+        }
+
+        void rotate_16_region(const uint16_t* src, uint16_t* dst, int width, int height, int x_begin, int x_end, int y_begin, int y_end)
+        {
+            rotate_region(src, dst, width, height, x_begin, x_end, y_begin, y_end);
+        }
+
+        void rotate_confidence_region(const uint8_t* src, uint8_t* dst, int width, int height, int x_begin, int x_end, int y_begin, int y_end)
+        {
+            for (int y = y_begin; y < y_end; ++y)
+            {
+                for (int x = x_begin; x < x_end; ++x)
+                {
+                    auto v = src[y * width + x];
+                    auto out = dst + 2 * (width - 1 - x) * height + (height - 1 - y);
+                    out[0] = uint8_t((v & 0x0f) << 4);
+                    out[height] = uint8_t(v & 0xf0);
+                }
+            }
+        }
+
+        // Walk the image in square tiles so both the reads and the (transposed) writes stay in cache
+        template<class T, class F>
+        static void rotate_tiled(const T* src, T* dst, int width, int height, F region)
+        {
+            const int tile = 16;
+            for (int y = 0; y < height; y += tile)
+                for (int x = 0; x < width; x += tile)
+                    region(src, dst, width, height, x, std::min(x + tile, width), y, std::min(y + tile, height));
+        }
+
+        void rotate_8_scalar(const uint8_t* src, uint8_t* dst, int width, int height)
+        {
+            rotate_tiled(src, dst, width, height, rotate_8_region);
+        }
+
+        void rotate_16_scalar(const uint16_t* src, uint16_t* dst, int width, int height)
+        {
+            rotate_tiled(src, dst, width, height, rotate_16_region);
+        }
+
+        void rotate_confidence_scalar(const uint8_t* src, uint8_t* dst, int width, int height)
+        {
+            rotate_tiled(src, dst, width, height, rotate_confidence_region);
+        }
+
+        void hdr_merge_depth_scalar(uint16_t* out, const uint16_t* depth, int count)
+        {
+            for (int i = 0; i < count; ++i)
+                if (!out[i])
+                    out[i] = depth[i];
+        }
+
+        void hdr_merge_depth_ir8_scalar(uint16_t* out, const uint16_t* depth, const uint8_t* ir, int count)
+        {
+            for (int i = 0; i < count; ++i)
+                if (!out[i] && ir[i] > 5 && ir[i] < 250)
+                    out[i] = depth[i];
+        }
+
+        void hdr_merge_depth_ir16_scalar(uint16_t* out, const uint16_t* depth, const uint16_t* ir, int count)
+        {
+            for (int i = 0; i < count; ++i)
+                if (!out[i] && ir[i] > 20 && ir[i] < 1003)
+                    out[i] = depth[i];
+        }
+
+        static const unpack_kernels scalar_kernels = {
+            simd_level::scalar,
+            split_y8i_scalar,
+            split_y12i_scalar,
+            expand_y10_to_y16_scalar,
+            narrow_y10_to_y8_scalar,
+            unpack_y10bpack_scalar,
+            rotate_8_scalar,
+            rotate_16_scalar,
+            rotate_confidence_scalar,
+            hdr_merge_depth_scalar,
+            hdr_merge_depth_ir8_scalar,
+            hdr_merge_depth_ir16_scalar,
+        };
+    }
+
+    const unpack_kernels* get_unpack_kernels(simd_level level)
+    {
+        if (!cpu_supports(level))
+            return nullptr;
+
+        switch (level)
+        {
+        case simd_level::scalar: return &simd::scalar_kernels;
+        case simd_level::sse41:  return simd::sse41_unpack_kernels();
+        case simd_level::avx2:   return simd::avx2_unpack_kernels();
+        case simd_level::avx512: return simd::avx512_unpack_kernels();
+        case simd_level::neon:   return simd::neon_unpack_kernels();
+        default:                 return nullptr;
+        }
+    }
+
+    const unpack_kernels& get_unpack_kernels()
+    {
+        static const unpack_kernels* best = []()
+        {
+            for (auto level : { simd_level::avx512, simd_level::avx2, simd_level::sse41, simd_level::neon })
+                if (auto kernels = get_unpack_kernels(level))
+                    return kernels;
+            return &simd::scalar_kernels;
+        }();
+        return *best;
+    }
+}
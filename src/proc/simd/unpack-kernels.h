@@ -0,0 +1,85 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2021 Intel Corporation. All Rights Reserved.
+
+#pragma once
+
+#include "../../cpu-dispatch.h"
+
+#include <stdint.h>
+
+namespace librealsense
+{
+    // Inner loops of the IR/depth unpackers, one table per instruction set. Every kernel accepts
+    // unaligned buffers and any pixel count, and produces output bit-exact with the scalar table.
+    struct unpack_kernels
+    {
+        simd_level level;
+
+        // Y8I: interleaved left/right 8-bit pixels, split into two planes
+        void (*split_y8i)(const uint8_t* src, uint8_t* left, uint8_t* right, int count);
+        // Y12I: left/right pixels packed in 3 bytes, split and expanded to 16 bit as (v << 6 | v >> 4)
+        void (*split_y12i)(const uint8_t* src, uint16_t* left, uint16_t* right, int count);
+        // 10-bit samples in 16-bit containers, scaled to 16 bit (v << 6)
+        void (*expand_y10_to_y16)(const uint16_t* src, uint16_t* dst, int count);
+        // 10-bit samples in 16-bit containers, reduced to 8 bit (v >> 2, truncated)
+        void (*narrow_y10_to_y8)(const uint16_t* src, uint8_t* dst, int count);
+        // Y10BPACK: four 10-bit pixels in 5 bytes, MSB-aligned to 16 bit; count is a multiple of 4
+        void (*unpack_y10bpack)(const uint8_t* src, uint16_t* dst, int count);
+
+        // L500 orientation: the width x height source is written height pixels wide and width rows
+        // tall, so that dst[(width - 1 - x) * height + (height - 1 - y)] = src[y * width + x]
+        void (*rotate_8)(const uint8_t* src, uint8_t* dst, int width, int height);
+        void (*rotate_16)(const uint16_t* src, uint16_t* dst, int width, int height);
+        // L500 confidence: rotated as above while each byte is split into its two 4-bit values,
+        // scaled to 8 bit; rotated row r becomes rows 2r (low nibbles) and 2r + 1 (high nibbles)
+        void (*rotate_confidence)(const uint8_t* src, uint8_t* dst, int width, int height);
+
+        // HDR merge, applied once per sequence entry in sequence order: pixels of out that are still
+        // 0 take the entry's depth, provided its IR pixel is neither under- nor over-saturated
+        // (5 < ir < 250 for Y8, 20 < ir < 1003 for 10-bit Y16) when IR is used
+        void (*hdr_merge_depth)(uint16_t* out, const uint16_t* depth, int count);
+        void (*hdr_merge_depth_ir8)(uint16_t* out, const uint16_t* depth, const uint8_t* ir, int count);
+        void (*hdr_merge_depth_ir16)(uint16_t* out, const uint16_t* depth, const uint16_t* ir, int count);
+    };
+
+    // Kernels of the given level, or nullptr if they were not compiled in or the CPU lacks support
+    const unpack_kernels* get_unpack_kernels(simd_level level);
+
+    // The fastest kernels usable on this machine
+    const unpack_kernels& get_unpack_kernels();
+
+    namespace simd
+    {
+        // Reference implementation, also used by the vector kernels for the last few pixels
+        void split_y8i_scalar(const uint8_t* src, uint8_t* left, uint8_t* right, int count);
+        void split_y12i_scalar(const uint8_t* src, uint16_t* left, uint16_t* right, int count);
+        void expand_y10_to_y16_scalar(const uint16_t* src, uint16_t* dst, int count);
+        void narrow_y10_to_y8_scalar(const uint16_t* src, uint8_t* dst, int count);
+        void unpack_y10bpack_scalar(const uint8_t* src, uint16_t* dst, int count);
+        void rotate_8_scalar(const uint8_t* src, uint8_t* dst, int width, int height);
+        void rotate_16_scalar(const uint16_t* src, uint16_t* dst, int width, int height);
+        void rotate_confidence_scalar(const uint8_t* src, uint8_t* dst, int width, int height);
+        void hdr_merge_depth_scalar(uint16_t* out, const uint16_t* depth, int count);
+        void hdr_merge_depth_ir8_scalar(uint16_t* out, const uint16_t* depth, const uint8_t* ir, int count);
+        void hdr_merge_depth_ir16_scalar(uint16_t* out, const uint16_t* depth, const uint16_t* ir, int count);
+
+        // Rotate only the source pixels in rows [y_begin, y_end) and columns [x_begin, x_end); the
+        // vector kernels handle whole blocks and leave the right and bottom edges to these
+        void rotate_8_region(const uint8_t* src, uint8_t* dst, int width, int height, int x_begin, int x_end, int y_begin, int y_end);
+        void rotate_16_region(const uint16_t* src, uint16_t* dst, int width, int height, int x_begin, int x_end, int y_begin, int y_end);
+        void rotate_confidence_region(const uint8_t* src, uint8_t* dst, int width, int height, int x_begin, int x_end, int y_begin, int y_end);
+
+        // Vector rotations work on square blocks; the wider instruction sets reuse the SSE4.1 ones
+        // since a block transpose gains nothing from wider registers
+        void rotate_8_sse41(const uint8_t* src, uint8_t* dst, int width, int height);
+        void rotate_16_sse41(const uint16_t* src, uint16_t* dst, int width, int height);
+        void rotate_confidence_sse41(const uint8_t* src, uint8_t* dst, int width, int height);
+
+        // Defined by the per-instruction-set translation units, each compiled with its own
+        // target flags; they return nullptr when the compiler could not target that instruction set
+        const unpack_kernels* sse41_unpack_kernels();
+        const unpack_kernels* avx2_unpack_kernels();
+        const unpack_kernels* avx512_unpack_kernels();
+        const unpack_kernels* neon_unpack_kernels();
+    }
+}
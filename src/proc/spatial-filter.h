@@ -264,6 +264,7 @@ namespace librealsense
         }
 
     private:
+        friend class depth_postprocess;
 
         float                   _spatial_alpha_param;
         uint8_t                 _spatial_delta_param;
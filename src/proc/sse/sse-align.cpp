@@ -12,6 +12,7 @@
 #include "proc/synthetic-stream.h"
 #include "environment.h"
 #include "stream.h"
+#include "thread-pool.h"
 
 using namespace librealsense;
 
@@ -194,6 +195,26 @@ inline void get_texture_map_sse(const uint16_t * depth,
     }
 }
 
+// Pixels are mapped independently of each other, in chunks of whole 8-pixel groups
+template<rs2_distortion dist>
+inline void get_texture_map_parallel(const uint16_t * depth,
+    float depth_scale,
+    const unsigned int size,
+    const float * pre_compute_x, const float * pre_compute_y,
+    byte * pixels_ptr_int,
+    const rs2_intrinsics& to,
+    const rs2_extrinsics& from_to_other)
+{
+    thread_pool::get_instance().parallel_for("Align", 0, int(size + 7) / 8, 1024, [&](int begin, int end)
+    {
+        auto first = begin * 8;
+        auto count = std::min(unsigned(end * 8), size) - first;
+        get_texture_map_sse<dist>(depth + first, depth_scale, count, pre_compute_x + first, pre_compute_y + first,
+            pixels_ptr_int + first * sizeof(int2), to, from_to_other);
+        _mm_sfence(); // the results are written with streaming stores
+    });
+}
+
 image_transform::image_transform(const rs2_intrinsics& from, float depth_scale)
     :_depth(from),
     _depth_scale(depth_scale),
@@ -302,7 +323,7 @@ template<rs2_distortion dist>
 inline void image_transform::align_depth_to_other_sse(const uint16_t * z_pixels, uint16_t * dest, const rs2_intrinsics& depth, const rs2_intrinsics& to,
     const rs2_extrinsics& from_to_other)
 {
-    get_texture_map_sse<dist>(z_pixels, _depth_scale, _depth.height*_depth.width, _pre_compute_map_x_top_left.data(),
+    get_texture_map_parallel<dist>(z_pixels, _depth_scale, _depth.height*_depth.width, _pre_compute_map_x_top_left.data(),
         _pre_compute_map_y_top_left.data(), (byte*)_pixel_top_left_int.data(), to, from_to_other);
 
     float fov[2];
@@ -314,7 +335,7 @@ inline void image_transform::align_depth_to_other_sse(const uint16_t * z_pixels,
 
     if (pixels_per_angle_depth.x < pixels_per_angle_target.x || pixels_per_angle_depth.y < pixels_per_angle_target.y || is_special_resolution(depth, to))
     {
-        get_texture_map_sse<dist>(z_pixels, _depth_scale, _depth.height*_depth.width, _pre_compute_map_x_bottom_right.data(),
+        get_texture_map_parallel<dist>(z_pixels, _depth_scale, _depth.height*_depth.width, _pre_compute_map_x_bottom_right.data(),
             _pre_compute_map_y_bottom_right.data(), (byte*)_pixel_bottom_right_int.data(), to, from_to_other);
 
         move_depth_to_other(z_pixels, dest, to, _pixel_top_left_int, _pixel_bottom_right_int);
@@ -330,13 +351,13 @@ template<rs2_distortion dist>
 inline void image_transform::align_other_to_depth_sse(const uint16_t * z_pixels, const byte * source, byte * dest, int bpp, const rs2_intrinsics& to,
     const rs2_extrinsics& from_to_other)
 {
-    get_texture_map_sse<dist>(z_pixels, _depth_scale, _depth.height*_depth.width, _pre_compute_map_x_top_left.data(),
+    get_texture_map_parallel<dist>(z_pixels, _depth_scale, _depth.height*_depth.width, _pre_compute_map_x_top_left.data(),
         _pre_compute_map_y_top_left.data(), (byte*)_pixel_top_left_int.data(), to, from_to_other);
 
     std::vector<int2>& bottom_right = _pixel_top_left_int;
     if (to.height < _depth.height && to.width < _depth.width)
     {
-        get_texture_map_sse<dist>(z_pixels, _depth_scale, _depth.height*_depth.width, _pre_compute_map_x_bottom_right.data(),
+        get_texture_map_parallel<dist>(z_pixels, _depth_scale, _depth.height*_depth.width, _pre_compute_map_x_bottom_right.data(),
             _pre_compute_map_y_bottom_right.data(), (byte*)_pixel_bottom_right_int.data(), to, from_to_other);
 
         bottom_right = _pixel_bottom_right_int;
@@ -372,29 +393,32 @@ void image_transform::move_other_to_depth(const uint16_t* z_pixels,
     const std::vector<librealsense::int2>& pixel_top_left_int,
     const std::vector<librealsense::int2>& pixel_bottom_right_int)
 {
-    // Iterate over the pixels of the depth image
-    for (int y = 0; y < _depth.height; ++y)
+    // Iterate over the pixels of the depth image; each one is written only by its own row
+    parallel_for_rows("Align", _depth.height, [&](int y_begin, int y_end)
     {
-        for (int x = 0; x < _depth.width; ++x)
+        for (int y = y_begin; y < y_end; ++y)
         {
-            auto depth_pixel_index = y * _depth.width + x;
-            // Skip over depth pixels with the value of zero, we have no depth data so we will not write anything into our aligned images
-            if (z_pixels[depth_pixel_index])
+            for (int x = 0; x < _depth.width; ++x)
             {
-                for (int other_y = pixel_top_left_int[depth_pixel_index].y; other_y <= pixel_bottom_right_int[depth_pixel_index].y; ++other_y)
+                auto depth_pixel_index = y * _depth.width + x;
+                // Skip over depth pixels with the value of zero, we have no depth data so we will not write anything into our aligned images
+                if (z_pixels[depth_pixel_index])
                 {
-                    for (int other_x = pixel_top_left_int[depth_pixel_index].x; other_x <= pixel_bottom_right_int[depth_pixel_index].x; ++other_x)
+                    for (int other_y = pixel_top_left_int[depth_pixel_index].y; other_y <= pixel_bottom_right_int[depth_pixel_index].y; ++other_y)
                     {
-                        if (other_x < 0 || other_y < 0 || other_x >= to.width || other_y >= to.height)
-                            continue;
-                        auto other_ind = other_y * to.width + other_x;
-
-                        dest[depth_pixel_index] = source[other_ind];
+                        for (int other_x = pixel_top_left_int[depth_pixel_index].x; other_x <= pixel_bottom_right_int[depth_pixel_index].x; ++other_x)
+                        {
+                            if (other_x < 0 || other_y < 0 || other_x >= to.width || other_y >= to.height)
+                                continue;
+                            auto other_ind = other_y * to.width + other_x;
+
+                            dest[depth_pixel_index] = source[other_ind];
+                        }
                     }
                 }
             }
         }
-    }
+    });
 }
 
 void align_sse::reset_cache(rs2_stream from, rs2_stream to)
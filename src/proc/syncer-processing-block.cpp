@@ -6,18 +6,41 @@
 #include "sync.h"
 #include "proc/synthetic-stream.h"
 #include "proc/syncer-processing-block.h"
+#include "frame-trace.h"
+#include "pipeline-stats.h"
 
 
 namespace librealsense
 {
+    static void record_syncer_latency( const frame_holder & f )
+    {
+        auto & stats = pipeline_stats::get_instance();
+        if( ! stats.is_enabled() )
+            return;
+
+        if( auto composite = dynamic_cast< composite_frame * >( f.frame ) )
+        {
+            for( size_t i = 0; i < composite->get_embedded_frames_count(); i++ )
+                if( auto embedded = composite->get_frame( int( i ) ) )
+                    stats.on_frame( *embedded, RS2_LATENCY_STAGE_SYNCER );
+        }
+        else
+            stats.on_frame( *f.frame, RS2_LATENCY_STAGE_SYNCER );
+    }
+
     syncer_process_unit::syncer_process_unit(std::initializer_list< bool_option::ptr > enable_opts, bool log)
-        : processing_block("syncer"), _matcher((new composite_identity_matcher({})))
+        : syncer_process_unit(std::make_shared<composite_identity_matcher>(std::vector<std::shared_ptr<matcher>>()), enable_opts, log)
+    {
+    }
+
+    syncer_process_unit::syncer_process_unit(std::shared_ptr<matcher> matcher, std::initializer_list< bool_option::ptr > enable_opts, bool log)
+        : processing_block("syncer"), _matcher(matcher)
         , _enable_opts(enable_opts.begin(), enable_opts.end())
     {
         _matcher->set_callback( [this]( frame_holder f, syncronization_environment env ) {
             if( env.log )
             {
-                LOG_DEBUG( "<-- queueing " << frame_holder_to_string( f ) );
+                TRACE_FRAME_EVENT( syncer_queued, *f.frame, 0 );
             }
 
             // We get here from within a dispatch() call, already protected by a mutex -- so only
@@ -52,7 +75,7 @@ namespace librealsense
                 get_source().frame_ready(std::move(frame));
                 return;
             }
-            LOG_DEBUG( "--> syncing " << frame_holder_to_string( frame ));
+            TRACE_FRAME_EVENT( syncer_received, *frame.frame, 0 );
             {
                 std::lock_guard<std::mutex> lock(_mutex);
                 _matcher->dispatch(std::move(frame), { source, _matches, log });
@@ -68,7 +91,8 @@ namespace librealsense
 
                 while (_matches.try_dequeue(&f))
                 {
-                    LOG_DEBUG( "--> frame ready: " << *f.frame );
+                    TRACE_FRAME_EVENT( syncer_ready, *f.frame, 0 );
+                    record_syncer_latency( f );
                     get_source().frame_ready(std::move(f));
                 }
             }
@@ -78,4 +102,20 @@ namespace librealsense
         set_processing_callback(std::shared_ptr<rs2_frame_processor_callback>(
             new internal_frame_processor_callback<decltype(f)>(f)));
     }
+
+    multi_device_syncer::multi_device_syncer( float tolerance, float max_latency )
+        : multi_device_syncer( std::make_shared< global_timestamp_composite_matcher >( tolerance, max_latency ) )
+    {
+    }
+
+    multi_device_syncer::multi_device_syncer( std::shared_ptr< global_timestamp_composite_matcher > matcher )
+        : syncer_process_unit( matcher, {} )
+        , _global_matcher( matcher )
+    {
+    }
+
+    std::vector< device_clock_skew > multi_device_syncer::get_clock_skews() const
+    {
+        return _global_matcher->get_clock_skews();
+    }
 }
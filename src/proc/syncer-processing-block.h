@@ -16,11 +16,17 @@ namespace librealsense
 {
     class processing_block;
     class timestamp_composite_matcher;
+    class global_timestamp_composite_matcher;
+    struct device_clock_skew;
+
     class syncer_process_unit : public processing_block
     {
     public:
         syncer_process_unit(std::initializer_list< bool_option::ptr > enable_opts, bool log = true);
 
+        // Syncs the frames with the given top-level matcher, which sees the frames of all devices
+        syncer_process_unit(std::shared_ptr<matcher> matcher, std::initializer_list< bool_option::ptr > enable_opts, bool log = true);
+
         syncer_process_unit( bool_option::ptr is_enabled_opt = nullptr, bool log = true)
             : syncer_process_unit( { is_enabled_opt }, log) {}
 
@@ -47,4 +53,19 @@ namespace librealsense
         single_consumer_frame_queue<frame_holder> _matches;
         std::mutex _callback_mutex;
     };
+
+    // Syncer of the frames of several devices into framesets of all of them (see global_timestamp_composite_matcher)
+    class multi_device_syncer : public syncer_process_unit
+    {
+    public:
+        // tolerance and max_latency are in ms
+        multi_device_syncer( float tolerance, float max_latency );
+
+        std::vector< device_clock_skew > get_clock_skews() const;
+
+    private:
+        multi_device_syncer( std::shared_ptr< global_timestamp_composite_matcher > matcher );
+
+        std::shared_ptr< global_timestamp_composite_matcher > _global_matcher;
+    };
 }
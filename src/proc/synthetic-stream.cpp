@@ -319,28 +319,42 @@ namespace librealsense
         _actual_source.invoke_callback(std::move(result));
     }
 
+    // Compact points vary in size from frame to frame: rounding it up lets the archive recycle the frames
+    static const size_t compact_points_granularity = 64 * 1024;
+
     frame_interface* synthetic_source::allocate_points(std::shared_ptr<stream_profile_interface> stream, frame_interface* original, rs2_extension frame_type)
     {
         auto vid_stream = dynamic_cast<video_stream_profile_interface*>(stream.get());
         if (vid_stream)
-        {
-            frame_additional_data data{};
-            data.frame_number = original->get_frame_number();
-            data.timestamp = original->get_frame_timestamp();
-            data.timestamp_domain = original->get_frame_timestamp_domain();
-            data.metadata_size = 0;
-            data.system_time = _actual_source.get_time();
-            data.is_blocking = original->is_blocking();
-
-            auto res = _actual_source.alloc_frame(frame_type, vid_stream->get_width() * vid_stream->get_height() * sizeof(float) * 5, data, true);
-            if (!res) throw wrong_api_call_sequence_exception("Out of frame resources!");
-            res->set_sensor(original->get_sensor());
-            res->set_stream(stream);
-            return res;
-        }
+            return allocate_points(stream, original, frame_type, vid_stream->get_width() * vid_stream->get_height() * sizeof(float) * 5, false);
         return nullptr;
     }
 
+    frame_interface* synthetic_source::allocate_compact_points(std::shared_ptr<stream_profile_interface> stream, frame_interface* original, size_t data_size)
+    {
+        data_size = (data_size + compact_points_granularity - 1) / compact_points_granularity * compact_points_granularity;
+        return allocate_points(stream, original, RS2_EXTENSION_POINTS, data_size, true);
+    }
+
+    frame_interface* synthetic_source::allocate_points(std::shared_ptr<stream_profile_interface> stream, frame_interface* original,
+        rs2_extension frame_type, size_t data_size, bool compact)
+    {
+        frame_additional_data data{};
+        data.frame_number = original->get_frame_number();
+        data.timestamp = original->get_frame_timestamp();
+        data.timestamp_domain = original->get_frame_timestamp_domain();
+        data.metadata_size = 0;
+        data.system_time = _actual_source.get_time();
+        data.is_blocking = original->is_blocking();
+        data.is_compact_points = compact;
+
+        auto res = _actual_source.alloc_frame(frame_type, data_size, data, true);
+        if (!res) throw wrong_api_call_sequence_exception("Out of frame resources!");
+        res->set_sensor(original->get_sensor());
+        res->set_stream(stream);
+        return res;
+    }
+
 
     frame_interface* synthetic_source::allocate_video_frame(std::shared_ptr<stream_profile_interface> stream,
         frame_interface* original,
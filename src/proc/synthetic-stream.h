@@ -36,11 +36,18 @@ namespace librealsense
         frame_interface* allocate_points(std::shared_ptr<stream_profile_interface> stream, 
             frame_interface* original, rs2_extension frame_type = RS2_EXTENSION_POINTS) override;
 
+        // Points frame of at least data_size bytes, to hold compact points (see compact-points.h)
+        frame_interface* allocate_compact_points(std::shared_ptr<stream_profile_interface> stream,
+            frame_interface* original, size_t data_size);
+
         void frame_ready(frame_holder result) override;
 
         rs2_source* get_c_wrapper() override { return _c_wrapper.get(); }
 
     private:
+        frame_interface* allocate_points(std::shared_ptr<stream_profile_interface> stream,
+            frame_interface* original, rs2_extension frame_type, size_t data_size, bool compact);
+
         frame_source & _actual_source;
         std::shared_ptr<rs2_source> _c_wrapper;
     };
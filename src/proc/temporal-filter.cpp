@@ -185,6 +185,15 @@ namespace librealsense
         return tgt;
     }
 
+    void temporal_filter::reset_history(size_t pixels, size_t bpp)
+    {
+        _last_frame.assign(pixels * bpp, 0);
+        _history.assign(pixels * bpp, 0);
+
+        // Frames the filter processes itself configure it anew
+        _source_stream_profile = rs2::stream_profile();
+    }
+
     void temporal_filter::recalc_persistence_map()
     {
         _persistence_map.fill(0);
@@ -24,17 +24,21 @@ namespace librealsense
         {
             static_assert((std::is_arithmetic<T>::value), "temporal filter assumes numeric types");
 
-            const bool fp = (std::is_floating_point<T>::value);
+            temp_jw_smooth_pixels(reinterpret_cast<T*>(frame_data), reinterpret_cast<T*>(_last_frame_data), history, _current_frm_size_pixels);
 
-            T delta_z = static_cast<T>(_delta_param);
+            _cur_frame_index = (_cur_frame_index + 1) % 8;  // at end of cycle
+        }
 
-            auto frame          = reinterpret_cast<T*>(frame_data);
-            auto _last_frame    = reinterpret_cast<T*>(_last_frame_data);
+        // Filter count pixels of the current frame against their last values and history
+        template<typename T>
+        void temp_jw_smooth_pixels(T* frame, T* _last_frame, uint8_t *history, size_t count)
+        {
+            T delta_z = static_cast<T>(_delta_param);
 
             unsigned char mask = 1 << _cur_frame_index;
 
             // pass one -- go through image and update all
-            for (size_t i = 0; i < _current_frm_size_pixels; i++)
+            for (size_t i = 0; i < count; i++)
             {
                 T cur_val = frame[i];
                 T prev_val = _last_frame[i];
@@ -79,11 +83,14 @@ namespace librealsense
                     history[i] &= ~mask;
                 }
             }
-
-            _cur_frame_index = (_cur_frame_index + 1) % 8;  // at end of cycle
         }
 
     private:
+        friend class depth_postprocess;
+
+        // Forget the history, sized for frames of the given pixels, until the next profile change
+        void reset_history(size_t pixels, size_t bpp);
+
         void on_set_persistence_control(uint8_t val);
         void on_set_alpha(float val);
         void on_set_delta(float val);
@@ -21,6 +21,8 @@ namespace librealsense
         rs2::frame process_frame(const rs2::frame_source& source, const rs2::frame& f) override;
 
     private:
+        friend class depth_postprocess;
+
         rs2::stream_profile _target_stream_profile;
         rs2::stream_profile _source_stream_profile;
 
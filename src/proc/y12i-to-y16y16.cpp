@@ -3,6 +3,7 @@
 
 #include "y12i-to-y16y16.h"
 #include "stream.h"
+#include "simd/unpack-kernels.h"
 #ifdef RS2_USE_CUDA
 #include "cuda/cuda-conversion.cuh"
 #endif
@@ -16,9 +17,8 @@ namespace librealsense
 #ifdef RS2_USE_CUDA
         rscuda::split_frame_y16_y16_from_y12i_cuda(dest, count, reinterpret_cast<const y12i_pixel *>(source));
 #else
-        split_frame(dest, count, reinterpret_cast<const y12i_pixel*>(source),
-            [](const y12i_pixel & p) -> uint16_t { return p.l() << 6 | p.l() >> 4; },  // We want to convert 10-bit data to 16-bit data
-            [](const y12i_pixel & p) -> uint16_t { return p.r() << 6 | p.r() >> 4; }); // Multiply by 64 1/16 to efficiently approximate 65535/1023
+        // Multiply by 64 1/16 to efficiently approximate 65535/1023
+        get_unpack_kernels().split_y12i(source, reinterpret_cast<uint16_t*>(dest[0]), reinterpret_cast<uint16_t*>(dest[1]), count);
 #endif
     }
 
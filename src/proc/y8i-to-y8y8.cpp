@@ -4,6 +4,7 @@
 #include "y8i-to-y8y8.h"
 
 #include "stream.h"
+#include "simd/unpack-kernels.h"
 
 #ifdef RS2_USE_CUDA
 #include "cuda/cuda-conversion.cuh"
@@ -18,9 +19,7 @@ namespace librealsense
 #ifdef RS2_USE_CUDA
         rscuda::split_frame_y8_y8_from_y8i_cuda(dest, count, reinterpret_cast<const y8i_pixel *>(source));
 #else
-        split_frame(dest, count, reinterpret_cast<const y8i_pixel*>(source),
-            [](const y8i_pixel & p) -> uint8_t { return p.l; },
-            [](const y8i_pixel & p) -> uint8_t { return p.r; });
+        get_unpack_kernels().split_y8i(source, dest[0], dest[1], count);
 #endif
     }
 
@@ -0,0 +1,311 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2021 Intel Corporation. All Rights Reserved.
+
+#include "../common/decompress-huffman.h"
+
+#include "z16h-codec.h"
+#include "thread-pool.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace librealsense
+{
+    namespace z16h
+    {
+        // Slices shorter than this many words are not worth a thread
+        static const size_t min_slice_words = 1024;
+
+        // Scanning and then decoding costs about twice the serial decoder, which takes three threads to win back
+        static const int min_parallel_workers = 2;
+
+        // One nibble of the stream read in one state: the difference it completes followed by run - 1 zero
+        // differences, or nothing when count is 0, and the state it leaves the decoder in, premultiplied by 16
+        struct step
+        {
+            uint8_t delta;
+            uint8_t count;
+            uint16_t next;
+        };
+
+        static const int states = sizeof(DecompressionStateTable) / sizeof(DecompressionStateTable[0]) / 16;
+
+        static const step* get_steps()
+        {
+            static const std::vector<step> steps = [] {
+                std::vector<step> s(states * 16);
+                for (int i = 0; i < states * 16; ++i)
+                {
+                    auto word = uint32_t(DecompressionStateTable[i]);
+                    bool emits = (word & 0x8) != 0;
+                    s[i].delta = emits ? uint8_t(word >> 24) : 0;
+                    s[i].count = emits ? uint8_t(1 + (word & 0x7)) : 0;
+                    s[i].next = uint16_t((word & 0x7fc0) >> 2);
+                }
+                return s;
+            }();
+            return steps.data();
+        }
+
+        struct code
+        {
+            uint32_t bits;
+            int length;
+        };
+
+        // The difference the first code of a bit stream decodes to, -1 if there is none in 64 bits
+        static int first_symbol(const step* steps, uint64_t bits)
+        {
+            uint16_t state = 0;
+            for (int shift = 60; shift >= 0; shift -= 4)
+            {
+                auto& s = steps[state + ((bits >> shift) & 0xf)];
+                if (s.count)
+                    return s.delta;
+                state = s.next;
+            }
+            return -1;
+        }
+
+        // The code of every difference, recovered from the decoder's table: a prefix is a complete code once
+        // the stream decodes to the same first difference whatever follows it
+        static const code* get_codes()
+        {
+            static const std::vector<code> codes = [] {
+                auto steps = get_steps();
+                std::vector<code> c(256, code{ 0, 0 });
+                std::vector<code> prefixes = { { 0, 1 }, { 1, 1 } };
+                while (!prefixes.empty())
+                {
+                    auto p = prefixes.back();
+                    prefixes.pop_back();
+                    auto top = uint64_t(p.bits) << (64 - p.length);
+                    auto with_zeros = first_symbol(steps, top);
+                    auto with_ones = first_symbol(steps, top | (~uint64_t(0) >> p.length));
+                    if (with_zeros >= 0 && with_zeros == with_ones)
+                    {
+                        if (!c[with_zeros].length)
+                            c[with_zeros] = p;
+                    }
+                    else if (p.length < 24)
+                    {
+                        prefixes.push_back({ p.bits << 1, p.length + 1 });
+                        prefixes.push_back({ (p.bits << 1) | 1, p.length + 1 });
+                    }
+                }
+                return c;
+            }();
+            return codes.data();
+        }
+
+        // Decode the words [begin, end) from state and output position pos, up to limit. With predict, the
+        // differences are added to the line above; without, only the differences are written. Every nibble
+        // writes 8 bytes, the difference and what is above, and moves on by the count it decodes, so the bytes
+        // past a short run are overwritten by the next nibble; near limit the runs are copied exactly.
+        // Returns the index of the word after the one that reached limit, or end.
+        template<bool predict>
+        static size_t decode_words(const step* steps, const uint32_t* words, size_t begin, size_t end,
+                                   uint16_t& state, uint8_t* image, size_t& pos, size_t limit, size_t stride)
+        {
+            size_t w = begin;
+            // A word decodes to at most 64 bytes, and the line above must not overlap the 8 bytes written
+            if (stride >= 8)
+            {
+                while (w < end && pos + 64 <= limit)
+                {
+                    auto word = words[w++];
+                    for (int shift = 28; shift >= 0; shift -= 4)
+                    {
+                        auto& s = steps[state + ((word >> shift) & 0xf)];
+                        auto out = image + pos;
+                        if (predict)
+                        {
+                            memcpy(out, out - stride, 8);
+                            out[0] = uint8_t(out[0] + s.delta);
+                        }
+                        else
+                        {
+                            memset(out, 0, 8);
+                            out[0] = s.delta;
+                        }
+                        pos += s.count;
+                        state = s.next;
+                    }
+                }
+            }
+
+            while (w < end && pos < limit)
+            {
+                auto word = words[w++];
+                for (int shift = 28; shift >= 0 && pos < limit; shift -= 4)
+                {
+                    auto& s = steps[state + ((word >> shift) & 0xf)];
+                    if (s.count)
+                    {
+                        auto out = image + pos;
+                        auto n = std::min(size_t(s.count), limit - pos);
+                        out[0] = predict ? uint8_t(out[-ptrdiff_t(stride)] + s.delta) : s.delta;
+                        for (size_t i = 1; i < n; ++i)
+                            out[i] = predict ? out[i - stride] : 0;
+                    }
+                    pos += s.count;
+                    state = s.next;
+                }
+            }
+            return w;
+        }
+
+        static size_t header_words(size_t stride)
+        {
+            return (stride + 3) / 4;
+        }
+
+        bool decode_serial(const uint32_t* compressed, size_t length_words, size_t stride, size_t height, uint8_t* image)
+        {
+            auto head = header_words(stride);
+            if (!height || length_words < head)
+                return false;
+            memcpy(image, compressed, stride);
+            if (height == 1)
+                return length_words == head;
+
+            uint16_t state = 0;
+            size_t pos = stride, total = stride * height;
+            auto w = decode_words<true>(get_steps(), compressed, head, length_words, state, image, pos, total, stride);
+            return pos >= total && w == length_words;
+        }
+
+        bool decode(const uint32_t* compressed, size_t length_words, size_t stride, size_t height, uint8_t* image)
+        {
+            auto head = header_words(stride);
+            auto threads = thread_pool::get_instance().get_threads();
+            if (threads < min_parallel_workers || height < 2 || stride < 8 || length_words < head + 2 * min_slice_words)
+                return decode_serial(compressed, length_words, stride, height, image);
+
+            auto steps = get_steps();
+            auto words = compressed + head;
+            size_t body = length_words - head;
+            size_t slices = std::min(size_t(threads + 1) * 2, body / min_slice_words);
+            auto slice_begin = [&](size_t k) { return body * k / slices; };
+
+            // Scan every slice as if a code began with it: the state and the output count after each word,
+            // relative to the start of the slice, whose own entry is implicitly state 0 and no output
+            std::vector<uint16_t> scan_states(body + 1);
+            std::vector<uint32_t> scan_counts(body + 1);
+            thread_pool::get_instance().parallel_for("Z16H scan", 0, int(slices), 1, [&](int k_begin, int k_end)
+            {
+                for (auto k = size_t(k_begin); k < size_t(k_end); ++k)
+                {
+                    uint16_t state = 0;
+                    uint32_t count = 0;
+                    for (auto w = slice_begin(k); w < slice_begin(k + 1); ++w)
+                    {
+                        auto word = words[w];
+                        for (int shift = 28; shift >= 0; shift -= 4)
+                        {
+                            auto& s = steps[state + ((word >> shift) & 0xf)];
+                            count += s.count;
+                            state = s.next;
+                        }
+                        scan_states[w + 1] = state;
+                        scan_counts[w + 1] = count;
+                    }
+                }
+            });
+
+            // Follow the true state into each slice until it meets the state scanned there; from then on the
+            // scan is right, and only the output counts need the offset
+            std::vector<uint16_t> start_states(slices + 1);
+            std::vector<size_t> start_pos(slices + 1);
+            start_states[0] = 0;
+            start_pos[0] = stride;
+            for (size_t k = 0; k < slices; ++k)
+            {
+                auto state = start_states[k];
+                auto pos = start_pos[k];
+                auto begin = slice_begin(k), end = slice_begin(k + 1);
+                auto w = begin;
+                for (; w < end; ++w)
+                {
+                    auto scanned_state = w == begin ? uint16_t(0) : scan_states[w];
+                    if (state == scanned_state)
+                    {
+                        pos += scan_counts[end] - (w == begin ? 0 : scan_counts[w]);
+                        state = scan_states[end];
+                        break;
+                    }
+                    auto word = words[w];
+                    for (int shift = 28; shift >= 0; shift -= 4)
+                    {
+                        auto& s = steps[state + ((word >> shift) & 0xf)];
+                        pos += s.count;
+                        state = s.next;
+                    }
+                }
+                start_states[k + 1] = state;
+                start_pos[k + 1] = pos;
+            }
+
+            // Exactly the image: no slice but the last reaches its end, and the last reaches it in its last word
+            size_t total = stride * height;
+            bool good = start_pos[slices] >= total;
+            for (size_t k = 1; k < slices; ++k)
+                good = good && start_pos[k] < total;
+
+            memcpy(image, compressed, stride);
+            std::vector<size_t> words_used(slices);
+            thread_pool::get_instance().parallel_for("Z16H decode", 0, int(slices), 1, [&](int k_begin, int k_end)
+            {
+                for (auto k = size_t(k_begin); k < size_t(k_end); ++k)
+                {
+                    auto state = start_states[k];
+                    auto pos = std::min(start_pos[k], total);
+                    auto limit = std::min(start_pos[k + 1], total);
+                    words_used[k] = decode_words<false>(steps, words, slice_begin(k), slice_begin(k + 1), state, image, pos, limit, stride);
+                }
+            });
+            good = good && words_used[slices - 1] == body;
+
+            // Sum the differences down the columns
+            thread_pool::get_instance().parallel_for("Z16H decode", 0, int(stride), 64, [&](int x_begin, int x_end)
+            {
+                for (size_t y = 1; y < height; ++y)
+                {
+                    auto line = image + y * stride, above = line - stride;
+                    for (int x = x_begin; x < x_end; ++x)
+                        line[x] = uint8_t(line[x] + above[x]);
+                }
+            });
+            return good;
+        }
+
+        void encode(const uint8_t* image, size_t stride, size_t height, std::vector<uint32_t>& compressed)
+        {
+            auto codes = get_codes();
+            compressed.assign(header_words(stride), 0);
+            if (!height)
+                return;
+            memcpy(compressed.data(), image, stride);
+
+            // Codes are at most 24 bits, so 32 bits of output and a code fit the accumulator
+            uint64_t bits = 0;
+            int pending = 0;
+            size_t total = stride * height;
+            compressed.reserve(compressed.size() + total / 8);
+            for (size_t i = stride; i < total; ++i)
+            {
+                auto& c = codes[uint8_t(image[i] - image[i - stride])];
+                bits = (bits << c.length) | c.bits;
+                pending += c.length;
+                if (pending >= 32)
+                {
+                    pending -= 32;
+                    compressed.push_back(uint32_t(bits >> pending));
+                }
+            }
+            // Pad with zero differences, which the decoder drops past the end of the image
+            if (pending)
+                compressed.push_back(uint32_t(bits << (32 - pending)) | ((uint32_t(1) << (32 - pending)) - 1));
+        }
+    }
+}
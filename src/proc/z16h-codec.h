@@ -0,0 +1,32 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2021 Intel Corporation. All Rights Reserved.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace librealsense
+{
+    // Codec of the Z16H depth format. An image is its first line, stored as is and padded to a 32-bit word,
+    // followed by the difference of every other byte from the byte one line above it, Huffman coded into
+    // 32-bit words from the most significant bit down.
+    //
+    // The format has no restart points, so with enough workers in the pool the decoder finds where to split the
+    // stream by scanning it: every thread scans a slice of the words as if a code began there, and since the code
+    // resynchronizes within a few symbols, a short serial pass then corrects the start of each slice. The slices
+    // are then decoded in parallel into differences and summed down the columns.
+    namespace z16h
+    {
+        // Decode a compressed image of length_words words into height lines of stride bytes. Returns false when
+        // the stream does not hold exactly that image, in which case the image may be partially decoded
+        bool decode(const uint32_t* compressed, size_t length_words, size_t stride, size_t height, uint8_t* image);
+
+        // Decode on the calling thread only
+        bool decode_serial(const uint32_t* compressed, size_t length_words, size_t stride, size_t height, uint8_t* image);
+
+        // Compress height lines of stride bytes, replacing the content of compressed
+        void encode(const uint8_t* image, size_t stride, size_t height, std::vector<uint32_t>& compressed);
+    }
+}
@@ -3,7 +3,9 @@
 
 #include "zero-order.h"
 #include <iomanip>
+#include <algorithm>
 #include "l500/l500-depth.h"
+#include "thread-pool.h"
 
 const double METER_TO_MM = 1000;
 
@@ -32,58 +34,54 @@ namespace librealsense
         return v.z ? rtd : 0;
     }
 
-    void z2rtd(const rs2::vertex* vertices, double* rtd, const rs2_intrinsics& intrinsics, int baseline)
+    // Collects the patch around the zero order point into values, which is reused between frames
+    template<typename T, typename F>
+    void get_zo_point_values(std::vector<T>& values, F pixel_value, const rs2_intrinsics& intrinsics, int zo_point_x, int zo_point_y, int patch_r)
     {
-        for (auto i = 0;i < intrinsics.height*intrinsics.width; i++)
-        {
-            rtd[i] = get_pixel_rtd(vertices[i], baseline);           
-        }
-    }
-    
-    template<typename T>
-    std::vector <T> get_zo_point_values(const T* frame_data_in, const rs2_intrinsics& intrinsics, int zo_point_x, int zo_point_y, int patch_r)
-    {
-        std::vector<T> values;
-        values.reserve((patch_r + 2ULL) *(patch_r + 2ULL));
+        values.clear();
 
         for (auto i = zo_point_y - 1 - patch_r; i <= (zo_point_y + patch_r) && i < intrinsics.height; i++)
         {
             for (auto j = (zo_point_x - 1 - patch_r); j <= (zo_point_x + patch_r) && i < intrinsics.width; j++)
             {
-                values.push_back(frame_data_in[i*intrinsics.width + j]);
+                values.push_back(pixel_value(i*intrinsics.width + j));
             }
         }
-
-        return values;
     }
 
+    // The median, or the mean of the two middle values for an even count, as if the values were sorted
     template<typename T>
     T get_zo_point_value(std::vector<T>& values)
     {
-        std::sort(values.begin(), values.end());
+        if (values.empty())
+            return 0;
 
-        if ((values.size()) % 2 == 0)
-        {
-            return (values[values.size() / 2 - 1] + values[values.size() / 2]) / 2;
-        }
-        else if (values.size() > 0)
-            return values[values.size() / 2];
+        auto middle = values.begin() + values.size() / 2;
+        std::nth_element(values.begin(), middle, values.end());
+        if (values.size() % 2 != 0)
+            return *middle;
 
-        return 0;
+        auto below_middle = *std::max_element(values.begin(), middle);
+        return (below_middle + *middle) / 2;
     }
 
-    bool try_get_zo_rtd_ir_point_values(const double* rtd, const uint16_t* depth_data_in, const uint8_t* ir_data, 
+    bool try_get_zo_rtd_ir_point_values(const rs2::vertex* vertices, const uint16_t* depth_data_in, const uint8_t* ir_data,
         const rs2_intrinsics& intrinsics, const zero_order_options& options, int zo_point_x, int zo_point_y,
-        double *rtd_zo_value, uint8_t* ir_zo_data)
+        zero_order_patch& patch, double *rtd_zo_value, uint8_t* ir_zo_data)
     {
         if (zo_point_x - options.patch_size < 0 || zo_point_x + options.patch_size >= intrinsics.width ||
             zo_point_y - options.patch_size < 0 || zo_point_y + options.patch_size >= intrinsics.height)
             return false;
 
-        auto values_rtd = get_zo_point_values(rtd, intrinsics, zo_point_x, zo_point_y, options.patch_size);
-        auto values_ir = get_zo_point_values(ir_data, intrinsics, zo_point_x, zo_point_y, options.patch_size);
-        auto values_z = get_zo_point_values(depth_data_in, intrinsics, zo_point_x, zo_point_y, options.patch_size);
+        // Only the pixels of the patch need their RTD here
+        auto baseline = int(options.baseline);
+        get_zo_point_values(patch.rtd, [&](int i) { return get_pixel_rtd(vertices[i], baseline); }, intrinsics, zo_point_x, zo_point_y, options.patch_size);
+        get_zo_point_values(patch.ir, [&](int i) { return ir_data[i]; }, intrinsics, zo_point_x, zo_point_y, options.patch_size);
+        get_zo_point_values(patch.z, [&](int i) { return depth_data_in[i]; }, intrinsics, zo_point_x, zo_point_y, options.patch_size);
 
+        auto& values_rtd = patch.rtd;
+        auto& values_ir = patch.ir;
+        auto& values_z = patch.z;
         for (auto i = 0; i < values_rtd.size(); i++)
         {
             if ((values_z[i] / 8.0) > options.z_max || (values_ir[i] < options.ir_min))
@@ -113,7 +111,7 @@ namespace librealsense
     }
 
     template<class T>
-    void detect_zero_order(const double * rtd, const uint16_t* depth_data_in, const uint8_t* ir_data, T zero_pixel,
+    void detect_zero_order(const rs2::vertex* vertices, const uint16_t* depth_data_in, const uint8_t* ir_data, T zero_pixel,
        const rs2_intrinsics& intrinsics, const zero_order_options& options,
        double zo_value, uint8_t iro_value)
     {
@@ -123,35 +121,43 @@ namespace librealsense
 
         double res = (1.0 + r);
         double i_threshold_relative = options.ir_threshold / res;
-        for (auto i = 0; i < intrinsics.height*intrinsics.width; i++)
-        {
-            double rtd_val = rtd[i];
-            uint8_t ir_val = ir_data[i];
+        double rtd_low = zo_value - options.rtd_low_threshold;
+        double rtd_high = zo_value + options.rtd_high_threshold;
+        int baseline = int(options.baseline);
 
-            bool zero = (depth_data_in[i] > 0) && 
-                        (ir_val < i_threshold_relative) &&
-                        (rtd_val > (zo_value - options.rtd_low_threshold)) && 
-                        (rtd_val < (zo_value + options.rtd_high_threshold));
+        // Rows are independent; the RTD is only computed for pixels that pass the cheap depth and IR
+        // tests, which leaves the result exactly as when computing it for the whole frame
+        parallel_for_rows("Zero Order Fix", intrinsics.height, [&](int y_begin, int y_end)
+        {
+            auto end = y_end * intrinsics.width;
+            for (auto i = y_begin * intrinsics.width; i < end; i++)
+            {
+                bool zero = false;
+                if ((depth_data_in[i] > 0) && (ir_data[i] < i_threshold_relative))
+                {
+                    double rtd_val = get_pixel_rtd(vertices[i], baseline);
+                    zero = (rtd_val > rtd_low) && (rtd_val < rtd_high);
+                }
 
-            zero_pixel(i, zero);
-        }
+                zero_pixel(i, zero);
+            }
+        });
     }
 
     template<class T>
     bool zero_order_invalidation(const uint16_t * depth_data_in, const uint8_t * ir_data, T zero_pixel,
         const rs2::vertex* vertices,
         rs2_intrinsics intrinsics,
-        const zero_order_options& options, int zo_point_x, int zo_point_y)
+        const zero_order_options& options, int zo_point_x, int zo_point_y,
+        zero_order_patch& patch)
     {
-        std::vector<double> rtd(size_t(intrinsics.height)*intrinsics.width);
-        z2rtd(vertices, rtd.data(), intrinsics, int(options.baseline));
         double rtd_zo_value; 
         uint8_t ir_zo_value;
 
-        if (try_get_zo_rtd_ir_point_values(rtd.data(), depth_data_in, ir_data, intrinsics, 
-            options,zo_point_x, zo_point_y, &rtd_zo_value, &ir_zo_value))
+        if (try_get_zo_rtd_ir_point_values(vertices, depth_data_in, ir_data, intrinsics, 
+            options,zo_point_x, zo_point_y, patch, &rtd_zo_value, &ir_zo_value))
         {
-            detect_zero_order(rtd.data(), depth_data_in, ir_data, zero_pixel, intrinsics,
+            detect_zero_order(vertices, depth_data_in, ir_data, zero_pixel, intrinsics,
                 options, rtd_zo_value, ir_zo_value);
             return true;
         }
@@ -436,7 +442,7 @@ namespace librealsense
         auto depth_intrinsics = depth_frame.get_profile().as<rs2::video_stream_profile>().get_intrinsics();
 
         auto depth_output = (uint16_t*)depth_out.get_data();
-        uint8_t* confidence_output;
+        uint8_t* confidence_output = nullptr;
 
         if (confidence_frame)
         {
@@ -445,20 +451,23 @@ namespace librealsense
 
         auto zo = get_zo_point(depth_frame);
 
-        if (zero_order_invalidation((const uint16_t*)depth_frame.get_data(),
+        auto depth_input = (const uint16_t*)depth_frame.get_data();
+        auto confidence_input = confidence_frame ? (const uint8_t*)confidence_frame.get_data() : nullptr;
+
+        if (zero_order_invalidation(depth_input,
             (const uint8_t*)ir_frame.get_data(),
             [&](int index, bool zero) 
         {
-            depth_output[index] = zero ? 0 : ((uint16_t*)depth_frame.get_data())[index];
+            depth_output[index] = zero ? 0 : depth_input[index];
 
-            if (confidence_frame)
+            if (confidence_input)
             {
-                confidence_output[index] = zero ? 0 : ((uint8_t*)confidence_frame.get_data())[index];
+                confidence_output[index] = zero ? 0 : confidence_input[index];
             }
         },
             points.get_vertices(),
             depth_intrinsics,
-            _options, zo.first, zo.second))
+            _options, zo.first, zo.second, _patch))
         {
             result.push_back(depth_out);
             if (confidence_frame)
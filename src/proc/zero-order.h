@@ -46,6 +46,14 @@ namespace librealsense
         int                     threshold_scale;
     };
 
+    // Values of the pixels around the zero order point, kept between frames to avoid reallocating them
+    struct zero_order_patch
+    {
+        std::vector<double>     rtd;
+        std::vector<uint8_t>    ir;
+        std::vector<uint16_t>   z;
+    };
+
     class zero_order : public generic_processing_block
     {
     public:
@@ -75,6 +83,7 @@ namespace librealsense
         zero_order_options          _options;
         std::weak_ptr<bool_option>  _is_enabled_opt;
         ivcam2::intrinsic_params    _resolutions_depth;
+        zero_order_patch            _patch;
     };
     MAP_EXTENSION(RS2_EXTENSION_ZERO_ORDER_FILTER, librealsense::zero_order);
 }
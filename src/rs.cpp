@@ -33,6 +33,7 @@
 #include "proc/rates-printer.h"
 #include "proc/hdr-merge.h"
 #include "proc/sequence-id-filter.h"
+#include "proc/depth-postprocess.h"
 #include "media/playback/playback_device.h"
 #include "stream.h"
 #include "../include/librealsense2/h/rs_types.h"
@@ -40,6 +41,8 @@
 #include "environment.h"
 #include "proc/temporal-filter.h"
 #include "proc/depth-decompress.h"
+#include "proc/motion-batch.h"
+#include "proc/compact-points.h"
 #include "software-device.h"
 #include "global_timestamp_reader.h"
 #include "auto-calibrated-device.h"
@@ -47,6 +50,12 @@
 #include "firmware_logger_device.h"
 #include "device-calibration.h"
 #include "calibrated-sensor.h"
+#include "frame-trace.h"
+#include "pipeline-stats.h"
+#include "thread-pool.h"
+#include "latency-budget.h"
+#include "proc/color-to-depth-map.h"
+#include "proc/depth-quality-metrics.h"
 ////////////////////////
 // API implementation //
 ////////////////////////
@@ -108,11 +117,16 @@ struct rs2_pipeline_profile
 struct rs2_frame_queue
 {
     explicit rs2_frame_queue(int cap)
-        : queue(cap)
+        : queue(cap, [](librealsense::frame_holder const & fh)
+          {
+              if (fh.frame)
+                  librealsense::pipeline_stats::get_instance().on_drop(*fh.frame, RS2_FRAME_DROP_REASON_QUEUE_OVERFLOW);
+          }), capacity(cap)
     {
     }
 
     single_consumer_frame_queue<librealsense::frame_holder> queue;
+    int capacity;
 };
 
 struct rs2_sensor_list
@@ -851,6 +865,25 @@ rs2_metadata_type rs2_get_frame_metadata(const rs2_frame* frame, rs2_frame_metad
 }
 HANDLE_EXCEPTIONS_AND_RETURN(0, frame, frame_metadata)
 
+int rs2_get_frame_metadata_all(const rs2_frame* frame, rs2_frame_metadata_entry* entries, int count, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(frame);
+    VALIDATE_NOT_NULL(entries);
+    VALIDATE_RANGE(count, 0, ::RS2_FRAME_METADATA_COUNT);
+    auto f = (frame_interface*)frame;
+    int valid = 0;
+    for (int i = 0; i < count; ++i)
+    {
+        auto& entry = entries[i];
+        entry.id = static_cast<rs2_frame_metadata_value>(i);
+        entry.value = 0;
+        entry.valid = f->find_frame_metadata(entry.id, entry.value);
+        valid += entry.valid;
+    }
+    return valid;
+}
+HANDLE_EXCEPTIONS_AND_RETURN(0, frame, entries, count)
+
 const char* rs2_get_notification_description(rs2_notification* notification, rs2_error** error) BEGIN_API_CALL
 {
     VALIDATE_NOT_NULL(notification);
@@ -1100,6 +1133,14 @@ void rs2_enqueue_frame(rs2_frame* frame, void* queue) BEGIN_API_CALL
 }
 NOEXCEPT_RETURN(, frame, queue)
 
+void rs2_set_frame_queue_latency_budget(rs2_frame_queue* queue, float max_age_ms, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(queue);
+    VALIDATE_RANGE(max_age_ms, 0.f, 3600000.f);
+    librealsense::latency_budget::apply(queue->queue, max_age_ms, queue->capacity);
+}
+HANDLE_EXCEPTIONS_AND_RETURN(, queue, max_age_ms)
+
 void rs2_flush_queue(rs2_frame_queue* queue, rs2_error** error) BEGIN_API_CALL
 {
     VALIDATE_NOT_NULL(queue);
@@ -1180,6 +1221,29 @@ void rs2_hardware_reset(const rs2_device* device, rs2_error** error) BEGIN_API_C
 }
 HANDLE_EXCEPTIONS_AND_RETURN(, device)
 
+void rs2_set_device_thread_placement(const rs2_device* device, rs2_thread_role role, const int* cpus, int cpu_count, int realtime_priority, int numa_node, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(device);
+    VALIDATE_ENUM(role);
+    VALIDATE_RANGE(cpu_count, 0, 1024);
+    if (cpu_count)
+        VALIDATE_NOT_NULL(cpus);
+    if (role == RS2_THREAD_ROLE_PROCESSING)
+        throw librealsense::invalid_value_exception("Processing threads are shared by all devices, place them on the context");
+
+    auto ids = device->device->get_device_data().get_unique_ids();
+    if (ids.empty())
+        throw librealsense::invalid_value_exception("The device has no backend threads to place");
+
+    librealsense::thread_placement placement;
+    placement.cpus.assign(cpus, cpus + cpu_count);
+    placement.realtime_priority = realtime_priority;
+    placement.numa_node = numa_node;
+    for (auto&& id : ids)
+        librealsense::thread_placement_registry::get_instance().set(id, role, placement);
+}
+HANDLE_EXCEPTIONS_AND_RETURN(, device, role, cpus, cpu_count, realtime_priority, numa_node)
+
 // Verify  and provide API version encoded as integer value
 int rs2_get_api_version(rs2_error** error) BEGIN_API_CALL
 {
@@ -1267,6 +1331,7 @@ const char* rs2_camera_info_to_string(rs2_camera_info info)
 const char* rs2_timestamp_domain_to_string(rs2_timestamp_domain info)                     { return librealsense::get_string(info);         }
 const char* rs2_notification_category_to_string(rs2_notification_category category)       { return librealsense::get_string(category);     }
 const char* rs2_calib_target_type_to_string(rs2_calib_target_type type)                   { return librealsense::get_string(type);         }
+const char* rs2_points_layout_to_string(rs2_points_layout layout)                         { return librealsense::get_string(layout);       }
 const char* rs2_sr300_visual_preset_to_string(rs2_sr300_visual_preset preset)             { return librealsense::get_string(preset);       }
 const char* rs2_log_severity_to_string(rs2_log_severity severity)                         { return librealsense::get_string(severity);     }
 const char* rs2_exception_type_to_string(rs2_exception_type type)                         { return librealsense::get_string(type);         }
@@ -1283,6 +1348,9 @@ const char* rs2_cah_trigger_to_string( int mode )
 const char* rs2_calibration_type_to_string(rs2_calibration_type type)                     { return get_string(type); }
 const char* rs2_calibration_status_to_string(rs2_calibration_status status)               { return get_string(status); }
 const char* rs2_host_perf_mode_to_string(rs2_host_perf_mode mode)                         { return get_string(mode); }
+const char* rs2_latency_stage_to_string(rs2_latency_stage stage)                          { return get_string(stage); }
+const char* rs2_frame_drop_reason_to_string(rs2_frame_drop_reason reason)                 { return get_string(reason); }
+const char* rs2_thread_role_to_string(rs2_thread_role role)                               { return get_string(role); }
 
 void rs2_log_to_console(rs2_log_severity min_severity, rs2_error** error) BEGIN_API_CALL
 {
@@ -1553,6 +1621,49 @@ void rs2_context_unload_tracking_module(rs2_context* ctx, rs2_error** error) BEG
 }
 HANDLE_EXCEPTIONS_AND_RETURN(, ctx)
 
+void rs2_context_set_processing_threads(rs2_context* ctx, int threads, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(ctx);
+    VALIDATE_RANGE(threads, -1, 1024);
+    librealsense::thread_pool::get_instance().set_threads(threads);
+}
+HANDLE_EXCEPTIONS_AND_RETURN(, ctx, threads)
+
+int rs2_context_get_processing_threads(const rs2_context* ctx, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(ctx);
+    return librealsense::thread_pool::get_instance().get_threads();
+}
+HANDLE_EXCEPTIONS_AND_RETURN(0, ctx)
+
+void rs2_context_set_processing_affinity(rs2_context* ctx, const int* cpus, int count, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(ctx);
+    VALIDATE_RANGE(count, 0, 1024);
+    if (count)
+        VALIDATE_NOT_NULL(cpus);
+    librealsense::thread_pool::get_instance().set_affinity(std::vector<int>(cpus, cpus + count));
+}
+HANDLE_EXCEPTIONS_AND_RETURN(, ctx, cpus, count)
+
+void rs2_context_set_thread_placement(rs2_context* ctx, rs2_thread_role role, const int* cpus, int cpu_count, int realtime_priority, int numa_node, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(ctx);
+    VALIDATE_ENUM(role);
+    VALIDATE_RANGE(cpu_count, 0, 1024);
+    if (cpu_count)
+        VALIDATE_NOT_NULL(cpus);
+    librealsense::thread_placement placement;
+    placement.cpus.assign(cpus, cpus + cpu_count);
+    placement.realtime_priority = realtime_priority;
+    placement.numa_node = numa_node;
+    if (role == RS2_THREAD_ROLE_PROCESSING)
+        librealsense::thread_pool::get_instance().set_placement(placement);
+    else
+        librealsense::thread_placement_registry::get_instance().set(role, placement);
+}
+HANDLE_EXCEPTIONS_AND_RETURN(, ctx, role, cpus, cpu_count, realtime_priority, numa_node)
+
 const char* rs2_playback_device_get_file_path(const rs2_device* device, rs2_error** error) BEGIN_API_CALL
 {
     VALIDATE_NOT_NULL(device);
@@ -1578,6 +1689,36 @@ void rs2_playback_seek(const rs2_device* device, long long int time, rs2_error**
 }
 HANDLE_EXCEPTIONS_AND_RETURN(, device)
 
+void rs2_playback_seek_to_frame(const rs2_device* device, const rs2_stream_profile* stream, unsigned long long int frame_number, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(device);
+    VALIDATE_NOT_NULL(stream);
+    auto playback = VALIDATE_INTERFACE(device->device, librealsense::playback_device);
+    playback->seek_to_frame(*stream->profile, frame_number);
+}
+HANDLE_EXCEPTIONS_AND_RETURN(, device, stream, frame_number)
+
+unsigned long long int rs2_playback_get_frame_count(const rs2_device* device, const rs2_stream_profile* stream, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(device);
+    VALIDATE_NOT_NULL(stream);
+    auto playback = VALIDATE_INTERFACE(device->device, librealsense::playback_device);
+    return playback->get_frame_count(*stream->profile);
+}
+HANDLE_EXCEPTIONS_AND_RETURN(0, device, stream)
+
+rs2_frame* rs2_playback_get_frame_at(const rs2_device* device, const rs2_stream_profile* stream, unsigned long long int index, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(device);
+    VALIDATE_NOT_NULL(stream);
+    auto playback = VALIDATE_INTERFACE(device->device, librealsense::playback_device);
+    auto f = playback->get_frame_at(*stream->profile, static_cast<size_t>(index));
+    auto frame = f.frame;
+    f.frame = nullptr;
+    return (rs2_frame*)(frame);
+}
+HANDLE_EXCEPTIONS_AND_RETURN(nullptr, device, stream, index)
+
 unsigned long long int rs2_playback_get_position(const rs2_device* device, rs2_error** error) BEGIN_API_CALL
 {
     VALIDATE_NOT_NULL(device);
@@ -1816,6 +1957,14 @@ int rs2_pipeline_try_wait_for_frames(rs2_pipeline* pipe, rs2_frame** output_fram
 }
 HANDLE_EXCEPTIONS_AND_RETURN(0, pipe, output_frame)
 
+void rs2_pipeline_set_latency_budget(rs2_pipeline* pipe, float max_age_ms, rs2_error ** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(pipe);
+    VALIDATE_RANGE(max_age_ms, 0.f, 3600000.f);
+    pipe->pipeline->set_latency_budget(max_age_ms);
+}
+HANDLE_EXCEPTIONS_AND_RETURN(, pipe, max_age_ms)
+
 void rs2_delete_pipeline(rs2_pipeline* pipe) BEGIN_API_CALL
 {
     VALIDATE_NOT_NULL(pipe);
@@ -2067,6 +2216,44 @@ rs2_processing_block* rs2_create_sync_processing_block(rs2_error** error) BEGIN_
 }
 NOARGS_HANDLE_EXCEPTIONS_AND_RETURN(nullptr)
 
+rs2_processing_block* rs2_create_multi_device_sync_processing_block(float tolerance, float max_latency, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_RANGE(tolerance, 0.f, 1000.f);
+    VALIDATE_RANGE(max_latency, 0.f, 10000.f);
+    auto block = std::make_shared<librealsense::multi_device_syncer>(tolerance, max_latency);
+
+    return new rs2_processing_block{ block };
+}
+HANDLE_EXCEPTIONS_AND_RETURN(nullptr, tolerance, max_latency)
+
+int rs2_get_device_clock_skews(const rs2_processing_block* block, rs2_device_clock_skew* skews, int count, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(block);
+    VALIDATE_RANGE(count, 0, std::numeric_limits<int>::max());
+    if (count)
+        VALIDATE_NOT_NULL(skews);
+
+    auto syncer = std::dynamic_pointer_cast<librealsense::multi_device_syncer>(block->block);
+    if (!syncer)
+        throw invalid_value_exception("The processing block is not a multi-device syncer");
+
+    auto device_skews = syncer->get_clock_skews();
+    for (int i = 0; i < count && i < int(device_skews.size()); ++i)
+    {
+        auto& skew = device_skews[i];
+        std::memset(skews[i].serial_number, 0, sizeof(skews[i].serial_number));
+        skew.serial_number.copy(skews[i].serial_number, sizeof(skews[i].serial_number) - 1);
+        skews[i].has_clock = skew.has_clock;
+        skews[i].clock_offset = skew.clock_offset;
+        skews[i].clock_drift = skew.clock_drift;
+        skews[i].frameset_offset = skew.frameset_offset;
+        skews[i].max_frameset_offset = skew.max_frameset_offset;
+        skews[i].framesets = skew.framesets;
+    }
+    return int(device_skews.size());
+}
+HANDLE_EXCEPTIONS_AND_RETURN(0, block, skews, count)
+
 void rs2_start_processing(rs2_processing_block* block, rs2_frame_callback* on_frame, rs2_error** error) BEGIN_API_CALL
 {
     VALIDATE_NOT_NULL(block);
@@ -2184,6 +2371,30 @@ int rs2_get_frame_points_count(const rs2_frame* frame, rs2_error** error) BEGIN_
 }
 HANDLE_EXCEPTIONS_AND_RETURN(0, frame)
 
+int rs2_get_compact_points(const rs2_frame* frame, rs2_compact_points* points, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(frame);
+    VALIDATE_NOT_NULL(points);
+
+    auto pf = VALIDATE_INTERFACE((frame_interface*)frame, librealsense::points);
+    if (!is_compact_points(pf))
+        return 0;
+
+    compact_points compact(pf->get_frame_data());
+    auto texture = compact.texture();
+    points->layout = compact.layout();
+    points->count = static_cast<int>(compact.count());
+    points->width = static_cast<int>(compact.width());
+    points->height = static_cast<int>(compact.height());
+    points->vertices = compact.vertices();
+    points->scale = compact.scale();
+    points->texture_coordinates = texture == texture_coordinates_float32 ? static_cast<const float*>(compact.texture_coordinates()) : nullptr;
+    points->normalized_texture_coordinates = texture == texture_coordinates_uint16 ? static_cast<const unsigned short*>(compact.texture_coordinates()) : nullptr;
+    points->valid_pixels = compact.valid_pixels();
+    return 1;
+}
+HANDLE_EXCEPTIONS_AND_RETURN(0, frame, points)
+
 rs2_processing_block* rs2_create_pointcloud(rs2_error** error) BEGIN_API_CALL
 {
     return new rs2_processing_block { pointcloud::create() };
@@ -2309,6 +2520,27 @@ rs2_processing_block* rs2_create_sequence_id_filter(rs2_error** error) BEGIN_API
 }
 NOARGS_HANDLE_EXCEPTIONS_AND_RETURN(nullptr)
 
+rs2_processing_block* rs2_create_depth_postprocess_block(rs2_processing_block** filters, int count, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(filters);
+    if (count < 1)
+        throw librealsense::invalid_value_exception("depth post-processing requires at least one filter");
+
+    std::vector<std::shared_ptr<librealsense::processing_block>> chain;
+    for (int i = 0; i < count; ++i)
+    {
+        VALIDATE_NOT_NULL(filters[i]);
+        auto filter = std::dynamic_pointer_cast<librealsense::processing_block>(filters[i]->block);
+        if (!filter)
+            throw librealsense::invalid_value_exception("filters must be librealsense processing blocks");
+        chain.push_back(filter);
+    }
+    auto block = std::make_shared<librealsense::depth_postprocess>(chain);
+
+    return new rs2_processing_block{ block };
+}
+HANDLE_EXCEPTIONS_AND_RETURN(nullptr, filters, count)
+
 float rs2_get_depth_scale(rs2_sensor* sensor, rs2_error** error) BEGIN_API_CALL
 {
     VALIDATE_NOT_NULL(sensor);
@@ -2361,6 +2593,61 @@ float rs2_depth_frame_get_units( const rs2_frame* frame_ref, rs2_error** error )
 }
 HANDLE_EXCEPTIONS_AND_RETURN( 0, frame_ref )
 
+int rs2_project_color_pixels_to_depth_pixels(const rs2_frame* depth_frame, const rs2_stream_profile* color_profile,
+    float depth_min, float depth_max, const float* color_pixels, float* depth_pixels, int count, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(depth_frame);
+    VALIDATE_NOT_NULL(color_profile);
+    VALIDATE_NOT_NULL(color_pixels);
+    VALIDATE_NOT_NULL(depth_pixels);
+    VALIDATE_RANGE(count, 0, std::numeric_limits<int>::max());
+    VALIDATE_RANGE(depth_min, 0.f, depth_max);
+    auto df = VALIDATE_INTERFACE(((frame_interface*)depth_frame), librealsense::depth_frame);
+    auto depth_profile = VALIDATE_INTERFACE(df->get_stream().get(), librealsense::video_stream_profile_interface);
+    auto color = VALIDATE_INTERFACE(color_profile->profile, librealsense::video_stream_profile_interface);
+    if (df->get_stream()->get_format() != RS2_FORMAT_Z16)
+        throw invalid_value_exception("Color pixels can only be projected to Z16 depth frames");
+
+    auto map = color_to_depth_map::get(depth_profile->get_unique_id(), color->get_unique_id());
+    std::lock_guard<std::mutex> lock(map->get_mutex());
+    if (!map->is_built_from(df, depth_min, depth_max))
+    {
+        rs2_extrinsics depth_to_color;
+        if (!environment::get_instance().get_extrinsics_graph().try_fetch_extrinsics(*depth_profile, *color, &depth_to_color))
+            throw not_implemented_exception("Requested extrinsics are not available!");
+
+        map->build(reinterpret_cast<const uint16_t*>(df->get_frame_data()), df->get_units(), depth_min, depth_max,
+                   depth_profile->get_intrinsics(), color->get_intrinsics(), depth_to_color);
+        map->set_source(df, depth_min, depth_max);
+    }
+    return map->project(color_pixels, depth_pixels, count);
+}
+HANDLE_EXCEPTIONS_AND_RETURN(0, depth_frame, color_profile, depth_min, depth_max, color_pixels, depth_pixels, count)
+
+void rs2_analyze_depth_quality(const rs2_frame* depth_frame, const rs2_depth_quality_params* params,
+    rs2_depth_quality_metrics* metrics, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(depth_frame);
+    VALIDATE_NOT_NULL(params);
+    VALIDATE_NOT_NULL(metrics);
+    auto df = VALIDATE_INTERFACE(((frame_interface*)depth_frame), librealsense::depth_frame);
+    auto profile = VALIDATE_INTERFACE(df->get_stream().get(), librealsense::video_stream_profile_interface);
+    if (df->get_stream()->get_format() != RS2_FORMAT_Z16)
+        throw invalid_value_exception("Depth quality can only be analyzed on Z16 depth frames");
+    VALIDATE_RANGE(params->roi_min_x, 0, df->get_width() - 1);
+    VALIDATE_RANGE(params->roi_min_y, 0, df->get_height() - 1);
+    VALIDATE_RANGE(params->roi_max_x, params->roi_min_x + 1, int(df->get_width()));
+    VALIDATE_RANGE(params->roi_max_y, params->roi_min_y + 1, int(df->get_height()));
+    VALIDATE_RANGE(params->outlier_percent, 0.f, 49.f);
+    VALIDATE_RANGE(params->ground_truth_mm, 0, std::numeric_limits<int>::max());
+
+    auto analyzer = depth_quality_analyzer::get(profile->get_unique_id());
+    std::lock_guard<std::mutex> lock(analyzer->get_mutex());
+    analyzer->analyze(reinterpret_cast<const uint16_t*>(df->get_frame_data()), df->get_stride() / sizeof(uint16_t),
+        df->get_units(), profile->get_intrinsics(), *params, *metrics);
+}
+HANDLE_EXCEPTIONS_AND_RETURN(, depth_frame, params, metrics)
+
 float rs2_depth_stereo_frame_get_baseline(const rs2_frame* frame_ref, rs2_error** error) BEGIN_API_CALL
 {
     VALIDATE_NOT_NULL(frame_ref);
@@ -2399,6 +2686,25 @@ void rs2_pose_frame_get_pose_data(const rs2_frame* frame, rs2_pose* pose, rs2_er
 }
 HANDLE_EXCEPTIONS_AND_RETURN(, frame, pose)
 
+int rs2_get_motion_batch(const rs2_frame* frame, rs2_motion_batch* batch, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(frame);
+    VALIDATE_NOT_NULL(batch);
+
+    auto mf = VALIDATE_INTERFACE((frame_interface*)frame, librealsense::motion_frame);
+    if (!is_motion_batch(mf))
+        return 0;
+
+    motion_batch samples(mf->get_frame_data());
+    batch->count = static_cast<int>(samples.count());
+    batch->timestamps = samples.timestamps();
+    batch->x = samples.x();
+    batch->y = samples.y();
+    batch->z = samples.z();
+    return 1;
+}
+HANDLE_EXCEPTIONS_AND_RETURN(0, frame, batch)
+
 void rs2_extract_target_dimensions(const rs2_frame* frame_ref, rs2_calib_target_type calib_type, float* target_dims, unsigned int target_dims_size, rs2_error** error) BEGIN_API_CALL
 {
     VALIDATE_NOT_NULL(frame_ref);
@@ -2597,6 +2903,60 @@ void rs2_software_sensor_detach(rs2_sensor* sensor, rs2_error** error) BEGIN_API
 }
 HANDLE_EXCEPTIONS_AND_RETURN(, sensor)
 
+void rs2_enable_frame_trace(int enable, rs2_error ** error) BEGIN_API_CALL
+{
+    librealsense::frame_tracer::get_instance().enable(enable != 0);
+}
+HANDLE_EXCEPTIONS_AND_RETURN(, enable)
+
+void rs2_dump_frame_trace(const char * file_path, int chrome_trace, rs2_error ** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(file_path);
+    librealsense::frame_tracer::get_instance().dump(file_path, chrome_trace != 0);
+}
+HANDLE_EXCEPTIONS_AND_RETURN(, file_path, chrome_trace)
+
+void rs2_enable_pipeline_stats(int enable, rs2_error** error) BEGIN_API_CALL
+{
+    librealsense::pipeline_stats::get_instance().enable(enable != 0);
+}
+HANDLE_EXCEPTIONS_AND_RETURN(, enable)
+
+void rs2_reset_pipeline_stats(rs2_error** error) BEGIN_API_CALL
+{
+    librealsense::pipeline_stats::get_instance().reset();
+    librealsense::thread_pool::get_instance().reset_task_stats();
+}
+NOARGS_HANDLE_EXCEPTIONS_AND_RETURN_VOID()
+
+int rs2_get_pipeline_stats(rs2_stream stream, int index, rs2_latency_stage stage, rs2_latency_stats* stats, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_ENUM(stream);
+    VALIDATE_ENUM(stage);
+    VALIDATE_NOT_NULL(stats);
+    return librealsense::pipeline_stats::get_instance().get_stats(stream, index, stage, *stats) ? 1 : 0;
+}
+HANDLE_EXCEPTIONS_AND_RETURN(0, stream, index, stage, stats)
+
+unsigned long long rs2_get_pipeline_frame_drops(rs2_stream stream, int index, rs2_frame_drop_reason reason, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_ENUM(stream);
+    VALIDATE_ENUM(reason);
+    return librealsense::pipeline_stats::get_instance().get_drops(stream, index, reason);
+}
+HANDLE_EXCEPTIONS_AND_RETURN(0, stream, index, reason)
+
+int rs2_get_processing_task_stats(rs2_processing_task_stats* stats, int max_count, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_RANGE(max_count, 0, std::numeric_limits<int>::max());
+    if (max_count)
+        VALIDATE_NOT_NULL(stats);
+    auto tasks = librealsense::thread_pool::get_instance().get_task_stats();
+    std::copy_n(tasks.begin(), std::min(int(tasks.size()), max_count), stats);
+    return int(tasks.size());
+}
+HANDLE_EXCEPTIONS_AND_RETURN(0, stats, max_count)
+
 void rs2_log(rs2_log_severity severity, const char * message, rs2_error ** error) BEGIN_API_CALL
 {
     VALIDATE_ENUM(severity);
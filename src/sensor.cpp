@@ -15,8 +15,12 @@
 #include "proc/synthetic-stream.h"
 #include "proc/decimation-filter.h"
 #include "proc/depth-decompress.h"
+#include "proc/motion-batch.h"
 #include "global_timestamp_reader.h"
 #include "device-calibration.h"
+#include "frame-trace.h"
+#include "pipeline-stats.h"
+#include "thread-placement.h"
 
 namespace librealsense
 {
@@ -40,6 +44,7 @@ namespace librealsense
     })
     {
         register_option(RS2_OPTION_FRAMES_QUEUE_SIZE, _source.get_published_size_option());
+        register_option(RS2_OPTION_FRAMES_POOL_SIZE, _source.get_published_pool_size_option());
 
         register_metadata(RS2_FRAME_METADATA_TIME_OF_ARRIVAL, std::make_shared<librealsense::md_time_of_arrival_parser>());
 
@@ -336,14 +341,10 @@ namespace librealsense
 
                     frame_continuation release_and_enqueue(continuation, f.pixels);
 
-                    LOG_DEBUG("FrameAccepted," << librealsense::get_string(req_profile_base->get_stream_type())
-                        << ",Counter," << std::dec << fr->additional_data.frame_number
-                        << ",Index," << req_profile_base->get_stream_index()
-                        << ",BackEndTS," << std::fixed << f.backend_time
-                        << ",SystemTime," << std::fixed << system_time
-                        << " ,diff_ts[Sys-BE]," << system_time - f.backend_time
-                        << ",TS," << std::fixed << timestamp << ",TS_Domain," << rs2_timestamp_domain_to_string(timestamp_domain)
-                        << ",last_frame_number," << last_frame_number << ",last_timestamp," << last_timestamp);
+                    TRACE_FRAME_EVENT(frame_accepted, *fr, f.backend_time);
+                    if (pipeline_stats::get_instance().is_enabled())
+                        pipeline_stats::get_instance().record_latency(req_profile_base->get_stream_type(), req_profile_base->get_stream_index(),
+                                                                      RS2_LATENCY_STAGE_BACKEND, system_time - f.backend_time);
 
                     last_frame_number = frame_counter;
                     last_timestamp = timestamp;
@@ -364,9 +365,11 @@ namespace librealsense
                         video->assign(width, height, width * bpp / 8, bpp);
                         video->set_timestamp_domain(timestamp_domain);
                         fh->set_stream(req_profile_base);
+                        pipeline_stats::get_instance().on_frame(*fh.frame, RS2_LATENCY_STAGE_ARCHIVE);
                     }
                     else
                     {
+                        pipeline_stats::get_instance().on_drop(*fr, RS2_FRAME_DROP_REASON_ARCHIVE_FULL);
                         LOG_INFO("Dropped frame. alloc_frame(...) returned nullptr");
                         return;
                     }
@@ -664,6 +667,13 @@ namespace librealsense
     {
         register_metadata(RS2_FRAME_METADATA_BACKEND_TIMESTAMP, make_additional_data_parser(&frame_additional_data::backend_timestamp));
 
+        register_option(RS2_OPTION_MOTION_BATCH_SIZE,
+            std::make_shared<ptr_option<int>>(0, 1000, 1, 0, &_motion_batch_size,
+                "Number of accel/gyro samples delivered together in one motion frame. 0 delivers every sample in its own frame"));
+        register_option(RS2_OPTION_MOTION_BATCH_INTERVAL,
+            std::make_shared<ptr_option<int>>(0, 1000, 1, 0, &_motion_batch_interval,
+                "Longest time, in milliseconds, a motion batch may collect samples before it is delivered. 0 waits for the batch to fill"));
+
         std::map<std::string, uint32_t> frequency_per_sensor;
         for (auto&& elem : sensor_name_and_hid_profiles)
             frequency_per_sensor.insert(make_pair(elem.first, elem.second.fps));
@@ -788,9 +798,12 @@ namespace librealsense
 
         unsigned long long last_frame_number = 0;
         rs2_time_t last_timestamp = 0;
+        // The batching options are sampled once per streaming session
+        uint32_t batch_size = _motion_batch_size > 1 ? uint32_t(_motion_batch_size) : 0;
+        double batch_interval = _motion_batch_interval;
         raise_on_before_streaming_changes(true); //Required to be just before actual start allow recording to work
 
-        _hid_device->start_capture([this, last_frame_number, last_timestamp](const platform::sensor_data& sensor_data) mutable
+        _hid_device->start_capture([this, last_frame_number, last_timestamp, batch_size, batch_interval](const platform::sensor_data& sensor_data) mutable
         {
             const auto&& system_time = environment::get_instance().get_time_service()->get_time();
             auto timestamp_reader = _hid_iio_timestamp_reader.get();
@@ -832,25 +845,28 @@ namespace librealsense
             const auto&& bpp = get_image_bpp(request->get_format());
             auto&& data_size = sensor_data.fo.frame_size;
 
-            LOG_DEBUG("FrameAccepted," << get_string(request->get_stream_type())
-                << ",Counter," << std::dec << frame_counter << ",Index,0"
-                << ",BackEndTS," << std::fixed << sensor_data.fo.backend_time
-                << ",SystemTime," << std::fixed << system_time
-                << " ,diff_ts[Sys-BE]," << system_time - sensor_data.fo.backend_time
-                << ",TS," << std::fixed << timestamp << ",TS_Domain," << rs2_timestamp_domain_to_string(timestamp_domain)
-                << ",last_frame_number," << last_frame_number << ",last_timestamp," << last_timestamp);
+            TRACE_FRAME_EVENT(frame_accepted, *fr, sensor_data.fo.backend_time);
 
             last_frame_number = frame_counter;
             last_timestamp = timestamp;
+
+            if (batch_size && !is_custom_sensor && fr->data.size() >= sizeof(hid_data))
+            {
+                append_motion_sample(request, *fr, timestamp_domain, batch_size, batch_interval);
+                return;
+            }
+
             frame_holder frame = _source.alloc_frame(RS2_EXTENSION_MOTION_FRAME, data_size, fr->additional_data, true);
-            memcpy((void*)frame->get_frame_data(), fr->data.data(), sizeof(byte)*fr->data.size());
             if (!frame)
             {
+                pipeline_stats::get_instance().on_drop(*fr, RS2_FRAME_DROP_REASON_ARCHIVE_FULL);
                 LOG_INFO("Dropped frame. alloc_frame(...) returned nullptr");
                 return;
             }
+            memcpy((void*)frame->get_frame_data(), fr->data.data(), sizeof(byte)*fr->data.size());
             frame->set_stream(request);
             frame->set_timestamp_domain(timestamp_domain);
+            pipeline_stats::get_instance().on_frame(*frame.frame, RS2_LATENCY_STAGE_ARCHIVE);
             _source.invoke_callback(std::move(frame));
         });
         _is_streaming = true;
@@ -865,6 +881,7 @@ namespace librealsense
 
         _hid_device->stop_capture();
         _is_streaming = false;
+        flush_motion_batches();
         _source.flush();
         _source.reset();
         _hid_iio_timestamp_reader->reset();
@@ -872,6 +889,64 @@ namespace librealsense
         raise_on_before_streaming_changes(false);
     }
 
+    void hid_sensor::append_motion_sample(std::shared_ptr<stream_profile_interface> request, const frame& sample,
+        rs2_timestamp_domain timestamp_domain, uint32_t batch_size, double batch_interval)
+    {
+        frame_holder ready;
+        {
+            // Accel and gyro reports may arrive on different threads
+            std::lock_guard<std::mutex> lock(_motion_batch_mutex);
+            auto&& pending = _motion_batches[request->get_stream_type()];
+            if (!pending.frame)
+            {
+                pending.frame = _source.alloc_frame(RS2_EXTENSION_MOTION_FRAME, motion_batch::data_size(batch_size), sample.additional_data, true);
+                if (!pending.frame)
+                {
+                    pipeline_stats::get_instance().on_drop(sample, RS2_FRAME_DROP_REASON_ARCHIVE_FULL);
+                    LOG_INFO("Dropped frame. alloc_frame(...) returned nullptr");
+                    return;
+                }
+                pending.frame->set_stream(request);
+                pending.started = sample.additional_data.system_time;
+                motion_batch(((frame*)pending.frame.frame)->data.data()).reset(batch_size);
+            }
+
+            auto batch_frame = (frame*)pending.frame.frame;
+            motion_batch batch(batch_frame->data.data());
+            auto hid = reinterpret_cast<const hid_data*>(sample.data.data());
+            batch.append(sample.additional_data.timestamp, { float(hid->x), float(hid->y), float(hid->z) });
+
+            // The batch frame carries the timestamp and counters of its latest sample
+            batch_frame->additional_data = sample.additional_data;
+            batch_frame->additional_data.is_motion_batch = true;
+            batch_frame->set_timestamp_domain(timestamp_domain);
+
+            if (batch.full() || (batch_interval > 0 && sample.additional_data.system_time - pending.started >= batch_interval))
+                ready = std::move(pending.frame);
+        }
+
+        if (ready)
+        {
+            pipeline_stats::get_instance().on_frame(*ready.frame, RS2_LATENCY_STAGE_ARCHIVE);
+            _source.invoke_callback(std::move(ready));
+        }
+    }
+
+    void hid_sensor::flush_motion_batches()
+    {
+        std::vector<frame_holder> partial;
+        {
+            std::lock_guard<std::mutex> lock(_motion_batch_mutex);
+            for (auto&& pending : _motion_batches)
+                if (pending.second.frame)
+                    partial.push_back(std::move(pending.second.frame));
+            _motion_batches.clear();
+        }
+
+        for (auto&& f : partial)
+            _source.invoke_callback(std::move(f));
+    }
+
     std::vector<uint8_t> hid_sensor::get_custom_report_data(const std::string& custom_sensor_name,
         const std::string& report_name, platform::custom_sensor_report_field report_field) const
     {
@@ -1029,8 +1104,17 @@ namespace librealsense
         device* device,
         const std::map<uint32_t, rs2_format>& fourcc_to_rs2_format_map,
         const std::map<uint32_t, rs2_stream>& fourcc_to_rs2_stream_map)
-        : sensor_base(name, device, (recommended_proccesing_blocks_interface*)this), _raw_sensor(std::move(sensor))
+        : sensor_base(name, device, (recommended_proccesing_blocks_interface*)this), _raw_sensor(std::move(sensor)),
+        _conversion_queue_size(2)
     {
+        // The conversion stage belongs to the synthetic sensor only, the raw sensor is not aware of it
+        sensor_base::register_option(RS2_OPTION_CONVERSION_QUEUE_SIZE,
+            std::make_shared<ptr_option<int>>(0, 32, 1, 2, &_conversion_queue_size,
+                "Number of raw frames allowed to wait for format conversion per conversion block. 0 converts on the capture thread"));
+
+        // The frames from the device are allocated by the raw sensor
+        sensor_base::register_option(RS2_OPTION_FRAMES_POOL_SIZE, _raw_sensor->get_option_handler(RS2_OPTION_FRAMES_POOL_SIZE));
+
         // synthetic sensor and its raw sensor will share the formats and streams mapping
         auto& raw_fourcc_to_rs2_format_map = _raw_sensor->get_fourcc_to_rs2_format_map();
         _fourcc_to_rs2_format = std::make_shared<std::map<uint32_t, rs2_format>>(fourcc_to_rs2_format_map);
@@ -1515,8 +1599,22 @@ namespace librealsense
                     else
                         continue;
 
+                    auto&& stats = pipeline_stats::get_instance();
+                    stats.on_frame(*fr, RS2_LATENCY_STAGE_PROCESSING);
+
+                    // The frame is the user's once the callback has it, so the end of the callback is recorded
+                    // from what is taken of the frame beforehand
+                    auto stream_type = cached_profile->get_stream_type();
+                    auto stream_index = cached_profile->get_stream_index();
+                    auto system_time = stats.is_enabled() ? fr->get_frame_system_time() : 0.;
+
                     fr->acquire();
-                    _post_process_callback->on_frame((rs2_frame*)fr);
+                    stats.on_frame(*fr, RS2_LATENCY_STAGE_CALLBACK_START);
+                    {
+                        std::lock_guard<std::mutex> delivery(_post_process_mutex);
+                        _post_process_callback->on_frame((rs2_frame*)fr);
+                    }
+                    stats.on_frame(stream_type, stream_index, system_time, RS2_LATENCY_STAGE_CALLBACK_END);
                 }
             }
         });
@@ -1532,7 +1630,10 @@ namespace librealsense
                 }
         }
 
+        start_conversion_lanes();
+
         // Invoke processing blocks callback
+        // When conversion lanes are active the capture thread only enqueues the raw frame
         const auto&& process_cb = make_callback([&, this](frame_holder f) {
             if (!f)
                 return;
@@ -1541,7 +1642,20 @@ namespace librealsense
             for (auto&& pb : pbs)
             {
                 f->acquire();
-                pb->invoke(f.frame);
+
+                auto lane = _conversion_lanes.find(pb);
+                if (lane == _conversion_lanes.end())
+                {
+                    pb->invoke(f.frame);
+                    continue;
+                }
+
+                // Shared holder keeps the lambda copyable and releases the frame if the lane drops it
+                auto raw = std::make_shared<frame_holder>(f.frame);
+                lane->second->invoke([pb, raw](dispatcher::cancellable_timer t)
+                {
+                    pb->invoke(std::move(*raw));
+                }, f.is_blocking());
             }
         });
 
@@ -1553,6 +1667,56 @@ namespace librealsense
     {
         std::lock_guard<std::mutex> lock(_synthetic_configure_lock);
         _raw_sensor->stop();
+        stop_conversion_lanes();
+    }
+
+    void synthetic_sensor::start_conversion_lanes()
+    {
+        stop_conversion_lanes();
+        if (_conversion_queue_size <= 0)
+            return;
+
+        // The lanes run the frame callbacks, and the syncer behind them, so they take the dispatch placement
+        std::string device_id;
+        if (_owner)
+        {
+            auto ids = _owner->get_device_data().get_unique_ids();
+            if (!ids.empty())
+                device_id = ids.front();
+        }
+
+        for (auto&& pb_entry : _profiles_to_processing_block)
+        {
+            for (auto&& pb : pb_entry.second)
+            {
+                if (!pb || _conversion_lanes.count(pb))
+                    continue;
+
+                auto stream_type = pb_entry.first->get_stream_type();
+                auto stream_index = pb_entry.first->get_stream_index();
+                std::string name = to_string() << "rs-" << get_string(stream_type) << (stream_index ? std::to_string(stream_index) : "");
+                auto lane = std::make_shared<dispatcher>(_conversion_queue_size, [stream_type, stream_index](dispatcher::action)
+                {
+                    if (pipeline_stats::get_instance().is_enabled())
+                        pipeline_stats::get_instance().record_drop(stream_type, stream_index, RS2_FRAME_DROP_REASON_QUEUE_OVERFLOW);
+                    LOG_DEBUG("Conversion queue is full, dropping the oldest raw frame");
+                }, [name, device_id]()
+                {
+                    thread_placement_registry::get_instance().apply(RS2_THREAD_ROLE_DISPATCH, name, device_id);
+                });
+                lane->start();
+                _conversion_lanes[pb] = lane;
+            }
+        }
+    }
+
+    void synthetic_sensor::stop_conversion_lanes()
+    {
+        // Called once the raw sensor stopped producing, so pending conversions are discarded
+        // and the in-flight ones are allowed to complete
+        for (auto&& lane : _conversion_lanes)
+            lane.second->stop();
+        _conversion_lanes.clear();
     }
 
     float librealsense::synthetic_sensor::get_preset_max_value() const
@@ -242,10 +242,14 @@ namespace librealsense
         std::shared_ptr<stream_profile_interface> clone_profile(const std::shared_ptr<stream_profile_interface>& profile);
         void register_processing_block_options(const processing_block& pb);
         void unregister_processing_block_options(const processing_block& pb);
+        void start_conversion_lanes();
+        void stop_conversion_lanes();
 
         std::mutex _synthetic_configure_lock;
 
         frame_callback_ptr _post_process_callback;
+        // The conversion lanes run in parallel, but the user callback still gets the frames of the sensor one at a time
+        std::mutex _post_process_mutex;
         std::shared_ptr<sensor_base> _raw_sensor;
         std::vector<std::shared_ptr<processing_block_factory>> _pb_factories;
         std::unordered_map<processing_block_factory*, stream_profiles> _pbf_supported_profiles;
@@ -254,6 +258,11 @@ namespace librealsense
         std::unordered_map<stream_profile, stream_profiles> _target_to_source_profiles_map;
         std::unordered_map<rs2_format, stream_profiles> _cached_requests;
         std::vector<rs2_option> _cached_processing_blocks_options;
+
+        // Each conversion block gets its own lane so that fan-out conversions run in parallel
+        // with each other and with the next capture, while frames of a single block stay in order
+        int _conversion_queue_size;
+        std::unordered_map<std::shared_ptr<processing_block>, std::shared_ptr<dispatcher>> _conversion_lanes;
     };
 
     class iio_hid_timestamp_reader : public frame_timestamp_reader
@@ -322,6 +331,24 @@ namespace librealsense
         uint32_t stream_to_fourcc(rs2_stream stream) const;
 
         uint32_t fps_to_sampling_frequency(rs2_stream stream, uint32_t fps) const;
+
+        // Adds an accel/gyro sample to the pending batch of its stream and delivers the batch when
+        // it is full or has been collecting for batch_interval milliseconds
+        void append_motion_sample(std::shared_ptr<stream_profile_interface> request, const frame& sample,
+            rs2_timestamp_domain timestamp_domain, uint32_t batch_size, double batch_interval);
+        // Delivers the partially filled batches when streaming stops
+        void flush_motion_batches();
+
+        struct pending_motion_batch
+        {
+            frame_holder frame;
+            rs2_time_t started = 0;
+        };
+
+        int _motion_batch_size = 0;
+        int _motion_batch_interval = 0;
+        std::mutex _motion_batch_mutex;
+        std::map<rs2_stream, pending_motion_batch> _motion_batches;
     };
 
     class uvc_sensor : public sensor_base
@@ -36,14 +36,50 @@ namespace librealsense
         std::atomic<uint32_t>* _ptr;
     };
 
+    class frame_pool_size : public option_base
+    {
+    public:
+        frame_pool_size(frame_source* source, const option_range& opt_range)
+            : option_base(opt_range),
+              _source(source)
+        {}
+
+        void set(float value) override
+        {
+            if (!is_valid(value))
+                throw invalid_value_exception(to_string() << "set(frame_pool_size) failed! Given value " << value << " is out of range.");
+
+            _source->set_published_pool_size(static_cast<int>(value));
+            _recording_function(*this);
+        }
+
+        float query() const override { return static_cast<float>(_source->get_published_pool_size()); }
+
+        bool is_enabled() const override { return true; }
+
+        const char* get_description() const override
+        {
+            return "Number of frames of each frame type preallocated for the frames received from the device; frames held beyond it "
+                   "are allocated on the heap. Takes effect the next time the sensor is opened";
+        }
+    private:
+        frame_source* _source;
+    };
+
     std::shared_ptr<option> frame_source::get_published_size_option()
     {
         return std::make_shared<frame_queue_size>(&_max_publish_list_size, option_range{ 0, 32, 1, 16 });
     }
 
+    std::shared_ptr<option> frame_source::get_published_pool_size_option()
+    {
+        return std::make_shared<frame_pool_size>(this, option_range{ 1, 1024, 1, RS2_USER_QUEUE_SIZE });
+    }
+
     frame_source::frame_source(uint32_t max_publish_list_size)
             : _callback(nullptr, [](rs2_frame_callback*) {}),
               _max_publish_list_size(max_publish_list_size),
+              _published_pool_size(RS2_USER_QUEUE_SIZE),
               _ts(environment::get_instance().get_time_service())
     {}
 
@@ -61,12 +97,19 @@ namespace librealsense
 
         for (auto type : supported)
         {
-            _archive[type] = make_archive(type, &_max_publish_list_size, _ts, metadata_parsers);
+            _archive[type] = make_archive(type, &_max_publish_list_size, _ts, metadata_parsers, _published_pool_size);
         }
 
         _metadata_parsers = metadata_parsers;
     }
 
+    void frame_source::set_published_pool_size(int size)
+    {
+        if (size <= 0)
+            throw invalid_value_exception(to_string() << "set_published_pool_size(...) failed! Given size " << size << " is out of range.");
+        _published_pool_size = size;
+    }
+
     callback_invocation_holder frame_source::begin_callback()
     {
         return _archive[RS2_EXTENSION_VIDEO_FRAME]->begin_callback();
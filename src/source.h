@@ -25,6 +25,7 @@ namespace librealsense
         void reset();
 
         std::shared_ptr<option> get_published_size_option();
+        std::shared_ptr<option> get_published_pool_size_option();
 
         frame_interface* alloc_frame(rs2_extension type, size_t size, frame_additional_data additional_data, bool requires_memory) const;
 
@@ -44,11 +45,17 @@ namespace librealsense
         template<class T>
         void add_extension(rs2_extension ex)
         {
-            _archive[ex] = std::make_shared<frame_archive<T>>(&_max_publish_list_size, _ts, _metadata_parsers);
+            _archive[ex] = std::make_shared<frame_archive<T>>(&_max_publish_list_size, _ts, _metadata_parsers, _published_pool_size);
         }
 
         void set_max_publish_list_size(int qsize) {_max_publish_list_size = qsize; }
 
+        // Number of preallocated frame slots in each archive; frames published beyond it are heap
+        // allocated. Takes effect on the archives created by the next init() or add_extension().
+        // Sensors expose it as RS2_OPTION_FRAMES_POOL_SIZE.
+        void set_published_pool_size(int size);
+        int get_published_pool_size() const { return _published_pool_size; }
+
     private:
         friend class syncer_process_unit;
 
@@ -57,6 +64,7 @@ namespace librealsense
         std::map<rs2_extension, std::shared_ptr<archive_interface>> _archive;
 
         std::atomic<uint32_t> _max_publish_list_size;
+        std::atomic<int> _published_pool_size;
         frame_callback_ptr _callback;
         std::shared_ptr<platform::time_service> _ts;
         std::shared_ptr<metadata_parser_map> _metadata_parsers;
@@ -4,6 +4,11 @@
 #include "proc/synthetic-stream.h"
 #include "sync.h"
 #include "environment.h"
+#include "frame-trace.h"
+#include "pipeline-stats.h"
+#include "global_timestamp_reader.h"
+
+#include <cmath>
 
 namespace librealsense
 {
@@ -16,6 +21,19 @@ namespace librealsense
         break; \
     }
 
+    // Frames still waiting for a match when their stream goes inactive never reach the user
+    static void discard_frames( single_consumer_frame_queue< frame_holder > & q )
+    {
+        auto & stats = pipeline_stats::get_instance();
+        if( stats.is_enabled() )
+        {
+            frame_holder f;
+            while( q.try_dequeue( &f ) )
+                stats.on_drop( *f.frame, RS2_FRAME_DROP_REASON_SYNCER_DISCARD );
+        }
+        q.clear();
+    }
+
 
     matcher::matcher(std::vector<stream_id> streams_id)
         : _streams_id(streams_id){}
@@ -292,7 +310,12 @@ namespace librealsense
         }
         update_next_expected( matcher, f );
 
-        _frames_queue[matcher.get()].enqueue(std::move(f));
+        auto & q = _frames_queue[matcher.get()];
+        frame_holder* oldest;
+        if( ! f.is_blocking() && q.size() >= QUEUE_MAX_SIZE && q.peek( &oldest ) && oldest->frame )
+            pipeline_stats::get_instance().on_drop( *oldest->frame, RS2_FRAME_DROP_REASON_SYNCER_DISCARD );
+        q.enqueue(std::move(f));
+        on_queued( matcher.get() );
 
         // We have a queue for each known stream we want to sync.
         // E.g., for (Depth Color), we need to sync two frames, one from each.
@@ -462,7 +485,7 @@ namespace librealsense
 
         for(auto id: inactive_matchers)
         {
-            _frames_queue[_matchers[id].get()].clear();
+            discard_frames( _frames_queue[_matchers[id].get()] );
         }
     }
 
@@ -535,8 +558,9 @@ namespace librealsense
 
     void timestamp_composite_matcher::update_last_arrived(frame_holder& f, matcher* m)
     {
-        if(f->supports_frame_metadata(RS2_FRAME_METADATA_ACTUAL_FPS))
-            _fps[m] = (uint32_t)f->get_frame_metadata(RS2_FRAME_METADATA_ACTUAL_FPS);
+        rs2_metadata_type actual_fps;
+        if(f->find_frame_metadata(RS2_FRAME_METADATA_ACTUAL_FPS, actual_fps))
+            _fps[m] = (uint32_t)actual_fps;
         else
             _fps[m] = f->get_stream()->get_framerate();
 
@@ -545,12 +569,13 @@ namespace librealsense
         _last_arrived[m] = now;
     }
 
-    unsigned int timestamp_composite_matcher::get_fps(const frame_holder & f)
+    static unsigned int get_frame_fps( const frame_holder & f )
     {
         uint32_t fps = 0;
-        if(f.frame->supports_frame_metadata(RS2_FRAME_METADATA_ACTUAL_FPS))
+        rs2_metadata_type actual_fps;
+        if(f.frame->find_frame_metadata(RS2_FRAME_METADATA_ACTUAL_FPS, actual_fps))
         {
-            fps = (uint32_t)f.frame->get_frame_metadata(RS2_FRAME_METADATA_ACTUAL_FPS);
+            fps = (uint32_t)actual_fps;
         }
         if( fps )
         {
@@ -564,6 +589,11 @@ namespace librealsense
         return fps;
     }
 
+    unsigned int timestamp_composite_matcher::get_fps(const frame_holder & f)
+    {
+        return get_frame_fps( f );
+    }
+
     void
     timestamp_composite_matcher::update_next_expected( std::shared_ptr< matcher > const & matcher,
                                                        const frame_holder & f )
@@ -623,7 +653,7 @@ namespace librealsense
                 auto const q_it = _frames_queue.find( p_matcher );
                 if( q_it != _frames_queue.end() )
                 {
-                    q_it->second.clear();
+                    discard_frames( q_it->second );
                     _frames_queue.erase( q_it );
                 }
                 p_matcher->set_active( false );
@@ -684,6 +714,250 @@ namespace librealsense
         return abs(a - b) < (gap / 2);
     }
 
+    // Time of a frame on the clock of the host, where frames of different devices can be compared
+    static double get_host_time( const frame_interface & f )
+    {
+        auto domain = f.get_frame_timestamp_domain();
+        if( domain == RS2_TIMESTAMP_DOMAIN_GLOBAL_TIME || domain == RS2_TIMESTAMP_DOMAIN_SYSTEM_TIME )
+            return f.get_frame_timestamp();
+
+        // Without the global time of the device, the time the frame reached the host is the closest there is
+        rs2_metadata_type arrival;
+        if( f.find_frame_metadata( RS2_FRAME_METADATA_TIME_OF_ARRIVAL, arrival ) )
+            return double( arrival );
+        return environment::get_instance().get_time_service()->get_time();
+    }
+
+    // Weight of the offset of the latest frameset in the average offset of a device
+    const double skew_smoothing = 0.1;
+
+    global_timestamp_composite_matcher::global_timestamp_composite_matcher( double tolerance, double max_latency )
+        : composite_matcher( {}, "GT: " )
+        , _tolerance( tolerance )
+        , _max_latency( max_latency )
+    {
+    }
+
+    void global_timestamp_composite_matcher::sync( frame_holder f, const syncronization_environment & env )
+    {
+        if( auto m = find_matcher( f ) )
+            if( _arrived.find( m.get() ) == _arrived.end() )
+                add_device( *f.frame );
+        composite_matcher::sync( std::move( f ), env );
+
+        // Framesets are matched off the front of the queues
+        for( auto & a : _arrived )
+        {
+            auto q = _frames_queue.find( a.first );
+            size_t queued = q != _frames_queue.end() ? q->second.size() : 0;
+            while( a.second.size() > queued )
+                a.second.pop_front();
+        }
+    }
+
+    void global_timestamp_composite_matcher::on_queued( matcher * m )
+    {
+        // A full queue drops its oldest frameset to take the new one
+        auto & arrived = _arrived[m];
+        arrived.push_back( environment::get_instance().get_time_service()->get_time() );
+        while( arrived.size() > _frames_queue[m].size() )
+            arrived.pop_front();
+    }
+
+    void global_timestamp_composite_matcher::set_callback( sync_callback f )
+    {
+        composite_matcher::set_callback( [this, f]( frame_holder frameset, const syncronization_environment & env ) {
+            update_clock_skews( frameset );
+            f( std::move( frameset ), env );
+        } );
+    }
+
+    double global_timestamp_composite_matcher::get_tolerance( const frame_holder & a, const frame_holder & b ) const
+    {
+        if( _tolerance > 0 )
+            return _tolerance;
+        auto fps = std::max( 1u, std::min( get_frame_fps( a ), get_frame_fps( b ) ) );
+        return 500. / fps;
+    }
+
+    bool global_timestamp_composite_matcher::are_equivalent( frame_holder & a, frame_holder & b )
+    {
+        return std::abs( get_host_time( *a.frame ) - get_host_time( *b.frame ) ) < get_tolerance( a, b );
+    }
+
+    bool global_timestamp_composite_matcher::is_smaller_than( frame_holder & a, frame_holder & b )
+    {
+        if( ! a || ! b )
+            return false;
+        return get_host_time( *a.frame ) < get_host_time( *b.frame );
+    }
+
+    void global_timestamp_composite_matcher::update_last_arrived( frame_holder & f, matcher * m )
+    {
+        _fps[m] = get_frame_fps( f );
+        _last_arrived[m] = environment::get_instance().get_time_service()->get_time();
+    }
+
+    void global_timestamp_composite_matcher::update_next_expected( std::shared_ptr< matcher > const & matcher,
+                                                                   const frame_holder & f )
+    {
+        auto fps = std::max( 1u, get_frame_fps( f ) );
+        _next_expected[matcher.get()] = get_host_time( *f.frame ) + 1000. / fps;
+    }
+
+    void global_timestamp_composite_matcher::clean_inactive_streams( frame_holder & f )
+    {
+        if( f.is_blocking() )
+            return;
+
+        // A device that stopped sending frames for 5 of its frame periods (and at least the latency) stops holding
+        // back the framesets of the others
+        auto const now = environment::get_instance().get_time_service()->get_time();
+        for( auto & m : _matchers )
+        {
+            auto const p_matcher = m.second.get();
+            auto const it = _last_arrived.find( p_matcher );
+            if( it == _last_arrived.end() || ! p_matcher->get_active() )
+                continue;
+
+            auto const fps_it = _fps.find( p_matcher );
+            auto const period = ( fps_it != _fps.end() && fps_it->second ) ? 1000. / fps_it->second : 100.;
+            auto const threshold = std::max( 5 * period, _max_latency );
+            if( now - it->second > threshold )
+            {
+                LOG_DEBUG( _name << ": more (" << now - it->second << ") than " << threshold
+                                 << " ms since last frame; cleaning up " << p_matcher->get_name() );
+                auto const q_it = _frames_queue.find( p_matcher );
+                if( q_it != _frames_queue.end() )
+                {
+                    discard_frames( q_it->second );
+                    _frames_queue.erase( q_it );
+                }
+                _arrived.erase( p_matcher );
+                p_matcher->set_active( false );
+            }
+        }
+    }
+
+    bool global_timestamp_composite_matcher::skip_missing_stream( std::vector< matcher * > const & synced,
+                                                                  matcher * missing,
+                                                                  const syncronization_environment & env )
+    {
+        if( ! missing->get_active() )
+            return true;
+
+        frame_holder * synced_frame;
+        if( ! _frames_queue[synced[0]].peek( &synced_frame ) )
+            return true;
+
+        // The next frame of the missing device is past this frameset: it has nothing to add to it
+        auto timestamp = get_host_time( *synced_frame->frame );
+        if( _next_expected[missing] - timestamp >= get_tolerance( *synced_frame, *synced_frame ) )
+            return true;
+
+        // Frames already matched off the queue arrived before the ones still in it
+        auto & arrived = _arrived[synced[0]];
+        while( arrived.size() > _frames_queue[synced[0]].size() )
+            arrived.pop_front();
+        auto const now = environment::get_instance().get_time_service()->get_time();
+        if( ! arrived.empty() && now - arrived.front() >= _max_latency )
+        {
+            LOG_IF_ENABLE( "...     waited " << now - arrived.front() << " ms; exceeded the latency", env );
+            return true;
+        }
+        return false;
+    }
+
+    void global_timestamp_composite_matcher::add_device( const frame_interface & f )
+    {
+        auto sensor = f.get_sensor();
+        if( ! sensor )
+            return;
+        const device_interface * dev = &sensor->get_device();
+
+        // The first device to send frames is the one the clocks of the others are measured against
+        std::lock_guard< std::mutex > lock( _skews_mutex );
+        auto it = std::find_if( _skews.begin(), _skews.end(),
+                                [dev]( const std::pair< const device_interface *, device_clock_skew > & s ) { return s.first == dev; } );
+        if( it != _skews.end() )
+            return;
+        device_clock_skew skew;
+        if( dev->supports_info( RS2_CAMERA_INFO_SERIAL_NUMBER ) )
+            skew.serial_number = dev->get_info( RS2_CAMERA_INFO_SERIAL_NUMBER );
+        _skews.emplace_back( dev, skew );
+    }
+
+    void global_timestamp_composite_matcher::update_clock_skews( const frame_holder & frameset )
+    {
+        auto composite = dynamic_cast< const composite_frame * >( frameset.frame );
+        if( ! composite )
+            return;
+
+        // Host time of the first frame of each device in the frameset, and whether the device mapped it from its
+        // own clock
+        struct device_frame
+        {
+            const device_interface * dev;
+            double host_time;
+            bool global_time;
+        };
+        std::vector< device_frame > devices;
+        for( size_t i = 0; i < composite->get_embedded_frames_count(); ++i )
+        {
+            auto f = composite->get_frame( int( i ) );
+            auto sensor = f ? f->get_sensor() : nullptr;
+            if( ! sensor )
+                continue;
+            const device_interface * dev = &sensor->get_device();
+            if( std::find_if( devices.begin(), devices.end(), [dev]( const device_frame & d ) { return d.dev == dev; } )
+                == devices.end() )
+                devices.push_back( { dev, get_host_time( *f ),
+                                     f->get_frame_timestamp_domain() == RS2_TIMESTAMP_DOMAIN_GLOBAL_TIME } );
+        }
+
+        std::lock_guard< std::mutex > lock( _skews_mutex );
+        if( _skews.empty() )
+            return;
+
+        // The clock of a device, where it has one, is as the time diff keeper behind its global time measures it
+        for( auto & s : _skews )
+        {
+            auto it = std::find_if( devices.begin(), devices.end(), [&s]( const device_frame & d ) { return d.dev == s.first; } );
+            if( it == devices.end() || ! it->global_time )
+                continue;
+            if( auto global_time = dynamic_cast< const global_time_interface * >( s.first ) )
+                s.second.has_clock = global_time->get_clock_skew( s.second.clock_offset, s.second.clock_drift );
+        }
+
+        if( devices.size() < 2 )
+            return;
+        auto reference = std::find_if( devices.begin(), devices.end(),
+                                       [this]( const device_frame & d ) { return d.dev == _skews.front().first; } );
+        if( reference == devices.end() )
+            return;
+
+        for( auto & s : _skews )
+        {
+            auto it = std::find_if( devices.begin(), devices.end(), [&s]( const device_frame & d ) { return d.dev == s.first; } );
+            if( it == devices.end() )
+                continue;
+            auto & skew = s.second;
+            auto offset = it->host_time - reference->host_time;
+            skew.frameset_offset = skew.framesets ? skew.frameset_offset + ( offset - skew.frameset_offset ) * skew_smoothing : offset;
+            skew.max_frameset_offset = std::max( skew.max_frameset_offset, std::abs( offset ) );
+            ++skew.framesets;
+        }
+    }
+
+    std::vector< device_clock_skew > global_timestamp_composite_matcher::get_clock_skews() const
+    {
+        std::lock_guard< std::mutex > lock( _skews_mutex );
+        std::vector< device_clock_skew > skews;
+        for( auto & s : _skews )
+            skews.push_back( s.second );
+        return skews;
+    }
+
     composite_identity_matcher::composite_identity_matcher(
         std::vector< std::shared_ptr< matcher > > const & matchers )
         : composite_matcher( matchers, "CI: " )
@@ -702,7 +976,7 @@ namespace librealsense
             if (composite.frame)
             {
                 auto cb = begin_callback();
-                LOG_DEBUG( "wrapped with composite: " << *composite.frame );
+                TRACE_FRAME_EVENT( composite_wrapped, *composite.frame, 0 );
                 _callback(std::move(composite), env);
             }
             else
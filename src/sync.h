@@ -7,6 +7,7 @@
 #include "archive.h"
 
 #include <stdint.h>
+#include <deque>
 #include <vector>
 #include <mutex>
 #include <memory>
@@ -147,6 +148,8 @@ namespace librealsense
         virtual void update_next_expected( std::shared_ptr< matcher > const & matcher,
                                            const frame_holder & f )
             = 0;
+        // Right after the frame, or frameset of a sub-matcher, is queued in the queue of its matcher
+        virtual void on_queued( matcher * m ) {}
 
         std::map<matcher*, single_consumer_frame_queue<frame_holder>> _frames_queue;
         std::map<stream_id, std::shared_ptr<matcher>> _matchers;
@@ -219,4 +222,61 @@ namespace librealsense
         std::map<matcher*, unsigned int> _fps;
 
     };
+
+    // Offset of the clock of a device from that of the first device a multi-device syncer received frames of
+    struct device_clock_skew
+    {
+        std::string serial_number;
+        bool has_clock = false;             // the device maps its clock onto the host's, see time_diff_keeper
+        double clock_offset = 0;            // ms, host clock less the device clock
+        double clock_drift = 0;             // ppm, rate of the device clock against the host's, less 1
+        double frameset_offset = 0;         // ms, averaged over the recent framesets
+        double max_frameset_offset = 0;     // ms, largest absolute offset of any frameset
+        unsigned long long framesets = 0;   // with frames of both devices
+    };
+
+    // Matches the framesets of different devices by the host time of their frames: the global time domain (see
+    // global_timestamp_reader) maps the clock of each device onto that of the host, where frames of different
+    // devices can be compared. The streams of each device are still synced by the matcher of that device, and
+    // their framesets are then matched across devices when their host times are within the tolerance. A frameset
+    // waits for a device missing from it until that device is past it, or for max_latency ms from when it arrived,
+    // as checked whenever a frame arrives.
+    class global_timestamp_composite_matcher : public composite_matcher
+    {
+    public:
+        // A tolerance of 0 is half the frame period of the slower of two devices
+        global_timestamp_composite_matcher( double tolerance, double max_latency );
+
+        void sync( frame_holder f, const syncronization_environment & env ) override;
+        void set_callback( sync_callback f ) override;
+
+        bool are_equivalent( frame_holder & a, frame_holder & b ) override;
+        bool is_smaller_than( frame_holder & a, frame_holder & b ) override;
+        void update_last_arrived( frame_holder & f, matcher * m ) override;
+        void clean_inactive_streams( frame_holder & f ) override;
+        bool skip_missing_stream( std::vector< matcher * > const & synced,
+                                  matcher * missing,
+                                  const syncronization_environment & env ) override;
+
+        std::vector< device_clock_skew > get_clock_skews() const;
+
+    protected:
+        void update_next_expected( std::shared_ptr< matcher > const & matcher,
+                                   const frame_holder & f ) override;
+        void on_queued( matcher * m ) override;
+
+    private:
+        double get_tolerance( const frame_holder & a, const frame_holder & b ) const;
+        void add_device( const frame_interface & f );
+        void update_clock_skews( const frame_holder & frameset );
+
+        double _tolerance;
+        double _max_latency;
+        std::map< matcher *, double > _last_arrived;
+        std::map< matcher *, unsigned int > _fps;
+        std::map< matcher *, std::deque< double > > _arrived;  // wall clock of when each frameset in _frames_queue was queued
+
+        mutable std::mutex _skews_mutex;
+        std::vector< std::pair< const device_interface *, device_clock_skew > > _skews;  // first is the reference
+    };
 }
@@ -0,0 +1,227 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2021 Intel Corporation. All Rights Reserved.
+
+#include "thread-placement.h"
+#include "types.h"
+
+#include <fstream>
+#include <sstream>
+
+#ifdef _WIN32
+#include <windows.h>
+#elif defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#elif defined(__APPLE__)
+#include <pthread.h>
+#endif
+
+namespace librealsense
+{
+    bool set_current_thread_affinity(const std::vector<int>& cpus)
+    {
+#ifdef _WIN32
+        DWORD_PTR mask = 0;
+        if (cpus.empty())
+        {
+            DWORD_PTR system_mask;
+            if (!GetProcessAffinityMask(GetCurrentProcess(), &mask, &system_mask))
+                return false;
+        }
+        for (auto cpu : cpus)
+        {
+            if (cpu >= 0 && cpu < int(sizeof(DWORD_PTR) * 8))
+                mask |= DWORD_PTR(1) << cpu;
+        }
+        return mask && SetThreadAffinityMask(GetCurrentThread(), mask) != 0;
+#elif defined(__linux__)
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        if (cpus.empty())
+        {
+            for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+                CPU_SET(cpu, &set);
+        }
+        for (auto cpu : cpus)
+        {
+            if (cpu >= 0 && cpu < CPU_SETSIZE)
+                CPU_SET(cpu, &set);
+        }
+        return sched_setaffinity(0, sizeof(set), &set) == 0;
+#else
+        return cpus.empty();
+#endif
+    }
+
+    void set_current_thread_name(const std::string& name)
+    {
+#ifdef _WIN32
+        // SetThreadDescription is only available from Windows 10 1607
+        typedef HRESULT(WINAPI *set_thread_description_func)(HANDLE, PCWSTR);
+        static auto set_thread_description = reinterpret_cast<set_thread_description_func>(
+            GetProcAddress(GetModuleHandleW(L"kernel32.dll"), "SetThreadDescription"));
+        if (set_thread_description)
+        {
+            std::wstring wide(name.begin(), name.end());
+            set_thread_description(GetCurrentThread(), wide.c_str());
+        }
+#elif defined(__linux__)
+        pthread_setname_np(pthread_self(), name.substr(0, 15).c_str());
+#elif defined(__APPLE__)
+        pthread_setname_np(name.c_str());
+#else
+        (void)name;
+#endif
+    }
+
+#ifdef __linux__
+    // CPUs of a memory node, as listed in sysfs ("0-7,16-23")
+    static std::vector<int> get_node_cpus(int node)
+    {
+        std::vector<int> cpus;
+        std::ifstream file(to_string() << "/sys/devices/system/node/node" << node << "/cpulist");
+        std::string list;
+        if (!std::getline(file, list))
+            return cpus;
+
+        std::stringstream ss(list);
+        std::string range;
+        while (std::getline(ss, range, ','))
+        {
+            int first, last;
+            auto dash = range.find('-');
+            try
+            {
+                first = std::stoi(range.substr(0, dash));
+                last = dash == std::string::npos ? first : std::stoi(range.substr(dash + 1));
+            }
+            catch (...)
+            {
+                continue;
+            }
+            for (int cpu = first; cpu <= last; ++cpu)
+                cpus.push_back(cpu);
+        }
+        return cpus;
+    }
+
+    static bool set_preferred_node(int node)
+    {
+#ifdef SYS_set_mempolicy
+        // MPOL_PREFERRED rather than a strict bind, so that allocations still succeed when the node
+        // runs out of memory
+        const int mpol_preferred = 1;
+        const int max_nodes = 1024;
+        unsigned long mask[max_nodes / (8 * sizeof(unsigned long))] = {};
+        if (node >= max_nodes)
+            return false;
+        mask[node / (8 * sizeof(unsigned long))] |= 1UL << (node % (8 * sizeof(unsigned long)));
+        return syscall(SYS_set_mempolicy, mpol_preferred, mask, max_nodes + 1) == 0;
+#else
+        return false;
+#endif
+    }
+#endif
+
+    void validate_thread_placement(const thread_placement& placement)
+    {
+        for (auto cpu : placement.cpus)
+        {
+            if (cpu < 0)
+                throw invalid_value_exception(to_string() << "Invalid CPU index " << cpu);
+        }
+        if (placement.realtime_priority < 0 || placement.realtime_priority > 99)
+            throw invalid_value_exception(to_string() << "Invalid real-time priority " << placement.realtime_priority);
+        if (placement.numa_node < -1)
+            throw invalid_value_exception(to_string() << "Invalid memory node " << placement.numa_node);
+#ifdef __linux__
+        if (placement.numa_node >= 0 && placement.cpus.empty() && get_node_cpus(placement.numa_node).empty())
+            throw invalid_value_exception(to_string() << "Memory node " << placement.numa_node << " does not exist");
+#endif
+    }
+
+    void apply_thread_placement(const thread_placement& placement, const std::string& name)
+    {
+        set_current_thread_name(name);
+
+        // Without an explicit CPU set, a memory node keeps the thread on the CPUs of that node
+        auto cpus = placement.cpus;
+#ifdef __linux__
+        if (cpus.empty() && placement.numa_node >= 0)
+            cpus = get_node_cpus(placement.numa_node);
+#endif
+        if (!cpus.empty() && !set_current_thread_affinity(cpus))
+            LOG_WARNING("Could not set the affinity of thread " << name);
+
+        if (placement.realtime_priority > 0)
+        {
+#ifdef _WIN32
+            if (!SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_TIME_CRITICAL))
+                LOG_WARNING("Could not raise the priority of thread " << name);
+#elif defined(__linux__)
+            sched_param param = {};
+            param.sched_priority = placement.realtime_priority;
+            if (pthread_setschedparam(pthread_self(), SCHED_FIFO, &param))
+                LOG_WARNING("Could not set SCHED_FIFO priority " << placement.realtime_priority << " for thread " << name
+                            << ", real-time scheduling requires CAP_SYS_NICE or an RLIMIT_RTPRIO limit");
+#else
+            LOG_WARNING("Real-time priority is not supported for thread " << name);
+#endif
+        }
+
+        if (placement.numa_node >= 0)
+        {
+#ifdef __linux__
+            if (!set_preferred_node(placement.numa_node))
+                LOG_WARNING("Could not set the memory node of thread " << name << " to " << placement.numa_node);
+#else
+            LOG_WARNING("Memory node placement is not supported for thread " << name);
+#endif
+        }
+    }
+
+    thread_placement_registry& thread_placement_registry::get_instance()
+    {
+        static thread_placement_registry instance;
+        return instance;
+    }
+
+    void thread_placement_registry::set(rs2_thread_role role, const thread_placement& placement)
+    {
+        validate_thread_placement(placement);
+        std::lock_guard<std::mutex> lock(_mutex);
+        _roles[role] = placement;
+    }
+
+    void thread_placement_registry::set(const std::string& device_id, rs2_thread_role role, const thread_placement& placement)
+    {
+        validate_thread_placement(placement);
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (placement.empty())
+            _devices.erase(std::make_pair(device_id, role));
+        else
+            _devices[std::make_pair(device_id, role)] = placement;
+    }
+
+    thread_placement thread_placement_registry::get(rs2_thread_role role, const std::string& device_id) const
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (!device_id.empty())
+        {
+            auto it = _devices.find(std::make_pair(device_id, role));
+            if (it != _devices.end())
+                return it->second;
+        }
+        auto it = _roles.find(role);
+        if (it != _roles.end())
+            return it->second;
+        return thread_placement();
+    }
+
+    void thread_placement_registry::apply(rs2_thread_role role, const std::string& name, const std::string& device_id) const
+    {
+        apply_thread_placement(get(role, device_id), name);
+    }
+}
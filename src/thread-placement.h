@@ -0,0 +1,64 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2021 Intel Corporation. All Rights Reserved.
+
+#pragma once
+
+#include "../include/librealsense2/h/rs_types.h"
+
+#include <map>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace librealsense
+{
+    // Where the threads of one role run
+    struct thread_placement
+    {
+        std::vector<int> cpus;          // CPUs the threads may run on, none for no restriction
+        int realtime_priority = 0;      // SCHED_FIFO priority, 0 to keep the default scheduling policy
+        int numa_node = -1;             // memory node preferred for the allocations of the threads, -1 for none
+
+        bool empty() const { return cpus.empty() && realtime_priority == 0 && numa_node < 0; }
+    };
+
+    // Restrict the calling thread to the given CPUs, or lift the restriction when the set is empty.
+    // Returns false if the platform does not support thread affinity.
+    bool set_current_thread_affinity(const std::vector<int>& cpus);
+
+    // Name the calling thread, as shown by debuggers and tools such as top -H. Linux truncates the
+    // name to 15 characters.
+    void set_current_thread_name(const std::string& name);
+
+    // Name the calling thread and apply a placement to it. The memory node applies to the pages the
+    // thread touches first, which keeps the frame buffers a capture thread fills on that node.
+    // Failures, typically a missing permission for real-time scheduling, are logged and ignored.
+    void apply_thread_placement(const thread_placement& placement, const std::string& name);
+
+    // Throws if the placement is not valid on this system
+    void validate_thread_placement(const thread_placement& placement);
+
+    // Placement policy of the capture and dispatch threads, for all devices and per device. A device
+    // is identified by the unique id of its backend interfaces. Threads read the policy when they
+    // start, so a change takes effect the next time a sensor starts streaming.
+    class thread_placement_registry
+    {
+    public:
+        static thread_placement_registry& get_instance();
+
+        void set(rs2_thread_role role, const thread_placement& placement);
+        void set(const std::string& device_id, rs2_thread_role role, const thread_placement& placement);
+
+        // The device placement if there is one, else the one of the role
+        thread_placement get(rs2_thread_role role, const std::string& device_id = "") const;
+
+        // Name the calling thread and apply the placement of its role and device
+        void apply(rs2_thread_role role, const std::string& name, const std::string& device_id = "") const;
+
+    private:
+        mutable std::mutex _mutex;
+        std::map<rs2_thread_role, thread_placement> _roles;
+        std::map<std::pair<std::string, rs2_thread_role>, thread_placement> _devices;
+    };
+}
@@ -0,0 +1,372 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2021 Intel Corporation. All Rights Reserved.
+
+#include "thread-pool.h"
+#include "types.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+namespace librealsense
+{
+    // Non-zero while the thread runs chunks of a parallel_for, or is a pool worker
+    static thread_local int parallel_depth = 0;
+
+    struct thread_pool::job
+    {
+        // The body belongs to the submitting thread, which waits for every claimed chunk before
+        // returning. Jobs left in the worker queues after that have no chunks to claim.
+        const std::function<void(int, int)>* body;
+        int begin;
+        int end;
+        int chunk_size;
+        int chunk_count;
+
+        std::atomic<int> next_chunk;
+        std::atomic<int> done_chunks;
+        std::atomic<int> stolen_chunks;
+
+        std::mutex mutex;
+        std::condition_variable done;
+        std::exception_ptr error;
+
+        job() : next_chunk(0), done_chunks(0), stolen_chunks(0) {}
+    };
+
+    thread_pool& thread_pool::get_instance()
+    {
+        static thread_pool* instance = new thread_pool();
+        return *instance;
+    }
+
+    thread_pool::thread_pool()
+        : _requested_threads(-1), _started(false), _pending(0), _stopping(false),
+          _next_worker(0), _running(0), _resizing(false)
+    {
+    }
+
+    thread_pool::~thread_pool()
+    {
+        std::lock_guard<std::mutex> lock(_config_mutex);
+        stop_workers();
+    }
+
+    void thread_pool::release_workers()
+    {
+        reconfigure([]() {});
+    }
+
+    void thread_pool::set_threads(int threads)
+    {
+        if (threads < -1)
+            throw invalid_value_exception(to_string() << "Invalid number of processing threads " << threads);
+
+        reconfigure([&]() { _requested_threads = threads; });
+    }
+
+    int thread_pool::get_threads() const
+    {
+        std::lock_guard<std::mutex> lock(_config_mutex);
+        if (_requested_threads >= 0)
+            return _requested_threads;
+        return std::max(int(std::thread::hardware_concurrency()) - 1, 0);
+    }
+
+    void thread_pool::set_affinity(const std::vector<int>& cpus)
+    {
+        auto placement = get_placement();
+        placement.cpus = cpus;
+        set_placement(placement);
+    }
+
+    std::vector<int> thread_pool::get_affinity() const
+    {
+        return get_placement().cpus;
+    }
+
+    void thread_pool::set_placement(const thread_placement& placement)
+    {
+        validate_thread_placement(placement);
+
+        // Workers place themselves when they start
+        reconfigure([&]() { _placement = placement; });
+    }
+
+    thread_placement thread_pool::get_placement() const
+    {
+        std::lock_guard<std::mutex> lock(_config_mutex);
+        return _placement;
+    }
+
+    void thread_pool::reconfigure(const std::function<void()>& change)
+    {
+        // Wait for the parallel_for calls in flight to finish, and keep new ones out meanwhile
+        std::unique_lock<std::mutex> running_lock(_running_mutex);
+        _running_cv.wait(running_lock, [&]() { return !_resizing; });
+        _resizing = true;
+        _running_cv.wait(running_lock, [&]() { return _running == 0; });
+        running_lock.unlock();
+
+        {
+            // The workers are started again, with the new configuration, by the next parallel_for
+            std::lock_guard<std::mutex> lock(_config_mutex);
+            stop_workers();
+            change();
+        }
+
+        running_lock.lock();
+        _resizing = false;
+        _running_cv.notify_all();
+    }
+
+    // Called with _config_mutex held
+    void thread_pool::start_workers()
+    {
+        auto threads = _requested_threads >= 0 ? _requested_threads
+                                               : std::max(int(std::thread::hardware_concurrency()) - 1, 0);
+        {
+            std::lock_guard<std::mutex> lock(_wake_mutex);
+            _stopping = false;
+            _pending = 0;
+        }
+
+        // All the queues must exist before any worker looks for something to steal
+        for (int i = 0; i < threads; ++i)
+            _workers.push_back(std::unique_ptr<worker>(new worker()));
+        auto placement = _placement;
+        for (int i = 0; i < threads; ++i)
+            _workers[i]->thread = std::thread([this, i, placement]() { worker_loop(i, placement); });
+
+        _started = true;
+    }
+
+    // Called with _config_mutex held, while no parallel_for is running
+    void thread_pool::stop_workers()
+    {
+        if (!_started)
+            return;
+
+        {
+            std::lock_guard<std::mutex> lock(_wake_mutex);
+            _stopping = true;
+        }
+        _wake.notify_all();
+
+        for (auto&& w : _workers)
+        {
+            if (w->thread.joinable())
+                w->thread.join();
+        }
+        _workers.clear();
+        _started = false;
+    }
+
+    std::shared_ptr<thread_pool::job> thread_pool::take_job(int index)
+    {
+        std::shared_ptr<job> j;
+
+        // Own queue first, newest job first
+        {
+            auto& own = *_workers[index];
+            std::lock_guard<std::mutex> lock(own.mutex);
+            if (!own.jobs.empty())
+            {
+                j = std::move(own.jobs.back());
+                own.jobs.pop_back();
+            }
+        }
+
+        // Then steal the oldest job of another worker
+        for (size_t k = 1; !j && k < _workers.size(); ++k)
+        {
+            auto& victim = *_workers[(index + k) % _workers.size()];
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            if (!victim.jobs.empty())
+            {
+                j = std::move(victim.jobs.front());
+                victim.jobs.pop_front();
+            }
+        }
+
+        if (j)
+        {
+            std::lock_guard<std::mutex> lock(_wake_mutex);
+            --_pending;
+        }
+        return j;
+    }
+
+    void thread_pool::worker_loop(int index, thread_placement placement)
+    {
+        parallel_depth = 1;
+        apply_thread_placement(placement, to_string() << "rs-proc-" << index);
+
+        while (true)
+        {
+            if (auto j = take_job(index))
+            {
+                run_chunks(*j, true);
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(_wake_mutex);
+            _wake.wait(lock, [&]() { return _stopping || _pending > 0; });
+            if (_stopping)
+                break;
+        }
+    }
+
+    void thread_pool::run_chunks(job& j, bool on_worker)
+    {
+        while (true)
+        {
+            auto chunk = j.next_chunk.fetch_add(1);
+            if (chunk >= j.chunk_count)
+                break;
+
+            auto chunk_begin = j.begin + chunk * j.chunk_size;
+            auto chunk_end = std::min(chunk_begin + j.chunk_size, j.end);
+            try
+            {
+                (*j.body)(chunk_begin, chunk_end);
+            }
+            catch (...)
+            {
+                std::lock_guard<std::mutex> lock(j.mutex);
+                if (!j.error)
+                    j.error = std::current_exception();
+            }
+
+            if (on_worker)
+                ++j.stolen_chunks;
+            if (j.done_chunks.fetch_add(1) + 1 == j.chunk_count)
+            {
+                std::lock_guard<std::mutex> lock(j.mutex);
+                j.done.notify_all();
+            }
+        }
+    }
+
+    void thread_pool::parallel_for(const char* name, int begin, int end, int grain, const std::function<void(int, int)>& body)
+    {
+        if (end <= begin)
+            return;
+        grain = std::max(grain, 1);
+
+        // Nested calls, and calls made from the pool's own threads, stay on the calling thread
+        if (parallel_depth > 0)
+        {
+            body(begin, end);
+            return;
+        }
+
+        {
+            std::unique_lock<std::mutex> lock(_running_mutex);
+            _running_cv.wait(lock, [&]() { return !_resizing; });
+            ++_running;
+        }
+
+        int workers;
+        {
+            std::lock_guard<std::mutex> lock(_config_mutex);
+            if (!_started)
+                start_workers();
+            workers = int(_workers.size());
+        }
+
+        auto started = std::chrono::steady_clock::now();
+
+        // A few chunks per thread let the faster threads pick up the slack of the slower ones
+        auto items = end - begin;
+        auto j = std::make_shared<job>();
+        j->body = &body;
+        j->begin = begin;
+        j->end = end;
+        j->chunk_count = std::min((items + grain - 1) / grain, (workers + 1) * 4);
+        j->chunk_size = (items + j->chunk_count - 1) / j->chunk_count;
+        j->chunk_count = (items + j->chunk_size - 1) / j->chunk_size;
+
+        auto helpers = std::min(workers, j->chunk_count - 1);
+        if (helpers > 0)
+        {
+            for (int i = 0; i < helpers; ++i)
+            {
+                auto& w = *_workers[_next_worker++ % workers];
+                std::lock_guard<std::mutex> lock(w.mutex);
+                w.jobs.push_back(j);
+            }
+            {
+                std::lock_guard<std::mutex> lock(_wake_mutex);
+                _pending += helpers;
+            }
+            _wake.notify_all();
+        }
+
+        ++parallel_depth;
+        run_chunks(*j, false);
+        --parallel_depth;
+
+        {
+            std::unique_lock<std::mutex> lock(j->mutex);
+            j->done.wait(lock, [&]() { return j->done_chunks.load() == j->chunk_count; });
+        }
+
+        if (pipeline_stats::get_instance().is_enabled())
+        {
+            auto duration = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - started).count();
+            record(name, *j, duration);
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(_running_mutex);
+            --_running;
+        }
+        _running_cv.notify_all();
+
+        if (j->error)
+            std::rethrow_exception(j->error);
+    }
+
+    void thread_pool::record(const char* name, const job& j, double duration_ms)
+    {
+        task_stats* stats;
+        {
+            std::lock_guard<std::mutex> lock(_stats_mutex);
+            auto& entry = _stats[name ? name : ""];
+            if (!entry)
+                entry.reset(new task_stats());
+            stats = entry.get();    // entries are never removed
+        }
+        stats->chunks += j.chunk_count;
+        stats->stolen += j.stolen_chunks.load();
+        stats->duration.record(static_cast<uint64_t>(duration_ms * 1000));
+    }
+
+    std::vector<rs2_processing_task_stats> thread_pool::get_task_stats() const
+    {
+        std::vector<rs2_processing_task_stats> res;
+        std::lock_guard<std::mutex> lock(_stats_mutex);
+        for (auto&& entry : _stats)
+        {
+            rs2_processing_task_stats s = {};
+            strncpy(s.name, entry.first.c_str(), sizeof(s.name) - 1);
+            s.chunks = entry.second->chunks;
+            s.stolen = entry.second->stolen;
+            if (entry.second->duration.get_stats(s.duration))
+                res.push_back(s);
+        }
+        return res;
+    }
+
+    void thread_pool::reset_task_stats()
+    {
+        std::lock_guard<std::mutex> lock(_stats_mutex);
+        for (auto&& entry : _stats)
+        {
+            entry.second->chunks = 0;
+            entry.second->stolen = 0;
+            entry.second->duration.reset();
+        }
+    }
+}
@@ -0,0 +1,116 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2021 Intel Corporation. All Rights Reserved.
+
+#pragma once
+
+#include "pipeline-stats.h"
+#include "thread-placement.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace librealsense
+{
+    // Library-wide pool of worker threads for data-parallel work, shared by all processing blocks.
+    //
+    // parallel_for() splits a range into chunks that the calling thread and the workers claim one at
+    // a time, so a slow chunk never holds up the others. Each worker has its own queue of jobs to help
+    // with and steals from the queues of the other workers when its own runs dry. Calls nested inside
+    // a chunk run inline, which keeps the total number of busy threads bounded by the pool size.
+    class thread_pool
+    {
+    public:
+        // The pool is never destroyed: joining the workers from a static destructor can deadlock while the
+        // library is unloaded on Windows. Contexts release the workers instead when they are destroyed.
+        static thread_pool& get_instance();
+        ~thread_pool();
+
+        // Stop the workers, after the parallel_for calls in flight; the next parallel_for starts them again
+        void release_workers();
+
+        // Number of workers besides the calling thread. 0 runs everything on the calling thread,
+        // -1 (the default) uses one worker per core, less the calling thread.
+        void set_threads(int threads);
+        int get_threads() const;
+
+        // CPUs the workers are restricted to, none for no restriction
+        void set_affinity(const std::vector<int>& cpus);
+        std::vector<int> get_affinity() const;
+
+        // CPUs, scheduling priority and memory node of the workers
+        void set_placement(const thread_placement& placement);
+        thread_placement get_placement() const;
+
+        // Run body(chunk_begin, chunk_end) over [begin, end) in chunks of at least grain items, and
+        // return once every chunk is done. The first exception thrown by a chunk is rethrown here.
+        void parallel_for(const char* name, int begin, int end, int grain, const std::function<void(int, int)>& body);
+
+        // Chunk counts and run durations per task name, collected while pipeline statistics are enabled
+        std::vector<rs2_processing_task_stats> get_task_stats() const;
+        void reset_task_stats();
+
+    private:
+        struct job;
+        struct worker
+        {
+            std::mutex mutex;
+            std::deque<std::shared_ptr<job>> jobs;
+            std::thread thread;
+        };
+
+        struct task_stats
+        {
+            std::atomic<uint64_t> chunks;
+            std::atomic<uint64_t> stolen;
+            latency_histogram duration;
+
+            task_stats() : chunks(0), stolen(0) {}
+        };
+
+        thread_pool();
+
+        void reconfigure(const std::function<void()>& change);
+        void start_workers();
+        void stop_workers();
+        void worker_loop(int index, thread_placement placement);
+        std::shared_ptr<job> take_job(int index);
+        void run_chunks(job& j, bool on_worker);
+        void record(const char* name, const job& j, double duration_ms);
+
+        mutable std::mutex _config_mutex;      // guards the configuration and the worker set
+        int _requested_threads;
+        thread_placement _placement;
+        std::vector<std::unique_ptr<worker>> _workers;
+        bool _started;
+
+        std::mutex _wake_mutex;
+        std::condition_variable _wake;
+        int _pending;                           // jobs sitting in the worker queues, guarded by _wake_mutex
+        bool _stopping;
+        std::atomic<unsigned> _next_worker;
+
+        // Blocks resizing while a parallel_for is in flight
+        std::mutex _running_mutex;
+        std::condition_variable _running_cv;
+        int _running;
+        bool _resizing;
+
+        mutable std::mutex _stats_mutex;
+        std::map<std::string, std::unique_ptr<task_stats>> _stats;
+    };
+
+    // Run body(y_begin, y_end) over horizontal strips of an image
+    template<class T>
+    void parallel_for_rows(const char* name, int height, T&& body, int min_rows = 16)
+    {
+        thread_pool::get_instance().parallel_for(name, 0, height, min_rows, std::forward<T>(body));
+    }
+}
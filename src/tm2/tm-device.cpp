@@ -278,6 +278,13 @@ namespace librealsense
     {
     public:
         md_tm2_parser(rs2_frame_metadata_value type) : _type(type) {}
+        bool try_get(const frame& frm, rs2_metadata_type& value) const override
+        {
+            if (!supports(frm))
+                return false;
+            value = get(frm);
+            return true;
+        }
         rs2_metadata_type get(const frame& frm) const override
         {
             if(_type == RS2_FRAME_METADATA_ACTUAL_EXPOSURE)
@@ -361,6 +368,7 @@ namespace librealsense
     {
         LOG_DEBUG("Making a sensor " << this);
         _source.set_max_publish_list_size(256); //increase frame source queue size for TM2
+        _source.set_published_pool_size(256); // and preallocate as many frame slots
         _data_dispatcher = std::make_shared<dispatcher>(256); // make a queue of the same size to dispatch data messages
         _data_dispatcher->start();
         register_metadata(RS2_FRAME_METADATA_ACTUAL_EXPOSURE, std::make_shared<md_tm2_parser>(RS2_FRAME_METADATA_ACTUAL_EXPOSURE));
@@ -253,6 +253,49 @@ namespace librealsense
 #undef CASE
     }
 
+    const char* get_string(rs2_latency_stage value)
+    {
+#define CASE(X) STRCASE(LATENCY_STAGE, X)
+        switch (value)
+        {
+            CASE(BACKEND)
+            CASE(ARCHIVE)
+            CASE(PROCESSING)
+            CASE(SYNCER)
+            CASE(CALLBACK_START)
+            CASE(CALLBACK_END)
+        default: assert(!is_valid(value)); return UNKNOWN_VALUE;
+        }
+#undef CASE
+    }
+
+    const char* get_string(rs2_frame_drop_reason value)
+    {
+#define CASE(X) STRCASE(FRAME_DROP_REASON, X)
+        switch (value)
+        {
+            CASE(ARCHIVE_FULL)
+            CASE(QUEUE_OVERFLOW)
+            CASE(SYNCER_DISCARD)
+            CASE(LATENCY_BUDGET)
+        default: assert(!is_valid(value)); return UNKNOWN_VALUE;
+        }
+#undef CASE
+    }
+
+    const char* get_string(rs2_thread_role value)
+    {
+#define CASE(X) STRCASE(THREAD_ROLE, X)
+        switch (value)
+        {
+            CASE(CAPTURE)
+            CASE(DISPATCH)
+            CASE(PROCESSING)
+        default: assert(!is_valid(value)); return UNKNOWN_VALUE;
+        }
+#undef CASE
+    }
+
     const char* get_string(rs2_extension value)
     {
 #define CASE(X) STRCASE(EXTENSION, X)
@@ -444,6 +487,12 @@ namespace librealsense
             CASE(AUTO_GAIN_LIMIT)
             CASE(AUTO_RX_SENSITIVITY)
             CASE(TRANSMITTER_FREQUENCY)
+            CASE(CONVERSION_QUEUE_SIZE)
+            CASE(MOTION_BATCH_SIZE)
+            CASE(MOTION_BATCH_INTERVAL)
+            CASE(POINTS_LAYOUT)
+            CASE(POINTS_TEXTURE_COORDINATES)
+            CASE(FRAMES_POOL_SIZE)
         default: assert(!is_valid(value)); return UNKNOWN_VALUE;
         }
 #undef CASE
@@ -599,6 +648,20 @@ namespace librealsense
 #undef CASE
     }
 
+    const char* get_string(rs2_points_layout value)
+    {
+#define CASE(X) STRCASE(POINTS_LAYOUT, X)
+        switch (value)
+        {
+            CASE(FULL)
+            CASE(FLOAT32)
+            CASE(FLOAT16)
+            CASE(INT16)
+        default: assert(!is_valid(value)); return UNKNOWN_VALUE;
+        }
+#undef CASE
+    }
+
     const char* get_string(rs2_notification_category value)
     {
 #define CASE(X) STRCASE(NOTIFICATION_CATEGORY, X)
@@ -611,6 +674,7 @@ namespace librealsense
             CASE(UNKNOWN_ERROR)
             CASE(FIRMWARE_UPDATE_RECOMMENDED)
             CASE(POSE_RELOCALIZATION)
+            CASE(FRAMES_DROPPED)
         default: assert(!is_valid(value)); return UNKNOWN_VALUE;
         }
 #undef CASE
@@ -42,6 +42,10 @@
 #include <utility>                          // For std::forward
 #include <limits>
 #include <iomanip>
+#include <atomic>
+#ifdef _MSC_VER
+#include <intrin.h>                         // For _BitScanForward
+#endif
 #include "backend.h"
 #include "concurrency.h"
 
@@ -543,6 +547,7 @@ namespace librealsense
     RS2_ENUM_HELPERS(rs2_frame_metadata_value, FRAME_METADATA)
     RS2_ENUM_HELPERS(rs2_timestamp_domain, TIMESTAMP_DOMAIN)
     RS2_ENUM_HELPERS(rs2_calib_target_type, CALIB_TARGET)
+    RS2_ENUM_HELPERS(rs2_points_layout, POINTS_LAYOUT)
     RS2_ENUM_HELPERS(rs2_sr300_visual_preset, SR300_VISUAL_PRESET)
     RS2_ENUM_HELPERS(rs2_extension, EXTENSION)
     RS2_ENUM_HELPERS(rs2_exception_type, EXCEPTION_TYPE)
@@ -557,6 +562,9 @@ namespace librealsense
     RS2_ENUM_HELPERS_CUSTOMIZED(rs2_ambient_light, RS2_AMBIENT_LIGHT_NO_AMBIENT, RS2_AMBIENT_LIGHT_LOW_AMBIENT)
     RS2_ENUM_HELPERS_CUSTOMIZED(rs2_digital_gain, RS2_DIGITAL_GAIN_HIGH, RS2_DIGITAL_GAIN_LOW)
     RS2_ENUM_HELPERS(rs2_host_perf_mode, HOST_PERF)
+    RS2_ENUM_HELPERS(rs2_latency_stage, LATENCY_STAGE)
+    RS2_ENUM_HELPERS(rs2_frame_drop_reason, FRAME_DROP_REASON)
+    RS2_ENUM_HELPERS(rs2_thread_role, THREAD_ROLE)
 
 
     ////////////////////////////////////////////
@@ -1199,72 +1207,104 @@ namespace librealsense
         return (c0 << 24) | (c1 << 16) | (c2 << 8) | c3;
     }
 
+    // Fixed pool of T slots, C by default. Slots are claimed from an atomic bitmap so that
+    // allocate() and deallocate() never block; only waiting for the pool to drain takes a lock.
     template<class T, int C>
     class small_heap
     {
-        T buffer[C];
-        bool is_free[C];
+        std::unique_ptr<T[]> buffer;
+        std::unique_ptr<std::atomic<uint64_t>[]> used; // one bit per slot, set while allocated
+        int capacity;
+        int words;
+        std::atomic<bool> keep_allocating{ true };
+        std::atomic<int> size{ 0 };
         std::mutex mutex;
-        bool keep_allocating = true;
         std::condition_variable cv;
-        int size = 0;
 
-    public:
-        static const int CAPACITY = C;
+        static int find_first_zero(uint64_t bits)
+        {
+            const uint64_t free_bits = ~bits;
+#ifdef _MSC_VER
+            unsigned long index;
+            if (_BitScanForward(&index, static_cast<unsigned long>(free_bits)))
+                return static_cast<int>(index);
+            _BitScanForward(&index, static_cast<unsigned long>(free_bits >> 32));
+            return static_cast<int>(index) + 32;
+#else
+            return __builtin_ctzll(free_bits);
+#endif
+        }
 
-        small_heap()
+        void release_count()
         {
-            for (auto i = 0; i < C; i++)
+            if (--size == 0)
             {
-                is_free[i] = true;
-                buffer[i] = std::move(T());
+                // Taking the lock orders the notification after a waiter's predicate check
+                std::lock_guard<std::mutex> lock(mutex);
+                cv.notify_all();
             }
         }
 
+    public:
+        static const int CAPACITY = C;
+
+        explicit small_heap(int capacity = C)
+            : buffer(new T[capacity]),
+              used(new std::atomic<uint64_t>[(capacity + 63) / 64]),
+              capacity(capacity),
+              words((capacity + 63) / 64)
+        {
+            for (auto w = 0; w < words; w++)
+                used[w] = 0;
+            // Slots past the capacity are permanently taken
+            if (capacity % 64)
+                used[words - 1] = ~uint64_t(0) << (capacity % 64);
+        }
+
         T * allocate()
         {
-            std::unique_lock<std::mutex> lock(mutex);
-            if (!keep_allocating) return nullptr;
+            // Count the slot before checking for a stop: flush() stops allocation and then reads
+            // the size, so it either sees this allocation or this allocation sees the stop
+            ++size;
+            if (!keep_allocating)
+            {
+                release_count();
+                return nullptr;
+            }
 
-            for (auto i = 0; i < C; i++)
+            for (auto w = 0; w < words; w++)
             {
-                if (is_free[i])
+                auto bits = used[w].load(std::memory_order_relaxed);
+                while (bits != ~uint64_t(0))
                 {
-                    is_free[i] = false;
-                    size++;
-                    return &buffer[i];
+                    auto bit = find_first_zero(bits);
+                    if (used[w].compare_exchange_weak(bits, bits | (uint64_t(1) << bit), std::memory_order_acquire, std::memory_order_relaxed))
+                        return &buffer[w * 64 + bit];
                 }
             }
+
+            release_count();
             return nullptr;
         }
 
         void deallocate(T * item)
         {
-             if (item < buffer || item >= buffer + C)
+            if (item < buffer.get() || item >= buffer.get() + capacity)
             {
                 throw invalid_value_exception("Trying to return item to a heap that didn't allocate it!");
             }
-            auto i = item - buffer;
-            auto old_value = std::move(buffer[i]);
-            buffer[i] = std::move(T());
+            auto i = item - buffer.get();
 
-            {
-                std::unique_lock<std::mutex> lock(mutex);
+            // Reset in place through T's own assignment (some types rely on it to keep their
+            // buffers); the slot stays ours until its bit is cleared
+            *item = T();
 
-                is_free[i] = true;
-                size--;
-
-                if (size == 0)
-                {
-                    lock.unlock();
-                    cv.notify_one();
-                }
-            }
+            used[i / 64].fetch_and(~(uint64_t(1) << (i % 64)), std::memory_order_release);
+            release_count();
         }
 
         void stop_allocation()
         {
-            std::unique_lock<std::mutex> lock(mutex);
             keep_allocating = false;
         }
 
@@ -1284,6 +1324,7 @@ namespace librealsense
 
         bool is_empty() const { return size == 0; }
         int get_size() const { return size; }
+        int get_capacity() const { return capacity; }
     };
 
     struct uvc_device_info
@@ -5,12 +5,9 @@
 #include "../backend.h"
 
 const int UVC_PAYLOAD_MAX_HEADER_LENGTH         = 1024;
-const int DEQUEUE_MILLISECONDS_TIMEOUT          = 50;
 const int ENDPOINT_RESET_MILLISECONDS_TIMEOUT   = 100;
-
-void cleanup_frame(backend_frame *ptr) {
-    if (ptr) ptr->owner->deallocate(ptr);
-}
+// Requests a streamer allocates at most; the dispatcher queue must fit their completions
+const int UVC_MAX_REQUESTS                      = 8;
 
 namespace librealsense
 {
@@ -39,113 +36,153 @@ namespace librealsense
             flush();
         }
 
-        void uvc_process_bulk_payload(backend_frame_ptr fp, size_t payload_len, backend_frames_queue& queue) {
+        void uvc_streamer::init()
+        {
+            _watchdog = std::make_shared<watchdog>([this]()
+             {
+                 _action_dispatcher.invoke([this](dispatcher::cancellable_timer c)
+                   {
+                       if(!_running || !_frame_arrived)
+                           return;
 
-            /* ignore empty payload transfers */
-            if (!fp || payload_len < 2)
-                return;
+                       LOG_ERROR("uvc streamer watchdog triggered on endpoint: " << (int)_read_endpoint->get_address());
+                       _context.messenger->reset_endpoint(_read_endpoint, ENDPOINT_RESET_MILLISECONDS_TIMEOUT);
+                       _frame_arrived = false;
+                   });
+             }, _watchdog_timeout);
+
+            _watchdog->start();
 
-            uint8_t header_len = fp->pixels[0];
-            uint8_t header_info = fp->pixels[1];
+            std::lock_guard<std::mutex> lock(_requests_mutex);
+            _target_in_flight = std::max<int>(_context.request_count, 1);
+        }
 
-            size_t data_len = payload_len - header_len;
+        rs_usb_request uvc_streamer::create_request()
+        {
+            auto r = _context.messenger->create_request(_read_endpoint);
+            r->set_buffer(std::vector<uint8_t>(_read_buff_length));
+            r->set_callback(_request_callback);
+            _requests.push_back(r);
+            return r;
+        }
 
-            if (header_info & 0x40)
+        void uvc_streamer::submit_requests()
+        {
+            while (_submitting && _in_flight < _target_in_flight)
             {
-                LOG_ERROR("bad packet: error bit set");
-                return;
+                rs_usb_request r;
+                if (!_idle.empty())
+                {
+                    r = _idle.back();
+                    _idle.pop_back();
+                }
+                else if (_requests.size() < size_t(UVC_MAX_REQUESTS))
+                    r = create_request();
+                else
+                    break;
+
+                auto sts = _context.messenger->submit_request(r);
+                if (sts != platform::RS2_USB_STATUS_SUCCESS)
+                {
+                    LOG_ERROR("failed to submit UVC request, error: " << sts);
+                    _idle.push_back(r);
+                    break;
+                }
+                ++_in_flight;
             }
-            if (header_len > payload_len)
+
+            // Requests allocated while the user callback was busy are freed once they are back, but for a spare
+            while (_idle.size() > 1 && _requests.size() > size_t(_target_in_flight + 1))
             {
-                LOG_ERROR("bogus packet: actual_len=" << payload_len << ", header_len=" << header_len);
-                return;
+                _requests.erase(std::find(_requests.begin(), _requests.end(), _idle.back()));
+                _idle.pop_back();
             }
+        }
 
+        void uvc_streamer::on_request_returned()
+        {
+            std::lock_guard<std::mutex> lock(_requests_mutex);
+            --_in_flight;
 
-            LOG_DEBUG("Passing packet to user CB with size " << (data_len + header_len));
-            librealsense::platform::frame_object fo{ data_len, header_len,
-                                                     fp->pixels.data() + header_len , fp->pixels.data() };
-            fp->fo = fo;
-
-            queue.enqueue(std::move(fp));
+            // The endpoint was left without a request to fill, and may have dropped data: keep more submitted.
+            // A second of requests returned without that lets the number down again
+            if (_in_flight == 0 && _target_in_flight < UVC_MAX_REQUESTS)
+            {
+                ++_target_in_flight;
+                _returned_since_starved = 0;
+            }
+            else if (++_returned_since_starved >= int(_context.profile.fps) && _target_in_flight > std::max<int>(_context.request_count, 1))
+            {
+                --_target_in_flight;
+                _returned_since_starved = 0;
+            }
         }
 
-        void uvc_streamer::init()
+        void uvc_streamer::on_request_completed(const rs_usb_request& r)
         {
-            _frames_archive = std::make_shared<backend_frames_archive>();
-            // Get all pointers from archive and initialize their content
-            std::vector<backend_frame *> frames;
-            for (auto i = 0; i < _frames_archive->CAPACITY; i++) {
-                auto ptr = _frames_archive->allocate();
-                ptr->pixels.resize(_read_buff_length, 0);
-                ptr->owner = _frames_archive.get();
-                frames.push_back(ptr);
-            }
+            if(!_running)
+                return;
+
+            auto al = r->get_actual_length();
+            // Relax the frame size constrain for compressed streams
+            bool is_compressed = val_in_range(_context.profile.format, { 0x4d4a5047U , 0x5a313648U}); // MJPEG, Z16H
+            bool is_frame = al > 0L && ((al == r->get_buffer().data()[0] + _context.control->dwMaxVideoFrameSize) || is_compressed);
+            bool publish_frame = is_frame && _publish_frames;
 
-            for (auto ptr : frames) {
-                _frames_archive->deallocate(ptr);
+            // Other requests keep the endpoint busy while the user callback reads this one
+            {
+                std::lock_guard<std::mutex> lock(_requests_mutex);
+                if (!publish_frame)
+                    _idle.push_back(r);
+                submit_requests();
             }
 
-            _publish_frame_thread = std::make_shared<active_object<>>([this](dispatcher::cancellable_timer cancellable_timer)
+            if (is_frame)
             {
-                backend_frame_ptr fp(nullptr, [](backend_frame *) {});
-                if (_queue.dequeue(&fp, DEQUEUE_MILLISECONDS_TIMEOUT))
-                {
-                    if(_publish_frames && running())
-                        _context.user_cb(_context.profile, fp->fo, []() mutable {});
-                }
-            });
+                _frame_arrived = true;
+                _watchdog->kick();
+            }
+            if (publish_frame)
+            {
+                publish(r, al);
+                release(r);
+            }
+        }
 
-            _watchdog = std::make_shared<watchdog>([this]()
-             {
-                 _action_dispatcher.invoke([this](dispatcher::cancellable_timer c)
-                   {
-                       if(!_running || !_frame_arrived)
-                           return;
+        void uvc_streamer::publish(const rs_usb_request& r, int payload_length)
+        {
+            auto&& buffer = r->get_buffer();
 
-                       LOG_ERROR("uvc streamer watchdog triggered on endpoint: " << (int)_read_endpoint->get_address());
-                       _context.messenger->reset_endpoint(_read_endpoint, ENDPOINT_RESET_MILLISECONDS_TIMEOUT);
-                       _frame_arrived = false;
-                   });
-             }, _watchdog_timeout);
+            /* ignore empty payload transfers */
+            if (payload_length < 2)
+                return;
 
-            _watchdog->start();
+            uint8_t header_len = buffer[0];
+            uint8_t header_info = buffer[1];
 
-            _request_callback = std::make_shared<usb_request_callback>([this](platform::rs_usb_request r)
+            if (header_info & 0x40)
             {
-                _action_dispatcher.invoke([this, r](dispatcher::cancellable_timer)
-                {
-                    if(!_running)
-                      return;
-
-                    auto al = r->get_actual_length();
-                    // Relax the frame size constrain for compressed streams
-                    bool is_compressed = val_in_range(_context.profile.format, { 0x4d4a5047U , 0x5a313648U}); // MJPEG, Z16H
-                    if(al > 0L && ((al == r->get_buffer().data()[0] + _context.control->dwMaxVideoFrameSize) || is_compressed ))
-                    {
-                        auto f = backend_frame_ptr(_frames_archive->allocate(), &cleanup_frame);
-                        if(f)
-                        {
-                            _frame_arrived = true;
-                            _watchdog->kick();
-                            memcpy(f->pixels.data(), r->get_buffer().data(), r->get_buffer().size());
-                            uvc_process_bulk_payload(std::move(f), r->get_actual_length(), _queue);
-                        }
-                    }
-
-                    auto sts = _context.messenger->submit_request(r);
-                    if(sts != platform::RS2_USB_STATUS_SUCCESS)
-                        LOG_ERROR("failed to submit UVC request, error: " << sts);
-                });
-            });
-
-            _requests = std::vector<rs_usb_request>(_context.request_count);
-            for(auto&& r : _requests)
+                LOG_ERROR("bad packet: error bit set");
+                return;
+            }
+            if (header_len > payload_length)
             {
-                r = _context.messenger->create_request(_read_endpoint);
-                r->set_buffer(std::vector<uint8_t>(_read_buff_length));
-                r->set_callback(_request_callback);
+                LOG_ERROR("bogus packet: actual_len=" << payload_length << ", header_len=" << header_len);
+                return;
             }
+
+            LOG_DEBUG("Passing packet to user CB with size " << payload_length);
+            librealsense::platform::frame_object fo{ size_t(payload_length - header_len), header_len,
+                                                     buffer.data() + header_len, buffer.data() };
+            // The callback copies the payload into a frame of its own before it returns
+            _context.user_cb(_context.profile, fo, []() {});
+        }
+
+        void uvc_streamer::release(const rs_usb_request& r)
+        {
+            std::lock_guard<std::mutex> lock(_requests_mutex);
+            _idle.push_back(r);
+            submit_requests();
         }
 
         void uvc_streamer::start()
@@ -162,14 +199,21 @@ namespace librealsense
                     _running = true;
                 }
 
-                for(auto&& r : _requests)
+                // Stopping cancels the callback for good, so every run gets its own, and its own requests
+                _request_callback = std::make_shared<usb_request_callback>([this](platform::rs_usb_request r)
                 {
-                    auto sts = _context.messenger->submit_request(r);
-                    if(sts != platform::RS2_USB_STATUS_SUCCESS)
-                        throw std::runtime_error("failed to submit UVC request while start streaming");
-                }
+                    on_request_returned();
+                    _action_dispatcher.invoke([this, r](dispatcher::cancellable_timer)
+                    {
+                        on_request_completed(r);
+                    });
+                });
 
-                _publish_frame_thread->start();
+                std::lock_guard<std::mutex> lock(_requests_mutex);
+                _submitting = true;
+                submit_requests();
+                if (_in_flight < _target_in_flight)
+                    throw std::runtime_error("failed to submit UVC request while start streaming");
 
             }, [this](){ return _running; });
         }
@@ -185,21 +229,26 @@ namespace librealsense
 
                 _watchdog->stop();
 
-                _frames_archive->stop_allocation();
-
-                _queue.clear();
+                std::vector<rs_usb_request> requests;
+                {
+                    std::lock_guard<std::mutex> lock(_requests_mutex);
+                    _submitting = false;
+                    requests = _requests;
+                }
 
-                for(auto&& r : _requests)
+                for(auto&& r : requests)
                   _context.messenger->cancel_request(r);
 
-                _requests.clear();
-
-                _frames_archive->wait_until_empty();
+                // A request with the user callback is released once it returns, which also runs on the dispatcher thread
+                {
+                    std::lock_guard<std::mutex> lock(_requests_mutex);
+                    _requests.clear();
+                    _idle.clear();
+                    _in_flight = 0;
+                }
 
                 _context.messenger->reset_endpoint(_read_endpoint, RS2_USB_ENDPOINT_DIRECTION_READ);
 
-                _publish_frame_thread->stop();
-
                 {
                     std::lock_guard<std::mutex> lock(_running_mutex);
                     _running = false;
@@ -223,11 +272,8 @@ namespace librealsense
             _read_endpoint.reset();
 
             _watchdog.reset();
-            _publish_frame_thread.reset();
             _request_callback.reset();
 
-            _frames_archive.reset();
-
             _action_dispatcher.stop();
         }
 
@@ -243,5 +289,17 @@ namespace librealsense
             }
             return _frame_arrived;
         }
+
+        size_t uvc_streamer::get_requests_count()
+        {
+            std::lock_guard<std::mutex> lock(_requests_mutex);
+            return _requests.size();
+        }
+
+        int uvc_streamer::get_target_in_flight()
+        {
+            std::lock_guard<std::mutex> lock(_requests_mutex);
+            return _target_in_flight;
+        }
     }
 }
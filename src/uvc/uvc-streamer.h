@@ -28,6 +28,9 @@ namespace librealsense
             uint8_t request_count;
         };
 
+        // Streams the bulk endpoint of a UVC interface. The user callback reads the payload straight from the
+        // buffer of the USB request that completed with it, and the request is submitted again once the callback
+        // returns. Other requests, up to a limit, are submitted meanwhile to keep the endpoint busy.
         class uvc_streamer
         {
         public:
@@ -43,6 +46,11 @@ namespace librealsense
             void disable_user_callbacks() { _publish_frames = false; }
             bool wait_for_first_frame(uint32_t timeout_ms);
 
+            // Requests allocated, whether submitted, with the user callback or idle
+            size_t get_requests_count();
+            // Requests the streamer currently aims to keep submitted
+            int get_target_in_flight();
+
         private:
             std::mutex _running_mutex;
             std::condition_variable _stopped_cv;
@@ -57,15 +65,29 @@ namespace librealsense
 
             std::shared_ptr<watchdog> _watchdog;
             uint32_t _read_buff_length;
-            backend_frames_queue _queue;
             rs_usb_endpoint _read_endpoint;
-            std::vector<rs_usb_request> _requests;
-            std::shared_ptr<backend_frames_archive> _frames_archive;
-            std::shared_ptr<active_object<>> _publish_frame_thread;
             std::shared_ptr<platform::usb_request_callback> _request_callback;
 
+            std::mutex _requests_mutex;
+            bool _submitting = false;                   // requests are only submitted while streaming
+            std::vector<rs_usb_request> _requests;      // every request allocated
+            std::vector<rs_usb_request> _idle;          // neither submitted nor with the user callback
+            int _in_flight = 0;
+            int _target_in_flight = 0;
+            int _returned_since_starved = 0;
+
             void init();
             void flush();
+
+            // On the USB thread, as soon as a request is back from the endpoint
+            void on_request_returned();
+            // On the dispatcher thread, to publish the frame of the request, then submit it again
+            void on_request_completed(const rs_usb_request& request);
+            void publish(const rs_usb_request& request, int payload_length);
+            void release(const rs_usb_request& request);
+            // Called with _requests_mutex held
+            void submit_requests();
+            rs_usb_request create_request();
         };
     }
 }
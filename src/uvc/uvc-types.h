@@ -413,29 +413,3 @@ T as(const std::vector<uint8_t>& data, size_t index)
     }
     return rv;
 }
-
-struct backend_frame;
-
-typedef librealsense::small_heap<backend_frame, 10> backend_frames_archive;
-
-struct backend_frame {
-    backend_frame() {}
-
-    // We don't want the frames to be overwritten at any point
-    // (deallocate resets item to "default" that we want to avoid)
-    backend_frame(const backend_frame &other) {}
-
-    backend_frame(backend_frame &&other) {}
-
-    backend_frame &operator=(const backend_frame &other) { return *this; }
-
-    std::vector<uint8_t> pixels;
-    librealsense::platform::frame_object fo;
-    backend_frames_archive *owner; // Keep pointer to owner for light-deleter
-};
-
-typedef void(*cleanup_ptr)(backend_frame *);
-
-// Unique_ptr is used as the simplest RAII, with static deleter
-typedef std::unique_ptr<backend_frame, cleanup_ptr> backend_frame_ptr;
-typedef single_consumer_queue<backend_frame_ptr> backend_frames_queue;
@@ -121,6 +121,8 @@ public:
     void            setCompression(CompressionType compression);  //!< Set the compression method to use for writing chunks
     CompressionType getCompression() const;                       //!< Get the compression method to use for writing chunks
     std::tuple<std::string, uint64_t, uint64_t> getCompressionInfo() const;
+    //! The message of a topic at a position of the index of the bag (see MessageInstance::getIndexEntry), without a View
+    MessageInstance getMessage(std::string const& topic, IndexEntry const& index_entry) const;
     void            setChunkThreshold(uint32_t chunk_threshold);  //!< Set the threshold for creating new chunks
     uint32_t        getChunkThreshold() const;                    //!< Get the threshold for creating new chunks
 
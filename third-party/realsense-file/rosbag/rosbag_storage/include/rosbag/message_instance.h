@@ -59,6 +59,7 @@ class Bag;
 class ROSBAG_DECL MessageInstance
 {
     friend class View;
+    friend class Bag;
   
 public:
     rs2rosinternal::Time   const& getTime()              const;
@@ -93,6 +94,9 @@ public:
     //! Size of serialized message
     uint32_t size() const;
 
+    //! Position of the message in the bag, for Bag::getMessage to read it again
+    IndexEntry const& getIndexEntry() const;
+
 private:
     MessageInstance(ConnectionInfo const* connection_info, IndexEntry const& index, Bag const& bag);
 
@@ -238,6 +238,17 @@ std::tuple<std::string, uint64_t, uint64_t> Bag::getCompressionInfo() const
     //auto main_compression_count = compression_counts.begin()->second;
     return std::make_tuple(main_compression, compressed, uncompressed);
 }
+
+MessageInstance Bag::getMessage(string const& topic, IndexEntry const& index_entry) const
+{
+    // topic_connection_ids_ is only kept while writing
+    for (map<uint32_t, ConnectionInfo*>::const_iterator i = connections_.begin(); i != connections_.end(); i++)
+        if (i->second->topic == topic)
+            return MessageInstance(i->second, index_entry, *this);
+
+    throw BagException((format("Unknown topic: %1%") % topic).str());
+}
+
 void Bag::setCompression(CompressionType compression) {
     if (file_.isOpen() && chunk_open_)
         stopWritingChunk();
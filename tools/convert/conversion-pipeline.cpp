@@ -0,0 +1,211 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2021 Intel Corporation. All Rights Reserved.
+
+#include "conversion-pipeline.hpp"
+
+#include <cstdio>
+#include <iostream>
+
+using namespace rs2::tools::converter;
+
+namespace
+{
+    // Beyond this, workers mostly wait for decoding and writing
+    const unsigned max_default_workers = 8;
+    // Playback hands out about 16 frames of every stream before dropping the next
+    const unsigned max_frames_in_flight = 12;
+    // Frame numbers kept per stream to skip the frames playback repeats
+    const size_t max_recent_frames = 64;
+
+    double seconds_between(std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point end)
+    {
+        return std::max(std::chrono::duration<double>(end - start).count(), 1e-3);
+    }
+}
+
+unsigned conversion_pipeline::default_workers()
+{
+    auto cores = std::thread::hardware_concurrency();
+    return std::max(1u, std::min(cores, max_default_workers));
+}
+
+conversion_pipeline::conversion_pipeline(std::vector<std::shared_ptr<converter_base>> converters,
+    std::shared_ptr<output_writer> writer, unsigned workers, unsigned max_in_flight)
+    : _converters(std::move(converters))
+    , _writer(std::move(writer))
+    , _frames(max_in_flight ? max_in_flight : std::min(std::max(workers, 1u) + 2, max_frames_in_flight))
+    , _outputs(std::max(workers, 1u) * 2)
+    , _frames_converted(0)
+    , _files_written(0)
+    , _bytes_written(0)
+    , _start(std::chrono::steady_clock::now())
+    , _last_progress(_start)
+{
+    for (unsigned i = 0; i < std::max(workers, 1u); ++i)
+        _workers.emplace_back([this] { work(); });
+    _writer_thread = std::thread([this] { write(); });
+}
+
+conversion_pipeline::~conversion_pipeline()
+{
+    try {
+        finish();
+    }
+    catch (...) {
+    }
+}
+
+void conversion_pipeline::fail()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (!_error)
+        _error = std::current_exception();
+}
+
+void conversion_pipeline::work()
+{
+    rs2::frame frame;
+    while (_frames.pop(frame)) {
+        std::vector<output_file> outputs;
+        bool failed;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            failed = bool(_error);
+        }
+
+        // After a failure the frames left are only drained
+        if (!failed) {
+            try {
+                for (auto& converter : _converters)
+                    converter->convert(frame, outputs);
+                ++_frames_converted;
+            }
+            catch (...) {
+                fail();
+            }
+        }
+
+        // Let go of the frame before waiting for the writer, for playback to reuse it
+        frame = rs2::frame();
+        if (!outputs.empty())
+            _outputs.push(std::move(outputs));
+        _frames.done();
+    }
+}
+
+void conversion_pipeline::write()
+{
+    std::vector<output_file> outputs;
+    while (_outputs.pop(outputs)) {
+        bool failed;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            failed = bool(_error);
+        }
+
+        if (!failed) {
+            try {
+                for (auto& file : outputs) {
+                    _writer->write(file);
+                    ++_files_written;
+                    _bytes_written += file.data.size();
+                }
+            }
+            catch (...) {
+                fail();
+            }
+        }
+
+        outputs.clear();
+        _outputs.done();
+    }
+}
+
+bool conversion_pipeline::push(const rs2::frame& frame)
+{
+    rs2::frame key_frame = frame;
+    if (auto frameset = frame.as<rs2::frameset>()) {
+        key_frame = frameset.get_depth_frame();
+        if (!key_frame)
+            key_frame = frameset[0];
+    }
+
+    auto profile = key_frame.get_profile();
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_error)
+            std::rethrow_exception(_error);
+        auto& recent = _recent[std::make_pair(int(profile.stream_type()), profile.stream_index())];
+        auto number = key_frame.get_frame_number();
+        if (std::find(recent.begin(), recent.end(), number) != recent.end())
+            return false;
+        recent.push_back(number);
+        if (recent.size() > max_recent_frames)
+            recent.pop_front();
+    }
+
+    _frames.push(frame);
+    return true;
+}
+
+void conversion_pipeline::finish()
+{
+    if (_finished)
+        return;
+    _finished = true;
+
+    _frames.close();
+    for (auto& worker : _workers)
+        worker.join();
+
+    // The files made of all the frames, written after the rest
+    for (auto& converter : _converters) {
+        std::vector<output_file> outputs;
+        try {
+            converter->finish(outputs);
+        }
+        catch (...) {
+            fail();
+        }
+        if (!outputs.empty())
+            _outputs.push(std::move(outputs));
+    }
+
+    _outputs.close();
+    _writer_thread.join();
+    _end = std::chrono::steady_clock::now();
+
+    if (_error)
+        std::rethrow_exception(_error);
+}
+
+void conversion_pipeline::report_progress(uint64_t position, uint64_t duration)
+{
+    auto now = std::chrono::steady_clock::now();
+    if (now - _last_progress < std::chrono::milliseconds(250))
+        return;
+    _last_progress = now;
+
+    auto seconds = seconds_between(_start, now);
+    char line[128];
+    snprintf(line, sizeof(line), "\r%3d%% | %llu frames | %.1f frames/s | %.1f MB/s   ",
+        duration ? static_cast<int>(position * 100. / duration) : 0,
+        static_cast<unsigned long long>(_frames_converted),
+        _frames_converted / seconds,
+        _bytes_written / seconds / (1024 * 1024));
+    std::cout << line << std::flush;
+}
+
+std::string conversion_pipeline::get_statistics() const
+{
+    auto seconds = seconds_between(_start, _finished ? _end : std::chrono::steady_clock::now());
+    char line[256];
+    snprintf(line, sizeof(line), "%llu frame(s) converted into %llu file(s), %.1f MB in %.1f s (%.1f frames/s, %.1f MB/s)",
+        static_cast<unsigned long long>(_frames_converted),
+        static_cast<unsigned long long>(_files_written),
+        _bytes_written / (1024. * 1024),
+        seconds,
+        _frames_converted / seconds,
+        _bytes_written / seconds / (1024 * 1024));
+    return line;
+}
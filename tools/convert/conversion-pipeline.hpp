@@ -0,0 +1,139 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2021 Intel Corporation. All Rights Reserved.
+
+#ifndef __RS_CONVERTER_CONVERSION_PIPELINE_H
+#define __RS_CONVERTER_CONVERSION_PIPELINE_H
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <map>
+#include <thread>
+#include <utility>
+
+#include "converter.hpp"
+#include "writers.hpp"
+
+
+namespace rs2 {
+    namespace tools {
+        namespace converter {
+
+            // A queue of at most capacity items, counting the ones popped until they are done with:
+            // push() blocks while it is full, which holds back whoever feeds it
+            template <typename T>
+            class bounded_queue {
+                std::mutex _mutex;
+                std::condition_variable _not_full;
+                std::condition_variable _not_empty;
+                std::deque<T> _items;
+                size_t _capacity;
+                size_t _in_flight = 0;
+                bool _closed = false;
+
+            public:
+                explicit bounded_queue(size_t capacity) : _capacity(std::max<size_t>(capacity, 1)) {}
+
+                void push(T item)
+                {
+                    std::unique_lock<std::mutex> lock(_mutex);
+                    _not_full.wait(lock, [this] { return _in_flight < _capacity || _closed; });
+                    if (_closed)
+                        return;
+                    ++_in_flight;
+                    _items.push_back(std::move(item));
+                    _not_empty.notify_one();
+                }
+
+                // False once the queue is closed and empty
+                bool pop(T& item)
+                {
+                    std::unique_lock<std::mutex> lock(_mutex);
+                    _not_empty.wait(lock, [this] { return !_items.empty() || _closed; });
+                    if (_items.empty())
+                        return false;
+                    item = std::move(_items.front());
+                    _items.pop_front();
+                    return true;
+                }
+
+                // Called once a popped item is done with, to make room for the next
+                void done()
+                {
+                    std::lock_guard<std::mutex> lock(_mutex);
+                    --_in_flight;
+                    _not_full.notify_one();
+                }
+
+                // Lets the consumers drain the items left and stop
+                void close()
+                {
+                    std::lock_guard<std::mutex> lock(_mutex);
+                    _closed = true;
+                    _not_full.notify_all();
+                    _not_empty.notify_all();
+                }
+            };
+
+            // Converts frames in three stages: the caller decodes and pushes frames, a pool of workers runs every
+            // converter on them, and a single writer writes the files they make. Each stage holds a bounded number
+            // of items, so a slow stage slows down the ones before it rather than piling up frames in memory.
+            class conversion_pipeline {
+                std::vector<std::shared_ptr<converter_base>> _converters;
+                std::shared_ptr<output_writer> _writer;
+
+                bounded_queue<rs2::frame> _frames;
+                bounded_queue<std::vector<output_file>> _outputs;
+                std::vector<std::thread> _workers;
+                std::thread _writer_thread;
+
+                std::mutex _mutex;
+                // The last frame numbers pushed of every stream, by type and index: playback repeats only recent frames
+                std::map<std::pair<int, int>, std::deque<unsigned long long>> _recent;
+                std::exception_ptr _error;
+
+                std::atomic<unsigned long long> _frames_converted;
+                std::atomic<unsigned long long> _files_written;
+                std::atomic<unsigned long long> _bytes_written;
+                std::chrono::steady_clock::time_point _start;
+                std::chrono::steady_clock::time_point _last_progress;
+                std::chrono::steady_clock::time_point _end;
+                bool _finished = false;
+
+                void work();
+                void write();
+                void fail();
+
+            public:
+                // Number of workers to use when not told otherwise
+                static unsigned default_workers();
+
+                // Frames pushed and not yet converted are kept to max_in_flight; playback only has so many
+                // frames of every stream to hand out before it has to drop them, so this stays small
+                conversion_pipeline(std::vector<std::shared_ptr<converter_base>> converters,
+                    std::shared_ptr<output_writer> writer,
+                    unsigned workers = default_workers(),
+                    unsigned max_in_flight = 0);
+                ~conversion_pipeline();
+
+                // Hands a frame, or a frameset, over to the workers, blocking while they are busy with enough of
+                // them. Frames the pipeline has recently seen of their stream, as playback repeats some, are skipped and false returned
+                bool push(const rs2::frame& frame);
+
+                // Waits for every frame pushed to be converted and written; rethrows the first error of any stage.
+                // The writer is left open, for other pipelines to share
+                void finish();
+
+                // Prints the progress of the conversion, position of duration, to one line of the console
+                void report_progress(uint64_t position, uint64_t duration);
+
+                std::string get_statistics() const;
+            };
+
+        }
+    }
+}
+
+
+#endif
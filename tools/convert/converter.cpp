@@ -1,18 +1,15 @@
 // License: Apache 2.0. See LICENSE file in root directory.
 // Copyright(c) 2021 Intel Corporation. All Rights Reserved.
 
-#include <fstream>
 #include "converter.hpp"
 
 using namespace rs2::tools::converter;
 
-void rs2::tools::converter::metadata_to_txtfile(const rs2::frame& frm, const std::string& filename)
+std::string rs2::tools::converter::metadata_to_text(const rs2::frame& frm)
 {
-    std::ofstream file;
+    std::stringstream text;
 
-    file.open(filename);
-
-    file << "Stream: " << rs2_stream_to_string(frm.get_profile().stream_type()) << "\n";
+    text << "Stream: " << rs2_stream_to_string(frm.get_profile().stream_type()) << "\n";
 
     // Record all the available metadata attributes
     for (size_t i = 0; i < RS2_FRAME_METADATA_COUNT; i++)
@@ -20,43 +17,60 @@ void rs2::tools::converter::metadata_to_txtfile(const rs2::frame& frm, const std
         rs2_frame_metadata_value metadata_val = (rs2_frame_metadata_value)i;
         if (frm.supports_frame_metadata(metadata_val))
         {
-            file << rs2_frame_metadata_to_string(metadata_val) << ": "
+            text << rs2_frame_metadata_to_string(metadata_val) << ": "
                 << frm.get_frame_metadata(metadata_val) << "\n";
         }
     }
 
-    file.close();
+    return text.str();
 }
 
-bool converter_base::frames_map_get_and_set(rs2_stream streamType, frame_number_t frameNumber)
+std::vector<float> rs2::tools::converter::depth_in_meters(const rs2::depth_frame& frm)
 {
-    if (_framesMap.find(streamType) == _framesMap.end()) {
-        _framesMap.emplace(streamType, std::unordered_set<frame_number_t>());
+    std::vector<float> meters;
+    meters.reserve(frm.get_width() * frm.get_height());
+
+    if (frm.get_profile().format() == RS2_FORMAT_Z16) {
+        auto units = frm.get_units();
+        auto data = static_cast<const uint8_t*>(frm.get_data());
+        for (int y = 0; y < frm.get_height(); y++) {
+            auto row = reinterpret_cast<const uint16_t*>(data + y * frm.get_stride_in_bytes());
+            for (int x = 0; x < frm.get_width(); x++)
+                meters.push_back(row[x] * units);
+        }
     }
-
-    auto& set = _framesMap[streamType];
-    bool result = (set.find(frameNumber) != set.end());
-
-    if (!result) {
-        set.emplace(frameNumber);
+    else {
+        for (int y = 0; y < frm.get_height(); y++)
+            for (int x = 0; x < frm.get_width(); x++)
+                meters.push_back(frm.get_distance(x, y));
     }
 
-    return result;
+    return meters;
+}
+
+std::string rs2::tools::converter::file_name(const std::string& prefix, double timestamp, const std::string& extension)
+{
+    std::stringstream filename;
+    filename << prefix
+        << "_" << std::setprecision(14) << std::fixed << timestamp
+        << extension;
+    return filename.str();
 }
 
-void converter_base::wait_sub_workers()
+std::string rs2::tools::converter::frame_file_name(const std::string& prefix, const rs2::frame& frm, const std::string& extension)
 {
-    for_each(_subWorkers.begin(), _subWorkers.end(),
-        [](std::thread& t) {
-            t.join();
-        });
+    return file_name(prefix + "_" + frm.get_profile().stream_name(), frm.get_timestamp(), extension);
+}
 
-    _subWorkers.clear();
+std::string rs2::tools::converter::metadata_file_name(const std::string& prefix, const rs2::frame& frm)
+{
+    return file_name(prefix + "_" + frm.get_profile().stream_name() + "_metadata", frm.get_timestamp(), ".txt");
 }
 
-void converter_base::wait()
+converter_base::converter_base()
 {
-    _worker.join();
+    for (auto& count : _frames)
+        count = 0;
 }
 
 std::string converter_base::get_statistics()
@@ -64,14 +78,15 @@ std::string converter_base::get_statistics()
     std::stringstream result;
     result << name() << '\n';
 
-    for (auto& i : _framesMap) {
+    for (int i = 0; i < RS2_STREAM_COUNT; ++i) {
+        if (!_frames[i])
+            continue;
         result << '\t'
-            << i.second.size() << ' '
-            << (static_cast<rs2_stream>(i.first) != rs2_stream::RS2_STREAM_ANY ? rs2_stream_to_string(static_cast<rs2_stream>(i.first)) : "")
+            << _frames[i] << ' '
+            << (static_cast<rs2_stream>(i) != rs2_stream::RS2_STREAM_ANY ? rs2_stream_to_string(static_cast<rs2_stream>(i)) : "")
             << " frame(s) processed"
             << '\n';
     }
 
     return (result.str());
 }
-
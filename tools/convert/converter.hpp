@@ -4,12 +4,16 @@
 #ifndef __RS_CONVERTER_CONVERTER_H
 #define __RS_CONVERTER_CONVERTER_H
 
-#include <unordered_map>
-#include <unordered_set>
-#include <thread>
+#include <array>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <sstream>
+#include <iomanip>
 #include <algorithm>
+#include <vector>
 
 #include "librealsense2/rs.hpp"
 
@@ -18,37 +22,72 @@ namespace rs2 {
     namespace tools {
         namespace converter {
 
-            void metadata_to_txtfile(const rs2::frame& frm, const std::string& filename);
+            // A file produced by a converter, which the pipeline's writer stage writes out
+            struct output_file
+            {
+                std::string name;
+                std::string data;
+            };
 
-            typedef unsigned long long frame_number_t;
+            std::string metadata_to_text(const rs2::frame& frm);
 
-            class converter_base {
-            protected:
-                std::thread _worker;
-                std::vector<std::thread> _subWorkers;
-                std::unordered_map<int, std::unordered_set<frame_number_t>> _framesMap;
+            // The distance of every pixel in meters, row by row; Z16 is scaled by the depth units directly
+            // rather than through get_distance() for every pixel
+            std::vector<float> depth_in_meters(const rs2::depth_frame& frm);
 
-            protected:
-                bool frames_map_get_and_set(rs2_stream streamType, frame_number_t frameNumber);
-                void wait_sub_workers();
+            // <prefix>_<timestamp><extension>, the name of every file rs-convert writes for a frame
+            std::string file_name(const std::string& prefix, double timestamp, const std::string& extension);
+            // <prefix>_<stream name>_<timestamp><extension>
+            std::string frame_file_name(const std::string& prefix, const rs2::frame& frm, const std::string& extension);
+            // <prefix>_<stream name>_metadata_<timestamp>.txt
+            std::string metadata_file_name(const std::string& prefix, const rs2::frame& frm);
 
-                template <typename F> void start_worker(const F& f)
-                {
-                    _worker = std::thread(f);
-                }
+            // Processing blocks keep state between frames, so every conversion worker takes blocks of its own
+            template <typename T>
+            class block_pool {
+                std::mutex _mutex;
+                std::vector<std::unique_ptr<T>> _free;
 
-                template <typename F> void add_sub_worker(const F& f)
+            public:
+                // A block no other worker uses until the returned pointer is released
+                std::shared_ptr<T> acquire()
                 {
-                    _subWorkers.emplace_back(f);
+                    std::unique_ptr<T> block;
+                    {
+                        std::lock_guard<std::mutex> lock(_mutex);
+                        if (!_free.empty()) {
+                            block = std::move(_free.back());
+                            _free.pop_back();
+                        }
+                    }
+                    if (!block)
+                        block.reset(new T());
+
+                    return std::shared_ptr<T>(block.release(), [this](T* b) {
+                        std::lock_guard<std::mutex> lock(_mutex);
+                        _free.emplace_back(b);
+                    });
                 }
+            };
+
+            // Converters are called from several workers at once, each with its own frame, and add the files
+            // they make of it to outputs; the pipeline writes them in turn
+            class converter_base {
+            protected:
+                std::array<std::atomic<unsigned long long>, RS2_STREAM_COUNT> _frames;
+
+                void count_frame(rs2_stream streamType) { ++_frames[streamType]; }
 
             public:
-                virtual void convert(rs2::frame& frame) = 0;
+                converter_base();
+                virtual ~converter_base() = default;
+
+                virtual void convert(const rs2::frame& frame, std::vector<output_file>& outputs) = 0;
+                // Called once every frame was converted, for the files made of all of them
+                virtual void finish(std::vector<output_file>& outputs) {}
                 virtual std::string name() const = 0;
 
                 virtual std::string get_statistics();
-
-                void wait();
             };
 
         }
@@ -5,8 +5,7 @@
 #define __RS_CONVERTER_CONVERTER_BIN_H
 
 
-#include <fstream>
-#include <cmath>
+#include <cstring>
 
 #include "../converter.hpp"
 
@@ -20,43 +19,18 @@ namespace rs2 {
                 std::string _filePath;
 
             protected:
-                static void* to_ieee754_32(float f, uint8_t* buffer)
+                // Little-endian IEEE 754 single precision, whatever the host byte order
+                static void append_ieee754_32(float f, std::string& data)
                 {
-                    uint32_t ieee754 = 0;
-
-                    if (f != 0.) {
-                        int sign = 0;
-
-                        if (f < 0) {
-                            sign = 1;
-                            f = -f;
-                        }
-
-                        int shift = 0;
-
-                        while (f >= 2.0) {
-                            f /= 2.0;
-                            shift++;
-                        }
-
-                        while (f < 1.0) {
-                            f *= 2.0;
-                            shift--;
-                        }
-
-                        f = f - 1.f;
-                        uint32_t mantissa = uint32_t(f * ((1U << 23) + 0.5f));
-                        uint32_t exponent = shift + ((1 << 7) - 1);
-
-                        ieee754 = (sign << 31) | (exponent << 23) | mantissa;
-                    }
-
-                    buffer[0] = ieee754 & 0xff;
-                    buffer[1] = (ieee754 >> 8) & 0xff;
-                    buffer[2] = (ieee754 >> 16) & 0xff;
-                    buffer[3] = (ieee754 >> 24) & 0xff;
-
-                    return buffer;
+                    uint32_t ieee754;
+                    memcpy(&ieee754, &f, sizeof(ieee754));
+
+                    char buffer[4] = {
+                        char(ieee754 & 0xff),
+                        char((ieee754 >> 8) & 0xff),
+                        char((ieee754 >> 16) & 0xff),
+                        char((ieee754 >> 24) & 0xff) };
+                    data.append(buffer, sizeof buffer);
                 }
 
             public:
@@ -71,7 +45,7 @@ namespace rs2 {
                     return "BIN converter";
                 }
 
-                void convert(rs2::frame& frame) override
+                void convert(const rs2::frame& frame, std::vector<output_file>& outputs) override
                 {
                     rs2::depth_frame depthframe = frame.as<rs2::depth_frame>();
 
@@ -79,52 +53,16 @@ namespace rs2 {
                         return;
                     }
 
-                    if (frames_map_get_and_set(depthframe.get_profile().stream_type(), depthframe.get_frame_number())) {
-                        return;
-                    }
-
-                    start_worker(
-                        [this, &frame] {
-                            rs2::depth_frame depthframe = frame.as<rs2::depth_frame>();
-
-                            std::stringstream filename;
-                            filename << _filePath
-                                << "_" << depthframe.get_profile().stream_name()
-                                << "_" << std::setprecision(14) << std::fixed << depthframe.get_timestamp()
-                                << ".bin";
-
-                            std::stringstream metadata_file;
-                            metadata_file << _filePath
-                                << "_" << depthframe.get_profile().stream_name()
-                                << "_metadata_" << std::setprecision(14) << std::fixed << depthframe.get_timestamp()
-                                << ".txt";
-
-                            std::string filenameS = filename.str();
-                            std::string metadataS = metadata_file.str();
+                    output_file bin{ frame_file_name(_filePath, depthframe, ".bin"), std::string() };
+                    bin.data.reserve(sizeof(float) * depthframe.get_width() * depthframe.get_height());
 
-                            add_sub_worker(
-                                [filenameS, metadataS, depthframe] {
-                                    std::ofstream fs(filenameS, std::ios::binary | std::ios::trunc);
-
-                                    if (fs) {
-                                        uint8_t buffer[4];
-
-                                        for (int y = 0; y < depthframe.get_height(); y++) {
-                                            for (int x = 0; x < depthframe.get_width(); x++) {
-                                                fs.write(
-                                                    static_cast<const char *>(to_ieee754_32(depthframe.get_distance(x, y), buffer))
-                                                    , sizeof buffer);
-                                            }
-                                        }
-
-                                        fs.flush();
-                                    }
-
-                                    metadata_to_txtfile(depthframe, metadataS);
-                            });
+                    for (auto meters : depth_in_meters(depthframe)) {
+                        append_ieee754_32(meters, bin.data);
+                    }
 
-                            wait_sub_workers();
-                    });
+                    outputs.push_back(std::move(bin));
+                    outputs.push_back({ metadata_file_name(_filePath, depthframe), metadata_to_text(depthframe) });
+                    count_frame(depthframe.get_profile().stream_type());
                 }
             };
 
@@ -5,7 +5,8 @@
 #include "converter-csv.hpp"
 #include <iomanip>
 #include <algorithm>
-#include <iostream>
+#include <cstdio>
+#include <ctime>
 
 using namespace rs2::tools::converter;
 
@@ -45,56 +46,31 @@ converter_csv::converter_csv(const std::string& filePath, rs2_stream streamType)
     : _filePath(filePath)
     , _streamType(streamType)
     , _imu_pose_collection()
-    , _sub_workers_joined(false)
     , _m()
-    , _cv()
 {
 }
 
-void converter_csv::convert_depth(rs2::depth_frame& depthframe)
+void converter_csv::convert_depth(const rs2::depth_frame& depthframe, std::vector<output_file>& outputs)
 {
-    if (frames_map_get_and_set(depthframe.get_profile().stream_type(), depthframe.get_frame_number())) {
-        return;
+    output_file csv{ frame_file_name(_filePath, depthframe, ".csv"), std::string() };
+
+    // Formatted as the default stream output of a float, without a stream per value
+    char value[32];
+    auto meters = depth_in_meters(depthframe);
+    auto width = depthframe.get_width();
+    for (size_t i = 0; i < meters.size(); i += width) {
+        auto delim = "";
+
+        for (int x = 0; x < width; x++) {
+            csv.data += delim;
+            csv.data.append(value, snprintf(value, sizeof(value), "%g", meters[i + x]));
+            delim = ",";
+        }
+        csv.data += '\n';
     }
 
-    start_worker(
-        [this, &depthframe] {
-
-            std::stringstream filename;
-            filename << _filePath
-                << "_" << depthframe.get_profile().stream_name()
-                << "_" << std::setprecision(14) << std::fixed << depthframe.get_timestamp()
-                << ".csv";
-
-            std::stringstream metadata_file;
-            metadata_file << _filePath
-                << "_" << depthframe.get_profile().stream_name()
-                << "_metadata_" << std::setprecision(14) << std::fixed << depthframe.get_timestamp()
-                << ".txt";
-
-            std::string filenameS = filename.str();
-            std::string metadataS = metadata_file.str();
-
-            add_sub_worker(
-                [filenameS, metadataS, depthframe] {
-                    std::ofstream fs(filenameS, std::ios::trunc);
-
-                    if (fs) {
-                        for (int y = 0; y < depthframe.get_height(); y++) {
-                            auto delim = "";
-
-                            for (int x = 0; x < depthframe.get_width(); x++) {
-                                fs << delim << depthframe.get_distance(x, y);
-                                delim = ",";
-                            }
-                            fs << '\n';
-                        }
-                        fs.flush();
-                    }
-                    metadata_to_txtfile(depthframe, metadataS);
-                });
-            wait_sub_workers();
-        });
+    outputs.push_back(std::move(csv));
+    outputs.push_back({ metadata_file_name(_filePath, depthframe), metadata_to_text(depthframe) });
 }
 
 std::string converter_csv::get_time_string() const
@@ -108,31 +84,20 @@ std::string converter_csv::get_time_string() const
     return std::string(buffer);
 }
 
-void converter_csv::save_motion_pose_data_to_file()
+void converter_csv::finish(std::vector<output_file>& outputs)
 {
+    std::lock_guard<std::mutex> lock(_m);
     if (!_imu_pose_collection.size())
-    {
-        std::cout << "No imu or pose data collected" << std::endl;
         return;
-    }
-
-    // Report amount of frames collected
-    std::vector<uint64_t> frames_per_stream;
-    for (const auto& kv : _imu_pose_collection)
-        frames_per_stream.emplace_back(kv.second.size());
-
-    std::sort(frames_per_stream.begin(), frames_per_stream.end());
 
     // Serialize and store data into csv-like format
-    static auto time_Str = get_time_string();
-    std::stringstream filename;
-    filename << _filePath  << "_" << time_Str <<"_imu_pose.csv";
-    std::ofstream csv(filename.str());
-    if (!csv.is_open())
-        throw std::runtime_error(stringify() << "Cannot open the requested output file " << _filePath << ", please check permissions");
-
-    for (const auto& elem : _imu_pose_collection)
+    std::stringstream csv;
+    for (auto& elem : _imu_pose_collection)
     {
+        // The workers convert the samples out of order
+        std::sort(elem.second.begin(), elem.second.end(),
+            [](const motion_pose_frame_record& a, const motion_pose_frame_record& b) { return a._frame_number < b._frame_number; });
+
         csv << "\n\nStream Type,F#,HW Timestamp (ms),Backend Timestamp(ms),Host Timestamp(ms)"
             << (val_in_range(elem.first.first, { RS2_STREAM_GYRO,RS2_STREAM_ACCEL }) ? ",3DOF_x,3DOF_y,3DOF_z" : "")
             << (val_in_range(elem.first.first, { RS2_STREAM_POSE }) ? ",t_x,t_y,t_z,r_x,r_y,r_z,r_w" : "")
@@ -142,67 +107,53 @@ void converter_csv::save_motion_pose_data_to_file()
             csv << elem.second[i].to_string();
     }
 
+    std::stringstream filename;
+    filename << _filePath << "_" << get_time_string() << "_imu_pose.csv";
+    outputs.push_back({ filename.str(), csv.str() });
 }
 
-void converter_csv::convert_motion_pose(rs2::frame& f)
+void converter_csv::convert_motion_pose(const rs2::frame& f)
 {
-    if (frames_map_get_and_set(f.get_profile().stream_type(), f.get_frame_number())) {
-        return;
+    auto stream_uid = std::make_pair(f.get_profile().stream_type(),
+        f.get_profile().stream_index());
+
+    long long frame_timestamp = 0LL;
+    if (f.supports_frame_metadata(RS2_FRAME_METADATA_FRAME_TIMESTAMP))
+        frame_timestamp = f.get_frame_metadata(RS2_FRAME_METADATA_FRAME_TIMESTAMP);
+
+    long long backend_timestamp = 0LL;
+    if (f.supports_frame_metadata(RS2_FRAME_METADATA_BACKEND_TIMESTAMP))
+        backend_timestamp = f.get_frame_metadata(RS2_FRAME_METADATA_BACKEND_TIMESTAMP);
+
+    long long time_of_arrival = 0LL;
+    if (f.supports_frame_metadata(RS2_FRAME_METADATA_TIME_OF_ARRIVAL))
+        time_of_arrival = f.get_frame_metadata(RS2_FRAME_METADATA_TIME_OF_ARRIVAL);
+
+    motion_pose_frame_record record{ f.get_profile().stream_type(),
+                                f.get_profile().stream_index(),
+                                f.get_frame_number(),
+                                frame_timestamp,
+                                backend_timestamp,
+                                time_of_arrival};
+
+    if (auto motion = f.as<rs2::motion_frame>())
+    {
+        auto axes = motion.get_motion_data();
+        record._params = { axes.x, axes.y, axes.z };
+    }
+
+    if (auto pf = f.as<rs2::pose_frame>())
+    {
+        auto pose = pf.get_pose_data();
+        record._params = { pose.translation.x, pose.translation.y, pose.translation.z,
+                pose.rotation.x,pose.rotation.y,pose.rotation.z,pose.rotation.w };
     }
 
-    start_worker(
-        [this, f] {
-
-            add_sub_worker(
-                [this, f] {
-                    auto stream_uid = std::make_pair(f.get_profile().stream_type(),
-                        f.get_profile().stream_index());
-
-                    long long frame_timestamp = 0LL;
-                    if (f.supports_frame_metadata(RS2_FRAME_METADATA_FRAME_TIMESTAMP))
-                        frame_timestamp = f.get_frame_metadata(RS2_FRAME_METADATA_FRAME_TIMESTAMP);
-
-                    long long backend_timestamp = 0LL;
-                    if (f.supports_frame_metadata(RS2_FRAME_METADATA_BACKEND_TIMESTAMP))
-                        backend_timestamp = f.get_frame_metadata(RS2_FRAME_METADATA_BACKEND_TIMESTAMP);
-
-                    long long time_of_arrival = 0LL;
-                    if (f.supports_frame_metadata(RS2_FRAME_METADATA_TIME_OF_ARRIVAL))
-                        time_of_arrival = f.get_frame_metadata(RS2_FRAME_METADATA_TIME_OF_ARRIVAL);
-                    
-                    motion_pose_frame_record record{ f.get_profile().stream_type(),
-                                                f.get_profile().stream_index(),
-                                                f.get_frame_number(),
-                                                frame_timestamp,
-                                                backend_timestamp,
-                                                time_of_arrival};
-
-                    if (auto motion = f.as<rs2::motion_frame>())
-                    {
-                        auto axes = motion.get_motion_data();
-                        record._params = { axes.x, axes.y, axes.z };
-                    }
-
-                    if (auto pf = f.as<rs2::pose_frame>())
-                    {
-                        auto pose = pf.get_pose_data();
-                        record._params = { pose.translation.x, pose.translation.y, pose.translation.z,
-                                pose.rotation.x,pose.rotation.y,pose.rotation.z,pose.rotation.w };
-                    }
-
-                    _imu_pose_collection[stream_uid].emplace_back(record);
-                });
-            wait_sub_workers();
-            _sub_workers_joined = true;
-            _cv.notify_all();
-        });
-    std::unique_lock<std::mutex> lck(_m);
-    while (!_sub_workers_joined)
-        _cv.wait(lck);
-    save_motion_pose_data_to_file();
+    std::lock_guard<std::mutex> lock(_m);
+    _imu_pose_collection[stream_uid].emplace_back(record);
 }
 
-void converter_csv::convert(rs2::frame& frame)
+void converter_csv::convert(const rs2::frame& frame, std::vector<output_file>& outputs)
 {
     if (!(_streamType == rs2_stream::RS2_STREAM_ANY || frame.get_profile().stream_type() == _streamType))
         return;
@@ -210,7 +161,8 @@ void converter_csv::convert(rs2::frame& frame)
     auto depthframe = frame.as<rs2::depth_frame>();
     if (depthframe)
     {
-        convert_depth(depthframe);
+        convert_depth(depthframe, outputs);
+        count_frame(frame.get_profile().stream_type());
         return;
     }
 
@@ -219,6 +171,7 @@ void converter_csv::convert(rs2::frame& frame)
     if (motionframe || poseframe)
     {
         convert_motion_pose(frame);
+        count_frame(frame.get_profile().stream_type());
         return;
     }
 }
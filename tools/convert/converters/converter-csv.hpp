@@ -5,10 +5,8 @@
 #define __RS_CONVERTER_CONVERTER_CSV_H
 
 
-#include <fstream>
 #include <map>
 #include <mutex>
-#include <condition_variable>
 #include "../converter.hpp"
 
 
@@ -58,25 +56,24 @@ namespace rs2 {
                 rs2_stream _streamType;
                 std::string _filePath;
                 std::map<std::pair<rs2_stream, int>, std::vector<motion_pose_frame_record>> _imu_pose_collection;
-                bool _sub_workers_joined;
                 std::mutex _m;
-                std::condition_variable _cv;
 
 
             public:
 
                 converter_csv(const std::string& filePath, rs2_stream streamType = rs2_stream::RS2_STREAM_ANY);
 
-                void convert(rs2::frame& frame) override;
-                
+                void convert(const rs2::frame& frame, std::vector<output_file>& outputs) override;
+                // IMU and pose samples of every stream go to a single file, in frame number order
+                void finish(std::vector<output_file>& outputs) override;
+
                 std::string name() const override
                 {
                     return "CSV converter";
                 }
 
-                void convert_depth(rs2::depth_frame& depthframe);
-                void convert_motion_pose(rs2::frame& f);
-                void save_motion_pose_data_to_file();
+                void convert_depth(const rs2::depth_frame& depthframe, std::vector<output_file>& outputs);
+                void convert_motion_pose(const rs2::frame& f);
             };
         } // namespace converter
     } // namespace tools
@@ -0,0 +1,53 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2021 Intel Corporation. All Rights Reserved.
+
+
+#include "converter-ply.hpp"
+#include "ply-writer.h"
+
+using namespace rs2::tools::converter;
+
+void converter_ply::convert(const rs2::frame& frame, std::vector<output_file>& outputs)
+{
+    auto frameset = frame.as<rs2::frameset>();
+    if (!frameset)
+        return;
+
+    auto frameDepth = frameset.get_depth_frame();
+    auto frameColor = frameset.get_color_frame();
+    if (!frameDepth || !frameColor)
+        return;
+
+    rs2::points points;
+    {
+        auto pc = _pointclouds.acquire();
+        pc->map_to(frameColor);
+        points = pc->calculate(frameDepth);
+    }
+
+    outputs.push_back({ file_name(_filePath, frameDepth.get_timestamp(), ".ply"), to_ply(points, frameColor) });
+    outputs.push_back({ file_name(_filePath + "_metadata", frameDepth.get_timestamp(), ".txt"), metadata_to_text(frameDepth) });
+    count_frame(rs2_stream::RS2_STREAM_ANY);
+}
+
+std::string converter_ply::to_ply(const rs2::points& points, const rs2::video_frame& texture)
+{
+    auto profile = points.get_profile().as<rs2::video_stream_profile>();
+    if (!profile)
+        throw std::runtime_error("stream must be video stream");
+
+    auto texcoords = points.get_texture_coordinates();
+    std::function<void(size_t, uint8_t[3])> color;
+    if (texture)
+    {
+        auto texture_data = static_cast<const uint8_t*>(texture.get_data());
+        color = [&texture, texture_data, texcoords](size_t i, uint8_t rgb[3]) {
+            librealsense::ply::sample_texture(texture_data, texture.get_width(), texture.get_height(),
+                texture.get_bytes_per_pixel(), texture.get_stride_in_bytes(), texcoords[i].u, texcoords[i].v, rgb);
+        };
+    }
+
+    std::ostringstream out;
+    librealsense::ply::write(out, &points.get_vertices()->x, profile.width(), profile.height(), color);
+    return out.str();
+}
@@ -15,6 +15,7 @@ namespace rs2 {
             class converter_ply : public converter_base {
             protected:
                 std::string _filePath;
+                block_pool<rs2::pointcloud> _pointclouds;
 
             public:
                 converter_ply(const std::string& filePath)
@@ -27,40 +28,11 @@ namespace rs2 {
                     return "PLY converter";
                 }
 
-                void convert(rs2::frame& frame) override
-                {
-                    rs2::pointcloud pc;
-                    start_worker(
-                        [this, &frame, pc]() mutable {
-                            auto frameset = frame.as<rs2::frameset>();
-                            auto frameDepth = frameset.get_depth_frame();
-                            auto frameColor = frameset.get_color_frame();
-
-                            if (frameDepth && frameColor) {
-                                if (frames_map_get_and_set(rs2_stream::RS2_STREAM_ANY, frameDepth.get_frame_number())) {
-                                    return;
-                                }
-
-                                pc.map_to(frameColor);
-
-                                auto points = pc.calculate(frameDepth);
+                void convert(const rs2::frame& frame, std::vector<output_file>& outputs) override;
 
-                                std::stringstream filename;
-                                filename << _filePath
-                                    << "_" << std::setprecision(14) << std::fixed << frameDepth.get_timestamp()
-                                    << ".ply";
-
-                                points.export_to_ply(filename.str(), frameColor);
-
-                                std::stringstream metadata_file;
-                                metadata_file << _filePath
-                                    << "_metadata_" << std::setprecision(14) << std::fixed << frameDepth.get_timestamp()
-                                    << ".txt";
-
-                                metadata_to_txtfile(frameDepth, metadata_file.str());
-                            }
-                    });
-                }
+                // The binary PLY file points::export_to_ply() writes, colored by texture if given, made in memory
+                // by the same writer, see ply-writer.h
+                static std::string to_ply(const rs2::points& points, const rs2::video_frame& texture);
             };
 
         }
@@ -19,7 +19,12 @@ namespace rs2 {
             class converter_png : public converter_base {
                 rs2_stream _streamType;
                 std::string _filePath;
-                rs2::colorizer _colorizer;
+                block_pool<rs2::colorizer> _colorizers;
+
+                static void append(void* context, void* data, int size)
+                {
+                    static_cast<std::string*>(context)->append(static_cast<const char*>(data), size);
+                }
 
             public:
                 converter_png(const std::string& filePath, rs2_stream streamType = rs2_stream::RS2_STREAM_ANY)
@@ -33,57 +38,33 @@ namespace rs2 {
                     return "PNG converter";
                 }
 
-                void convert(rs2::frame& frame) override
+                void convert(const rs2::frame& frame, std::vector<output_file>& outputs) override
                 {
                     rs2::video_frame videoframe = frame.as<rs2::video_frame>();
                     if (!videoframe || !(_streamType == rs2_stream::RS2_STREAM_ANY || videoframe.get_profile().stream_type() == _streamType)) {
                         return;
                     }
 
-                    if (frames_map_get_and_set(videoframe.get_profile().stream_type(), 
-                        static_cast<rs2::tools::converter::frame_number_t>(videoframe.get_timestamp()))) {
-                        return;
+                    // The metadata is that of the recorded frame, not of its colorized copy
+                    output_file metadata{ metadata_file_name(_filePath, videoframe), metadata_to_text(videoframe) };
+
+                    if (videoframe.get_profile().stream_type() == rs2_stream::RS2_STREAM_DEPTH) {
+                        videoframe = _colorizers.acquire()->process(videoframe);
                     }
 
-                    start_worker(
-                        [this, &frame] {
-                            rs2::video_frame videoframe = frame.as<rs2::video_frame>();
-
-                            if (videoframe.get_profile().stream_type() == rs2_stream::RS2_STREAM_DEPTH) {
-                                videoframe = _colorizer.process(videoframe);
-                            }
-
-                            std::stringstream filename;
-                            filename << _filePath
-                                << "_" << videoframe.get_profile().stream_name()
-                                << "_" << std::setprecision(14) << std::fixed << videoframe.get_timestamp()
-                                << ".png";
-
-                            std::stringstream metadata_file;
-                            metadata_file << _filePath
-                                << "_" << videoframe.get_profile().stream_name()
-                                << "_metadata_" << std::setprecision(14) << std::fixed << videoframe.get_timestamp()
-                                << ".txt";
-
-                            std::string filenameS = filename.str();
-                            std::string metadataS = metadata_file.str();
-
-                            add_sub_worker(
-                                [filenameS, metadataS, videoframe] {
-                                    stbi_write_png(
-                                        filenameS.c_str()
-                                        , videoframe.get_width()
-                                        , videoframe.get_height()
-                                        , videoframe.get_bytes_per_pixel()
-                                        , videoframe.get_data()
-                                        , videoframe.get_stride_in_bytes()
-                                    );
-
-                                    metadata_to_txtfile(videoframe, metadataS);
-                            });
-
-                            wait_sub_workers();
-                    });
+                    output_file png{ frame_file_name(_filePath, videoframe, ".png"), std::string() };
+                    png.data.reserve(videoframe.get_stride_in_bytes() * videoframe.get_height());
+                    stbi_write_png_to_func(append, &png.data
+                        , videoframe.get_width()
+                        , videoframe.get_height()
+                        , videoframe.get_bytes_per_pixel()
+                        , videoframe.get_data()
+                        , videoframe.get_stride_in_bytes()
+                    );
+
+                    outputs.push_back(std::move(png));
+                    outputs.push_back(std::move(metadata));
+                    count_frame(videoframe.get_profile().stream_type());
                 }
             };
 
@@ -5,8 +5,6 @@
 #define __RS_CONVERTER_CONVERTER_RAW_H
 
 
-#include <fstream>
-
 #include "../converter.hpp"
 
 
@@ -30,7 +28,7 @@ namespace rs2 {
                     return "RAW converter";
                 }
 
-                void convert(rs2::frame& frame) override
+                void convert(const rs2::frame& frame, std::vector<output_file>& outputs) override
                 {
                     rs2::video_frame videoframe = frame.as<rs2::video_frame>();
 
@@ -38,46 +36,11 @@ namespace rs2 {
                         return;
                     }
 
-                    if (frames_map_get_and_set(videoframe.get_profile().stream_type(), videoframe.get_frame_number())) {
-                        return;
-                    }
-
-                    start_worker(
-                        [this, &frame] {
-                            rs2::video_frame videoframe = frame.as<rs2::video_frame>();
-
-                            std::stringstream filename;
-                            filename << _filePath
-                                << "_" << videoframe.get_profile().stream_name()
-                                << "_" << std::setprecision(14) << std::fixed << videoframe.get_timestamp()
-                                << ".raw";
-
-                            std::stringstream metadata_file;
-                            metadata_file << _filePath
-                                << "_" << videoframe.get_profile().stream_name()
-                                << "_metadata_" << std::setprecision(14) << std::fixed << videoframe.get_timestamp()
-                                << ".txt";
-
-                            std::string filenameS = filename.str();
-                            std::string metadataS = metadata_file.str();
-
-                            add_sub_worker(
-                                [filenameS, metadataS, videoframe] {
-                                    std::ofstream fs(filenameS, std::ios::binary | std::ios::trunc);
-
-                                    if (fs) {
-                                        fs.write(
-                                            static_cast<const char *>(videoframe.get_data())
-                                            , videoframe.get_stride_in_bytes() * videoframe.get_height());
-
-                                        fs.flush();
-                                    }
-
-                                    metadata_to_txtfile(videoframe, metadataS);
-                            });
-
-                            wait_sub_workers();
-                    });
+                    outputs.push_back({ frame_file_name(_filePath, videoframe, ".raw"),
+                        std::string(static_cast<const char *>(videoframe.get_data())
+                            , videoframe.get_stride_in_bytes() * videoframe.get_height()) });
+                    outputs.push_back({ metadata_file_name(_filePath, videoframe), metadata_to_text(videoframe) });
+                    count_frame(videoframe.get_profile().stream_type());
                 }
             };
 
@@ -12,8 +12,10 @@
 #include "converters/converter-raw.hpp"
 #include "converters/converter-ply.hpp"
 #include "converters/converter-bin.hpp"
+#include "conversion-pipeline.hpp"
 
-#include <mutex>
+#include <atomic>
+#include <thread>
 
 #define SECONDS_TO_NANOSECONDS 1000000000
  
@@ -41,6 +43,9 @@ int main(int argc, char** argv) try
     ValueArg <string> frameNumberEnd("t", "last-framenumber", "ignore frames whose frame number is greater than this value", false, "", "last-framenumber");
     ValueArg <string> startTime("s", "start-time", "ignore frames whose timestamp is less than this value (the first frame is at time 0)", false, "", "start-time");
     ValueArg <string> endTime("e", "end-time", "ignore frames whose timestamp is greater than this value (the first frame is at time 0)", false, "", "end-time");
+    ValueArg <unsigned> workers("w", "workers", "number of threads converting frames (default - number of cores, up to 8)", false,
+        rs2::tools::converter::conversion_pipeline::default_workers(), "workers");
+    ValueArg <string> outputArchive("a", "archive", "write all the output files into a single TAR archive instead of one by one", false, "", "tar-file");
 
 
     cmd.add(inputFilename);
@@ -55,6 +60,8 @@ int main(int argc, char** argv) try
     cmd.add(outputFilenameBin);
     cmd.add(switchDepth);
     cmd.add(switchColor);
+    cmd.add(workers);
+    cmd.add(outputArchive);
     cmd.parse(argc, argv);
 
     vector<shared_ptr<rs2::tools::converter::converter_base>> converters;
@@ -100,6 +107,13 @@ int main(int argc, char** argv) try
         throw runtime_error("output not defined");
     }
 
+    // Both the PLY conversion and the others write through the same writer
+    shared_ptr<rs2::tools::converter::output_writer> writer;
+    if (outputArchive.isSet())
+        writer = make_shared<rs2::tools::converter::tar_writer>(outputArchive.getValue());
+    else
+        writer = make_shared<rs2::tools::converter::file_writer>();
+
     unsigned long long first_frame = 0;
     unsigned long long last_frame = 0;
     uint64_t start_time = 0;
@@ -144,8 +158,8 @@ int main(int argc, char** argv) try
         playback.set_real_time(false);
 
         auto duration = playback.get_duration();
-        int progress = 0;
         auto frameNumber = 0ULL;
+        rs2::tools::converter::conversion_pipeline conversion({ plyconverter }, writer, workers.getValue());
 
         rs2::frameset frameset;
         uint64_t posCurr = playback.get_position();
@@ -154,12 +168,7 @@ int main(int argc, char** argv) try
         // so we need to exit the look in some other way!
         while (pipe->try_wait_for_frames(&frameset, 1000))
         {
-            int posP = static_cast<int>(posCurr * 100. / duration.count());
-            if (posP > progress)
-            {
-                progress = posP;
-                cout << posP << "%" << "\r" << flush;
-            }
+            conversion.report_progress(posCurr, duration.count());
 
             frameNumber = frameset[0].get_frame_number();
 
@@ -175,8 +184,7 @@ int main(int argc, char** argv) try
          
             if( process_frame )
             {
-                plyconverter->convert(frameset);
-                plyconverter->wait();
+                conversion.push(frameset);
             }
 
             auto posNext = playback.get_position();
@@ -187,22 +195,24 @@ int main(int argc, char** argv) try
 
             posCurr = posNext;
         }
+
+        conversion.finish();
+        cout << "\r" << conversion.get_statistics() << endl;
     }
 
     // for every converter other than ply,
-    // we get the frames from playback sensors 
-    // and convert them one by one
+    // we get the frames from playback sensors
+    // and hand them over to the conversion workers
     if( ! converters.empty() )
     {
         rs2::context ctx;
         auto playback = ctx.load_device(inputFilename.getValue());
         playback.set_real_time(false);
         std::vector<rs2::sensor> sensors = playback.query_sensors();
-        std::mutex mutex;
+        rs2::tools::converter::conversion_pipeline conversion(converters, writer, workers.getValue());
 
         auto duration = playback.get_duration();
-        int progress = 0;
-        uint64_t posCurr = playback.get_position();
+        std::atomic<uint64_t> posCurr(playback.get_position());
 
         for (auto sensor : sensors)
         {
@@ -212,10 +222,9 @@ int main(int argc, char** argv) try
             }
 
             sensor.open(sensor.get_stream_profiles());
+            // Playback does not read on while the callback blocks, which pushing does once the workers are busy
             sensor.start([&](rs2::frame frame)
             {
-                std::lock_guard<std::mutex> lock(mutex);
-
                 auto frameNumber = frame.get_frame_number();
 
                 if (frameNumberStart.isSet() && frameNumber < first_frame)
@@ -227,38 +236,21 @@ int main(int argc, char** argv) try
                 if (endTime.isSet() && posCurr > end_time)
                     return;
 
-                for_each(converters.begin(), converters.end(),
-                    [&frame](shared_ptr<rs2::tools::converter::converter_base>& converter) {
-                    converter->convert(frame);
-                });
-
-                for_each(converters.begin(), converters.end(),
-                    [](shared_ptr<rs2::tools::converter::converter_base>& converter) {
-                    converter->wait();
-                });
+                conversion.push(frame);
             });
 
         }
 
-        //we need to clear the output of ply progress ("100%") before writing
-        //the progress of the other converters in the same line
-        cout << "\r    \r";
-
         while (true)
         {
-            int posP = static_cast<int>(posCurr * 100. / duration.count());
-
-            if (posP > progress)
-            {
-                progress = posP;
-                cout << posP << "%" << "\r" << flush;
-            }
+            conversion.report_progress(posCurr, duration.count());
 
             const uint64_t posNext = playback.get_position();
             if (posNext < posCurr)
                 break;
 
             posCurr = posNext;
+            this_thread::sleep_for(chrono::milliseconds(10));
         }
 
         for (auto sensor : sensors)
@@ -270,8 +262,12 @@ int main(int argc, char** argv) try
             sensor.stop();
             sensor.close();
         }
+
+        conversion.finish();
+        cout << "\r" << conversion.get_statistics() << endl;
     }
 
+    writer->close();
     cout << endl;
 
     //print statistics for ply converter. 
@@ -0,0 +1,141 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2021 Intel Corporation. All Rights Reserved.
+
+#include "writers.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <stdexcept>
+
+using namespace rs2::tools::converter;
+
+void file_writer::write(const output_file& file)
+{
+    std::ofstream fs(file.name, std::ios::binary | std::ios::trunc);
+    if (!fs)
+        throw std::runtime_error("Cannot open the requested output file " + file.name + ", please check permissions");
+
+    fs.write(file.data.data(), file.data.size());
+    if (!fs)
+        throw std::runtime_error("Failed to write " + file.name);
+}
+
+namespace
+{
+    const size_t block_size = 512;
+
+    // The ustar header, a block of fixed width fields, numbers in octal
+    struct tar_header
+    {
+        char name[100];
+        char mode[8];
+        char uid[8];
+        char gid[8];
+        char size[12];
+        char mtime[12];
+        char checksum[8];
+        char typeflag;
+        char linkname[100];
+        char magic[6];
+        char version[2];
+        char uname[32];
+        char gname[32];
+        char devmajor[8];
+        char devminor[8];
+        char prefix[155];
+        char padding[12];
+    };
+    static_assert(sizeof(tar_header) == block_size, "tar header must take a single block");
+
+    template <size_t N>
+    void write_octal(char(&field)[N], unsigned long long value)
+    {
+        snprintf(field, N, "%0*llo", int(N - 1), value);
+    }
+
+    // Names longer than 100 characters are split on a '/' into a prefix of up to 155 characters and the rest
+    void set_name(tar_header& header, std::string name)
+    {
+        while (!name.empty() && name[0] == '/')
+            name.erase(0, 1);
+
+        if (name.size() <= sizeof(header.name)) {
+            memcpy(header.name, name.data(), name.size());
+            return;
+        }
+
+        auto split = name.rfind('/', sizeof(header.prefix));
+        while (split != std::string::npos && split > 0) {
+            if (name.size() - split - 1 <= sizeof(header.name)) {
+                memcpy(header.prefix, name.data(), split);
+                memcpy(header.name, name.data() + split + 1, name.size() - split - 1);
+                return;
+            }
+            split = name.rfind('/', split - 1);
+        }
+
+        throw std::runtime_error("Output file name " + name + " is too long for the archive");
+    }
+}
+
+tar_writer::tar_writer(const std::string& filePath)
+    : _filePath(filePath)
+    , _archive(filePath, std::ios::binary | std::ios::trunc)
+{
+    if (!_archive)
+        throw std::runtime_error("Cannot open the requested output file " + filePath + ", please check permissions");
+}
+
+tar_writer::~tar_writer()
+{
+    try {
+        close();
+    }
+    catch (...) {
+    }
+}
+
+void tar_writer::write(const output_file& file)
+{
+    tar_header header;
+    memset(&header, 0, sizeof(header));
+
+    set_name(header, file.name);
+    write_octal(header.mode, 0644);
+    write_octal(header.uid, 0);
+    write_octal(header.gid, 0);
+    write_octal(header.size, file.data.size());
+    write_octal(header.mtime, static_cast<unsigned long long>(time(nullptr)));
+    header.typeflag = '0';
+    memcpy(header.magic, "ustar", 6);
+    memcpy(header.version, "00", 2);
+
+    // The checksum is taken over the header with its own field as spaces
+    memset(header.checksum, ' ', sizeof(header.checksum));
+    unsigned checksum = 0;
+    auto bytes = reinterpret_cast<const unsigned char*>(&header);
+    for (size_t i = 0; i < sizeof(header); ++i)
+        checksum += bytes[i];
+    snprintf(header.checksum, sizeof(header.checksum), "%06o", checksum);
+
+    static const char zeros[block_size] = {};
+    _archive.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    _archive.write(file.data.data(), file.data.size());
+    _archive.write(zeros, (block_size - file.data.size() % block_size) % block_size);
+    if (!_archive)
+        throw std::runtime_error("Failed to write " + file.name + " to " + _filePath);
+}
+
+void tar_writer::close()
+{
+    if (!_archive.is_open())
+        return;
+
+    // The archive ends with two blocks of zeros
+    static const char zeros[2 * block_size] = {};
+    _archive.write(zeros, sizeof(zeros));
+    _archive.close();
+    if (!_archive)
+        throw std::runtime_error("Failed to write " + _filePath);
+}
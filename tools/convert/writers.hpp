@@ -0,0 +1,50 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2021 Intel Corporation. All Rights Reserved.
+
+#ifndef __RS_CONVERTER_WRITERS_H
+#define __RS_CONVERTER_WRITERS_H
+
+#include <fstream>
+
+#include "converter.hpp"
+
+
+namespace rs2 {
+    namespace tools {
+        namespace converter {
+
+            // Where the files made by the converters go; called from the pipeline's single writer thread
+            class output_writer {
+            public:
+                virtual ~output_writer() = default;
+
+                virtual void write(const output_file& file) = 0;
+                virtual void close() {}
+            };
+
+            // Every file on its own, under its own name
+            class file_writer : public output_writer {
+            public:
+                void write(const output_file& file) override;
+            };
+
+            // All the files packed into a single tar archive (POSIX ustar), under their names,
+            // so a whole recording does not leave tens of thousands of small files behind
+            class tar_writer : public output_writer {
+                std::string _filePath;
+                std::ofstream _archive;
+
+            public:
+                explicit tar_writer(const std::string& filePath);
+                ~tar_writer();
+
+                void write(const output_file& file) override;
+                void close() override;
+            };
+
+        }
+    }
+}
+
+
+#endif
@@ -1048,14 +1048,13 @@ namespace rs2
 
                         if ((RS2_STREAM_DEPTH == stream_type) && (RS2_FORMAT_Z16 == stream_format))
                         {
-                            float su = 0, baseline = -1.f;
+                            float baseline = -1.f;
                             rs2_intrinsics intrin{};
                             int gt_mm{};
                             bool plane_fit_set{};
                             region_of_interest roi{};
                             {
                                 std::lock_guard<std::mutex> lock(_m);
-                                su = _depth_scale_units;
                                 baseline = _stereo_baseline_mm;
                                 auto depth_profile = profile.as<video_stream_profile>();
                                 intrin = depth_profile.get_intrinsics();
@@ -1070,7 +1069,7 @@ namespace rs2
 
                             std::tie(gt_mm, plane_fit_set) = get_inputs();
 
-                            auto metrics = analyze_depth_image(f, su, baseline, &intrin, roi, gt_mm, plane_fit_set, sample, _recorder.is_recording(), callback);
+                            auto metrics = analyze_depth_image(f, baseline, &intrin, roi, gt_mm, plane_fit_set, sample, _recorder.is_recording(), callback);
 
                             {
                                 std::lock_guard<std::mutex> lock(_m);
@@ -0,0 +1,426 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2021 Intel Corporation. All Rights Reserved.
+
+#include <librealsense2/rs.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+#include "tclap/CmdLine.h"
+#include "json.hpp"
+
+using namespace TCLAP;
+using json = nlohmann::json;
+
+// Peak resident set size of the process, in MB
+static double get_peak_rss_mb()
+{
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+        return counters.PeakWorkingSetSize / (1024. * 1024.);
+    return 0;
+#else
+    rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage))
+        return 0;
+#ifdef __APPLE__
+    return usage.ru_maxrss / (1024. * 1024.);   // bytes
+#else
+    return usage.ru_maxrss / 1024.;             // KB
+#endif
+#endif
+}
+
+static std::string base_name(const std::string& path)
+{
+    auto pos = path.find_last_of("/\\");
+    return pos == std::string::npos ? path : path.substr(pos + 1);
+}
+
+// Post-processing settings in the format the viewer saves them to its configuration file: flat keys
+// "viewer_model.post_processing.<device>.<sensor>.<filter>.<option>", plus "<filter>.enabled" per filter
+class chain_settings
+{
+public:
+    chain_settings() = default;
+
+    explicit chain_settings(const std::string& file)
+    {
+        std::ifstream in(file);
+        if (!in.good())
+            throw std::runtime_error("Could not open the post-processing settings " + file);
+        auto j = json::parse(in);
+        for (auto it = j.begin(); it != j.end(); ++it)
+            _values[it.key()] = it.value().is_string() ? it.value().get<std::string>() : it.value().dump();
+    }
+
+    // Value of the setting "<sensor>.<filter>.<option>" of the device. The settings saved for a device of another
+    // name are used when they are the only ones holding that setting
+    bool find(const std::string& device, const std::string& setting, std::string& value) const
+    {
+        static const std::string prefix = "viewer_model.post_processing.";
+        auto it = _values.find(prefix + device + "." + setting);
+        if (it != _values.end())
+        {
+            value = it->second;
+            return true;
+        }
+
+        auto suffix = "." + setting;
+        std::vector<std::string> matches;
+        for (auto&& kvp : _values)
+        {
+            auto& key = kvp.first;
+            if (key.size() > prefix.size() + suffix.size() && key.compare(0, prefix.size(), prefix) == 0
+                && key.compare(key.size() - suffix.size(), suffix.size(), suffix) == 0)
+            {
+                matches.push_back(key);
+                value = kvp.second;
+            }
+        }
+        if (matches.size() > 1)
+        {
+            std::stringstream ss;
+            ss << "The post-processing settings hold " << setting << " for several devices, none of them " << device << ":";
+            for (auto&& key : matches)
+                ss << " " << key;
+            throw std::runtime_error(ss.str());
+        }
+        return !matches.empty();
+    }
+
+    bool empty() const { return _values.empty(); }
+
+private:
+    std::map<std::string, std::string> _values;
+};
+
+struct stage
+{
+    std::string sensor;
+    std::string name;
+    rs2::filter block;
+};
+
+// The recommended filters of every sensor of the device that the settings enable, configured as the settings say
+static std::vector<stage> build_chain(const rs2::device& dev, const chain_settings& settings)
+{
+    std::vector<stage> chain;
+    std::string device_name = dev.supports(RS2_CAMERA_INFO_NAME) ? dev.get_info(RS2_CAMERA_INFO_NAME) : "";
+    for (auto&& s : dev.query_sensors())
+    {
+        std::string sensor_name = s.get_info(RS2_CAMERA_INFO_NAME);
+        for (auto&& f : s.get_recommended_filters())
+        {
+            std::string filter_name = f.get_info(RS2_CAMERA_INFO_NAME);
+            auto prefix = sensor_name + "." + filter_name + ".";
+
+            std::string value;
+            if (!settings.find(device_name, prefix + "enabled", value) || (value != "1" && value != "true"))
+                continue;
+
+            for (auto opt : f.get_supported_options())
+            {
+                if (f.is_option_read_only(opt) || !settings.find(device_name, prefix + f.get_option_name(opt), value))
+                    continue;
+                try
+                {
+                    auto val = std::stof(value);
+                    auto range = f.get_option_range(opt);
+                    if (val >= range.min && val <= range.max)
+                        f.set_option(opt, val);
+                }
+                catch (const std::exception& e)
+                {
+                    std::cerr << "Ignoring " << filter_name << " " << f.get_option_name(opt) << ": " << e.what() << std::endl;
+                }
+            }
+            chain.push_back({ sensor_name, sensor_name + "/" + filter_name, f });
+        }
+    }
+    return chain;
+}
+
+static bool is_depth_postprocessing(const rs2::filter& f)
+{
+    return f.is<rs2::decimation_filter>() || f.is<rs2::threshold_filter>() || f.is<rs2::disparity_transform>()
+        || f.is<rs2::spatial_filter>() || f.is<rs2::temporal_filter>() || f.is<rs2::hole_filling_filter>();
+}
+
+// Every run of two or more depth post-processing filters of a sensor, applied by one depth_postprocess block
+static std::vector<stage> fuse_chain(std::vector<stage>& chain)
+{
+    std::vector<stage> fused;
+    for (size_t i = 0; i < chain.size();)
+    {
+        auto end = i;
+        while (end < chain.size() && chain[end].sensor == chain[i].sensor && is_depth_postprocessing(chain[end].block))
+            ++end;
+        if (end - i < 2)
+        {
+            fused.push_back(chain[i++]);
+            continue;
+        }
+
+        std::vector<rs2::filter*> filters;
+        for (auto k = i; k < end; ++k)
+            filters.push_back(&chain[k].block);
+        // Take the block as a plain filter, rather than as a callback to wrap in a new one
+        stage s = chain[i];
+        s.name = s.sensor + "/Depth Post-Processing";
+        s.block = rs2::depth_postprocess(filters);
+        fused.push_back(s);
+        i = end;
+    }
+    return fused;
+}
+
+struct distribution
+{
+    double mean = 0, p50 = 0, p99 = 0, max = 0;
+
+    explicit distribution(std::vector<double> samples)
+    {
+        if (samples.empty())
+            return;
+        std::sort(samples.begin(), samples.end());
+        double sum = 0;
+        for (auto s : samples)
+            sum += s;
+        mean = sum / samples.size();
+        p50 = samples[samples.size() / 2];
+        p99 = samples[std::min(samples.size() - 1, samples.size() * 99 / 100)];
+        max = samples.back();
+    }
+
+    json to_json() const { return { { "mean", mean }, { "p50", p50 }, { "p99", p99 }, { "max", max } }; }
+};
+
+// Replay a bag as fast as the frame path allows, and time every post-processing stage
+static json replay(const std::string& file, const chain_settings& settings, bool fuse, bool verbose)
+{
+    rs2::pipeline pipe;
+    rs2::config cfg;
+    cfg.enable_device_from_file(file, false);
+
+    rs2::enable_pipeline_stats(true);
+    rs2::reset_pipeline_stats();
+
+    auto profile = pipe.start(cfg);
+    auto playback = profile.get_device().as<rs2::playback>();
+    playback.set_real_time(false);
+    auto chain = build_chain(playback, settings);
+    if (fuse)
+        chain = fuse_chain(chain);
+
+    std::vector<std::vector<double>> stage_times(chain.size());
+    std::vector<double> frame_path_times;
+    unsigned long long framesets = 0, frames = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    auto last = start;
+    while (true)
+    {
+        rs2::frameset fs;
+        if (!pipe.try_wait_for_frames(&fs, 1000))
+        {
+            if (playback.current_status() == RS2_PLAYBACK_STATUS_STOPPED)
+                break;
+            continue;
+        }
+
+        auto now = std::chrono::steady_clock::now();
+        frame_path_times.push_back(std::chrono::duration<double, std::milli>(now - last).count());
+        ++framesets;
+        frames += fs.size();
+
+        rs2::frame f = fs;
+        for (size_t i = 0; i < chain.size(); ++i)
+        {
+            auto stage_start = std::chrono::steady_clock::now();
+            f = chain[i].block.process(f);
+            stage_times[i].push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - stage_start).count());
+        }
+        last = std::chrono::steady_clock::now();
+
+        if (verbose && framesets % 100 == 0)
+            std::cout << "\r" << base_name(file) << ": " << framesets << " frame sets" << std::flush;
+    }
+    auto seconds = std::chrono::duration<double>(last - start).count();
+    pipe.stop();
+    if (verbose)
+        std::cout << "\r";
+
+    json result;
+    result["framesets"] = framesets;
+    result["frames"] = frames;
+    result["seconds"] = seconds;
+    result["framesets_per_second"] = seconds > 0 ? framesets / seconds : 0;
+    result["frames_per_second"] = seconds > 0 ? frames / seconds : 0;
+    result["peak_rss_mb"] = get_peak_rss_mb();
+
+    // Time spent waiting for the next set, which is the library frame path when replaying faster than real time
+    json stages;
+    stages["wait_for_frames"] = distribution(frame_path_times).to_json();
+    for (size_t i = 0; i < chain.size(); ++i)
+        stages[chain[i].name] = distribution(stage_times[i]).to_json();
+    result["stages"] = stages;
+
+    json tasks;
+    for (auto&& t : rs2::get_processing_task_stats())
+        tasks[t.name] = { { "mean", t.duration.mean }, { "p50", t.duration.p50 }, { "p99", t.duration.p99 }, { "max", t.duration.max } };
+    result["processing_tasks"] = tasks;
+    return result;
+}
+
+static void print(const std::string& file, const json& r)
+{
+    std::cout << file << ": " << r["framesets"].get<unsigned long long>() << " frame sets, "
+              << r["frames"].get<unsigned long long>() << " frames in " << std::fixed << std::setprecision(2)
+              << r["seconds"].get<double>() << " s, " << r["framesets_per_second"].get<double>() << " sets/s, "
+              << r["frames_per_second"].get<double>() << " frames/s, peak RSS " << r["peak_rss_mb"].get<double>() << " MB\n";
+
+    auto print_stages = [](const json& stages) {
+        for (auto it = stages.begin(); it != stages.end(); ++it)
+        {
+            std::cout << "    " << std::left << std::setw(48) << it.key() << std::right << std::setprecision(3)
+                      << " mean " << std::setw(8) << it.value()["mean"].get<double>()
+                      << " p50 " << std::setw(8) << it.value()["p50"].get<double>()
+                      << " p99 " << std::setw(8) << it.value()["p99"].get<double>()
+                      << " max " << std::setw(8) << it.value()["max"].get<double>() << " ms\n";
+        }
+    };
+    std::cout << "  Stages:\n";
+    print_stages(r["stages"]);
+    if (!r["processing_tasks"].empty())
+    {
+        std::cout << "  Processing tasks:\n";
+        print_stages(r["processing_tasks"]);
+    }
+}
+
+// Returns the number of metrics that are worse than the baseline by more than the tolerance
+static int compare(const std::string& file, const json& r, const json& baseline, double tolerance)
+{
+    int regressions = 0;
+    auto check = [&](const std::string& metric, double current, double reference, bool higher_is_better) {
+        if (reference <= 0)
+            return;
+        auto change = (current - reference) / reference;
+        bool regressed = higher_is_better ? change < -tolerance : change > tolerance;
+        if (regressed)
+        {
+            ++regressions;
+            std::cout << "REGRESSION " << file << " " << metric << ": " << std::setprecision(3) << current
+                      << " vs. baseline " << reference << " (" << std::showpos << change * 100 << std::noshowpos << "%)\n";
+        }
+    };
+
+    check("frames_per_second", r["frames_per_second"], baseline.value("frames_per_second", 0.), true);
+    check("peak_rss_mb", r["peak_rss_mb"], baseline.value("peak_rss_mb", 0.), false);
+    if (baseline.count("stages"))
+    {
+        auto& stages = r["stages"];
+        for (auto it = stages.begin(); it != stages.end(); ++it)
+        {
+            if (baseline["stages"].count(it.key()))
+                check(it.key() + " p50", it.value()["p50"], baseline["stages"][it.key()].value("p50", 0.), false);
+        }
+    }
+    return regressions;
+}
+
+int main(int argc, char* argv[]) try
+{
+    CmdLine cmd("librealsense rs-replay-benchmark tool", ' ', RS2_API_VERSION_STR);
+    UnlabeledMultiArg<std::string> inputs("bags", "Recorded .bag files to replay", true, "file");
+    ValueArg<std::string> chain_file("c", "chain", "Post-processing settings, as saved by the viewer (realsense-config.json)", false, "", "json");
+    ValueArg<int> repeat("n", "repeat", "Replay every file this number of times and keep the fastest run", false, 1, "count");
+    ValueArg<std::string> output("o", "output", "Write the results to this file, to serve as a baseline", false, "", "json");
+    ValueArg<std::string> baseline_file("b", "baseline", "Compare the results with a baseline and fail on regressions", false, "", "json");
+    ValueArg<float> tolerance("t", "tolerance", "Change from the baseline, in percent, beyond which a metric regressed", false, 10.f, "percent");
+    SwitchArg fused("f", "fused", "Apply the depth post-processing filters of every sensor through one fused block");
+    SwitchArg quiet("q", "quiet", "Do not report progress");
+
+    cmd.add(inputs);
+    cmd.add(chain_file);
+    cmd.add(repeat);
+    cmd.add(output);
+    cmd.add(baseline_file);
+    cmd.add(tolerance);
+    cmd.add(fused);
+    cmd.add(quiet);
+    cmd.parse(argc, argv);
+
+    chain_settings settings;
+    if (!chain_file.getValue().empty())
+        settings = chain_settings(chain_file.getValue());
+
+    json baseline;
+    if (!baseline_file.getValue().empty())
+    {
+        std::ifstream in(baseline_file.getValue());
+        if (!in.good())
+            throw std::runtime_error("Could not open the baseline " + baseline_file.getValue());
+        baseline = json::parse(in);
+    }
+
+    json results;
+    int regressions = 0;
+    for (auto&& file : inputs.getValue())
+    {
+        json best;
+        for (int i = 0; i < std::max(repeat.getValue(), 1); ++i)
+        {
+            auto r = replay(file, settings, fused.getValue(), !quiet.getValue());
+            if (best.is_null() || r["frames_per_second"].get<double>() > best["frames_per_second"].get<double>())
+                best = r;
+        }
+        print(file, best);
+
+        auto name = base_name(file);
+        results["bags"][name] = best;
+        if (baseline.count("bags") && baseline["bags"].count(name))
+            regressions += compare(name, best, baseline["bags"][name], tolerance.getValue() / 100.);
+        else if (!baseline.is_null())
+            std::cout << "No baseline for " << name << std::endl;
+    }
+
+    if (!output.getValue().empty())
+    {
+        std::ofstream out(output.getValue());
+        out << results.dump(2) << std::endl;
+    }
+
+    if (regressions)
+    {
+        std::cout << regressions << " metrics regressed" << std::endl;
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
+catch (const rs2::error& e)
+{
+    std::cerr << "RealSense error calling " << e.get_failed_function() << "(" << e.get_failed_args() << "):\n    " << e.what() << std::endl;
+    return EXIT_FAILURE;
+}
+catch (const std::exception& e)
+{
+    std::cerr << e.what() << std::endl;
+    return EXIT_FAILURE;
+}
@@ -0,0 +1,63 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2021 Intel Corporation. All Rights Reserved.
+
+//#cmake: static!
+//#test:donotrun:!nightly
+
+// Microbenchmark of the Z16H codec: the reference decoder against the serial and parallel decoders, and the
+// encoder, on a synthetic depth frame
+
+#include "../algo-common.h"
+#include <common/decompress-huffman.h>
+#include <src/proc/z16h-codec.h>
+#include <src/thread-pool.h>
+
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace librealsense;
+
+static double time_ms( std::function< void() > const & f, int iterations = 20 )
+{
+    f();  // warm up caches and page in the buffers
+    auto start = std::chrono::high_resolution_clock::now();
+    for( int i = 0; i < iterations; ++i )
+        f();
+    auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration< double, std::milli >( end - start ).count() / iterations;
+}
+
+TEST_CASE( "Z16H codec throughput" )
+{
+    const int width = 1280, height = 720;
+    const size_t stride = width * 2;
+    std::mt19937 rng( 1 );
+    std::normal_distribution< float > noise( 0.f, 2.f );
+    std::vector< uint16_t > depth( width * height );
+    for( int y = 0; y < height; ++y )
+        for( int x = 0; x < width; ++x )
+            depth[y * width + x] = ( x / 37 + y / 23 ) % 11 ? uint16_t( 900.f + 0.8f * x + 0.3f * y + noise( rng ) ) : 0;
+    auto image = reinterpret_cast< const uint8_t * >( depth.data() );
+
+    std::vector< uint32_t > compressed;
+    auto encode = time_ms( [&] { z16h::encode( image, stride, height, compressed ); } );
+    std::vector< uint8_t > decoded( stride * height );
+    auto reference = time_ms( [&] { unhuffimage4( compressed.data(), uint32_t( compressed.size() ), uint32_t( stride ), height, decoded.data() ); } );
+    auto serial = time_ms( [&] { z16h::decode_serial( compressed.data(), compressed.size(), stride, height, decoded.data() ); } );
+    auto parallel = time_ms( [&] { z16h::decode( compressed.data(), compressed.size(), stride, height, decoded.data() ); } );
+    CHECK( !memcmp( decoded.data(), image, decoded.size() ) );
+
+    auto mb = stride * height / 1e6;
+    std::cout << "Z16H, " << width << "x" << height << ", compressed to " << std::fixed << std::setprecision( 1 )
+              << 100. * compressed.size() * 4 / ( stride * height ) << "% (ms per frame, MB/s of depth)\n"
+              << std::setprecision( 3 )
+              << "  Encoder:            " << encode << " (" << mb / encode * 1000 << ")\n"
+              << "  Reference decoder:  " << reference << " (" << mb / reference * 1000 << ")\n"
+              << "  Serial decoder:     " << serial << " (" << mb / serial * 1000 << ")\n"
+              << "  Parallel decoder:   " << parallel << " (" << mb / parallel * 1000 << ") with "
+              << thread_pool::get_instance().get_threads() << " workers" << std::endl;
+}
@@ -0,0 +1,107 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2021 Intel Corporation. All Rights Reserved.
+
+//#cmake: static!
+
+// Unit Test Goals:
+// Test the Z16H codec: images survive a round trip through the encoder and the serial and parallel decoders, the
+// reference decoder reads what the encoder writes, and streams that do not hold the image are reported.
+
+#include "../algo-common.h"
+#include <common/decompress-huffman.h>
+#include <src/proc/z16h-codec.h>
+#include <src/thread-pool.h>
+
+#include <random>
+#include <vector>
+
+using namespace librealsense;
+
+// A scene of slanted planes with noise and holes, as 16-bit depth
+static std::vector< uint8_t > make_depth( int width, int height, unsigned seed )
+{
+    std::mt19937 rng( seed );
+    std::normal_distribution< float > noise( 0.f, 2.f );
+    std::vector< uint16_t > depth( width * height );
+    for( int y = 0; y < height; ++y )
+        for( int x = 0; x < width; ++x )
+        {
+            float z = x < width / 2 ? 900.f + 0.8f * x + 0.3f * y : 2500.f - 1.1f * y;
+            bool hole = ( x / 37 + y / 23 ) % 11 == 0;
+            depth[y * width + x] = hole ? 0 : uint16_t( z + noise( rng ) );
+        }
+    std::vector< uint8_t > bytes( depth.size() * 2 );
+    memcpy( bytes.data(), depth.data(), bytes.size() );
+    return bytes;
+}
+
+static void check_round_trip( std::vector< uint8_t > const & image, size_t stride, size_t height )
+{
+    std::vector< uint32_t > compressed;
+    z16h::encode( image.data(), stride, height, compressed );
+
+    std::vector< uint8_t > serial( image.size() ), parallel( image.size() ), reference( image.size() );
+    CHECK( z16h::decode_serial( compressed.data(), compressed.size(), stride, height, serial.data() ) );
+    CHECK( serial == image );
+    CHECK( z16h::decode( compressed.data(), compressed.size(), stride, height, parallel.data() ) );
+    CHECK( parallel == image );
+    CHECK( unhuffimage4( compressed.data(), uint32_t( compressed.size() ), uint32_t( stride ), uint32_t( height ), reference.data() ) );
+    CHECK( reference == image );
+}
+
+TEST_CASE( "Z16H round trip", "[z16h]" )
+{
+    // Slices of the parallel decoder need workers, even on a single core
+    thread_pool::get_instance().set_threads( 3 );
+
+    SECTION( "depth" )
+    {
+        auto image = make_depth( 848, 480, 1 );
+        check_round_trip( image, 848 * 2, 480 );
+    }
+    SECTION( "noise, where every difference has a long code" )
+    {
+        std::mt19937 rng( 2 );
+        std::vector< uint8_t > image( 640 * 2 * 360 );
+        for( auto & b : image )
+            b = uint8_t( rng() );
+        check_round_trip( image, 640 * 2, 360 );
+    }
+    SECTION( "flat, where the stream is much shorter than the image" )
+    {
+        std::vector< uint8_t > image( 1280 * 2 * 720, 0x12 );
+        check_round_trip( image, 1280 * 2, 720 );
+    }
+    SECTION( "narrow" )
+    {
+        auto image = make_depth( 2, 64, 3 );
+        check_round_trip( image, 4, 64 );
+    }
+
+    thread_pool::get_instance().set_threads( -1 );
+}
+
+TEST_CASE( "Z16H reports streams that do not hold the image", "[z16h]" )
+{
+    thread_pool::get_instance().set_threads( 3 );
+
+    const size_t width = 848, height = 480, stride = width * 2;
+    auto image = make_depth( int( width ), int( height ), 4 );
+    std::vector< uint32_t > compressed;
+    z16h::encode( image.data(), stride, height, compressed );
+    std::vector< uint8_t > decoded( image.size() );
+
+    // Too short
+    CHECK_FALSE( z16h::decode_serial( compressed.data(), compressed.size() - 1, stride, height, decoded.data() ) );
+    CHECK_FALSE( z16h::decode( compressed.data(), compressed.size() - 1, stride, height, decoded.data() ) );
+
+    // Too long: the image ends before the stream
+    compressed.push_back( 0xffffffff );
+    CHECK_FALSE( z16h::decode_serial( compressed.data(), compressed.size(), stride, height, decoded.data() ) );
+    CHECK_FALSE( z16h::decode( compressed.data(), compressed.size(), stride, height, decoded.data() ) );
+
+    // Not even the first line
+    CHECK_FALSE( z16h::decode( compressed.data(), 10, stride, height, decoded.data() ) );
+
+    thread_pool::get_instance().set_threads( -1 );
+}
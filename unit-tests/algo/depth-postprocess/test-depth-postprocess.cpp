@@ -0,0 +1,139 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2021 Intel Corporation. All Rights Reserved.
+
+// Unit Test Goals:
+// Test the depth post-processing block against the filters it is given: the fused recommended chain, with hole
+// filling on either side of disparity to depth, and a chain it does not fuse, match the filters applied one by one
+// over a sequence of frames, so the temporal filter's history is exercised too.
+
+#include "../algo-common.h"
+#include <librealsense2/rs.hpp>
+#include <librealsense2/hpp/rs_internal.hpp>
+
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+static const int width = 848;
+static const int height = 480;
+
+// A slanted wall with noise and a few holes
+static std::vector< uint16_t > make_depth( int frame )
+{
+    std::mt19937 rng( frame );
+    std::vector< uint16_t > depth( width * height );
+    for( int y = 0; y < height; ++y )
+        for( int x = 0; x < width; ++x )
+        {
+            auto r = rng();
+            depth[y * width + x] = r % 17 == 0 ? 0 : uint16_t( 800 + x + y / 2 + r % 9 );
+        }
+    return depth;
+}
+
+struct chain
+{
+    rs2::decimation_filter decimation;
+    rs2::threshold_filter threshold{ 0.1f, 1.6f };
+    rs2::disparity_transform to_disparity{ true };
+    rs2::spatial_filter spatial;
+    rs2::temporal_filter temporal;
+    rs2::disparity_transform to_depth{ false };
+    rs2::hole_filling_filter holes;
+
+    chain( int holes_mode, int spatial_holes )
+    {
+        holes.set_option( RS2_OPTION_HOLES_FILL, float( holes_mode ) );
+        spatial.set_option( RS2_OPTION_HOLES_FILL, float( spatial_holes ) );
+    }
+};
+
+// Streams the same frames through the filters one by one and through a depth_postprocess of their twins, and
+// compares all but the last rows_to_skip rows: the spatial filter's hole filling reads past the end of the frame
+static void compare( std::vector< rs2::filter * > const & filters, std::vector< rs2::filter * > const & twins, int rows_to_skip = 0 )
+{
+    rs2::software_device dev;
+    auto depth_sensor = dev.add_sensor( "Depth" );
+    rs2_intrinsics intrinsics = { width, height, width / 2.f, height / 2.f, 420.f, 420.f, RS2_DISTORTION_BROWN_CONRADY, { 0, 0, 0, 0, 0 } };
+    auto profile = depth_sensor.add_video_stream( { RS2_STREAM_DEPTH, 0, 0, width, height, 30, 2, RS2_FORMAT_Z16, intrinsics } );
+    depth_sensor.add_read_only_option( RS2_OPTION_DEPTH_UNITS, 0.001f );
+    depth_sensor.add_read_only_option( RS2_OPTION_STEREO_BASELINE, 50.f );
+
+    rs2::frame_queue queue;
+    depth_sensor.open( profile );
+    depth_sensor.start( queue );
+
+    rs2::depth_postprocess fused( twins );
+    for( int i = 0; i < 6; ++i )
+    {
+        auto depth = make_depth( i );
+        depth_sensor.on_video_frame( { depth.data(), []( void * ) {}, width * 2, 2, rs2_time_t( i ), RS2_TIMESTAMP_DOMAIN_SYSTEM_TIME, i, profile } );
+        rs2::frame f = queue.wait_for_frame();
+
+        rs2::frame expected = f;
+        for( auto filter : filters )
+            expected = filter->process( expected );
+        rs2::video_frame actual = fused.process( f );
+
+        auto vf = expected.as< rs2::video_frame >();
+        REQUIRE( actual.is< rs2::depth_frame >() );
+        REQUIRE( actual.get_width() == vf.get_width() );
+        REQUIRE( actual.get_height() == vf.get_height() );
+        CHECK( actual.get_profile().format() == RS2_FORMAT_Z16 );
+        CHECK( actual.get_profile().as< rs2::video_stream_profile >().get_intrinsics().fx
+               == vf.get_profile().as< rs2::video_stream_profile >().get_intrinsics().fx );
+
+        auto a = static_cast< const uint16_t * >( actual.get_data() );
+        auto e = static_cast< const uint16_t * >( vf.get_data() );
+        int mismatches = 0;
+        for( int p = 0; p < vf.get_width() * ( vf.get_height() - rows_to_skip ); ++p )
+            mismatches += std::abs( int( a[p] ) - int( e[p] ) ) > 1;
+        CHECK( mismatches == 0 );
+    }
+    depth_sensor.stop();
+    depth_sensor.close();
+}
+
+TEST_CASE( "fused chain with hole filling in disparity" )
+{
+    for( int mode = 0; mode < 3; ++mode )
+    {
+        CAPTURE( mode );
+        chain c( mode, 0 ), t( mode, 0 );
+        compare( { &c.decimation, &c.threshold, &c.to_disparity, &c.spatial, &c.temporal, &c.holes, &c.to_depth },
+                 { &t.decimation, &t.threshold, &t.to_disparity, &t.spatial, &t.temporal, &t.holes, &t.to_depth } );
+    }
+}
+
+TEST_CASE( "fused chain with hole filling in depth" )
+{
+    for( int mode = 0; mode < 3; ++mode )
+    {
+        CAPTURE( mode );
+        chain c( mode, 2 ), t( mode, 2 );
+        c.decimation.set_option( RS2_OPTION_FILTER_MAGNITUDE, 3 );
+        t.decimation.set_option( RS2_OPTION_FILTER_MAGNITUDE, 3 );
+        compare( { &c.decimation, &c.threshold, &c.to_disparity, &c.spatial, &c.temporal, &c.to_depth, &c.holes },
+                 { &t.decimation, &t.threshold, &t.to_disparity, &t.spatial, &t.temporal, &t.to_depth, &t.holes },
+                 2 );
+    }
+}
+
+TEST_CASE( "partial and unfused chains" )
+{
+    chain c( 1, 0 ), t( 1, 0 );
+    compare( { &c.to_disparity, &c.spatial, &c.to_depth }, { &t.to_disparity, &t.spatial, &t.to_depth } );
+
+    // Filtering depth rather than disparity goes through the filters
+    chain d( 1, 0 ), u( 1, 0 );
+    compare( { &d.decimation, &d.spatial, &d.temporal, &d.holes }, { &u.decimation, &u.spatial, &u.temporal, &u.holes } );
+}
+
+TEST_CASE( "only depth post-processing filters" )
+{
+    rs2::colorizer colorizer;
+    rs2::spatial_filter spatial;
+    CHECK_THROWS( rs2::depth_postprocess( { &spatial, &colorizer } ) );
+    CHECK_THROWS( rs2::depth_postprocess( { &spatial, &spatial } ) );
+    CHECK_THROWS( rs2::depth_postprocess( std::vector< rs2::filter * >() ) );
+}
@@ -0,0 +1,218 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2021 Intel Corporation. All Rights Reserved.
+
+//#cmake: static!
+
+// Unit Test Goals:
+// The depth quality metrics summed over strips of rows on the processing threads match those of the points of the
+// region collected and rated one by one: the plane fit, the fill rate, the errors after trimming the outliers, and
+// the accuracy against the ground truth.
+
+#include "../algo-common.h"
+#include <src/proc/depth-quality-metrics.h>
+#include <librealsense2/rsutil.h>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace librealsense;
+
+static const int width = 160;
+static const int height = 120;
+static const float depth_scale = 0.0001f;
+
+static rs2_intrinsics make_intrinsics()
+{
+    rs2_intrinsics intrin = { width, height, width / 2.f, height / 2.f, 100.f, 100.f, RS2_DISTORTION_NONE, { 0, 0, 0, 0, 0 } };
+    return intrin;
+}
+
+// A target at z0 meters, tilted along x and y, seen through noise of sigma meters; every fifth pixel is a hole
+// and every hundredth an outlier far off the target
+static std::vector< uint16_t > make_target( float z0, float tilt_x, float tilt_y, float sigma )
+{
+    std::mt19937 rng( 5 );
+    std::normal_distribution< float > noise( 0.f, sigma );
+    auto intrin = make_intrinsics();
+    std::vector< uint16_t > depth( width * height );
+    for( int y = 0, i = 0; y < height; ++y )
+        for( int x = 0; x < width; ++x, ++i )
+        {
+            if( i % 5 == 3 )
+                continue;
+            float rx = ( x - intrin.ppx ) / intrin.fx, ry = ( y - intrin.ppy ) / intrin.fy;
+            float z = z0 / ( 1 - tilt_x * rx - tilt_y * ry ) + noise( rng );
+            if( i % 100 == 7 )
+                z *= ( i % 200 == 7 ) ? 0.5f : 1.5f;
+            depth[i] = uint16_t( z / depth_scale + 0.5f );
+        }
+    return depth;
+}
+
+// The metrics of the points of the region, collected and sorted as the depth quality tool used to
+static rs2_depth_quality_metrics reference_metrics( const std::vector< uint16_t > & depth,
+                                                    const rs2_depth_quality_params & params )
+{
+    auto intrin = make_intrinsics();
+    rs2_depth_quality_metrics metrics = {};
+    std::vector< std::pair< uint16_t, float3 > > points;
+    for( int y = params.roi_min_y; y < params.roi_max_y; ++y )
+        for( int x = params.roi_min_x; x < params.roi_max_x; ++x )
+        {
+            auto raw = depth[y * width + x];
+            if( !raw )
+                continue;
+            float pixel[2] = { float( x ), float( y ) }, point[3];
+            rs2_deproject_pixel_to_point( point, &intrin, pixel, raw * depth_scale );
+            points.push_back( { raw, { point[0], point[1], point[2] } } );
+        }
+    metrics.roi_pixels = ( params.roi_max_x - params.roi_min_x ) * ( params.roi_max_y - params.roi_min_y );
+    metrics.valid_pixels = int( points.size() );
+    metrics.fill_rate = 100.f * metrics.valid_pixels / metrics.roi_pixels;
+
+    double c[3] = {};
+    for( auto & p : points )
+    {
+        c[0] += p.second.x;
+        c[1] += p.second.y;
+        c[2] += p.second.z;
+    }
+    for( auto & v : c )
+        v /= points.size();
+    double xx = 0, xy = 0, xz = 0, yy = 0, yz = 0, zz = 0;
+    for( auto & p : points )
+    {
+        double dx = p.second.x - c[0], dy = p.second.y - c[1], dz = p.second.z - c[2];
+        xx += dx * dx; xy += dx * dy; xz += dx * dz;
+        yy += dy * dy; yz += dy * dz; zz += dz * dz;
+    }
+    auto plane = plane_from_moments( c, xx, xy, xz, yy, yz, zz );
+    metrics.plane_fit = 1;
+    metrics.plane[0] = plane.x;
+    metrics.plane[1] = plane.y;
+    metrics.plane[2] = plane.z;
+    metrics.plane[3] = plane.w;
+    metrics.distance_mm = -plane.w * 1000;
+
+    // The outliers at either end, keeping the points as deep as the last one out
+    std::sort( points.begin(), points.end(),
+               []( const std::pair< uint16_t, float3 > & a, const std::pair< uint16_t, float3 > & b ) { return a.first < b.first; } );
+    auto outliers = size_t( points.size() * double( params.outlier_percent ) / 100. );
+    auto low = points[outliers].first, high = points[points.size() - 1 - outliers].first;
+
+    double sq_distance = 0, sq_disparity = 0;
+    std::vector< float > distances;
+    double bf = params.baseline_mm / 1000. * intrin.fx;
+    for( auto & p : points )
+    {
+        if( p.first < low || p.first > high )
+            continue;
+        auto & v = p.second;
+        double distance = plane.x * v.x + plane.y * v.y + plane.z * v.z + plane.w;
+        sq_distance += distance * distance * 1e6;
+        double ix = v.x - distance * plane.x, iy = v.y - distance * plane.y, iz = v.z - distance * plane.z;
+        double disparity = bf / std::sqrt( v.x * v.x + v.y * v.y + v.z * v.z ) - bf / std::sqrt( ix * ix + iy * iy + iz * iz );
+        sq_disparity += disparity * disparity;
+        distances.push_back( float( distance * 1000 ) );
+    }
+    metrics.plane_fit_rms_error_mm = float( std::sqrt( sq_distance / distances.size() ) );
+    metrics.subpixel_rms_error = float( std::sqrt( sq_disparity / distances.size() ) );
+
+    // The center ray meets the plane where z * (a * rx + b * ry + c) = -d
+    float z = -plane.w / plane.z;
+    metrics.plane_fit_to_ground_truth_mm = z * 1000 - params.ground_truth_mm;
+    std::sort( distances.begin(), distances.end() );
+    metrics.z_accuracy = 100.f * ( metrics.plane_fit_to_ground_truth_mm + distances[distances.size() / 2] ) / params.ground_truth_mm;
+    return metrics;
+}
+
+static rs2_depth_quality_params make_params( int min_x, int min_y, int max_x, int max_y )
+{
+    rs2_depth_quality_params params = { min_x, min_y, max_x, max_y, 50.f, 1000, 0.5f };
+    return params;
+}
+
+TEST_CASE( "plane of a clean target", "[depth-quality]" )
+{
+    auto depth = make_target( 1.f, 0.2f, -0.1f, 0.f );
+    auto params = make_params( 0, 0, width, height );
+    params.outlier_percent = 0;
+
+    depth_quality_analyzer analyzer;
+    rs2_depth_quality_metrics metrics;
+    analyzer.analyze( depth.data(), width, depth_scale, make_intrinsics(), params, metrics );
+
+    CHECK( metrics.roi_pixels == width * height );
+    CHECK( metrics.valid_pixels == width * height * 4 / 5 );
+    CHECK( metrics.fill_rate == approx( 80.f ) );
+    REQUIRE( metrics.plane_fit );
+    CHECK( metrics.plane_fit_to_ground_truth_mm == approx( 0.f ).margin( 5.f ) );
+}
+
+TEST_CASE( "metrics match those of the points one by one", "[depth-quality]" )
+{
+    auto depth = make_target( 1.2f, 0.15f, 0.05f, 0.002f );
+    depth_quality_analyzer analyzer;
+
+    for( auto params : { make_params( 0, 0, width, height ), make_params( 40, 30, 120, 90 ), make_params( 3, 50, 150, 53 ) } )
+    {
+        auto expected = reference_metrics( depth, params );
+        rs2_depth_quality_metrics metrics;
+        // Twice, as the second frame reuses the rays and the histograms of the first
+        for( int frame = 0; frame < 2; ++frame )
+        {
+            analyzer.analyze( depth.data(), width, depth_scale, make_intrinsics(), params, metrics );
+
+            CHECK( metrics.roi_pixels == expected.roi_pixels );
+            CHECK( metrics.valid_pixels == expected.valid_pixels );
+            CHECK( metrics.fill_rate == approx( expected.fill_rate ) );
+            REQUIRE( metrics.plane_fit );
+            for( int i = 0; i < 3; ++i )
+                CHECK( metrics.plane[i] == approx( expected.plane[i] ).margin( 1e-4 ) );
+            CHECK( metrics.distance_mm == approx( expected.distance_mm ).epsilon( 1e-4 ) );
+            CHECK( metrics.plane_fit_rms_error_mm == approx( expected.plane_fit_rms_error_mm ).epsilon( 1e-3 ) );
+            CHECK( metrics.subpixel_rms_error == approx( expected.subpixel_rms_error ).epsilon( 1e-3 ) );
+            CHECK( metrics.z_accuracy == approx( expected.z_accuracy ).margin( 1e-2 ) );
+        }
+    }
+}
+
+TEST_CASE( "trimming leaves the outliers out of the errors", "[depth-quality]" )
+{
+    auto depth = make_target( 1.f, 0.f, 0.f, 0.001f );
+    auto params = make_params( 0, 0, width, height );
+    depth_quality_analyzer analyzer;
+    rs2_depth_quality_metrics trimmed, untrimmed;
+
+    params.outlier_percent = 2.f;
+    analyzer.analyze( depth.data(), width, depth_scale, make_intrinsics(), params, trimmed );
+    params.outlier_percent = 0;
+    analyzer.analyze( depth.data(), width, depth_scale, make_intrinsics(), params, untrimmed );
+
+    // Outliers at half and one and a half times the distance are hundreds of mm off
+    CHECK( untrimmed.plane_fit_rms_error_mm > 50.f );
+    CHECK( trimmed.plane_fit_rms_error_mm < 2.f );
+}
+
+TEST_CASE( "no plane without points spanning one", "[depth-quality]" )
+{
+    depth_quality_analyzer analyzer;
+    rs2_depth_quality_metrics metrics;
+    auto params = make_params( 0, 0, width, height );
+
+    std::vector< uint16_t > empty( width * height );
+    analyzer.analyze( empty.data(), width, depth_scale, make_intrinsics(), params, metrics );
+    CHECK( metrics.valid_pixels == 0 );
+    CHECK( metrics.fill_rate == 0.f );
+    CHECK_FALSE( metrics.plane_fit );
+
+    // A single row of points at the same depth lies on a line
+    std::vector< uint16_t > line( width * height );
+    std::fill( line.begin() + 10 * width, line.begin() + 11 * width, uint16_t( 10000 ) );
+    analyzer.analyze( line.data(), width, depth_scale, make_intrinsics(), params, metrics );
+    CHECK( metrics.valid_pixels == width );
+    CHECK_FALSE( metrics.plane_fit );
+    CHECK( metrics.plane_fit_rms_error_mm == 0.f );
+}
@@ -0,0 +1,91 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2021 Intel Corporation. All Rights Reserved.
+
+//#cmake: static!
+
+// Unit Test Goals:
+// The batched motion frame layout round-trips its samples, and the whole-batch calibration gives
+// the same result as converting the samples one by one the way motion_transform does.
+
+#include "../algo-common.h"
+#include <src/proc/motion-batch.h>
+
+#include <random>
+#include <vector>
+
+using namespace librealsense;
+
+TEST_CASE( "motion batch layout" )
+{
+    const uint32_t capacity = 7;
+    std::vector< byte > data( motion_batch::data_size( capacity ) );
+    motion_batch batch( data.data() );
+    batch.reset( capacity );
+    CHECK( batch.count() == 0 );
+    CHECK( batch.capacity() == capacity );
+    CHECK( ( reinterpret_cast< byte * >( batch.timestamps() ) - data.data() ) % sizeof( double ) == 0 );
+
+    for( uint32_t i = 0; i < capacity; ++i )
+        batch.append( 100. + i, { float( i ), float( -int( i ) ), float( 2 * i ) } );
+    CHECK( batch.full() );
+
+    for( uint32_t i = 0; i < capacity; ++i )
+    {
+        CHECK( batch.timestamps()[i] == 100. + i );
+        CHECK( batch.x()[i] == float( i ) );
+        CHECK( batch.y()[i] == float( -int( i ) ) );
+        CHECK( batch.z()[i] == float( 2 * i ) );
+    }
+    // The latest sample leads the data, where a single-sample frame keeps its XYZ
+    auto first = reinterpret_cast< const float * >( data.data() );
+    CHECK( first[0] == float( capacity - 1 ) );
+    CHECK( first[2] == float( 2 * ( capacity - 1 ) ) );
+
+    std::vector< byte > copy( data.size() );
+    motion_batch out( copy.data() );
+    out.reset( capacity );
+    out.copy_layout( batch );
+    CHECK( out.count() == capacity );
+    CHECK( std::equal( batch.timestamps(), batch.timestamps() + capacity, out.timestamps() ) );
+}
+
+TEST_CASE( "batch calibration matches per-sample math" )
+{
+    std::mt19937 gen( 42 );
+    std::uniform_real_distribution< float > coef( -1.5f, 1.5f );
+    std::uniform_int_distribution< int > raw( -32768, 32767 );
+
+    float3x3 m{ { coef( gen ), coef( gen ), coef( gen ) },
+                { coef( gen ), coef( gen ), coef( gen ) },
+                { coef( gen ), coef( gen ), coef( gen ) } };
+    float3 bias{ coef( gen ), coef( gen ), coef( gen ) };
+
+    // Sizes around the vector width leave every possible scalar tail
+    for( uint32_t count : { 0u, 1u, 3u, 4u, 5u, 8u, 13u, 200u } )
+    {
+        CAPTURE( count );
+        std::vector< float > x( count ), y( count ), z( count );
+        for( uint32_t i = 0; i < count; ++i )
+        {
+            x[i] = float( raw( gen ) );
+            y[i] = float( raw( gen ) );
+            z[i] = float( raw( gen ) );
+        }
+
+        std::vector< float > ox( count ), oy( count ), oz( count );
+        calibrate_motion_samples( m, bias, x.data(), y.data(), z.data(), ox.data(), oy.data(), oz.data(), count );
+        for( uint32_t i = 0; i < count; ++i )
+        {
+            auto expected = m * float3{ x[i], y[i], z[i] } - bias;
+            CHECK( ox[i] == approx( expected.x ) );
+            CHECK( oy[i] == approx( expected.y ) );
+            CHECK( oz[i] == approx( expected.z ) );
+        }
+
+        // In place, as the input and output batches may share their arrays
+        calibrate_motion_samples( m, bias, x.data(), y.data(), z.data(), x.data(), y.data(), z.data(), count );
+        CHECK( x == ox );
+        CHECK( y == oy );
+        CHECK( z == oz );
+    }
+}
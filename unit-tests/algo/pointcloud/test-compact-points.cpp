@@ -0,0 +1,253 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2021 Intel Corporation. All Rights Reserved.
+
+//#cmake: static!
+
+// Unit Test Goals:
+// Compact points hold exactly the points with depth, in pixel order, within the precision of their layout,
+// and spread back to the full point cloud they were packed from. Normalized texture coordinates keep the points
+// that are off the texture off it. The pointcloud block computes compact points from depth that match its full
+// points.
+
+#include "../algo-common.h"
+#include <src/proc/compact-points.h>
+#include <librealsense2/rs.hpp>
+#include <librealsense2/hpp/rs_internal.hpp>
+
+#include <cmath>
+#include <random>
+#include <utility>
+#include <vector>
+
+using namespace librealsense;
+
+static const uint32_t width = 61;
+static const uint32_t height = 17;
+
+// A cloud of points up to max_z away, with every third pixel missing
+static void make_cloud( std::vector< float3 > & vertices, std::vector< float2 > & texcoords, float max_z )
+{
+    std::mt19937 rng( 7 );
+    std::uniform_real_distribution< float > z( 0.1f, max_z ), xy( -0.8f, 0.8f ), uv( -0.1f, 1.1f );
+    vertices.resize( width * height );
+    texcoords.resize( width * height );
+    for( size_t i = 0; i < vertices.size(); ++i )
+    {
+        if( i % 3 == 1 )
+        {
+            vertices[i] = { 0, 0, 0 };
+            texcoords[i] = { 0, 0 };
+            continue;
+        }
+        auto depth = z( rng );
+        vertices[i] = { xy( rng ) * depth, xy( rng ) * depth, depth };
+        texcoords[i] = { uv( rng ), uv( rng ) };
+    }
+}
+
+static std::vector< byte > pack( rs2_points_layout layout, compact_texture_coordinates texture,
+                                 const std::vector< float3 > & vertices, const std::vector< float2 > & texcoords )
+{
+    auto count = compact_points::count_valid( vertices.data(), vertices.size() );
+    std::vector< byte > data( compact_points::data_size( layout, texture, count, width, height ) );
+    compact_points( data.data() ).pack( layout, texture, width, height, count, vertices.data(),
+                                        texture == texture_coordinates_none ? nullptr : texcoords.data() );
+    return data;
+}
+
+// Packs the cloud, and checks every point against its pixel within tolerance meters
+static void check_layout( rs2_points_layout layout, compact_texture_coordinates texture, float max_z, float tolerance )
+{
+    std::vector< float3 > vertices;
+    std::vector< float2 > texcoords;
+    make_cloud( vertices, texcoords, max_z );
+    auto data = pack( layout, texture, vertices, texcoords );
+    compact_points compact( data.data() );
+
+    REQUIRE( compact.layout() == layout );
+    REQUIRE( compact.count() == width * height - ( width * height + 1 ) / 3 );
+    CHECK( ( static_cast< const byte * >( compact.vertices() ) - data.data() ) % 4 == 0 );
+    CHECK( ( static_cast< const byte * >( compact.texture_coordinates() ) - data.data() ) % 4 == 0 );
+
+    std::vector< float3 > full_vertices( width * height );
+    std::vector< float2 > full_texcoords( width * height );
+    compact.unpack( full_vertices.data(), full_texcoords.data() );
+
+    uint32_t n = 0;
+    for( size_t i = 0; i < vertices.size(); ++i )
+    {
+        bool valid = vertices[i].z != 0;
+        CHECK( ( ( compact.valid_pixels()[i / 8] >> ( i % 8 ) ) & 1 ) == int( valid ) );
+        if( !valid )
+        {
+            CHECK( full_vertices[i].z == 0 );
+            continue;
+        }
+        auto v = compact.get_vertex( n++ );
+        CHECK( std::fabs( v.x - vertices[i].x ) <= tolerance );
+        CHECK( std::fabs( v.y - vertices[i].y ) <= tolerance );
+        CHECK( std::fabs( v.z - vertices[i].z ) <= tolerance );
+        CHECK( full_vertices[i].z == v.z );
+
+        auto uv = full_texcoords[i];
+        switch( texture )
+        {
+        case texture_coordinates_float32:
+            CHECK( uv.x == texcoords[i].x );
+            CHECK( uv.y == texcoords[i].y );
+            break;
+        case texture_coordinates_uint16:
+            // Off the texture stays off it, rather than taking the color of its edge
+            for( auto c : { std::make_pair( uv.x, texcoords[i].x ), std::make_pair( uv.y, texcoords[i].y ) } )
+            {
+                if( c.second < 0.f || c.second > 1.f )
+                    CHECK( c.first == -1.f );
+                else
+                    CHECK( std::fabs( c.first - c.second ) <= 1.f / 65534 );
+            }
+            break;
+        default:
+            CHECK( uv.x == 0 );
+            CHECK( uv.y == 0 );
+        }
+    }
+}
+
+TEST_CASE( "compact points layouts" )
+{
+    check_layout( RS2_POINTS_LAYOUT_FLOAT32, texture_coordinates_float32, 10.f, 0.f );
+    // Half floats keep 11 significant bits
+    check_layout( RS2_POINTS_LAYOUT_FLOAT16, texture_coordinates_uint16, 10.f, 10.f / 2048 );
+    check_layout( RS2_POINTS_LAYOUT_INT16, texture_coordinates_none, 10.f, 0.0005f );
+}
+
+TEST_CASE( "int16 points scale to the farthest component" )
+{
+    std::vector< float3 > vertices;
+    std::vector< float2 > texcoords;
+    make_cloud( vertices, texcoords, 10.f );
+    CHECK( compact_points( pack( RS2_POINTS_LAYOUT_INT16, texture_coordinates_none, vertices, texcoords ).data() ).scale() == 0.001f );
+
+    // Beyond 32.767m millimeters do not fit
+    make_cloud( vertices, texcoords, 60.f );
+    auto data = pack( RS2_POINTS_LAYOUT_INT16, texture_coordinates_none, vertices, texcoords );
+    compact_points compact( data.data() );
+    CHECK( compact.scale() > 0.001f );
+    check_layout( RS2_POINTS_LAYOUT_INT16, texture_coordinates_uint16, 60.f, compact.scale() / 2 * 1.01f );
+}
+
+TEST_CASE( "half float conversion" )
+{
+    // Exact values, rounding to nearest even, overflow, and subnormals
+    CHECK( float_to_half( 1.f ) == 0x3c00 );
+    CHECK( float_to_half( -2.f ) == 0xc000 );
+    CHECK( float_to_half( 65504.f ) == 0x7bff );
+    CHECK( float_to_half( 65520.f ) == 0x7c00 );
+    CHECK( float_to_half( 1.f + 1.f / 2048 ) == 0x3c00 );
+    CHECK( float_to_half( 1.f + 3.f / 2048 ) == 0x3c02 );
+    CHECK( float_to_half( std::ldexp( 1.f, -24 ) ) == 0x0001 );
+    CHECK( float_to_half( std::ldexp( 1.f, -26 ) ) == 0x0000 );
+
+    for( uint32_t h = 0; h < 0x7c00; ++h )
+    {
+        CAPTURE( h );
+        CHECK( float_to_half( half_to_float( uint16_t( h ) ) ) == h );
+        CHECK( float_to_half( -half_to_float( uint16_t( h ) ) ) == ( h | 0x8000 ) );
+    }
+}
+
+TEST_CASE( "pointcloud computes compact points from depth" )
+{
+    // Undistorted, as depth streams are: the SSE full points ignore Brown-Conrady coefficients. The SSE points also
+    // take a multiple of 8 pixels
+    const uint32_t depth_width = 64, depth_height = 16;
+    rs2_intrinsics intrin = { int( depth_width ), int( depth_height ), 30.5f, 8.5f, 40.f, 40.f, RS2_DISTORTION_BROWN_CONRADY, { 0, 0, 0, 0, 0 } };
+    rs2::software_device dev;
+    auto sensor = dev.add_sensor( "Depth" );
+    auto profile = sensor.add_video_stream( { RS2_STREAM_DEPTH, 0, 0, intrin.width, intrin.height, 30, 2, RS2_FORMAT_Z16, intrin } );
+    sensor.add_read_only_option( RS2_OPTION_DEPTH_UNITS, 0.001f );
+
+    rs2::frame_queue queue;
+    sensor.open( profile );
+    sensor.start( queue );
+
+    // Every third pixel missing
+    std::vector< uint16_t > depth( depth_width * depth_height );
+    for( size_t i = 0; i < depth.size(); ++i )
+        depth[i] = i % 3 == 1 ? 0 : uint16_t( 300 + 7 * i );
+    sensor.on_video_frame( { depth.data(), []( void * ) {}, intrin.width * 2, 2, 1000., RS2_TIMESTAMP_DOMAIN_SYSTEM_TIME, 1, profile } );
+    rs2::depth_frame frame = queue.wait_for_frame();
+
+    rs2::pointcloud pc;
+    rs2::points full = pc.calculate( frame );
+    REQUIRE( full.get_compact_points().vertices == nullptr );
+    auto vertices = reinterpret_cast< const float3 * >( full.get_vertices() );
+
+    for( auto layout : { RS2_POINTS_LAYOUT_FLOAT32, RS2_POINTS_LAYOUT_INT16 } )
+    {
+        CAPTURE( layout );
+        pc.set_option( RS2_OPTION_POINTS_LAYOUT, float( layout ) );
+        rs2::points points = pc.calculate( frame );
+        auto compact_data = points.get_compact_points();
+        REQUIRE( compact_data.vertices );
+        compact_points compact( static_cast< const byte * >( points.get_data() ) );
+        REQUIRE( compact.count() == depth_width * depth_height - ( depth_width * depth_height + 1 ) / 3 );
+        CHECK( compact.texture() == texture_coordinates_none );
+
+        std::vector< float3 > unpacked( depth_width * depth_height );
+        compact.unpack( unpacked.data(), nullptr );
+        auto tolerance = layout == RS2_POINTS_LAYOUT_INT16 ? compact.scale() / 2 * 1.01f : 1e-5f;
+        for( size_t i = 0; i < unpacked.size(); ++i )
+        {
+            CAPTURE( i );
+            CHECK( ( unpacked[i].z == 0 ) == ( vertices[i].z == 0 ) );
+            CHECK( std::fabs( unpacked[i].x - vertices[i].x ) <= tolerance );
+            CHECK( std::fabs( unpacked[i].y - vertices[i].y ) <= tolerance );
+            CHECK( std::fabs( unpacked[i].z - vertices[i].z ) <= tolerance );
+        }
+    }
+
+    // Texture coordinates are computed along, unless occlusion removal needs the full grid
+    rs2::software_device color_dev;
+    auto color_sensor = color_dev.add_sensor( "Color" );
+    rs2_intrinsics color_intrin = { 80, 24, 40.f, 12.f, 50.f, 50.f, RS2_DISTORTION_NONE, { 0, 0, 0, 0, 0 } };
+    auto color_profile = color_sensor.add_video_stream( { RS2_STREAM_COLOR, 0, 1, color_intrin.width, color_intrin.height, 30, 3, RS2_FORMAT_RGB8, color_intrin } );
+    profile.register_extrinsics_to( color_profile, { { 1, 0, 0, 0, 1, 0, 0, 0, 1 }, { 0.05f, 0, 0 } } );
+    color_sensor.open( color_profile );
+    color_sensor.start( queue );
+    std::vector< uint8_t > color( color_intrin.width * color_intrin.height * 3 );
+    color_sensor.on_video_frame( { color.data(), []( void * ) {}, color_intrin.width * 3, 3, 1000., RS2_TIMESTAMP_DOMAIN_SYSTEM_TIME, 1, color_profile } );
+    rs2::frame color_frame = queue.wait_for_frame();
+
+    for( float occlusion : { 1.f, 2.f } )  // off, on
+    {
+        CAPTURE( occlusion );
+        pc.set_option( RS2_OPTION_FILTER_MAGNITUDE, occlusion );
+        pc.map_to( color_frame );
+        pc.set_option( RS2_OPTION_POINTS_LAYOUT, float( RS2_POINTS_LAYOUT_FULL ) );
+        full = pc.calculate( frame );
+        auto texcoords = reinterpret_cast< const float2 * >( full.get_texture_coordinates() );
+
+        pc.set_option( RS2_OPTION_POINTS_LAYOUT, float( RS2_POINTS_LAYOUT_FLOAT32 ) );
+        rs2::points points = pc.calculate( frame );
+        compact_points compact( static_cast< const byte * >( points.get_data() ) );
+        REQUIRE( compact.texture() == texture_coordinates_float32 );
+
+        std::vector< float3 > unpacked( depth_width * depth_height );
+        std::vector< float2 > unpacked_texcoords( depth_width * depth_height );
+        compact.unpack( unpacked.data(), unpacked_texcoords.data() );
+        for( size_t i = 0; i < unpacked.size(); ++i )
+        {
+            if( ! unpacked[i].z )
+                continue;
+            CAPTURE( i );
+            CHECK( std::fabs( unpacked_texcoords[i].x - texcoords[i].x ) <= 1e-5f );
+            CHECK( std::fabs( unpacked_texcoords[i].y - texcoords[i].y ) <= 1e-5f );
+        }
+    }
+
+    color_sensor.stop();
+    color_sensor.close();
+    sensor.stop();
+    sensor.close();
+}
@@ -0,0 +1,64 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2021 Intel Corporation. All Rights Reserved.
+
+//#cmake: static!
+//#test:donotrun:!nightly
+
+// Microbenchmark of projecting color pixels to depth: the per-pixel line search of rsutil.h against building a
+// color-to-depth map once per frame and looking every pixel up in it
+
+#include "../algo-common.h"
+#include <librealsense2/rsutil.h>
+#include <src/proc/color-to-depth-map.h>
+
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+static double time_ms( std::function< void() > const & f, int iterations = 20 )
+{
+    f();  // warm up caches and page in the buffers
+    auto start = std::chrono::high_resolution_clock::now();
+    for( int i = 0; i < iterations; ++i )
+        f();
+    auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration< double, std::milli >( end - start ).count() / iterations;
+}
+
+TEST_CASE( "color to depth projection throughput" )
+{
+    const rs2_intrinsics depth_intrin = { 848, 480, 424.f, 240.f, 425.f, 425.f, RS2_DISTORTION_BROWN_CONRADY, { 0, 0, 0, 0, 0 } };
+    const rs2_intrinsics color_intrin = { 1280, 720, 640.f, 360.f, 910.f, 910.f, RS2_DISTORTION_INVERSE_BROWN_CONRADY, { 0, 0, 0, 0, 0 } };
+    const rs2_extrinsics depth_to_color = { { 1, 0, 0, 0, 1, 0, 0, 0, 1 }, { 0.015f, 0, 0 } };
+    const rs2_extrinsics color_to_depth = { { 1, 0, 0, 0, 1, 0, 0, 0, 1 }, { -0.015f, 0, 0 } };
+
+    std::vector< uint16_t > depth( depth_intrin.width * depth_intrin.height );
+    for( size_t i = 0; i < depth.size(); ++i )
+        depth[i] = uint16_t( 800 + ( i * 7 ) % 1200 );
+
+    std::cout << "Color to depth projection, " << depth_intrin.width << "x" << depth_intrin.height << " depth (ms per frame)\n";
+    for( int count : { 10, 100, 500, 2000 } )
+    {
+        std::vector< float > from( 2 * count ), to( 2 * count );
+        for( int i = 0; i < count; ++i )
+        {
+            from[2 * i] = float( 100 + ( i * 97 ) % 1080 );
+            from[2 * i + 1] = float( 50 + ( i * 53 ) % 620 );
+        }
+
+        auto line_search = time_ms( [&] {
+            for( int i = 0; i < count; ++i )
+                rs2_project_color_pixel_to_depth_pixel( &to[2 * i], depth.data(), 0.001f, 0.1f, 10.f, &depth_intrin,
+                                                        &color_intrin, &color_to_depth, &depth_to_color, &from[2 * i] );
+        } );
+        librealsense::color_to_depth_map map;
+        auto mapped = time_ms( [&] {
+            map.build( depth.data(), 0.001f, 0.1f, 10.f, depth_intrin, color_intrin, depth_to_color );
+            map.project( from.data(), to.data(), count );
+        } );
+        std::cout << std::setw( 6 ) << count << " pixels: line search " << std::fixed << std::setprecision( 3 ) << line_search
+                  << ", map " << mapped << " (x" << std::setprecision( 1 ) << line_search / mapped << ")" << std::endl;
+    }
+}
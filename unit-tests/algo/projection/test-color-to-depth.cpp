@@ -0,0 +1,140 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2021 Intel Corporation. All Rights Reserved.
+
+//#cmake: static!
+
+// Unit Test Goals:
+// Test projecting color pixels to depth through a color-to-depth map: the lookups agree with the line search
+// of rs2_project_color_pixel_to_depth_pixel, and see the nearest surface where depth pixels overlap. The map
+// cached for a pair of profiles is rebuilt for a processed copy of the depth frame it was built from, and for a
+// new frame that reuses the buffer of a released one.
+
+#include "../algo-common.h"
+#include <librealsense2/rs.hpp>
+#include <librealsense2/hpp/rs_internal.hpp>
+#include <librealsense2/rsutil.h>
+#include <src/proc/color-to-depth-map.h>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+static const rs2_intrinsics depth_intrin = { 640, 480, 320.f, 240.f, 385.f, 385.f, RS2_DISTORTION_BROWN_CONRADY, { 0, 0, 0, 0, 0 } };
+static const rs2_intrinsics color_intrin = { 1280, 720, 640.f, 360.f, 910.f, 910.f, RS2_DISTORTION_BROWN_CONRADY, { 0, 0, 0, 0, 0 } };
+static const rs2_extrinsics depth_to_color = { { 1, 0, 0, 0, 1, 0, 0, 0, 1 }, { 0.015f, 0, 0 } };
+static const rs2_extrinsics color_to_depth = { { 1, 0, 0, 0, 1, 0, 0, 0, 1 }, { -0.015f, 0, 0 } };
+static const float depth_scale = 0.001f;
+
+TEST_CASE( "color to depth map agrees with the line search" )
+{
+    // A wall at 1.5 m
+    std::vector< uint16_t > depth( depth_intrin.width * depth_intrin.height, 1500 );
+
+    librealsense::color_to_depth_map map;
+    map.build( depth.data(), depth_scale, 0.1f, 10.f, depth_intrin, color_intrin, depth_to_color );
+
+    std::vector< float > color_pixels;
+    for( int y = 100; y < 620; y += 37 )
+        for( int x = 200; x < 1080; x += 41 )
+        {
+            color_pixels.push_back( float( x ) );
+            color_pixels.push_back( float( y ) );
+        }
+    auto count = int( color_pixels.size() / 2 );
+    std::vector< float > depth_pixels( color_pixels.size() );
+    CHECK( map.project( color_pixels.data(), depth_pixels.data(), count ) == count );
+
+    for( int i = 0; i < count; ++i )
+    {
+        float expected[2] = { -1, -1 };
+        rs2_project_color_pixel_to_depth_pixel( expected, depth.data(), depth_scale, 0.1f, 10.f, &depth_intrin,
+                                                &color_intrin, &color_to_depth, &depth_to_color, &color_pixels[2 * i] );
+        CAPTURE( color_pixels[2 * i], color_pixels[2 * i + 1] );
+        CHECK( std::abs( depth_pixels[2 * i] - expected[0] ) <= 1.f );
+        CHECK( std::abs( depth_pixels[2 * i + 1] - expected[1] ) <= 1.f );
+    }
+}
+
+TEST_CASE( "color to depth map sees the nearest surface" )
+{
+    // A box at 0.5 m in front of a wall at 1.5 m, and a band without depth
+    std::vector< uint16_t > depth( depth_intrin.width * depth_intrin.height, 1500 );
+    for( int y = 200; y < 280; ++y )
+        for( int x = 280; x < 360; ++x )
+            depth[y * depth_intrin.width + x] = 500;
+    for( int y = 0; y < depth_intrin.height; ++y )
+        for( int x = 100; x < 140; ++x )
+            depth[y * depth_intrin.width + x] = 0;
+
+    librealsense::color_to_depth_map map;
+    map.build( depth.data(), depth_scale, 0.1f, 10.f, depth_intrin, color_intrin, depth_to_color );
+
+    // The center of the box, as the color camera sees it
+    float point[3] = { 0, 0, 0.5f }, color_point[3], box_center[2];
+    rs2_transform_point_to_point( color_point, &depth_to_color, point );
+    rs2_project_point_to_pixel( box_center, &color_intrin, color_point );
+
+    // The middle of the band is at 177 in color
+    float pixels[] = { box_center[0], box_center[1], 177.f, 360.f, -10.f, 20.f };
+    float to[6];
+    CHECK( map.project( pixels, to, 3 ) == 1 );
+    CHECK( to[0] >= 280 );
+    CHECK( to[0] < 360 );
+    CHECK( to[1] >= 200 );
+    CHECK( to[1] < 280 );
+    CHECK( to[2] == -1.f );  // depth is missing there
+    CHECK( to[4] == -1.f );  // off the color image
+
+    // Depth out of range is not seen: the wall behind the box is hidden from the depth camera
+    map.build( depth.data(), depth_scale, 1.f, 10.f, depth_intrin, color_intrin, depth_to_color );
+    CHECK( map.project( pixels, to, 1 ) == 0 );
+    CHECK( to[0] == -1.f );
+}
+
+TEST_CASE( "color to depth map is rebuilt for a processed copy of the depth frame" )
+{
+    rs2::software_device dev;
+    auto depth_sensor = dev.add_sensor( "Depth" );
+    auto color_sensor = dev.add_sensor( "Color" );
+    auto depth_profile = depth_sensor.add_video_stream(
+        { RS2_STREAM_DEPTH, 0, 0, depth_intrin.width, depth_intrin.height, 30, 2, RS2_FORMAT_Z16, depth_intrin } );
+    auto color_profile = color_sensor.add_video_stream(
+        { RS2_STREAM_COLOR, 0, 1, color_intrin.width, color_intrin.height, 30, 3, RS2_FORMAT_RGB8, color_intrin } );
+    depth_sensor.add_read_only_option( RS2_OPTION_DEPTH_UNITS, depth_scale );
+    depth_profile.register_extrinsics_to( color_profile, depth_to_color );
+
+    rs2::frame_queue queue;
+    depth_sensor.open( depth_profile );
+    depth_sensor.start( queue );
+
+    // A wall at 1.5 m
+    std::vector< uint16_t > depth( depth_intrin.width * depth_intrin.height, 1500 );
+    depth_sensor.on_video_frame( { depth.data(), []( void * ) {}, depth_intrin.width * 2, 2, 1000., RS2_TIMESTAMP_DOMAIN_SYSTEM_TIME, 7, depth_profile } );
+    rs2::depth_frame original = queue.wait_for_frame();
+
+    // Same frame number and timestamp, but the wall is gone
+    rs2::threshold_filter threshold( 0.1f, 1.f );
+    rs2::depth_frame filtered = threshold.process( original );
+    REQUIRE( filtered.get_frame_number() == original.get_frame_number() );
+    REQUIRE( filtered.get_timestamp() == original.get_timestamp() );
+
+    std::vector< float > center = { 640.f, 360.f };
+    CHECK( original.project_color_pixels( color_profile, center )[0] != -1.f );
+    CHECK( filtered.project_color_pixels( color_profile, center )[0] == -1.f );
+    CHECK( original.project_color_pixels( color_profile, center )[0] != -1.f );
+
+    SECTION( "and for a new frame in the buffer of a released one" )
+    {
+        original = rs2::depth_frame( rs2::frame() );
+        filtered = rs2::depth_frame( rs2::frame() );
+
+        // The same buffer, frame number and timestamp come back with the wall gone
+        std::fill( depth.begin(), depth.end(), uint16_t( 0 ) );
+        depth_sensor.on_video_frame( { depth.data(), []( void * ) {}, depth_intrin.width * 2, 2, 1000., RS2_TIMESTAMP_DOMAIN_SYSTEM_TIME, 7, depth_profile } );
+        rs2::depth_frame again = queue.wait_for_frame();
+        CHECK( again.project_color_pixels( color_profile, center )[0] == -1.f );
+    }
+
+    depth_sensor.stop();
+    depth_sensor.close();
+}
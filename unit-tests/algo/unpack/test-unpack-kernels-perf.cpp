@@ -0,0 +1,68 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2021 Intel Corporation. All Rights Reserved.
+
+//#cmake: static!
+//#test:donotrun:!nightly
+
+// Microbenchmark of the unpack kernels: prints the throughput of every kernel set usable on this
+// machine, relative to the scalar reference
+
+#include "../algo-common.h"
+#include <src/proc/simd/unpack-kernels.h>
+
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+using namespace librealsense;
+
+static double time_ms( std::function< void() > const & f, int iterations = 50 )
+{
+    f();  // warm up caches and page in the buffers
+    auto start = std::chrono::high_resolution_clock::now();
+    for( int i = 0; i < iterations; ++i )
+        f();
+    auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration< double, std::milli >( end - start ).count() / iterations;
+}
+
+TEST_CASE( "unpack kernels throughput" )
+{
+    const int width = 1280, height = 720, count = width * height;
+    std::vector< uint8_t > src8( count * 3, 0x5a );
+    std::vector< uint16_t > src16( count, 0x3ff );
+    std::vector< uint8_t > a8( count ), b8( count );
+    std::vector< uint16_t > a16( count ), b16( count );
+
+    struct result { const char * name; std::function< double( const unpack_kernels & ) > run; };
+    std::vector< result > kernels = {
+        { "Y8I split",   [&]( const unpack_kernels & k ) { return time_ms( [&] { k.split_y8i( src8.data(), a8.data(), b8.data(), count ); } ); } },
+        { "Y12I split",  [&]( const unpack_kernels & k ) { return time_ms( [&] { k.split_y12i( src8.data(), a16.data(), b16.data(), count ); } ); } },
+        { "Y10 to Y16",  [&]( const unpack_kernels & k ) { return time_ms( [&] { k.expand_y10_to_y16( src16.data(), a16.data(), count ); } ); } },
+        { "Y10 to Y8",   [&]( const unpack_kernels & k ) { return time_ms( [&] { k.narrow_y10_to_y8( src16.data(), a8.data(), count ); } ); } },
+        { "Y10BPACK",    [&]( const unpack_kernels & k ) { return time_ms( [&] { k.unpack_y10bpack( src8.data(), a16.data(), count ); } ); } },
+        { "Rotate 8",    [&]( const unpack_kernels & k ) { return time_ms( [&] { k.rotate_8( src8.data(), a8.data(), width, height ); } ); } },
+        { "Rotate 16",   [&]( const unpack_kernels & k ) { return time_ms( [&] { k.rotate_16( src16.data(), a16.data(), width, height ); } ); } },
+        { "Confidence",  [&]( const unpack_kernels & k ) { return time_ms( [&] { k.rotate_confidence( src8.data(), a8.data(), width / 2, height ); } ); } },
+        { "HDR merge",   [&]( const unpack_kernels & k ) { return time_ms( [&] { k.hdr_merge_depth_ir8( a16.data(), src16.data(), src8.data(), count ); } ); } },
+    };
+
+    auto & scalar = *get_unpack_kernels( simd_level::scalar );
+    std::cout << "Unpack kernels, " << width << "x" << height << " (ms per frame, speedup vs. scalar)\n";
+    for( auto & k : kernels )
+    {
+        auto reference = k.run( scalar );
+        std::cout << std::setw( 12 ) << k.name << ": Scalar " << std::fixed << std::setprecision( 3 ) << reference;
+        for( auto level : { simd_level::sse41, simd_level::avx2, simd_level::avx512, simd_level::neon } )
+        {
+            if( auto vector = get_unpack_kernels( level ) )
+            {
+                auto t = k.run( *vector );
+                std::cout << ", " << get_string( level ) << " " << t << " (x" << std::setprecision( 1 ) << reference / t << ")" << std::setprecision( 3 );
+            }
+        }
+        std::cout << std::endl;
+    }
+}
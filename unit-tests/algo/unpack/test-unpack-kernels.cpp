@@ -0,0 +1,215 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2021 Intel Corporation. All Rights Reserved.
+
+//#cmake: static!
+
+#include "../algo-common.h"
+#include <src/proc/simd/unpack-kernels.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace librealsense;
+
+// Odd sizes exercise the scalar tails, the larger ones several vector iterations
+static const int pixel_counts[] = { 0, 1, 4, 7, 16, 33, 64, 100, 1000, 640 * 480 + 4 };
+
+// Rotation sizes: exact blocks, ragged edges on either side, and the L500 resolutions
+static const std::pair< int, int > rotate_sizes[] = { { 1, 1 }, { 16, 16 }, { 17, 5 }, { 5, 33 }, { 40, 24 }, { 641, 479 }, { 640, 480 }, { 1024, 768 } };
+
+static std::vector< uint8_t > random_bytes( size_t size )
+{
+    std::mt19937 gen( 1234 );
+    std::uniform_int_distribution< int > dist( 0, 255 );
+    std::vector< uint8_t > bytes( size );
+    for( auto & b : bytes )
+        b = uint8_t( dist( gen ) );
+    return bytes;
+}
+
+static std::vector< uint16_t > random_words( size_t size )
+{
+    std::mt19937 gen( 4321 );
+    std::uniform_int_distribution< int > dist( 0, 0xffff );  // also bits above the 10 that matter
+    std::vector< uint16_t > words( size );
+    for( auto & w : words )
+        w = uint16_t( dist( gen ) );
+    return words;
+}
+
+static void compare_with_scalar( const unpack_kernels & k )
+{
+    auto & ref = *get_unpack_kernels( simd_level::scalar );
+    CAPTURE( get_string( k.level ) );
+
+    for( auto count : pixel_counts )
+    {
+        CAPTURE( count );
+        {
+            auto src = random_bytes( count * 2 );
+            std::vector< uint8_t > l( count ), r( count ), ref_l( count ), ref_r( count );
+            ref.split_y8i( src.data(), ref_l.data(), ref_r.data(), count );
+            k.split_y8i( src.data(), l.data(), r.data(), count );
+            REQUIRE( l == ref_l );
+            REQUIRE( r == ref_r );
+        }
+        {
+            auto src = random_bytes( count * 3 );
+            std::vector< uint16_t > l( count ), r( count ), ref_l( count ), ref_r( count );
+            ref.split_y12i( src.data(), ref_l.data(), ref_r.data(), count );
+            k.split_y12i( src.data(), l.data(), r.data(), count );
+            REQUIRE( l == ref_l );
+            REQUIRE( r == ref_r );
+        }
+        {
+            auto src = random_words( count );
+            std::vector< uint16_t > out( count ), ref_out( count );
+            ref.expand_y10_to_y16( src.data(), ref_out.data(), count );
+            k.expand_y10_to_y16( src.data(), out.data(), count );
+            REQUIRE( out == ref_out );
+        }
+        {
+            auto src = random_words( count );
+            std::vector< uint8_t > out( count ), ref_out( count );
+            ref.narrow_y10_to_y8( src.data(), ref_out.data(), count );
+            k.narrow_y10_to_y8( src.data(), out.data(), count );
+            REQUIRE( out == ref_out );
+        }
+        {
+            auto packed = count / 4 * 4;
+            auto src = random_bytes( packed / 4 * 5 );
+            std::vector< uint16_t > out( packed ), ref_out( packed );
+            ref.unpack_y10bpack( src.data(), ref_out.data(), packed );
+            k.unpack_y10bpack( src.data(), out.data(), packed );
+            REQUIRE( out == ref_out );
+        }
+        {
+            // Sparse depth, so that each step both fills holes and leaves some open
+            auto depth = random_words( count );
+            auto ir8 = random_bytes( count );
+            auto ir16 = random_words( count );
+            auto start = random_words( count );
+            for( int i = 0; i < count; ++i )
+            {
+                if( depth[i] % 3 == 0 ) depth[i] = 0;
+                if( start[i] % 2 == 0 ) start[i] = 0;
+                ir16[i] &= 0x3ff;
+            }
+            auto out = start, ref_out = start;
+            ref.hdr_merge_depth( ref_out.data(), depth.data(), count );
+            k.hdr_merge_depth( out.data(), depth.data(), count );
+            REQUIRE( out == ref_out );
+            out = ref_out = start;
+            ref.hdr_merge_depth_ir8( ref_out.data(), depth.data(), ir8.data(), count );
+            k.hdr_merge_depth_ir8( out.data(), depth.data(), ir8.data(), count );
+            REQUIRE( out == ref_out );
+            out = ref_out = start;
+            ref.hdr_merge_depth_ir16( ref_out.data(), depth.data(), ir16.data(), count );
+            k.hdr_merge_depth_ir16( out.data(), depth.data(), ir16.data(), count );
+            REQUIRE( out == ref_out );
+        }
+    }
+
+    for( auto size : rotate_sizes )
+    {
+        int w = size.first, h = size.second;
+        CAPTURE( w, h );
+        {
+            auto src = random_bytes( w * h );
+            std::vector< uint8_t > out( w * h ), ref_out( w * h );
+            ref.rotate_8( src.data(), ref_out.data(), w, h );
+            k.rotate_8( src.data(), out.data(), w, h );
+            REQUIRE( out == ref_out );
+        }
+        {
+            auto src = random_words( w * h );
+            std::vector< uint16_t > out( w * h ), ref_out( w * h );
+            ref.rotate_16( src.data(), ref_out.data(), w, h );
+            k.rotate_16( src.data(), out.data(), w, h );
+            REQUIRE( out == ref_out );
+        }
+        {
+            auto src = random_bytes( w * h );
+            std::vector< uint8_t > out( 2 * w * h ), ref_out( 2 * w * h );
+            ref.rotate_confidence( src.data(), ref_out.data(), w, h );
+            k.rotate_confidence( src.data(), out.data(), w, h );
+            REQUIRE( out == ref_out );
+        }
+    }
+}
+
+TEST_CASE( "scalar unpack kernels match the original unpackers" )
+{
+    auto & k = *get_unpack_kernels( simd_level::scalar );
+
+    // Y12I pixel: right = 0xABC, left = 0x123
+    const uint8_t y12i[] = { 0xBC, 0x3A, 0x12 };
+    uint16_t l, r;
+    k.split_y12i( y12i, &l, &r, 1 );
+    CHECK( l == uint16_t( 0x123 << 6 | 0x123 >> 4 ) );
+    CHECK( r == uint16_t( 0xABC << 6 | 0xABC >> 4 ) );
+
+    // Y10BPACK macro-pixel: MSBs 0x01..0x04, LSB pairs 0,1,2,3
+    const uint8_t y10[] = { 0x01, 0x02, 0x03, 0x04, 0xE4 };
+    uint16_t out[4];
+    k.unpack_y10bpack( y10, out, 4 );
+    CHECK( out[0] == uint16_t( ( 0x01 << 2 | 0 ) << 6 ) );
+    CHECK( out[1] == uint16_t( ( 0x02 << 2 | 1 ) << 6 ) );
+    CHECK( out[2] == uint16_t( ( 0x03 << 2 | 2 ) << 6 ) );
+    CHECK( out[3] == uint16_t( ( 0x04 << 2 | 3 ) << 6 ) );
+
+    // 3x2 source: the rotated image is 2 wide and 3 tall, read back to front column by column
+    const uint16_t src16[] = { 1, 2, 3,
+                               4, 5, 6 };
+    uint16_t rot16[6];
+    k.rotate_16( src16, rot16, 3, 2 );
+    const uint16_t expected16[] = { 6, 3,
+                                    5, 2,
+                                    4, 1 };
+    CHECK( std::equal( rot16, rot16 + 6, expected16 ) );
+
+    // Confidence: each rotated row is followed by a row holding the high nibbles
+    const uint8_t conf[] = { 0x21, 0x43 };
+    uint8_t rot_conf[4];
+    k.rotate_confidence( conf, rot_conf, 2, 1 );
+    const uint8_t expected_conf[] = { 0x30, 0x40, 0x10, 0x20 };
+    CHECK( std::equal( rot_conf, rot_conf + 4, expected_conf ) );
+
+    // HDR merge of two entries: the first entry wins unless its depth is missing or its IR is
+    // saturated, and pixels that no entry can fill stay 0
+    const uint16_t d0[] = { 100, 0, 300, 400, 500 };
+    const uint16_t d1[] = { 111, 222, 333, 0, 555 };
+    const uint8_t i0[] = { 128, 128, 255, 255, 3 };
+    const uint8_t i1[] = { 128, 128, 128, 128, 250 };
+    uint16_t merged[5] = {};
+    k.hdr_merge_depth_ir8( merged, d0, i0, 5 );
+    k.hdr_merge_depth_ir8( merged, d1, i1, 5 );
+    const uint16_t expected_ir[] = { 100, 222, 333, 0, 0 };
+    CHECK( std::equal( merged, merged + 5, expected_ir ) );
+
+    std::fill( merged, merged + 5, uint16_t( 0 ) );
+    k.hdr_merge_depth( merged, d0, 5 );
+    k.hdr_merge_depth( merged, d1, 5 );
+    const uint16_t expected_depth[] = { 100, 222, 300, 400, 500 };
+    CHECK( std::equal( merged, merged + 5, expected_depth ) );
+}
+
+TEST_CASE( "vector unpack kernels are bit-exact with scalar" )
+{
+    int tested = 0;
+    for( auto level : { simd_level::sse41, simd_level::avx2, simd_level::avx512, simd_level::neon } )
+    {
+        auto k = get_unpack_kernels( level );
+        if( ! k )
+            continue;  // not compiled in, or not supported by this CPU
+        compare_with_scalar( *k );
+        ++tested;
+    }
+
+    // The dispatcher must always pick something usable
+    auto best = get_unpack_kernels().level;
+    CAPTURE( tested, get_string( best ) );
+    REQUIRE( get_unpack_kernels( best ) );
+    CHECK( get_unpack_kernels( best )->level == best );
+}
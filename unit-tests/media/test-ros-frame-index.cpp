@@ -0,0 +1,242 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2021 Intel Corporation. All Rights Reserved.
+
+//#cmake: static!
+
+// Unit Test Goals:
+// Index the frames of a bag the way playback seeks in it: by the frame numbers the writer leaves in the file, or,
+// for a file without them, by the frame numbers of its frames, cached next to the file for the next time, as long
+// as the file is the same. A file recorded from a device carries the index, through which playback seeks to a
+// frame and reads any frame.
+
+#include <easylogging++.h>
+#ifdef BUILD_SHARED_LIBS
+INITIALIZE_EASYLOGGINGPP
+#endif
+
+#include "../catch.h"
+
+#include <librealsense2/rs.hpp>
+#include <librealsense2/hpp/rs_internal.hpp>
+#include <src/media/ros/ros_frame_index.h>
+#include <rosbag/view.h>
+
+#include <cstdio>
+#include <fstream>
+
+using namespace librealsense;
+
+static const device_serializer::stream_identifier depth_stream{ 0, 0, RS2_STREAM_DEPTH, 0 };
+static const size_t frames_count = 50;
+
+// Recordings differ by take: a later one has later frames, numbered higher
+static rs2rosinternal::Time frame_time(size_t i, int take = 0)
+{
+    return rs2rosinternal::Time(1 + take, 0) + rs2rosinternal::Duration(0, 33000000 * uint32_t(i));
+}
+
+// Frame numbers skip every fifth frame, as when frames are dropped while recording
+static uint32_t frame_number(size_t i, int take = 0)
+{
+    return uint32_t(100 + 1000 * take + i + i / 4);
+}
+
+static void write_bag(const std::string& file_name, bool with_frame_index, int take = 0)
+{
+    rosbag::Bag bag;
+    bag.open(file_name, rosbag::BagMode::Write);
+    std_msgs::UInt64MultiArray index;
+    for (size_t i = 0; i < frames_count; ++i)
+    {
+        sensor_msgs::Image image;
+        image.width = 4;
+        image.height = 2;
+        image.step = 8;
+        image.encoding = sensor_msgs::image_encodings::MONO16;
+        image.data.resize(16, uint8_t(i));
+        image.header.seq = frame_number(i, take);
+        bag.write(ros_topic::frame_data_topic(depth_stream), frame_time(i, take), image);
+        index.data.push_back(frame_number(i, take));
+    }
+    if (with_frame_index)
+        bag.write(ros_topic::frame_index_topic(depth_stream), rs2rosinternal::TIME_MIN, index);
+}
+
+static bool file_exists(const std::string& file_name)
+{
+    return bool(std::ifstream(file_name));
+}
+
+static void check_index(ros_frame_index& index, int take = 0)
+{
+    auto topic = ros_topic::frame_data_topic(depth_stream);
+    auto frames = index.get_frames(topic);
+    REQUIRE(frames);
+    REQUIRE(frames->size() == frames_count);
+    CHECK_FALSE(index.get_frames(ros_topic::frame_data_topic({ 0, 0, RS2_STREAM_COLOR, 0 })));
+
+    for (size_t i = 0; i < frames_count; ++i)
+    {
+        size_t position = frames_count;
+        REQUIRE(index.find_frame(topic, frame_number(i, take), position));
+        CHECK(position == i);
+        CHECK((*frames)[i].time == frame_time(i, take));
+
+        REQUIRE(index.find_last_frame(topic, frame_time(i, take), position));
+        CHECK(position == i);
+        REQUIRE(index.find_last_frame(topic, frame_time(i, take) + rs2rosinternal::Duration(0, 1000), position));
+        CHECK(position == i);
+    }
+
+    size_t position;
+    CHECK_FALSE(index.find_frame(topic, frame_number(3, take) + 1, position));
+    CHECK_FALSE(index.find_frame(topic, frame_number(0, take) - 1, position));
+    CHECK_FALSE(index.find_last_frame(topic, frame_time(0, take) - rs2rosinternal::Duration(0, 1), position));
+}
+
+TEST_CASE("Frame index of a file recorded with one", "[record_playback]")
+{
+    std::string file_name = "test-frame-index-recorded.bag";
+    std::remove(ros_frame_index::cache_file_name(file_name).c_str());
+    write_bag(file_name, true);
+
+    rosbag::Bag bag;
+    bag.open(file_name, rosbag::BagMode::Read);
+    ros_frame_index index(bag, file_name);
+    check_index(index);
+
+    // The frames are not read, nor is anything kept next to the file
+    CHECK_FALSE(file_exists(ros_frame_index::cache_file_name(file_name)));
+
+    bag.close();
+    std::remove(file_name.c_str());
+}
+
+TEST_CASE("Frame index of a file recorded without one is cached next to it", "[record_playback]")
+{
+    std::string file_name = "test-frame-index-unrecorded.bag";
+    auto cache_file_name = ros_frame_index::cache_file_name(file_name);
+    std::remove(cache_file_name.c_str());
+    write_bag(file_name, false);
+
+    rosbag::Bag bag;
+    bag.open(file_name, rosbag::BagMode::Read);
+    {
+        ros_frame_index index(bag, file_name);
+        check_index(index);
+    }
+    REQUIRE(file_exists(cache_file_name));
+
+    {
+        ros_frame_index cached(bag, file_name);
+        check_index(cached);
+    }
+
+    // An index that is not of the file is made again
+    {
+        std::ofstream(cache_file_name, std::ios::binary | std::ios::trunc) << "not an index";
+    }
+    {
+        ros_frame_index index(bag, file_name);
+        check_index(index);
+    }
+    std::ifstream cache(cache_file_name, std::ios::binary);
+    char magic[4] = {};
+    cache.read(magic, sizeof(magic));
+    CHECK(std::string(magic, sizeof(magic)) == "RSFI");
+    cache.close();
+    bag.close();
+
+    // Another recording of the same size in place of the file is indexed again, even within the second the
+    // index was made in
+    write_bag(file_name, false, 1);
+    {
+        rosbag::Bag other;
+        other.open(file_name, rosbag::BagMode::Read);
+        ros_frame_index index(other, file_name);
+        check_index(index, 1);
+    }
+    std::remove(file_name.c_str());
+    std::remove(cache_file_name.c_str());
+}
+
+TEST_CASE("Playback seeks and reads frames of a recording through its index", "[record_playback]")
+{
+    std::string file_name = "test-frame-index-playback.bag";
+    auto cache_file_name = ros_frame_index::cache_file_name(file_name);
+    std::remove(cache_file_name.c_str());
+
+    std::vector<std::vector<uint16_t>> pixels;
+    for (size_t i = 0; i < frames_count; ++i)
+        pixels.emplace_back(8, uint16_t(i));
+    {
+        rs2::software_device dev;
+        auto sensor = dev.add_sensor("Depth");
+        sensor.add_read_only_option(RS2_OPTION_DEPTH_UNITS, 0.001f);
+        rs2_intrinsics intrinsics = { 4, 2, 2, 1, 4, 4, RS2_DISTORTION_NONE, { 0, 0, 0, 0, 0 } };
+        auto profile = sensor.add_video_stream({ RS2_STREAM_DEPTH, 0, 0, 4, 2, 30, 2, RS2_FORMAT_Z16, intrinsics });
+
+        rs2::recorder recorder(file_name, dev);
+        rs2::frame_queue queue(frames_count);
+        sensor.open(profile);
+        sensor.start(queue);
+        for (size_t i = 0; i < frames_count; ++i)
+        {
+            sensor.on_video_frame({ pixels[i].data(), [](void*) {}, 8, 2, 1000. + 33. * i,
+                                    RS2_TIMESTAMP_DOMAIN_HARDWARE_CLOCK, int(frame_number(i)), profile });
+            queue.wait_for_frame();
+        }
+        sensor.stop();
+        sensor.close();
+    }
+
+    // The writer left the index in the file
+    {
+        rosbag::Bag bag;
+        bag.open(file_name, rosbag::BagMode::Read);
+        rosbag::View index_view(bag, rosbag::TopicQuery(ros_topic::frame_index_topic(depth_stream)));
+        CHECK(index_view.size() == 1);
+        bag.close();
+    }
+
+    {
+        rs2::context ctx;
+        rs2::playback playback = ctx.load_device(file_name);
+        playback.set_real_time(false);
+        auto sensor = playback.first<rs2::depth_sensor>();
+        auto profile = sensor.get_stream_profiles().front();
+
+        REQUIRE(playback.get_frame_count(profile) == frames_count);
+        for (size_t i : { size_t(0), size_t(17), frames_count - 1 })
+        {
+            auto f = playback.get_frame_at(profile, i);
+            CHECK(f.get_frame_number() == frame_number(i));
+            CHECK(static_cast<const uint16_t*>(f.get_data())[0] == i);
+        }
+        CHECK_THROWS(playback.get_frame_at(profile, frames_count));
+
+        rs2::frame_queue queue(frames_count);
+        sensor.open(profile);
+        sensor.start(queue);
+        playback.pause();
+        rs2::frame f;
+        while (queue.try_wait_for_frame(&f, 200))
+            ;
+
+        // Paused, the playback publishes the frame it was set to
+        playback.seek_to_frame(profile, frame_number(30));
+        REQUIRE(queue.try_wait_for_frame(&f, 5000));
+        CHECK(f.get_frame_number() == frame_number(30));
+        CHECK(static_cast<const uint16_t*>(f.get_data())[0] == 30);
+        CHECK_THROWS(playback.seek_to_frame(profile, frame_number(3) + 1));
+
+        // Frames published by a seek must not outlive the playback sensor
+        f = rs2::frame();
+        sensor.stop();
+        sensor.close();
+    }
+
+    // The index came with the file, so none was made next to it
+    CHECK_FALSE(file_exists(cache_file_name));
+    std::remove(file_name.c_str());
+}
@@ -0,0 +1,234 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2021 Intel Corporation. All Rights Reserved.
+
+//#cmake: static!
+
+// Unit Test Goals:
+// Convert the frames of a synthetic sensor whose raw format fans out to two conversion blocks: each block gets a
+// lane of its own that keeps its frames in order, a full lane drops its oldest raw frame, a queue size of 0
+// converts on the capture thread, and the user callback is never entered by two lanes at once.
+
+#include "../catch.h"
+
+#include <src/software-device.h>
+#include <src/sensor.h>
+#include <src/proc/identity-processing-block.h>
+#include <src/proc/color-formats-converter.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace librealsense;
+
+static const int width = 16;
+static const int height = 2;
+
+typedef std::vector< unsigned long long > frame_numbers;
+
+// Holds the frames that reach it until it is opened
+struct gate
+{
+    std::mutex m;
+    std::condition_variable cv;
+    bool open = true;
+    int entered = 0;
+
+    void pass()
+    {
+        std::unique_lock< std::mutex > lock( m );
+        ++entered;
+        cv.notify_all();
+        cv.wait( lock, [&]() { return open; } );
+    }
+
+    void set_open( bool value )
+    {
+        std::lock_guard< std::mutex > lock( m );
+        open = value;
+        cv.notify_all();
+    }
+
+    void wait_entered( int count )
+    {
+        std::unique_lock< std::mutex > lock( m );
+        REQUIRE( cv.wait_for( lock, std::chrono::seconds( 5 ), [&]() { return entered >= count; } ) );
+    }
+};
+
+// Passes the YUYV frame through as is, once the gate lets it
+class gated_identity : public identity_processing_block
+{
+public:
+    gated_identity( gate & g ) : identity_processing_block( "Gated identity" ), _gate( g ) {}
+
+protected:
+    rs2::frame process_frame( const rs2::frame_source & source, const rs2::frame & f ) override
+    {
+        _gate.pass();
+        return identity_processing_block::process_frame( source, f );
+    }
+
+private:
+    gate & _gate;
+};
+
+// Records the frame numbers the user callback gets for each format, the threads it runs on, and how many lanes
+// are in it at once
+struct collector
+{
+    std::mutex m;
+    std::condition_variable cv;
+    std::map< rs2_format, frame_numbers > numbers;
+    std::vector< std::thread::id > threads;
+    std::atomic< int > inside{ 0 };
+    std::atomic< int > max_inside{ 0 };
+    int delay_ms = 0;
+
+    void on_frame( frame_holder f )
+    {
+        auto now_inside = ++inside;
+        if( now_inside > max_inside )
+            max_inside = now_inside;
+        if( delay_ms )
+            std::this_thread::sleep_for( std::chrono::milliseconds( delay_ms ) );
+        {
+            std::lock_guard< std::mutex > lock( m );
+            numbers[f->get_stream()->get_format()].push_back( f->get_frame_number() );
+            threads.push_back( std::this_thread::get_id() );
+        }
+        --inside;
+        cv.notify_all();
+    }
+
+    frame_numbers wait_for( rs2_format format, size_t count )
+    {
+        std::unique_lock< std::mutex > lock( m );
+        REQUIRE( cv.wait_for( lock, std::chrono::seconds( 5 ), [&]() { return numbers[format].size() >= count; } ) );
+        return numbers[format];
+    }
+};
+
+// A synthetic color sensor over a software sensor streaming YUYV, converted to RGB8 and passed through as YUYV by
+// two conversion blocks
+struct fan_out_sensor
+{
+    std::shared_ptr< software_device > dev = std::make_shared< software_device >();
+    std::shared_ptr< stream_profile_interface > raw_profile;
+    std::shared_ptr< synthetic_sensor > sensor;
+    collector frames;
+    gate yuyv_gate;
+    std::vector< uint8_t > pixels = std::vector< uint8_t >( width * height * 2 );
+
+    fan_out_sensor( int queue_size )
+    {
+        auto & raw = dev->add_software_sensor( "Raw" );
+        rs2_intrinsics intrinsics = { width, height, 0, 0, 1, 1, RS2_DISTORTION_NONE, { 0, 0, 0, 0, 0 } };
+        raw_profile = raw.add_video_stream( { RS2_STREAM_COLOR, 0, 1, width, height, 30, 2, RS2_FORMAT_YUYV, intrinsics } );
+
+        sensor = std::make_shared< synthetic_sensor >( "Color", std::dynamic_pointer_cast< sensor_base >( raw.shared_from_this() ),
+                                                       dev.get() );
+        sensor->register_processing_block( { { RS2_FORMAT_YUYV } }, { { RS2_FORMAT_RGB8, RS2_STREAM_COLOR } },
+                                           []() { return std::make_shared< yuy2_converter >( RS2_FORMAT_RGB8 ); } );
+        auto g = &yuyv_gate;
+        sensor->register_processing_block( { { RS2_FORMAT_YUYV } }, { { RS2_FORMAT_YUYV, RS2_STREAM_COLOR } },
+                                           [g]() { return std::make_shared< gated_identity >( *g ); } );
+        sensor->get_option( RS2_OPTION_CONVERSION_QUEUE_SIZE ).set( float( queue_size ) );
+
+        stream_profiles requests;
+        for( auto && p : sensor->get_stream_profiles() )
+            if( p->get_format() == RS2_FORMAT_RGB8 || p->get_format() == RS2_FORMAT_YUYV )
+                requests.push_back( p );
+        REQUIRE( requests.size() == 2 );
+        sensor->open( requests );
+
+        auto c = &frames;
+        sensor->start( { new internal_frame_callback< std::function< void( frame_interface * ) > >(
+                             [c]( frame_interface * f ) { c->on_frame( frame_holder( f ) ); } ),
+                         []( rs2_frame_callback * p ) { p->release(); } } );
+    }
+
+    ~fan_out_sensor()
+    {
+        yuyv_gate.set_open( true );
+        sensor->stop();
+        sensor->close();
+    }
+
+    void send( int frame_number )
+    {
+        rs2_stream_profile profile = { raw_profile.get() };
+        auto & raw = dynamic_cast< software_sensor & >( *sensor->get_raw_sensor() );
+        raw.on_video_frame( { pixels.data(), []( void * ) {}, width * 2, 2, 1000. + frame_number, RS2_TIMESTAMP_DOMAIN_SYSTEM_TIME,
+                              frame_number, &profile } );
+    }
+};
+
+TEST_CASE( "each conversion block delivers its frames in order", "[sensor][conversion-lanes]" )
+{
+    fan_out_sensor s( 32 );
+    frame_numbers all;
+    for( int i = 0; i < 20; ++i )
+    {
+        s.send( i );
+        all.push_back( i );
+    }
+    CHECK( s.frames.wait_for( RS2_FORMAT_RGB8, 20 ) == all );
+    CHECK( s.frames.wait_for( RS2_FORMAT_YUYV, 20 ) == all );
+}
+
+TEST_CASE( "a full conversion lane drops its oldest raw frame", "[sensor][conversion-lanes]" )
+{
+    fan_out_sensor s( 2 );
+    s.yuyv_gate.set_open( false );
+
+    // The YUYV lane is held converting frame 0, so of the frames queued behind it only the last two are kept,
+    // while the RGB8 lane is not held up by it
+    s.send( 0 );
+    s.yuyv_gate.wait_entered( 1 );
+    for( int i = 1; i <= 5; ++i )
+    {
+        s.send( i );
+        s.frames.wait_for( RS2_FORMAT_RGB8, i + 1 );
+    }
+    CHECK( s.frames.wait_for( RS2_FORMAT_RGB8, 6 ) == frame_numbers( { 0, 1, 2, 3, 4, 5 } ) );
+
+    s.yuyv_gate.set_open( true );
+    CHECK( s.frames.wait_for( RS2_FORMAT_YUYV, 3 ) == frame_numbers( { 0, 4, 5 } ) );
+    std::this_thread::sleep_for( std::chrono::milliseconds( 50 ) );
+    CHECK( s.frames.wait_for( RS2_FORMAT_YUYV, 3 ).size() == 3 );
+}
+
+TEST_CASE( "a conversion queue size of 0 converts on the capture thread", "[sensor][conversion-lanes]" )
+{
+    fan_out_sensor s( 0 );
+    for( int i = 0; i < 3; ++i )
+        s.send( i );
+
+    // Nothing is left to wait for: the conversions were done by the time send() returned
+    std::lock_guard< std::mutex > lock( s.frames.m );
+    CHECK( s.frames.numbers[RS2_FORMAT_RGB8] == frame_numbers( { 0, 1, 2 } ) );
+    CHECK( s.frames.numbers[RS2_FORMAT_YUYV] == frame_numbers( { 0, 1, 2 } ) );
+    for( auto && id : s.frames.threads )
+        CHECK( id == std::this_thread::get_id() );
+}
+
+TEST_CASE( "the user callback is never entered by two lanes at once", "[sensor][conversion-lanes]" )
+{
+    fan_out_sensor s( 32 );
+    s.frames.delay_ms = 2;
+    for( int i = 0; i < 20; ++i )
+        s.send( i );
+    s.frames.wait_for( RS2_FORMAT_RGB8, 20 );
+    s.frames.wait_for( RS2_FORMAT_YUYV, 20 );
+
+    CHECK( s.frames.max_inside == 1 );
+    // Both lanes did deliver, from threads other than the capture thread
+    std::lock_guard< std::mutex > lock( s.frames.m );
+    for( auto && id : s.frames.threads )
+        CHECK( id != std::this_thread::get_id() );
+}
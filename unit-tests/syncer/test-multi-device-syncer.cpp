@@ -0,0 +1,166 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2021 Intel Corporation. All Rights Reserved.
+
+// Unit Test Goals:
+// Sync the frames of two software devices whose clocks are a few ms apart in the global time domain: frames of the
+// devices are matched within the tolerance and the offset of the frames of the second device is reported, a frameset missing a
+// device is released once that device is past it, or once it waited for longer than the latency.
+
+#include "../catch.h"
+#include <librealsense2/rs.hpp>
+#include <librealsense2/hpp/rs_internal.hpp>
+
+#include <chrono>
+#include <thread>
+#include <vector>
+
+static const int width = 4;
+static const int height = 2;
+static const double period = 1000. / 30;
+
+struct camera
+{
+    rs2::software_device dev;
+    rs2::software_sensor sensor;
+    rs2::stream_profile profile;
+    double skew;
+    std::vector< uint16_t > pixels;
+
+    camera( const std::string & serial, int uid, double skew )
+        : sensor( dev.add_sensor( "Depth" ) ), skew( skew ), pixels( width * height )
+    {
+        dev.register_info( RS2_CAMERA_INFO_SERIAL_NUMBER, serial );
+        rs2_intrinsics intrinsics = { width, height, 0, 0, 1, 1, RS2_DISTORTION_NONE, { 0, 0, 0, 0, 0 } };
+        profile = sensor.add_video_stream( { RS2_STREAM_DEPTH, 0, uid, width, height, 30, 2, RS2_FORMAT_Z16, intrinsics } );
+        sensor.open( profile );
+    }
+
+    void send( int frame_number )
+    {
+        sensor.on_video_frame( { pixels.data(), []( void * ) {}, width * 2, 2, 1000 + frame_number * period + skew,
+                                 RS2_TIMESTAMP_DOMAIN_GLOBAL_TIME, frame_number, profile } );
+    }
+};
+
+// Frame numbers of the frames of each camera in the next frameset, -1 for a camera missing from it
+static std::vector< int > next_frameset( rs2::multi_device_syncer & sync, std::vector< camera * > const & cameras )
+{
+    rs2::frameset fs;
+    REQUIRE( sync.poll_for_frames( &fs ) );
+    std::vector< int > numbers( cameras.size(), -1 );
+    for( auto && f : fs )
+        for( size_t i = 0; i < cameras.size(); ++i )
+            if( f.get_profile().unique_id() == cameras[i]->profile.unique_id() )
+                numbers[i] = int( f.get_frame_number() );
+    return numbers;
+}
+
+static void check_no_frameset( rs2::multi_device_syncer & sync )
+{
+    rs2::frameset fs;
+    CHECK_FALSE( sync.poll_for_frames( &fs ) );
+}
+
+TEST_CASE( "Multi-device syncer matches frames of devices within the tolerance", "[software-device][syncer]" )
+{
+    camera a( "111", 101, 0 ), b( "222", 202, 3 );
+    rs2::multi_device_syncer sync( 0.f, 100.f, 100 );
+    a.sensor.start( sync );
+    b.sensor.start( sync );
+
+    // Until both devices are seen, each frame is a frameset of its own
+    a.send( 0 );
+    b.send( 0 );
+    CHECK( next_frameset( sync, { &a, &b } ) == std::vector< int >{ 0, -1 } );
+    CHECK( next_frameset( sync, { &a, &b } ) == std::vector< int >{ -1, 0 } );
+
+    for( int i = 1; i < 20; ++i )
+    {
+        a.send( i );
+        check_no_frameset( sync );
+        b.send( i );
+        CHECK( next_frameset( sync, { &a, &b } ) == std::vector< int >{ i, i } );
+    }
+    check_no_frameset( sync );
+
+    auto skews = sync.get_clock_skews();
+    REQUIRE( skews.size() == 2 );
+    CHECK( std::string( skews[0].serial_number ) == "111" );
+    CHECK( skews[0].frameset_offset == Approx( 0 ) );
+    CHECK( std::string( skews[1].serial_number ) == "222" );
+    CHECK( skews[1].frameset_offset == Approx( 3 ) );
+    CHECK( skews[1].max_frameset_offset == Approx( 3 ) );
+    CHECK( skews[1].framesets == 19 );
+    // Software devices have no clock of their own
+    CHECK_FALSE( skews[0].has_clock );
+    CHECK_FALSE( skews[1].has_clock );
+
+    a.sensor.stop();
+    b.sensor.stop();
+}
+
+TEST_CASE( "Multi-device syncer does not match frames farther apart than the tolerance", "[software-device][syncer]" )
+{
+    camera a( "111", 101, 0 ), b( "222", 202, 3 );
+    rs2::multi_device_syncer sync( 2.f, 100.f, 100 );
+    a.sensor.start( sync );
+    b.sensor.start( sync );
+
+    for( int i = 0; i < 5; ++i )
+    {
+        a.send( i );
+        b.send( i );
+    }
+    rs2::frameset fs;
+    while( sync.poll_for_frames( &fs ) )
+        CHECK( fs.size() == 1 );
+    auto skews = sync.get_clock_skews();
+    REQUIRE( skews.size() == 2 );
+    CHECK( skews[1].framesets == 0 );
+
+    a.sensor.stop();
+    b.sensor.stop();
+}
+
+TEST_CASE( "Multi-device syncer releases a frameset missing a device", "[software-device][syncer]" )
+{
+    camera a( "111", 101, 0 ), b( "222", 202, 3 );
+    rs2::multi_device_syncer sync( 0.f, 50.f, 100 );
+    a.sensor.start( sync );
+    b.sensor.start( sync );
+
+    a.send( 0 );
+    b.send( 0 );
+    next_frameset( sync, { &a, &b } );
+    next_frameset( sync, { &a, &b } );
+    a.send( 1 );
+    b.send( 1 );
+    CHECK( next_frameset( sync, { &a, &b } ) == std::vector< int >{ 1, 1 } );
+
+    SECTION( "once the device is past it" )
+    {
+        // Frame 2 of b is dropped; frame 2 of a waits until b sends frame 3
+        a.send( 2 );
+        a.send( 3 );
+        check_no_frameset( sync );
+        b.send( 3 );
+        CHECK( next_frameset( sync, { &a, &b } ) == std::vector< int >{ 2, -1 } );
+        CHECK( next_frameset( sync, { &a, &b } ) == std::vector< int >{ 3, 3 } );
+    }
+
+    SECTION( "once it waited longer than the latency" )
+    {
+        a.send( 2 );
+        check_no_frameset( sync );
+        std::this_thread::sleep_for( std::chrono::milliseconds( 80 ) );
+        a.send( 3 );
+        CHECK( next_frameset( sync, { &a, &b } ) == std::vector< int >{ 2, -1 } );
+        check_no_frameset( sync );
+        b.send( 3 );
+        CHECK( next_frameset( sync, { &a, &b } ) == std::vector< int >{ 3, 3 } );
+    }
+    check_no_frameset( sync );
+
+    a.sensor.stop();
+    b.sensor.stop();
+}
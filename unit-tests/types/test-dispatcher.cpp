@@ -0,0 +1,54 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2021 Intel Corporation. All Rights Reserved.
+
+//#cmake: static!
+
+// Unit Test Goals:
+// The thread-start hook of a dispatcher runs on the dispatcher thread, once and before any invoked item, and is
+// not subject to the overflow policy of the queue, which may drop invoked items.
+
+#include "../catch.h"
+
+#include <src/concurrency.h>
+
+#include <atomic>
+#include <thread>
+
+TEST_CASE( "dispatcher runs the thread-start hook before any item", "[types][dispatcher]" )
+{
+    std::atomic< int > starts( 0 );
+    std::atomic< int > items( 0 );
+    std::atomic< int > dropped( 0 );
+    std::atomic< bool > started_first( true );
+    std::thread::id hook_thread;
+
+    {
+        dispatcher d(
+            2,
+            [&]( dispatcher::action ) { ++dropped; },
+            [&]() {
+                hook_thread = std::this_thread::get_id();
+                ++starts;
+            } );
+        d.start();
+
+        // Flood the queue of two items so that some are dropped
+        std::thread::id item_thread;
+        for( int i = 0; i < 100; ++i )
+            d.invoke( [&]( dispatcher::cancellable_timer ) {
+                if( ! starts )
+                    started_first = false;
+                item_thread = std::this_thread::get_id();
+                ++items;
+            } );
+        REQUIRE( d.flush() );
+
+        CHECK( item_thread == hook_thread );
+        CHECK( item_thread != std::this_thread::get_id() );
+    }
+
+    CHECK( starts == 1 );
+    CHECK( started_first );
+    CHECK( items > 0 );
+    CHECK( items + dropped >= 100 );
+}
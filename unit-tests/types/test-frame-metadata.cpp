@@ -0,0 +1,86 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2021 Intel Corporation. All Rights Reserved.
+
+//#cmake: static!
+
+// Unit Test Goals:
+// Test the metadata attributes of a frame: parsers report attributes the frame does not carry without throwing,
+// every attribute is decoded once per frame, and moving the frame to its next use forgets what was decoded.
+
+#include "../catch.h"
+
+#include <src/archive.h>
+#include <src/metadata-parser.h>
+
+using namespace librealsense;
+
+// Reports the first metadata byte as the attribute, when it is non-zero, and counts the lookups
+class counting_parser : public md_attribute_parser_base
+{
+public:
+    mutable int calls = 0;
+
+    bool try_get( const frame & frm, rs2_metadata_type & value ) const override
+    {
+        ++calls;
+        if( ! frm.additional_data.metadata_blob[0] )
+            return false;
+        value = frm.additional_data.metadata_blob[0];
+        return true;
+    }
+};
+
+TEST_CASE( "frame metadata is decoded once", "[frame][metadata]" )
+{
+    auto parser = std::make_shared< counting_parser >();
+    auto parsers = std::make_shared< metadata_parser_map >();
+    parsers->insert( std::make_pair( RS2_FRAME_METADATA_GAIN_LEVEL, parser ) );
+
+    frame f;
+    f.metadata_parsers = parsers;
+    f.additional_data.metadata_blob[0] = 42;
+
+    CHECK( f.supports_frame_metadata( RS2_FRAME_METADATA_GAIN_LEVEL ) );
+    CHECK( f.get_frame_metadata( RS2_FRAME_METADATA_GAIN_LEVEL ) == 42 );
+    rs2_metadata_type value = 0;
+    CHECK( f.find_frame_metadata( RS2_FRAME_METADATA_GAIN_LEVEL, value ) );
+    CHECK( value == 42 );
+    CHECK( parser->calls == 1 );
+
+    // Attributes without a parser are missing, not errors
+    CHECK( ! f.find_frame_metadata( RS2_FRAME_METADATA_ACTUAL_EXPOSURE, value ) );
+    CHECK( ! f.supports_frame_metadata( RS2_FRAME_METADATA_ACTUAL_EXPOSURE ) );
+
+    // A frame that reuses the buffer decodes its own metadata
+    frame next;
+    next = std::move( f );
+    next.additional_data.metadata_blob[0] = 0;
+    CHECK( ! next.find_frame_metadata( RS2_FRAME_METADATA_GAIN_LEVEL, value ) );
+    CHECK( ! next.supports_frame_metadata( RS2_FRAME_METADATA_GAIN_LEVEL ) );
+    CHECK( parser->calls == 2 );
+
+    // Changes to the additional data after a read take effect once the frame is told
+    next.additional_data.metadata_blob[0] = 7;
+    next.reset_metadata_cache();
+    CHECK( next.get_frame_metadata( RS2_FRAME_METADATA_GAIN_LEVEL ) == 7 );
+    CHECK( parser->calls == 3 );
+}
+
+TEST_CASE( "metadata parsers do not throw for missing attributes", "[frame][metadata]" )
+{
+    frame f;
+    f.additional_data.metadata_size = 0;
+
+    // Too little metadata for a UVC header
+    auto uvc = make_uvc_header_parser( &platform::uvc_header::timestamp );
+    rs2_metadata_type value = 0;
+    CHECK_NOTHROW( uvc->try_get( f, value ) );
+    CHECK( ! uvc->try_get( f, value ) );
+    CHECK( ! uvc->supports( f ) );
+    CHECK_THROWS( uvc->get( f ) );
+
+    f.additional_data.backend_timestamp = 1234;
+    auto additional = make_additional_data_parser( &frame_additional_data::backend_timestamp );
+    CHECK( additional->try_get( f, value ) );
+    CHECK( value == 1234 );
+}
@@ -0,0 +1,186 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2021 Intel Corporation. All Rights Reserved.
+
+//#cmake: static!
+
+// Unit Test Goals:
+// Test the log-linear latency histogram behind the pipeline statistics: buckets tile the range with the stated
+// precision, percentiles fall within a bucket of the exact value and concurrent recording loses nothing. Frame
+// drops of a frame queue are counted per stream, and the end of a sensor callback is recorded for every frame
+// even when the callback lets go of it.
+
+#include "../catch.h"
+
+#include <src/pipeline-stats.h>
+#include <src/software-device.h>
+#include <src/sensor.h>
+#include <src/proc/color-formats-converter.h>
+#include <librealsense2/rs.hpp>
+#include <librealsense2/hpp/rs_internal.hpp>
+
+#include <thread>
+#include <vector>
+
+using namespace librealsense;
+
+TEST_CASE( "latency histogram buckets tile the range", "[types][pipeline-stats]" )
+{
+    // Below the sub-bucket count every value has a bucket of its own
+    for( uint64_t v = 0; v < latency_histogram::sub_buckets; ++v )
+    {
+        CHECK( latency_histogram::bucket_of( v ) == int( v ) );
+        CHECK( latency_histogram::bucket_width( int( v ) ) == 1 );
+    }
+
+    // Buckets follow each other without gaps, each within 1/16 of its lower bound
+    for( int b = 0; b + 1 < latency_histogram::bucket_count; ++b )
+    {
+        auto lower = latency_histogram::bucket_lower_bound( b );
+        auto width = latency_histogram::bucket_width( b );
+        CHECK( latency_histogram::bucket_lower_bound( b + 1 ) == lower + width );
+        CHECK( latency_histogram::bucket_of( lower ) == b );
+        CHECK( latency_histogram::bucket_of( lower + width - 1 ) == b );
+        if( b >= latency_histogram::sub_buckets )
+            CHECK( width * latency_histogram::sub_buckets <= lower );
+    }
+
+    // Latencies beyond the range all go to the last bucket
+    auto last = latency_histogram::bucket_count - 1;
+    CHECK( latency_histogram::bucket_of( uint64_t( 1 ) << 40 ) == last );
+    CHECK( latency_histogram::bucket_of( ~uint64_t( 0 ) ) == last );
+}
+
+TEST_CASE( "latency histogram percentiles", "[types][pipeline-stats]" )
+{
+    latency_histogram h;
+    rs2_latency_stats stats;
+    CHECK_FALSE( h.get_stats( stats ) );
+    CHECK( stats.count == 0 );
+
+    // 1 to 10000 usec
+    for( uint64_t v = 1; v <= 10000; ++v )
+        h.record( v );
+    REQUIRE( h.get_stats( stats ) );
+    CHECK( stats.count == 10000 );
+    CHECK( stats.min == Approx( 0.001 ) );
+    CHECK( stats.max == Approx( 10 ) );
+    CHECK( stats.mean == Approx( 5.0005 ) );
+    CHECK( stats.p50 == Approx( 5 ).epsilon( 1. / 16 ) );
+    CHECK( stats.p90 == Approx( 9 ).epsilon( 1. / 16 ) );
+    CHECK( stats.p99 == Approx( 9.9 ).epsilon( 1. / 16 ) );
+
+    // Percentiles never fall outside the values recorded
+    h.reset();
+    h.record( 1000 );
+    REQUIRE( h.get_stats( stats ) );
+    CHECK( stats.count == 1 );
+    CHECK( stats.p50 == Approx( 1 ) );
+    CHECK( stats.p99 == Approx( 1 ) );
+}
+
+TEST_CASE( "latency histogram records from several threads", "[types][pipeline-stats]" )
+{
+    latency_histogram h;
+    const int threads_count = 4;
+    const uint64_t per_thread = 20000;
+
+    std::vector< std::thread > threads;
+    for( int t = 0; t < threads_count; ++t )
+        threads.emplace_back( [&h, t, per_thread]() {
+            for( uint64_t v = 1; v <= per_thread; ++v )
+                h.record( v + t );
+        } );
+    for( auto && t : threads )
+        t.join();
+
+    rs2_latency_stats stats;
+    REQUIRE( h.get_stats( stats ) );
+    CHECK( stats.count == threads_count * per_thread );
+    CHECK( stats.min == Approx( 0.001 ) );
+    CHECK( stats.max == Approx( ( per_thread + threads_count - 1 ) / 1000. ) );
+    CHECK( stats.mean == Approx( ( per_thread + threads_count ) / 2000. ) );
+}
+
+TEST_CASE( "frame queue overflows are counted per stream", "[types][pipeline-stats]" )
+{
+    rs2_enable_pipeline_stats( 1, nullptr );
+    rs2_reset_pipeline_stats( nullptr );
+
+    rs2::software_device dev;
+    auto sensor = dev.add_sensor( "Depth" );
+    rs2_intrinsics intrinsics = { 4, 2, 0, 0, 1, 1, RS2_DISTORTION_NONE, { 0, 0, 0, 0, 0 } };
+    auto profile = sensor.add_video_stream( { RS2_STREAM_DEPTH, 0, 1, 4, 2, 30, 2, RS2_FORMAT_Z16, intrinsics } );
+    std::vector< uint16_t > pixels( 8 );
+
+    rs2::frame_queue queue( 2 );
+    sensor.open( profile );
+    sensor.start( queue );
+    for( int i = 0; i < 5; ++i )
+        sensor.on_video_frame( { pixels.data(), []( void * ) {}, 8, 2, 1000. + i, RS2_TIMESTAMP_DOMAIN_SYSTEM_TIME, i, profile } );
+
+    CHECK( rs2_get_pipeline_frame_drops( RS2_STREAM_DEPTH, 0, RS2_FRAME_DROP_REASON_QUEUE_OVERFLOW, nullptr ) == 3 );
+    CHECK( rs2_get_pipeline_frame_drops( RS2_STREAM_DEPTH, 0, RS2_FRAME_DROP_REASON_LATENCY_BUDGET, nullptr ) == 0 );
+    CHECK( rs2_get_pipeline_frame_drops( RS2_STREAM_DEPTH, 1, RS2_FRAME_DROP_REASON_QUEUE_OVERFLOW, nullptr ) == 0 );
+
+    rs2::frame f;
+    CHECK( queue.poll_for_frame( &f ) );
+    CHECK( f.get_frame_number() == 3 );
+    f = rs2::frame();
+
+    sensor.stop();
+    sensor.close();
+
+    rs2_reset_pipeline_stats( nullptr );
+    CHECK( rs2_get_pipeline_frame_drops( RS2_STREAM_DEPTH, 0, RS2_FRAME_DROP_REASON_QUEUE_OVERFLOW, nullptr ) == 0 );
+    rs2_enable_pipeline_stats( 0, nullptr );
+}
+
+TEST_CASE( "the end of the sensor callback is recorded for frames the callback lets go of", "[types][pipeline-stats]" )
+{
+    rs2_enable_pipeline_stats( 1, nullptr );
+    rs2_reset_pipeline_stats( nullptr );
+
+    // A synthetic sensor converting YUYV to RGB8 on the capture thread
+    const int width = 16, height = 2;
+    auto dev = std::make_shared< software_device >();
+    auto & raw = dev->add_software_sensor( "Raw" );
+    rs2_intrinsics intrinsics = { width, height, 0, 0, 1, 1, RS2_DISTORTION_NONE, { 0, 0, 0, 0, 0 } };
+    auto raw_profile = raw.add_video_stream( { RS2_STREAM_COLOR, 0, 1, width, height, 30, 2, RS2_FORMAT_YUYV, intrinsics } );
+    auto sensor = std::make_shared< synthetic_sensor >( "Color", std::dynamic_pointer_cast< sensor_base >( raw.shared_from_this() ),
+                                                        dev.get() );
+    sensor->register_processing_block( { { RS2_FORMAT_YUYV } }, { { RS2_FORMAT_RGB8, RS2_STREAM_COLOR } },
+                                       []() { return std::make_shared< yuy2_converter >( RS2_FORMAT_RGB8 ); } );
+    sensor->get_option( RS2_OPTION_CONVERSION_QUEUE_SIZE ).set( 0 );
+
+    stream_profiles requests;
+    for( auto && p : sensor->get_stream_profiles() )
+        if( p->get_format() == RS2_FORMAT_RGB8 )
+            requests.push_back( p );
+    REQUIRE( requests.size() == 1 );
+    sensor->open( requests );
+
+    // The callback releases every frame it gets before it returns
+    int delivered = 0;
+    sensor->start( { new internal_frame_callback< std::function< void( frame_interface * ) > >( [&]( frame_interface * f ) {
+                         f->release();
+                         ++delivered;
+                     } ),
+                     []( rs2_frame_callback * p ) { p->release(); } } );
+
+    std::vector< uint8_t > pixels( width * height * 2 );
+    rs2_stream_profile profile = { raw_profile.get() };
+    for( int i = 0; i < 10; ++i )
+        raw.on_video_frame( { pixels.data(), []( void * ) {}, width * 2, 2, 1000. + i, RS2_TIMESTAMP_DOMAIN_SYSTEM_TIME, i, &profile } );
+    CHECK( delivered == 10 );
+
+    rs2_latency_stats start, end;
+    REQUIRE( rs2_get_pipeline_stats( RS2_STREAM_COLOR, 0, RS2_LATENCY_STAGE_CALLBACK_START, &start, nullptr ) );
+    REQUIRE( rs2_get_pipeline_stats( RS2_STREAM_COLOR, 0, RS2_LATENCY_STAGE_CALLBACK_END, &end, nullptr ) );
+    CHECK( start.count == 10 );
+    CHECK( end.count == 10 );
+    CHECK( end.min >= start.min );
+
+    sensor->stop();
+    sensor->close();
+    rs2_enable_pipeline_stats( 0, nullptr );
+}
@@ -0,0 +1,131 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2021 Intel Corporation. All Rights Reserved.
+
+//#cmake: static!
+
+// Unit Test Goals:
+// Test the expiry policy of single_consumer_queue, on which the latency budget of frame queues is built: items
+// expire when they are queued and while they wait for the consumer, the policy sees every dequeue and is told when
+// the queue received each item.
+
+#include "../catch.h"
+
+#include <src/concurrency.h>
+
+#include <thread>
+#include <vector>
+
+// Items are their own age: an item expires once the "clock" passed it by more than the limit, or when more
+// items are queued than the depth
+class test_policy : public queue_expiry_policy< int >
+{
+public:
+    int now = 0;
+    int max_age = 10;
+    size_t depth = 100;
+    std::vector< int > expired;
+    std::vector< int > dequeued;
+
+    bool is_expired( int const & oldest, std::chrono::steady_clock::time_point, size_t queued ) override
+    {
+        return queued > depth || now - oldest > max_age;
+    }
+    void on_expired( int const & item ) override { expired.push_back( item ); }
+    void on_dequeued( int const & item ) override { dequeued.push_back( item ); }
+};
+
+TEST_CASE( "queue drops items by age", "[queue]" )
+{
+    single_consumer_queue< int > q( 100 );
+    auto policy = std::make_shared< test_policy >();
+    q.set_expiry_policy( policy );
+
+    for( int t = 0; t < 20; ++t )
+    {
+        policy->now = t;
+        q.enqueue( int( t ) );
+    }
+    // Enqueuing at 19 dropped whatever was older than 9
+    CHECK( q.size() == 11 );
+    CHECK( policy->expired.size() == 9 );
+    CHECK( policy->expired.front() == 0 );
+
+    // Items aging in the queue are dropped before the consumer gets them
+    policy->now = 25;
+    int item = -1;
+    REQUIRE( q.try_dequeue( &item ) );
+    CHECK( item == 15 );
+    REQUIRE( q.dequeue( &item, 10 ) );
+    CHECK( item == 16 );
+    CHECK( policy->dequeued == std::vector< int >{ 15, 16 } );
+
+    // Everything is stale: the consumer waits rather than getting an old item
+    policy->now = 100;
+    CHECK( ! q.dequeue( &item, 10 ) );
+    CHECK( q.size() == 0 );
+}
+
+TEST_CASE( "queue depth follows the policy", "[queue]" )
+{
+    single_consumer_queue< int > q( 100 );
+    auto policy = std::make_shared< test_policy >();
+    policy->depth = 3;
+    q.set_expiry_policy( policy );
+
+    for( int i = 0; i < 10; ++i )
+        q.enqueue( int( i ) );
+    CHECK( q.size() == 3 );
+    int item = -1;
+    REQUIRE( q.try_dequeue( &item ) );
+    CHECK( item == 7 );
+
+    // Without the policy the capacity decides again
+    q.set_expiry_policy( nullptr );
+    q.set_capacity( 5 );
+    for( int i = 10; i < 20; ++i )
+        q.enqueue( int( i ) );
+    CHECK( q.size() == 5 );
+    REQUIRE( q.try_dequeue( &item ) );
+    CHECK( item == 15 );
+}
+
+// Items expire by how long they waited in the queue, whatever they carry
+class wait_policy : public queue_expiry_policy< int >
+{
+public:
+    std::chrono::milliseconds max_wait{ 30 };
+
+    bool is_expired( int const &, std::chrono::steady_clock::time_point arrival, size_t ) override
+    {
+        return std::chrono::steady_clock::now() - arrival > max_wait;
+    }
+    void on_expired( int const & ) override {}
+    void on_dequeued( int const & ) override {}
+};
+
+TEST_CASE( "queue tells the policy when each item was received", "[queue]" )
+{
+    single_consumer_queue< int > q( 100 );
+    q.set_expiry_policy( std::make_shared< wait_policy >() );
+
+    // Items dropped by the capacity leave the arrival times of the others in place: 0 is dropped to make room
+    // for 2, then 1 expired, while 2 is fresh
+    q.set_capacity( 2 );
+    q.enqueue( 0 );
+    q.enqueue( 1 );
+    std::this_thread::sleep_for( std::chrono::milliseconds( 50 ) );
+    q.enqueue( 2 );
+    CHECK( q.size() == 1 );
+    q.enqueue( 3 );
+
+    int item = -1;
+    REQUIRE( q.try_dequeue( &item ) );
+    CHECK( item == 2 );
+    REQUIRE( q.try_dequeue( &item ) );
+    CHECK( item == 3 );
+    q.clear();
+    q.start();
+    q.enqueue( 5 );
+    REQUIRE( q.try_dequeue( &item ) );
+    CHECK( item == 5 );
+}
@@ -0,0 +1,161 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2021 Intel Corporation. All Rights Reserved.
+
+//#cmake: static!
+
+// Unit Test Goals:
+// Test the lock-free small_heap slot allocator behind the frame archives: no slot is ever handed
+// out twice, slots come back reset, and wait_until_empty() still waits for every borrowed slot.
+
+#include <easylogging++.h>
+#ifdef BUILD_SHARED_LIBS
+INITIALIZE_EASYLOGGINGPP
+#endif
+
+#include "../catch.h"
+
+#include <src/types.h>
+
+#include <thread>
+#include <vector>
+
+using namespace librealsense;
+
+struct slot
+{
+    std::atomic< int > owner{ -1 };
+    std::vector< int > payload;
+
+    slot() = default;
+    slot & operator=( slot && other )
+    {
+        owner = other.owner.load();
+        payload = std::move( other.payload );
+        return *this;
+    }
+};
+
+TEST_CASE( "small_heap allocates every slot exactly once", "[types]" )
+{
+    // Capacities below, at and across the 64-slot bitmap words
+    for( int capacity : { 1, 10, 64, 65, 128, 200 } )
+    {
+        CAPTURE( capacity );
+        small_heap< slot, RS2_USER_QUEUE_SIZE > heap( capacity );
+        CHECK( heap.get_capacity() == capacity );
+
+        std::vector< slot * > slots;
+        while( auto s = heap.allocate() )
+            slots.push_back( s );
+        REQUIRE( slots.size() == size_t( capacity ) );
+        CHECK( heap.get_size() == capacity );
+        std::sort( slots.begin(), slots.end() );
+        CHECK( std::unique( slots.begin(), slots.end() ) == slots.end() );
+
+        slots.front()->payload.resize( 10 );
+        heap.deallocate( slots.front() );
+        auto again = heap.allocate();
+        REQUIRE( again == slots.front() );
+        CHECK( again->payload.empty() );  // reset on return
+
+        for( auto s : slots )
+            heap.deallocate( s );
+        CHECK( heap.is_empty() );
+    }
+}
+
+TEST_CASE( "small_heap rejects foreign items and stops allocating", "[types]" )
+{
+    small_heap< slot, 4 > heap;
+    slot other;
+    CHECK_THROWS_AS( heap.deallocate( &other ), invalid_value_exception );
+
+    auto s = heap.allocate();
+    REQUIRE( s );
+    heap.stop_allocation();
+    CHECK( heap.allocate() == nullptr );
+    CHECK( heap.get_size() == 1 );
+    heap.deallocate( s );
+    CHECK( heap.is_empty() );
+}
+
+TEST_CASE( "small_heap under many threads", "[types]" )
+{
+    const int capacity = RS2_USER_QUEUE_SIZE;
+    const int threads = 16;
+    const int iterations = 20000;
+    small_heap< slot, RS2_USER_QUEUE_SIZE > heap;
+
+    std::atomic< int > double_allocations{ 0 };
+    std::atomic< int > allocated{ 0 };
+    std::vector< std::thread > workers;
+    for( int t = 0; t < threads; ++t )
+    {
+        workers.emplace_back( [&, t]() {
+            std::vector< slot * > held;
+            for( int i = 0; i < iterations; ++i )
+            {
+                // Hold a varying number of slots so the pool keeps running dry and refilling
+                if( held.size() < size_t( 1 + ( i + t ) % 12 ) )
+                {
+                    if( auto s = heap.allocate() )
+                    {
+                        int expected = -1;
+                        if( ! s->owner.compare_exchange_strong( expected, t ) )
+                            ++double_allocations;
+                        s->payload.push_back( t );
+                        held.push_back( s );
+                        ++allocated;
+                    }
+                }
+                else
+                {
+                    auto s = held.back();
+                    held.pop_back();
+                    if( s->owner.exchange( -1 ) != t || s->payload.size() != 1 )
+                        ++double_allocations;
+                    heap.deallocate( s );
+                }
+            }
+            for( auto s : held )
+            {
+                s->owner = -1;
+                heap.deallocate( s );
+            }
+        } );
+    }
+    for( auto & w : workers )
+        w.join();
+
+    CHECK( double_allocations == 0 );
+    CHECK( allocated > 0 );
+    CHECK( heap.is_empty() );
+
+    // After a full drain every slot must be available again
+    int count = 0;
+    while( heap.allocate() )
+        ++count;
+    CHECK( count == capacity );
+}
+
+TEST_CASE( "small_heap wait_until_empty waits for borrowed slots", "[types]" )
+{
+    small_heap< slot, 8 > heap;
+    std::vector< slot * > slots;
+    for( int i = 0; i < 8; ++i )
+        slots.push_back( heap.allocate() );
+
+    std::atomic< bool > released{ false };
+    std::thread releaser( [&]() {
+        std::this_thread::sleep_for( std::chrono::milliseconds( 50 ) );
+        released = true;
+        for( auto s : slots )
+            heap.deallocate( s );
+    } );
+
+    heap.stop_allocation();
+    heap.wait_until_empty();
+    CHECK( released );
+    CHECK( heap.is_empty() );
+    releaser.join();
+}
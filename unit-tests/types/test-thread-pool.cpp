@@ -0,0 +1,247 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2021 Intel Corporation. All Rights Reserved.
+
+//#cmake: static!
+
+// Unit Test Goals:
+// Test the processing thread pool: every item of a parallel_for runs exactly once whatever the pool
+// size, errors reach the caller, nested and concurrent calls complete, and the pool can be resized
+// while other threads keep submitting work. Also test the placement and naming of library threads.
+
+#include <easylogging++.h>
+#ifdef BUILD_SHARED_LIBS
+INITIALIZE_EASYLOGGINGPP
+#endif
+
+#include "../catch.h"
+
+#include <src/thread-pool.h>
+
+#include <atomic>
+#include <cstring>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+#include <pthread.h>
+#endif
+
+using namespace librealsense;
+
+static void check_coverage( int begin, int end, int grain )
+{
+    CAPTURE( begin, end, grain );
+    std::vector< std::atomic< int > > hits( std::max( end, 1 ) );
+    for( auto & h : hits )
+        h = 0;
+    std::atomic< int > bad_chunks{ 0 };
+    thread_pool::get_instance().parallel_for( "test", begin, end, grain, [&]( int b, int e ) {
+        if( b >= e || b < begin || e > end )
+            ++bad_chunks;
+        for( int i = b; i < e; ++i )
+            ++hits[i];
+    } );
+    CHECK( bad_chunks == 0 );
+    for( int i = 0; i < end; ++i )
+        REQUIRE( hits[i] == ( i >= begin ? 1 : 0 ) );
+}
+
+TEST_CASE( "parallel_for runs every item once", "[thread-pool]" )
+{
+    auto & pool = thread_pool::get_instance();
+    for( int threads : { 0, 1, 3, 8, -1 } )
+    {
+        CAPTURE( threads );
+        pool.set_threads( threads );
+        CHECK( pool.get_threads() >= 0 );
+
+        check_coverage( 0, 0, 1 );
+        check_coverage( 0, 1, 16 );
+        check_coverage( 0, 480, 16 );
+        check_coverage( 5, 1000, 1 );
+        check_coverage( 0, 100000, 7 );
+    }
+    pool.set_threads( -1 );
+}
+
+TEST_CASE( "parallel_for rethrows the error of a chunk", "[thread-pool]" )
+{
+    auto & pool = thread_pool::get_instance();
+    pool.set_threads( 4 );
+    std::atomic< int > done{ 0 };
+    CHECK_THROWS_AS( pool.parallel_for( "test", 0, 1000, 1, [&]( int b, int e ) {
+                         if( b <= 500 && 500 < e )
+                             throw std::runtime_error( "chunk failed" );
+                         done += e - b;
+                     } ),
+                     std::runtime_error );
+    // The other chunks still ran to completion before the call returned
+    CHECK( done > 0 );
+    CHECK( done < 1000 );
+
+    // And the pool is still usable
+    check_coverage( 0, 1000, 1 );
+    CHECK_THROWS_AS( pool.set_threads( -2 ), invalid_value_exception );
+    pool.set_threads( -1 );
+}
+
+TEST_CASE( "parallel_for after the workers are released", "[thread-pool]" )
+{
+    auto & pool = thread_pool::get_instance();
+    pool.set_threads( 4 );
+    check_coverage( 0, 1000, 1 );
+    pool.release_workers();
+    pool.release_workers();
+    check_coverage( 0, 1000, 1 );
+    CHECK( pool.get_threads() == 4 );
+    pool.set_threads( -1 );
+}
+
+TEST_CASE( "nested and concurrent parallel_for", "[thread-pool]" )
+{
+    auto & pool = thread_pool::get_instance();
+    pool.set_threads( 4 );
+
+    // Nested calls run inline on the thread that runs the outer chunk
+    std::atomic< int > total{ 0 };
+    pool.parallel_for( "outer", 0, 64, 1, [&]( int b, int e ) {
+        for( int i = b; i < e; ++i )
+        {
+            auto outer = std::this_thread::get_id();
+            pool.parallel_for( "inner", 0, 100, 1, [&]( int ib, int ie ) {
+                if( std::this_thread::get_id() == outer )
+                    total += ie - ib;
+            } );
+        }
+    } );
+    CHECK( total == 64 * 100 );
+
+    // Several threads submitting at once, while another one keeps resizing the pool
+    std::atomic< bool > stop{ false };
+    std::atomic< int > errors{ 0 };
+    std::vector< std::thread > submitters;
+    for( int t = 0; t < 4; ++t )
+    {
+        submitters.emplace_back( [&]() {
+            for( int k = 0; k < 200; ++k )
+            {
+                std::atomic< int > sum{ 0 };
+                pool.parallel_for( "concurrent", 0, 5000, 10, [&]( int b, int e ) { sum += e - b; } );
+                if( sum != 5000 )
+                    ++errors;
+            }
+        } );
+    }
+    std::thread resizer( [&]() {
+        int threads = 0;
+        while( ! stop )
+        {
+            pool.set_threads( threads );
+            threads = ( threads + 1 ) % 5;
+            std::this_thread::sleep_for( std::chrono::milliseconds( 1 ) );
+        }
+    } );
+    for( auto & t : submitters )
+        t.join();
+    stop = true;
+    resizer.join();
+    CHECK( errors == 0 );
+    pool.set_threads( -1 );
+}
+
+TEST_CASE( "thread pool task statistics", "[thread-pool]" )
+{
+    auto & pool = thread_pool::get_instance();
+    pool.set_threads( 2 );
+    pipeline_stats::get_instance().enable( true );
+    pool.reset_task_stats();
+
+    for( int k = 0; k < 10; ++k )
+        pool.parallel_for( "stats-test", 0, 1000, 10, []( int, int ) {} );
+
+    bool found = false;
+    for( auto & s : pool.get_task_stats() )
+    {
+        if( strcmp( s.name, "stats-test" ) )
+            continue;
+        found = true;
+        CHECK( s.duration.count == 10 );
+        CHECK( s.chunks >= 10 );
+        CHECK( s.stolen <= s.chunks );
+    }
+    CHECK( found );
+
+    pool.reset_task_stats();
+    for( auto & s : pool.get_task_stats() )
+        CHECK( strcmp( s.name, "stats-test" ) != 0 );
+
+    pipeline_stats::get_instance().enable( false );
+    pool.set_threads( -1 );
+}
+
+TEST_CASE( "thread pool affinity", "[thread-pool]" )
+{
+    auto & pool = thread_pool::get_instance();
+    CHECK_THROWS_AS( pool.set_affinity( { -1 } ), invalid_value_exception );
+
+    pool.set_affinity( { 0 } );
+    CHECK( pool.get_affinity() == std::vector< int >{ 0 } );
+    check_coverage( 0, 1000, 1 );
+
+    pool.set_affinity( {} );
+    CHECK( pool.get_affinity().empty() );
+}
+
+TEST_CASE( "thread placement", "[thread-pool]" )
+{
+    auto & registry = thread_placement_registry::get_instance();
+
+    thread_placement bad;
+    bad.cpus = { -1 };
+    CHECK_THROWS_AS( registry.set( RS2_THREAD_ROLE_CAPTURE, bad ), invalid_value_exception );
+    bad.cpus.clear();
+    bad.realtime_priority = 100;
+    CHECK_THROWS_AS( registry.set( RS2_THREAD_ROLE_CAPTURE, bad ), invalid_value_exception );
+
+    // A device placement overrides the one of its role, for that device only
+    thread_placement all, one;
+    all.cpus = { 0 };
+    one.cpus = { 0 };
+    one.numa_node = 0;
+    registry.set( RS2_THREAD_ROLE_CAPTURE, all );
+    registry.set( "device-a", RS2_THREAD_ROLE_CAPTURE, one );
+    CHECK( registry.get( RS2_THREAD_ROLE_CAPTURE ).numa_node == -1 );
+    CHECK( registry.get( RS2_THREAD_ROLE_CAPTURE, "device-b" ).numa_node == -1 );
+    CHECK( registry.get( RS2_THREAD_ROLE_CAPTURE, "device-a" ).numa_node == 0 );
+    CHECK( registry.get( RS2_THREAD_ROLE_DISPATCH, "device-a" ).empty() );
+
+    // An empty placement removes the override
+    registry.set( "device-a", RS2_THREAD_ROLE_CAPTURE, thread_placement() );
+    CHECK( registry.get( RS2_THREAD_ROLE_CAPTURE, "device-a" ).cpus == std::vector< int >{ 0 } );
+    registry.set( RS2_THREAD_ROLE_CAPTURE, thread_placement() );
+    CHECK( registry.get( RS2_THREAD_ROLE_CAPTURE ).empty() );
+
+#ifdef __linux__
+    // Threads carry the name of their role, and the pool workers are named when they start
+    std::thread( [&]() {
+        registry.apply( RS2_THREAD_ROLE_CAPTURE, "rs-uvc-0-with-a-long-name" );
+        char name[16] = {};
+        pthread_getname_np( pthread_self(), name, sizeof( name ) );
+        CHECK( std::string( name ) == "rs-uvc-0-with-a" );
+    } ).join();
+
+    auto & pool = thread_pool::get_instance();
+    pool.set_threads( 2 );
+    std::atomic< int > named{ 0 };
+    pool.parallel_for( "names", 0, 10000, 1, [&]( int, int ) {
+        char name[16] = {};
+        pthread_getname_np( pthread_self(), name, sizeof( name ) );
+        if( std::string( name ).compare( 0, 8, "rs-proc-" ) == 0 )
+            ++named;
+        std::this_thread::sleep_for( std::chrono::microseconds( 100 ) );
+    } );
+    CHECK( named > 0 );
+    pool.set_threads( -1 );
+#endif
+}
@@ -0,0 +1,121 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2021 Intel Corporation. All Rights Reserved.
+
+//#cmake: static!
+
+// Unit Test Goals:
+// Test the per-thread ring of the frame tracer: a snapshot returns the records in the order they were pushed,
+// keeps only the newest once the ring wrapped, and never returns a record the producer is still overwriting.
+
+#include <easylogging++.h>
+#ifdef BUILD_SHARED_LIBS
+INITIALIZE_EASYLOGGINGPP
+#endif
+
+#include "../catch.h"
+
+#include <src/frame-trace.h>
+
+#include <thread>
+#include <vector>
+
+using namespace librealsense;
+
+// All the fields of record i are i, so a record mixing two pushes shows
+static trace_record make_record( uint64_t i )
+{
+    trace_record r;
+    r.time_ns = i;
+    r.frame_number = i;
+    r.frame_timestamp = double( i );
+    r.value = double( i );
+    r.event = uint16_t( i );
+    r.stream = uint8_t( i );
+    r.stream_index = uint8_t( i );
+    r.reserved = uint32_t( i );
+    return r;
+}
+
+static bool is_whole( const trace_record & r )
+{
+    auto i = r.frame_number;
+    return r.time_ns == i && r.frame_timestamp == double( i ) && r.value == double( i ) && r.event == uint16_t( i )
+        && r.stream == uint8_t( i ) && r.stream_index == uint8_t( i ) && r.reserved == uint32_t( i );
+}
+
+static void check_consecutive( std::vector< trace_record > const & records, uint64_t first, uint64_t last )
+{
+    REQUIRE( records.size() == last - first + 1 );
+    for( size_t i = 0; i < records.size(); ++i )
+    {
+        CAPTURE( i );
+        REQUIRE( records[i].frame_number == first + i );
+        REQUIRE( is_whole( records[i] ) );
+    }
+}
+
+TEST_CASE( "trace_ring snapshot before the ring wraps", "[types]" )
+{
+    auto ring = std::make_shared< trace_ring >( 0 );
+    std::vector< trace_record > records;
+    ring->snapshot( records );
+    CHECK( records.empty() );
+
+    for( uint64_t i = 0; i < 10; ++i )
+        ring->push( make_record( i ) );
+    ring->snapshot( records );
+    check_consecutive( records, 0, 9 );
+
+    // Snapshots are appended to what the caller already has
+    ring->snapshot( records );
+    CHECK( records.size() == 20 );
+}
+
+TEST_CASE( "trace_ring snapshot after the ring wraps", "[types]" )
+{
+    auto ring = std::make_shared< trace_ring >( 0 );
+    std::vector< trace_record > records;
+
+    // The oldest record is left out: its slot is the next one the producer writes
+    for( uint64_t i = 0; i < trace_ring::capacity; ++i )
+        ring->push( make_record( i ) );
+    ring->snapshot( records );
+    check_consecutive( records, 1, trace_ring::capacity - 1 );
+
+    for( uint64_t i = trace_ring::capacity; i < 2 * trace_ring::capacity + 5; ++i )
+        ring->push( make_record( i ) );
+    records.clear();
+    ring->snapshot( records );
+    check_consecutive( records, trace_ring::capacity + 6, 2 * trace_ring::capacity + 4 );
+}
+
+TEST_CASE( "trace_ring snapshot while the producer writes", "[types]" )
+{
+    auto ring = std::make_shared< trace_ring >( 0 );
+    std::atomic< bool > done( false );
+    std::thread producer( [&]() {
+        for( uint64_t i = 0; ! done; ++i )
+            ring->push( make_record( i ) );
+    } );
+
+    std::vector< trace_record > records;
+    for( int snapshot = 0; snapshot < 2000; ++snapshot )
+    {
+        records.clear();
+        ring->snapshot( records );
+        for( size_t i = 0; i < records.size(); ++i )
+        {
+            if( ! is_whole( records[i] ) || ( i && records[i].frame_number != records[i - 1].frame_number + 1 ) )
+            {
+                done = true;
+                producer.join();
+                CAPTURE( snapshot );
+                CAPTURE( i );
+                CAPTURE( records[i].frame_number );
+                FAIL( "torn or out of order record" );
+            }
+        }
+    }
+    done = true;
+    producer.join();
+}
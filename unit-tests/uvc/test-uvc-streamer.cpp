@@ -0,0 +1,362 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2021 Intel Corporation. All Rights Reserved.
+
+//#cmake: static!
+
+// Unit Test Goals:
+// Replay UVC payloads through the rsusb streamer over a fake endpoint: frames reach the user callback in the very
+// buffers of the USB requests, a request is submitted again as soon as the callback returns, whatever the user keeps,
+// stop never waits for the user, and the number of requests kept on the endpoint grows when it runs dry and comes
+// back down after.
+
+#include <easylogging++.h>
+#ifdef BUILD_SHARED_LIBS
+INITIALIZE_EASYLOGGINGPP
+#endif
+
+#include "../catch.h"
+
+#if defined(RS2_USE_LIBUVC_BACKEND) || defined(RS2_USE_ANDROID_BACKEND) || defined(RS2_USE_WINUSB_UVC_BACKEND)
+
+#include <src/uvc/uvc-streamer.h>
+#include <src/usb/usb-device.h>
+#include <src/backend.h>
+
+#include <algorithm>
+#include <deque>
+
+using namespace librealsense::platform;
+
+static const uint32_t width = 64;
+static const uint32_t height = 8;
+static const uint32_t fps = 30;
+static const uint8_t header_length = 12;
+
+class replay_endpoint : public usb_endpoint
+{
+public:
+    uint8_t get_address() const override { return 0x82; }
+    endpoint_type get_type() const override { return RS2_USB_ENDPOINT_BULK; }
+    endpoint_direction get_direction() const override { return RS2_USB_ENDPOINT_DIRECTION_READ; }
+    uint8_t get_interface_number() const override { return 1; }
+};
+
+class replay_interface : public usb_interface
+{
+    rs_usb_endpoint _endpoint = std::make_shared< replay_endpoint >();
+
+public:
+    uint8_t get_number() const override { return 1; }
+    uint8_t get_class() const override { return 0x0e; }
+    uint8_t get_subclass() const override { return 0x02; }
+    const std::vector< rs_usb_endpoint > get_endpoints() const override { return { _endpoint }; }
+    const rs_usb_endpoint first_endpoint( const endpoint_direction, const endpoint_type ) const override { return _endpoint; }
+};
+
+class replay_device : public usb_device_mock
+{
+public:
+    const rs_usb_interface get_interface( uint8_t ) const override { return std::make_shared< replay_interface >(); }
+};
+
+class replay_request : public usb_request_base
+{
+    int _actual_length = 0;
+
+public:
+    explicit replay_request( rs_usb_endpoint endpoint ) { _endpoint = endpoint; }
+
+    int get_actual_length() const override { return _actual_length; }
+    void * get_native_request() const override { return nullptr; }
+
+    // The device writes a payload into the buffer of the request
+    void fill( const std::vector< uint8_t > & payload )
+    {
+        std::copy( payload.begin(), payload.end(), _buffer.begin() );
+        _actual_length = int( payload.size() );
+    }
+
+protected:
+    void set_native_buffer_length( int ) override {}
+    int get_native_buffer_length() override { return int( _buffer.size() ); }
+    void set_native_buffer( uint8_t * ) override {}
+    uint8_t * get_native_buffer() const override { return nullptr; }
+};
+
+// Keeps the requests submitted to the endpoint, in order, and completes them with the payloads it is given
+class replay_messenger : public usb_messenger
+{
+    std::mutex _mutex;
+    std::condition_variable _submitted_cv;
+    std::deque< rs_usb_request > _submitted;
+
+public:
+    usb_status control_transfer( int, int, int, int, uint8_t *, uint32_t, uint32_t & transferred, uint32_t ) override
+    {
+        transferred = 0;
+        return RS2_USB_STATUS_SUCCESS;
+    }
+    usb_status bulk_transfer( const rs_usb_endpoint &, uint8_t *, uint32_t, uint32_t & transferred, uint32_t ) override
+    {
+        transferred = 0;
+        return RS2_USB_STATUS_SUCCESS;
+    }
+    usb_status reset_endpoint( const rs_usb_endpoint &, uint32_t ) override { return RS2_USB_STATUS_SUCCESS; }
+    rs_usb_request create_request( rs_usb_endpoint endpoint ) override { return std::make_shared< replay_request >( endpoint ); }
+
+    usb_status submit_request( const rs_usb_request & request ) override
+    {
+        std::lock_guard< std::mutex > lock( _mutex );
+        REQUIRE( std::find( _submitted.begin(), _submitted.end(), request ) == _submitted.end() );
+        _submitted.push_back( request );
+        _submitted_cv.notify_all();
+        return RS2_USB_STATUS_SUCCESS;
+    }
+
+    usb_status cancel_request( const rs_usb_request & request ) override
+    {
+        std::lock_guard< std::mutex > lock( _mutex );
+        _submitted.erase( std::remove( _submitted.begin(), _submitted.end(), request ), _submitted.end() );
+        return RS2_USB_STATUS_SUCCESS;
+    }
+
+    size_t submitted()
+    {
+        std::lock_guard< std::mutex > lock( _mutex );
+        return _submitted.size();
+    }
+
+    bool wait_for_submitted( size_t count )
+    {
+        std::unique_lock< std::mutex > lock( _mutex );
+        return _submitted_cv.wait_for( lock, std::chrono::seconds( 5 ), [&]() { return _submitted.size() == count; } );
+    }
+
+    // Completes the oldest requests submitted with the payloads, all taken off the endpoint before any is returned
+    // to the streamer. Returns the buffers the payloads went to
+    std::vector< const uint8_t * > complete( const std::vector< std::vector< uint8_t > > & payloads )
+    {
+        std::vector< rs_usb_request > requests;
+        {
+            std::unique_lock< std::mutex > lock( _mutex );
+            REQUIRE( _submitted_cv.wait_for( lock, std::chrono::seconds( 5 ),
+                                             [&]() { return _submitted.size() >= payloads.size(); } ) );
+            for( auto & payload : payloads )
+            {
+                auto request = _submitted.front();
+                _submitted.pop_front();
+                std::static_pointer_cast< replay_request >( request )->fill( payload );
+                requests.push_back( request );
+            }
+        }
+        std::vector< const uint8_t * > buffers;
+        for( auto & request : requests )
+        {
+            buffers.push_back( request->get_buffer().data() );
+            request->get_callback()->callback( request );
+        }
+        return buffers;
+    }
+};
+
+// A bulk payload as the camera sends it: a header with presentation time and clock, then a frame of pixels
+static std::vector< uint8_t > make_payload( uint8_t index, uint8_t header_info = 0x8e )
+{
+    std::vector< uint8_t > payload( header_length + width * height * 2, index );
+    payload[0] = header_length;
+    payload[1] = header_info;
+    for( uint8_t i = 2; i < header_length; ++i )
+        payload[i] = i;
+    return payload;
+}
+
+// Collects the frames streamed, holding on to them or releasing them at once
+struct frame_sink
+{
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::vector< frame_object > frames;
+    std::vector< std::vector< uint8_t > > pixels;
+    std::vector< std::function< void() > > held;
+    bool hold = false;
+    bool block = false;
+
+    void on_frame( frame_object f, std::function< void() > continuation )
+    {
+        std::unique_lock< std::mutex > lock( mutex );
+        frames.push_back( f );
+        auto p = static_cast< const uint8_t * >( f.pixels );
+        pixels.emplace_back( p, p + f.frame_size );
+        if( hold )
+            held.push_back( continuation );
+        cv.notify_all();
+        cv.wait( lock, [&]() { return !block; } );
+    }
+
+    bool wait_for_frames( size_t count )
+    {
+        std::unique_lock< std::mutex > lock( mutex );
+        return cv.wait_for( lock, std::chrono::seconds( 5 ), [&]() { return frames.size() >= count; } );
+    }
+
+    void release_all()
+    {
+        std::vector< std::function< void() > > continuations;
+        {
+            std::lock_guard< std::mutex > lock( mutex );
+            continuations.swap( held );
+        }
+        for( auto & continuation : continuations )
+            continuation();
+    }
+
+    void unblock()
+    {
+        std::lock_guard< std::mutex > lock( mutex );
+        block = false;
+        cv.notify_all();
+    }
+};
+
+static std::shared_ptr< uvc_streamer > make_streamer( std::shared_ptr< replay_messenger > messenger, frame_sink & sink )
+{
+    auto control = std::make_shared< uvc_stream_ctrl_t >();
+    memset( control.get(), 0, sizeof( uvc_stream_ctrl_t ) );
+    control->bInterfaceNumber = 1;
+    control->dwMaxVideoFrameSize = width * height * 2;
+
+    stream_profile profile = { width, height, fps, 0x59555956 };  // YUYV
+    uvc_streamer_context context = { profile,
+                                     [&sink]( stream_profile, frame_object f, std::function< void() > continuation ) {
+                                         sink.on_frame( f, continuation );
+                                     },
+                                     control, std::make_shared< replay_device >(), messenger, 2 };
+    return std::make_shared< uvc_streamer >( context );
+}
+
+TEST_CASE( "frames are the buffers of the requests", "[uvc-streamer]" )
+{
+    auto messenger = std::make_shared< replay_messenger >();
+    frame_sink sink;
+    auto streamer = make_streamer( messenger, sink );
+    streamer->start();
+    REQUIRE( messenger->wait_for_submitted( 2 ) );
+
+    std::vector< const uint8_t * > buffers;
+    for( uint8_t i = 0; i < 6; ++i )
+    {
+        auto b = messenger->complete( { make_payload( i ) } );
+        buffers.push_back( b[0] );
+        REQUIRE( sink.wait_for_frames( i + 1 ) );
+    }
+    REQUIRE( messenger->wait_for_submitted( 2 ) );
+
+    for( uint8_t i = 0; i < 6; ++i )
+    {
+        CHECK( sink.frames[i].metadata == buffers[i] );
+        CHECK( sink.frames[i].pixels == buffers[i] + header_length );
+        CHECK( sink.frames[i].metadata_size == header_length );
+        CHECK( sink.frames[i].frame_size == width * height * 2 );
+        CHECK( sink.pixels[i] == std::vector< uint8_t >( width * height * 2, i ) );
+    }
+    // Released as soon as they were handled, three requests went round: two on the endpoint while the third was
+    // with the user
+    CHECK( streamer->get_requests_count() == 3 );
+    streamer->stop();
+    CHECK( messenger->submitted() == 0 );
+}
+
+TEST_CASE( "requests go back to the endpoint once the callback returns", "[uvc-streamer]" )
+{
+    auto messenger = std::make_shared< replay_messenger >();
+    frame_sink sink;
+    sink.hold = true;
+    auto streamer = make_streamer( messenger, sink );
+    streamer->start();
+
+    for( uint8_t i = 0; i < 3; ++i )
+    {
+        messenger->complete( { make_payload( i ) } );
+        REQUIRE( sink.wait_for_frames( i + 1 ) );
+    }
+    // The user keeps the continuations, but the requests are back: two on the endpoint and a spare
+    REQUIRE( messenger->wait_for_submitted( 2 ) );
+    CHECK( streamer->get_requests_count() == 3 );
+    CHECK( sink.pixels[0] == std::vector< uint8_t >( width * height * 2, 0 ) );
+
+    // Releasing the frames late gives nothing back twice
+    sink.release_all();
+    CHECK( messenger->submitted() == 2 );
+    CHECK( streamer->get_requests_count() == 3 );
+
+    // Payloads that are no frame go straight back to the endpoint
+    messenger->complete( { make_payload( 9, 0x8e | 0x40 ) } );
+    REQUIRE( messenger->wait_for_submitted( 2 ) );
+    std::vector< uint8_t > truncated( header_length + 10, 0 );
+    truncated[0] = header_length;
+    messenger->complete( { truncated } );
+    REQUIRE( messenger->wait_for_submitted( 2 ) );
+    CHECK( sink.frames.size() == 3 );
+    CHECK( streamer->get_requests_count() == 3 );
+
+    streamer->stop();
+    CHECK( messenger->submitted() == 0 );
+}
+
+TEST_CASE( "requests follow how often the endpoint runs dry", "[uvc-streamer]" )
+{
+    auto messenger = std::make_shared< replay_messenger >();
+    frame_sink sink;
+    auto streamer = make_streamer( messenger, sink );
+    streamer->start();
+    REQUIRE( messenger->wait_for_submitted( 2 ) );
+    CHECK( streamer->get_target_in_flight() == 2 );
+
+    // While the user is busy with a frame, the endpoint fills every request it has
+    sink.block = true;
+    messenger->complete( { make_payload( 0 ) } );
+    REQUIRE( sink.wait_for_frames( 1 ) );
+    messenger->complete( { make_payload( 1 ), make_payload( 2 ) } );
+    CHECK( streamer->get_target_in_flight() == 3 );
+    sink.unblock();
+    REQUIRE( sink.wait_for_frames( 3 ) );
+    REQUIRE( messenger->wait_for_submitted( 3 ) );
+
+    // A second of frames with requests to spare lets the number down again
+    for( uint32_t i = 0; i < fps; ++i )
+    {
+        messenger->complete( { make_payload( uint8_t( i ) ) } );
+        REQUIRE( sink.wait_for_frames( 4 + i ) );
+    }
+    CHECK( streamer->get_target_in_flight() == 2 );
+    streamer->stop();
+}
+
+TEST_CASE( "stop does not wait for the frames the user holds", "[uvc-streamer]" )
+{
+    auto messenger = std::make_shared< replay_messenger >();
+    frame_sink sink;
+    sink.hold = true;
+    auto streamer = make_streamer( messenger, sink );
+    streamer->start();
+    messenger->complete( { make_payload( 0 ) } );
+    REQUIRE( sink.wait_for_frames( 1 ) );
+
+    streamer->stop();
+    CHECK( messenger->submitted() == 0 );
+    CHECK( sink.pixels[0] == std::vector< uint8_t >( width * height * 2, 0 ) );
+
+    // Frames the user lets go of after the stop are no concern of the streamer anymore
+    sink.release_all();
+    CHECK( messenger->submitted() == 0 );
+
+    // Streaming again starts over with fresh requests
+    sink.hold = false;
+    streamer->start();
+    REQUIRE( messenger->wait_for_submitted( 2 ) );
+    messenger->complete( { make_payload( 1 ) } );
+    REQUIRE( sink.wait_for_frames( 2 ) );
+    streamer->stop();
+}
+
+#endif
@@ -90,7 +90,13 @@ public enum Option {
     AUTO_EXPOSURE_LIMIT(85),
     AUTO_GAIN_LIMIT(86),
     AUTO_RX_SENSITIVITY(87),
-    OPTION_TRANSMITTER_FREQUENCY(88);
+    OPTION_TRANSMITTER_FREQUENCY(88),
+    CONVERSION_QUEUE_SIZE(89),
+    MOTION_BATCH_SIZE(90),
+    MOTION_BATCH_INTERVAL(91),
+    POINTS_LAYOUT(92),
+    POINTS_TEXTURE_COORDINATES(93),
+    FRAMES_POOL_SIZE(94);
 
     private final int mValue;
 
@@ -32,5 +32,8 @@ namespace Intel.RealSense
 
         /// <summary> A relocalization event has updated the pose provided by a pose sensor</summary>
         PoseRelocalization = 6,
+
+        /// <summary> The host dropped frames on purpose, the type holds the reason</summary>
+        FramesDropped = 7,
     }
 }
@@ -279,6 +279,24 @@ namespace Intel.RealSense
         auto_rx_sensitivity = 87,
 
         /// <summary>Change transmitter frequency, increasing effective range over sharpness</summary>
-        transmitter_frequency = 88
+        transmitter_frequency = 88,
+
+        /// <summary>Number of raw frames allowed to wait for format conversion off the capture thread, per conversion block</summary>
+        ConversionQueueSize = 89,
+
+        /// <summary>Number of accel/gyro samples delivered together in one motion frame</summary>
+        MotionBatchSize = 90,
+
+        /// <summary>Longest time, in milliseconds, a motion batch may collect samples before it is delivered</summary>
+        MotionBatchInterval = 91,
+
+        /// <summary>Layout of the points produced by the pointcloud block</summary>
+        PointsLayout = 92,
+
+        /// <summary>Texture coordinates of compact points: none, float32 or normalized uint16</summary>
+        PointsTextureCoordinates = 93,
+
+        /// <summary>Number of frames of each frame type the sensor preallocates</summary>
+        FramesPoolSize = 94
     }
 }
@@ -90,6 +90,12 @@ classdef option < int64
         auto_gain_limit                 (86)
         auto_rx_sensitivity             (87)
         transmitter_frequency           (88)
-        count                           (89)
+        conversion_queue_size           (89)
+        motion_batch_size               (90)
+        motion_batch_interval           (91)
+        points_layout                   (92)
+        points_texture_coordinates      (93)
+        frames_pool_size                (94)
+        count                           (95)
     end
 end
@@ -4783,6 +4783,12 @@ void InitModule(v8::Local<v8::Object> exports) {
   _FORCE_SET_ENUM(RS2_OPTION_AUTO_GAIN_LIMIT);
   _FORCE_SET_ENUM(RS2_OPTION_AUTO_RX_SENSITIVITY);
   _FORCE_SET_ENUM(RS2_OPTION_TRANSMITTER_FREQUENCY);
+  _FORCE_SET_ENUM(RS2_OPTION_CONVERSION_QUEUE_SIZE);
+  _FORCE_SET_ENUM(RS2_OPTION_MOTION_BATCH_SIZE);
+  _FORCE_SET_ENUM(RS2_OPTION_MOTION_BATCH_INTERVAL);
+  _FORCE_SET_ENUM(RS2_OPTION_POINTS_LAYOUT);
+  _FORCE_SET_ENUM(RS2_OPTION_POINTS_TEXTURE_COORDINATES);
+  _FORCE_SET_ENUM(RS2_OPTION_FRAMES_POOL_SIZE);
   _FORCE_SET_ENUM(RS2_OPTION_COUNT);
 
   // rs2_camera_info
@@ -4821,6 +4827,7 @@ void InitModule(v8::Local<v8::Object> exports) {
   _FORCE_SET_ENUM(RS2_NOTIFICATION_CATEGORY_UNKNOWN_ERROR);
   _FORCE_SET_ENUM(RS2_NOTIFICATION_CATEGORY_FIRMWARE_UPDATE_RECOMMENDED);
   _FORCE_SET_ENUM(RS2_NOTIFICATION_CATEGORY_POSE_RELOCALIZATION);
+  _FORCE_SET_ENUM(RS2_NOTIFICATION_CATEGORY_FRAMES_DROPPED);
   _FORCE_SET_ENUM(RS2_NOTIFICATION_CATEGORY_COUNT);
 
   // rs2_timestamp_domain
@@ -4833,6 +4840,13 @@ void InitModule(v8::Local<v8::Object> exports) {
   _FORCE_SET_ENUM(RS2_CALIB_TARGET_RECT_GAUSSIAN_DOT_VERTICES);
   _FORCE_SET_ENUM(RS2_CALIB_TARGET_COUNT);
 
+  // rs2_points_layout
+  _FORCE_SET_ENUM(RS2_POINTS_LAYOUT_FULL);
+  _FORCE_SET_ENUM(RS2_POINTS_LAYOUT_FLOAT32);
+  _FORCE_SET_ENUM(RS2_POINTS_LAYOUT_FLOAT16);
+  _FORCE_SET_ENUM(RS2_POINTS_LAYOUT_INT16);
+  _FORCE_SET_ENUM(RS2_POINTS_LAYOUT_COUNT);
+
   // rs2_recording_mode
   _FORCE_SET_ENUM(RS2_RECORDING_MODE_BLANK_FRAMES);
   _FORCE_SET_ENUM(RS2_RECORDING_MODE_COMPRESSED);
@@ -32,6 +32,7 @@ void init_c_files(py::module &m) {
     BIND_ENUM(m, rs2_timestamp_domain, RS2_TIMESTAMP_DOMAIN_COUNT, "Specifies the clock in relation to which the frame timestamp was measured.")
     BIND_ENUM(m, rs2_frame_metadata_value, RS2_FRAME_METADATA_COUNT, "Per-Frame-Metadata is the set of read-only properties that might be exposed for each individual frame.")
     BIND_ENUM(m, rs2_calib_target_type, RS2_CALIB_TARGET_COUNT, "Calibration target type.")
+    BIND_ENUM(m, rs2_points_layout, RS2_POINTS_LAYOUT_COUNT, "Layout of the points produced by the pointcloud block.")
 
     BIND_ENUM(m, rs2_option, RS2_OPTION_COUNT, "Defines general configuration controls. These can generally be mapped to camera UVC controls, and can be set / queried at any time unless stated otherwise.")
     // Force binding of deprecated (renamed) options that we still want to expose for backwards compatibility
@@ -42,6 +43,9 @@ void init_c_files(py::module &m) {
     BIND_ENUM(m, rs2_playback_status, RS2_PLAYBACK_STATUS_COUNT, "") // No docstring in C++
     BIND_ENUM(m, rs2_calibration_type, RS2_CALIBRATION_TYPE_COUNT, "Calibration type for use in device_calibration")
     BIND_ENUM_CUSTOM(m, rs2_calibration_status, RS2_CALIBRATION_STATUS_FIRST, RS2_CALIBRATION_STATUS_LAST, "Calibration callback status for use in device_calibration.trigger_device_calibration")
+    BIND_ENUM(m, rs2_latency_stage, RS2_LATENCY_STAGE_COUNT, "Checkpoints of the frame pipeline at which frame latency is sampled")
+    BIND_ENUM(m, rs2_frame_drop_reason, RS2_FRAME_DROP_REASON_COUNT, "Reasons for which the library drops frames on the host")
+    BIND_ENUM(m, rs2_thread_role, RS2_THREAD_ROLE_COUNT, "Roles of the library threads, for placing them on CPUs and memory nodes")
 
     /** rs_types.h **/
     py::class_<rs2_intrinsics> intrinsics(m, "intrinsics", "Video stream intrinsics.");
@@ -139,6 +143,29 @@ void init_c_files(py::module &m) {
         .def_readwrite("angular_acceleration", &rs2_pose::angular_acceleration, "X, Y, Z values of angular acceleration, in radians/sec^2")
         .def_readwrite("tracker_confidence", &rs2_pose::tracker_confidence, "Pose confidence 0x0 - Failed, 0x1 - Low, 0x2 - Medium, 0x3 - High")
         .def_readwrite("mapper_confidence", &rs2_pose::mapper_confidence, "Pose map confidence 0x0 - Failed, 0x1 - Low, 0x2 - Medium, 0x3 - High");
+
+    py::class_<rs2_device_clock_skew> device_clock_skew(m, "device_clock_skew", "Clock of a device a multi_device_syncer received frames of, and the offset "
+                                                         "of its frames from those of the first such device.");
+    device_clock_skew.def(py::init<>())
+        .def_property_readonly("serial_number", [](const rs2_device_clock_skew& self) { return std::string(self.serial_number); })
+        .def_property_readonly("has_clock", [](const rs2_device_clock_skew& self) { return self.has_clock != 0; }, "Whether the device maps its clock onto "
+                               "the host's (global time enabled), and the clock fields are valid. Software devices and recordings have no clock of their own")
+        .def_readonly("clock_offset", &rs2_device_clock_skew::clock_offset, "Host clock less the device clock, in ms, as last estimated by the global time of the device")
+        .def_readonly("clock_drift", &rs2_device_clock_skew::clock_drift, "Rate of the device clock against the host's, less 1, in parts per million")
+        .def_readonly("frameset_offset", &rs2_device_clock_skew::frameset_offset, "Host time of the frames of the device less that of the first device in "
+                      "the framesets matched, in ms, averaged over recent framesets. This is the capture phase between the devices plus what is left of "
+                      "the clock offset, and is within the matching tolerance")
+        .def_readonly("max_frameset_offset", &rs2_device_clock_skew::max_frameset_offset, "Largest absolute frameset offset of any frameset, in ms")
+        .def_readonly("framesets", &rs2_device_clock_skew::framesets, "Number of framesets with frames of both devices")
+        .def("__repr__", [](const rs2_device_clock_skew& self) {
+            std::stringstream ss;
+            ss << "serial_number: " << self.serial_number;
+            if (self.has_clock)
+                ss << ", clock_offset: " << self.clock_offset << ", clock_drift: " << self.clock_drift;
+            ss << ", frameset_offset: " << self.frameset_offset << ", max_frameset_offset: " << self.max_frameset_offset
+               << ", framesets: " << self.framesets;
+            return ss.str();
+        });
     /** end rs_types.h **/
 
     /** rs_sensor.h **/
@@ -152,5 +179,70 @@ void init_c_files(py::module &m) {
             ss << "\ntranslation: " << array_to_string(e.translation);
             return ss.str();
         });
+
+    py::class_<rs2_latency_stats> latency_stats(m, "latency_stats", "Latency distribution of one stream at one stage of the frame pipeline, in milliseconds.");
+    latency_stats.def(py::init<>())
+        .def_readonly("count", &rs2_latency_stats::count, "Number of frames sampled")
+        .def_readonly("min", &rs2_latency_stats::min)
+        .def_readonly("mean", &rs2_latency_stats::mean)
+        .def_readonly("max", &rs2_latency_stats::max)
+        .def_readonly("p50", &rs2_latency_stats::p50)
+        .def_readonly("p90", &rs2_latency_stats::p90)
+        .def_readonly("p99", &rs2_latency_stats::p99)
+        .def("__repr__", [](const rs2_latency_stats &s) {
+            std::stringstream ss;
+            ss << "count: " << s.count << ", min: " << s.min << ", mean: " << s.mean << ", max: " << s.max
+               << ", p50: " << s.p50 << ", p90: " << s.p90 << ", p99: " << s.p99;
+            return ss.str();
+        });
+
+    py::class_<rs2_processing_task_stats> processing_task_stats(m, "processing_task_stats", "Statistics of one kind of task run on the processing thread pool.");
+    processing_task_stats.def(py::init<>())
+        .def_property_readonly("name", [](const rs2_processing_task_stats& s) { return std::string(s.name); })
+        .def_readonly("chunks", &rs2_processing_task_stats::chunks, "Number of chunks the runs of the task were split into")
+        .def_readonly("stolen", &rs2_processing_task_stats::stolen, "Number of chunks run by pool workers")
+        .def_readonly("duration", &rs2_processing_task_stats::duration, "Duration of a run, in milliseconds")
+        .def("__repr__", [](const rs2_processing_task_stats &s) {
+            std::stringstream ss;
+            ss << s.name << ": chunks: " << s.chunks << ", stolen: " << s.stolen << ", runs: " << s.duration.count
+               << ", mean: " << s.duration.mean << ", p99: " << s.duration.p99;
+            return ss.str();
+        });
     /** end rs_sensor.h **/
+
+    /** rs_frame.h **/
+    py::class_<rs2_depth_quality_params> depth_quality_params(m, "depth_quality_params", "Region of a depth frame facing a flat target, and how to rate its depth.");
+    depth_quality_params.def(py::init<>())
+        .def_readwrite("roi_min_x", &rs2_depth_quality_params::roi_min_x)
+        .def_readwrite("roi_min_y", &rs2_depth_quality_params::roi_min_y)
+        .def_readwrite("roi_max_x", &rs2_depth_quality_params::roi_max_x, "Exclusive")
+        .def_readwrite("roi_max_y", &rs2_depth_quality_params::roi_max_y, "Exclusive")
+        .def_readwrite("baseline_mm", &rs2_depth_quality_params::baseline_mm, "Stereo baseline, in mm, for the subpixel error")
+        .def_readwrite("ground_truth_mm", &rs2_depth_quality_params::ground_truth_mm, "Distance to the target, in mm, or 0 when unknown")
+        .def_readwrite("outlier_percent", &rs2_depth_quality_params::outlier_percent, "Percent of the nearest and of the farthest points left out");
+
+    py::class_<rs2_depth_quality_metrics> depth_quality_metrics(m, "depth_quality_metrics", "Fill rate, plane fit and error metrics of a region of a depth frame.");
+    depth_quality_metrics.def(py::init<>())
+        .def_readonly("roi_pixels", &rs2_depth_quality_metrics::roi_pixels)
+        .def_readonly("valid_pixels", &rs2_depth_quality_metrics::valid_pixels)
+        .def_readonly("fill_rate", &rs2_depth_quality_metrics::fill_rate, "Percent of the region with depth")
+        .def_readonly("plane_fit", &rs2_depth_quality_metrics::plane_fit, "Whether the points span a plane; the metrics below are 0 otherwise")
+        .def_property_readonly("plane", [](const rs2_depth_quality_metrics& self) {
+            return std::array<float, 4>{ { self.plane[0], self.plane[1], self.plane[2], self.plane[3] } };
+        }, "Fitted plane a*x + b*y + c*z + d = 0, as [a, b, c, d], in meters")
+        .def_readonly("distance_mm", &rs2_depth_quality_metrics::distance_mm)
+        .def_readonly("angle", &rs2_depth_quality_metrics::angle)
+        .def_readonly("plane_fit_rms_error_mm", &rs2_depth_quality_metrics::plane_fit_rms_error_mm)
+        .def_readonly("plane_fit_rms_error", &rs2_depth_quality_metrics::plane_fit_rms_error)
+        .def_readonly("subpixel_rms_error", &rs2_depth_quality_metrics::subpixel_rms_error)
+        .def_readonly("plane_fit_to_ground_truth_mm", &rs2_depth_quality_metrics::plane_fit_to_ground_truth_mm)
+        .def_readonly("z_accuracy", &rs2_depth_quality_metrics::z_accuracy)
+        .def("__repr__", [](const rs2_depth_quality_metrics& self) {
+            std::stringstream ss;
+            ss << "fill_rate: " << self.fill_rate << ", plane_fit: " << self.plane_fit
+               << ", distance_mm: " << self.distance_mm << ", plane_fit_rms_error_mm: " << self.plane_fit_rms_error_mm
+               << ", subpixel_rms_error: " << self.subpixel_rms_error << ", z_accuracy: " << self.z_accuracy;
+            return ss.str();
+        });
+    /** end rs_frame.h **/
 }
@@ -187,6 +187,12 @@ PYBIND11_MODULE(NAME, m) {
         .value("auto_gain_limit", RS2_OPTION_AUTO_GAIN_LIMIT)
         .value("auto_rx_sensitivity", RS2_OPTION_AUTO_RX_SENSITIVITY)
         .value("transmitter_frequency", RS2_OPTION_TRANSMITTER_FREQUENCY)
+        .value("conversion_queue_size", RS2_OPTION_CONVERSION_QUEUE_SIZE)
+        .value("motion_batch_size", RS2_OPTION_MOTION_BATCH_SIZE)
+        .value("motion_batch_interval", RS2_OPTION_MOTION_BATCH_INTERVAL)
+        .value("points_layout", RS2_OPTION_POINTS_LAYOUT)
+        .value("points_texture_coordinates", RS2_OPTION_POINTS_TEXTURE_COORDINATES)
+        .value("frames_pool_size", RS2_OPTION_FRAMES_POOL_SIZE)
         .value("count", RS2_OPTION_COUNT);
 
     py::enum_<platform::power_state> power_state(m, "power_state");
@@ -36,7 +36,14 @@ void init_context(py::module &m) {
              "On successful load, the device will be appended to the context and a devices_changed event triggered.",
              "filename"_a)
         .def("unload_device", &rs2::context::unload_device, "filename"_a) // No docstring in C++
-        .def("unload_tracking_module", &rs2::context::unload_tracking_module); // No docstring in C++
+        .def("unload_tracking_module", &rs2::context::unload_tracking_module) // No docstring in C++
+        .def("set_processing_threads", &rs2::context::set_processing_threads, "Set the number of worker threads of the processing "
+             "thread pool, shared by all processing blocks in the process. 0 for none, -1 for one per core less one", "threads"_a)
+        .def("get_processing_threads", &rs2::context::get_processing_threads)
+        .def("set_processing_affinity", &rs2::context::set_processing_affinity, "Restrict the worker threads of the processing "
+             "thread pool to a set of CPUs, an empty list lifts the restriction", "cpus"_a)
+        .def("set_thread_placement", &rs2::context::set_thread_placement, "Set the CPUs, SCHED_FIFO priority and memory node "
+             "of the library threads of a role, for all devices", "role"_a, "cpus"_a, "realtime_priority"_a = 0, "numa_node"_a = -1);
 
     // rs2::device_hub
     /** end rs_context.hpp **/
@@ -23,6 +23,8 @@ void init_device(py::module &m) {
         .def("get_info", &rs2::device::get_info, "Retrieve camera specific information, "
              "like versions of various internal components", "info"_a)
         .def("hardware_reset", &rs2::device::hardware_reset, "Send hardware reset request to the device")
+        .def("set_thread_placement", &rs2::device::set_thread_placement, "Set the CPUs, SCHED_FIFO priority and memory node "
+             "of the capture or dispatch threads of this device", "role"_a, "cpus"_a, "realtime_priority"_a = 0, "numa_node"_a = -1)
         .def(py::init<>())
         .def("__nonzero__", &rs2::device::operator bool) // Called to implement truth value testing in Python 2
         .def("__bool__", &rs2::device::operator bool) // Called to implement truth value testing in Python 3
@@ -4,6 +4,62 @@ Copyright(c) 2017 Intel Corporation. All Rights Reserved. */
 #include "python.hpp"
 #include "../include/librealsense2/rs.hpp"
 
+#include <pybind11/numpy.h>
+
+// Wraps frame memory in a NumPy array without copying. The array holds its own reference to the
+// frame, so it stays valid after the Python frame object is gone.
+static py::array make_frame_array(const rs2::frame& f, const void* data, const py::dtype& dtype,
+                                  const std::vector<size_t>& shape, const std::vector<size_t>& strides)
+{
+    auto owner = new rs2::frame(f);
+    py::capsule base(owner, [](void* p) { delete reinterpret_cast<rs2::frame*>(p); });
+    return py::array(dtype, shape, strides, data, base);
+}
+
+static py::array get_frame_array(const rs2::frame& self)
+{
+    if (auto vf = self.as<rs2::video_frame>())
+    {
+        size_t h = vf.get_height(), w = vf.get_width(), bpp = vf.get_bytes_per_pixel(), stride = vf.get_stride_in_bytes();
+        switch (vf.get_profile().format())
+        {
+        case RS2_FORMAT_RGB8: case RS2_FORMAT_BGR8: case RS2_FORMAT_RGBA8: case RS2_FORMAT_BGRA8:
+            return make_frame_array(vf, vf.get_data(), py::dtype::of<uint8_t>(), { h, w, bpp }, { stride, bpp, 1 });
+        case RS2_FORMAT_DISPARITY32: case RS2_FORMAT_DISTANCE:
+            return make_frame_array(vf, vf.get_data(), py::dtype::of<float>(), { h, w }, { stride, bpp });
+        default:
+            switch (bpp)
+            {
+            case 1: return make_frame_array(vf, vf.get_data(), py::dtype::of<uint8_t>(), { h, w }, { stride, bpp });
+            case 2: return make_frame_array(vf, vf.get_data(), py::dtype::of<uint16_t>(), { h, w }, { stride, bpp });
+            case 4: return make_frame_array(vf, vf.get_data(), py::dtype::of<uint32_t>(), { h, w }, { stride, bpp });
+            default: return make_frame_array(vf, vf.get_data(), py::dtype::of<uint8_t>(), { h, w, bpp }, { stride, bpp, 1 });
+            }
+        }
+    }
+    return make_frame_array(self, self.get_data(), py::dtype::of<uint8_t>(), { static_cast<size_t>(self.get_data_size()) }, { 1 });
+}
+
+// Vertices (3 floats) or texture coordinates (2 floats) as an N x components or H x W x components array
+static py::array get_points_array(const rs2::points& self, const float* data, size_t components, int dims)
+{
+    switch (dims) {
+    case 2:
+        return make_frame_array(self, data, py::dtype::of<float>(), { self.size(), components }, { components * sizeof(float), sizeof(float) });
+    case 3:
+    {
+        auto profile = self.get_profile().as<rs2::video_stream_profile>();
+        size_t h = profile.height(), w = profile.width();
+        if (self.size() != h * w)
+            throw std::domain_error("compact points only support dims=2");
+        return make_frame_array(self, data, py::dtype::of<float>(), { h, w, components },
+                                { w * components * sizeof(float), components * sizeof(float), sizeof(float) });
+    }
+    default:
+        throw std::domain_error("dims arg only supports values of 2 or 3");
+    }
+}
+
 void init_frame(py::module &m) {
     py::class_<BufData> BufData_py(m, "BufData", py::buffer_protocol());
     BufData_py.def_buffer([](BufData& self)
@@ -104,7 +160,7 @@ void init_frame(py::module &m) {
     pose_stream_profile.def(py::init<const rs2::stream_profile&>(), "sp"_a);
 
     py::class_<rs2::filter_interface> filter_interface(m, "filter_interface", "Interface for frame filtering functionality");
-    filter_interface.def("process", &rs2::filter_interface::process, "frame"_a); // No docstring in C++
+    filter_interface.def("process", &rs2::filter_interface::process, "frame"_a, py::call_guard<py::gil_scoped_release>()); // No docstring in C++
 
     py::class_<rs2::frame> frame(m, "frame", "Base class for multiple frame extensions");
     frame.def(py::init<>())
@@ -119,11 +175,20 @@ void init_frame(py::module &m) {
         .def_property_readonly("frame_timestamp_domain", &rs2::frame::get_frame_timestamp_domain, "The timestamp domain. Identical to calling get_frame_timestamp_domain.")
         .def("get_frame_metadata", &rs2::frame::get_frame_metadata, "Retrieve the current value of a single frame_metadata.", "frame_metadata"_a)
         .def("supports_frame_metadata", &rs2::frame::supports_frame_metadata, "Determine if the device allows a specific metadata to be queried.", "frame_metadata"_a)
+        .def("get_frame_metadata_all", [](const rs2::frame& f) {
+            std::map<rs2_frame_metadata_value, rs2_metadata_type> values;
+            for (auto&& entry : f.get_frame_metadata_all())
+                if (entry.valid)
+                    values[entry.id] = entry.value;
+            return values;
+        }, "Retrieve the values of all the frame_metadata the frame carries, in one call.")
         .def("get_frame_number", &rs2::frame::get_frame_number, "Retrieve the frame number.")
         .def_property_readonly("frame_number", &rs2::frame::get_frame_number, "The frame number. Identical to calling get_frame_number.")
         .def("get_data_size", &rs2::frame::get_data_size, "Retrieve data size from frame handle.")
         .def("get_data", get_frame_data, "Retrieve data from the frame handle.", py::keep_alive<0, 1>())
         .def_property_readonly("data", get_frame_data, "Data from the frame handle. Identical to calling get_data.", py::keep_alive<0, 1>())
+        .def("get_data_array", &get_frame_array, "Retrieve the frame data as a NumPy array that shares the frame's memory. "
+             "The array keeps the frame alive, so no copy is needed to hold on to it; the frame is returned to the pool once the array is released.")
         .def("get_profile", &rs2::frame::get_profile, "Retrieve stream profile from frame handle.")
         .def_property_readonly("profile", &rs2::frame::get_profile, "Stream profile from frame handle. Identical to calling get_profile.")
         .def("keep", &rs2::frame::keep, "Keep the frame, otherwise if no refernce to the frame, the frame will be released.")
@@ -233,13 +298,58 @@ void init_frame(py::module &m) {
                 throw std::domain_error("dims arg only supports values of 1, 2 or 3");
             }
         }, "Retrieve the texture coordinates (uv map) for the point cloud", py::keep_alive<0, 1>(), "dims"_a=1)
+        .def("get_vertices_array", [](const rs2::points& self, int dims) {
+            return get_points_array(self, reinterpret_cast<const float*>(self.get_vertices()), 3, dims);
+        }, "Retrieve the vertices as a float32 NumPy array of N x 3 (dims=2) or H x W x 3 (dims=3) that shares the frame's memory and keeps it alive.", "dims"_a = 2)
+        .def("get_texture_coordinates_array", [](const rs2::points& self, int dims) {
+            return get_points_array(self, reinterpret_cast<const float*>(self.get_texture_coordinates()), 2, dims);
+        }, "Retrieve the texture coordinates as a float32 NumPy array of N x 2 (dims=2) or H x W x 2 (dims=3) that shares the frame's memory and keeps it alive.", "dims"_a = 2)
+        .def("get_compact_points", [](const rs2::points& self) -> py::object {
+            auto compact = self.get_compact_points();
+            if (!compact.vertices)
+                return py::none();
+            size_t n = compact.count;
+            py::dtype type = compact.layout == RS2_POINTS_LAYOUT_FLOAT32 ? py::dtype::of<float>()
+                           : compact.layout == RS2_POINTS_LAYOUT_FLOAT16 ? py::dtype("float16") : py::dtype::of<int16_t>();
+            size_t item = type.itemsize();
+            auto vertices = make_frame_array(self, compact.vertices, type, { n, 3 }, { 3 * item, item });
+            py::object texture_coordinates = py::none();
+            if (compact.texture_coordinates)
+                texture_coordinates = make_frame_array(self, compact.texture_coordinates, py::dtype::of<float>(), { n, 2 }, { 2 * sizeof(float), sizeof(float) });
+            else if (compact.normalized_texture_coordinates)
+                texture_coordinates = make_frame_array(self, compact.normalized_texture_coordinates, py::dtype::of<uint16_t>(), { n, 2 }, { 2 * sizeof(uint16_t), sizeof(uint16_t) });
+            size_t mask = (size_t(compact.width) * compact.height + 7) / 8;
+            auto valid_pixels = make_frame_array(self, compact.valid_pixels, py::dtype::of<uint8_t>(), { mask }, { 1 });
+            return py::make_tuple(vertices, compact.scale, texture_coordinates, valid_pixels);
+        }, "Retrieve the points of a frame produced with option.points_layout set, as a tuple of an N x 3 NumPy array of the vertices "
+           "(float32, float16 or int16 as the layout names), the meters per vertex unit, an N x 2 array of the texture coordinates "
+           "(float32, or uint16 with [0,1] scaled to 0..65534 and 65535 marking a point off the texture) or None, and the uint8 bit mask of the depth pixels with a point (numpy.unpackbits "
+           "with bitorder='little'), all sharing the frame's memory. None for a frame holding a point for every depth pixel.")
         .def("export_to_ply", &rs2::points::export_to_ply, "Export the point cloud to a PLY file")
         .def("size", &rs2::points::size); // No docstring in C++
 
     py::class_<rs2::depth_frame, rs2::video_frame> depth_frame(m, "depth_frame", "Extends the video_frame class with additional depth related attributes and functions.");
     depth_frame.def(py::init<rs2::frame>())
         .def("get_distance", &rs2::depth_frame::get_distance, "x"_a, "y"_a, "Provide the depth in meters at the given pixel")
-        .def("get_units", &rs2::depth_frame::get_units, "Provide the scaling factor to use when converting from get_data() units to meters");
+        .def("get_units", &rs2::depth_frame::get_units, "Provide the scaling factor to use when converting from get_data() units to meters")
+        .def("project_color_pixels", [](const rs2::depth_frame& self, const rs2::stream_profile& color,
+                                        const std::vector<std::array<float, 2>>& color_pixels, float depth_min, float depth_max) {
+            std::vector<std::array<float, 2>> depth_pixels(color_pixels.size());
+            if (!depth_pixels.empty())
+            {
+                py::gil_scoped_release release;
+                rs2_error* e = nullptr;
+                rs2_project_color_pixels_to_depth_pixels(self.get(), color.get(), depth_min, depth_max,
+                    color_pixels.front().data(), depth_pixels.front().data(), static_cast<int>(color_pixels.size()), &e);
+                rs2::error::handle(e);
+            }
+            return depth_pixels;
+        }, "Project [x, y] color pixels to the [x, y] depth pixels of this frame that see the same points, all at once. "
+           "Pixels no depth pixel sees are projected to [-1, -1].", "color"_a, "color_pixels"_a, "depth_min"_a = 0.1f, "depth_max"_a = 10.f)
+        .def("analyze_quality", [](const rs2::depth_frame& self, const rs2_depth_quality_params& params) {
+            py::gil_scoped_release release;
+            return self.analyze_quality(params);
+        }, "Fit a plane to a region of the frame facing a flat target and rate the depth against it.", "params"_a);
     
     // rs2::disparity_frame
     py::class_<rs2::disparity_frame, rs2::depth_frame> disparity_frame(m, "disparity_frame", "Extends the depth_frame class with additional disparity related attributes and functions.");
@@ -249,7 +359,18 @@ void init_frame(py::module &m) {
     py::class_<rs2::motion_frame, rs2::frame> motion_frame(m, "motion_frame", "Extends the frame class with additional motion related attributes and functions");
     motion_frame.def(py::init<rs2::frame>())
         .def("get_motion_data", &rs2::motion_frame::get_motion_data, "Retrieve the motion data from IMU sensor.")
-        .def_property_readonly("motion_data", &rs2::motion_frame::get_motion_data, "Motion data from IMU sensor. Identical to calling get_motion_data.");
+        .def_property_readonly("motion_data", &rs2::motion_frame::get_motion_data, "Motion data from IMU sensor. Identical to calling get_motion_data.")
+        .def("get_motion_batch", [](const rs2::motion_frame& self) -> py::object {
+            auto batch = self.get_motion_batch();
+            if (!batch.count)
+                return py::none();
+            // x, y and z are consecutive arrays of the same capacity, viewed as the rows of one array
+            size_t n = batch.count, row = batch.y - batch.x;
+            auto timestamps = make_frame_array(self, batch.timestamps, py::dtype::of<double>(), { n }, { sizeof(double) });
+            auto samples = make_frame_array(self, batch.x, py::dtype::of<float>(), { 3, n }, { row * sizeof(float), sizeof(float) });
+            return py::make_tuple(timestamps, samples);
+        }, "Retrieve the samples of a frame delivered with option.motion_batch_size set, as a tuple of a float64 NumPy array of N timestamps "
+           "and a float32 3 x N array of the x, y and z values, both sharing the frame's memory. None for a frame holding a single sample.");
 
     py::class_<rs2::pose_frame, rs2::frame> pose_frame(m, "pose_frame", "Extends the frame class with additional pose related attributes and functions.");
     pose_frame.def(py::init<rs2::frame>())
@@ -43,7 +43,9 @@ void init_processing(py::module &m) {
         }, "timeout_ms"_a = 5000, py::call_guard<py::gil_scoped_release>()) // No docstring in C++
         .def("__call__", &rs2::frame_queue::operator(), "Identical to calling enqueue.", "f"_a)
         .def("capacity", &rs2::frame_queue::capacity, "Return the capacity of the queue.")
-        .def("keep_frames", &rs2::frame_queue::keep_frames, "Return whether or not the queue calls keep on enqueued frames.");
+        .def("keep_frames", &rs2::frame_queue::keep_frames, "Return whether or not the queue calls keep on enqueued frames.")
+        .def("set_latency_budget", &rs2::frame_queue::set_latency_budget, "Drop frames by age rather than by count, "
+             "0 to return to dropping by count", "max_age_ms"_a);
 
     py::class_<rs2::processing_block, rs2::options> processing_block(m, "processing_block", "Define the processing block workflow, inherit this class to "
                                                                      "generate your own processing_block.");
@@ -53,7 +55,7 @@ void init_processing(py::module &m) {
         .def("start", [](rs2::processing_block& self, std::function<void(rs2::frame)> f) {
             self.start(f);
         }, "Start the processing block with callback function to inform the application the frame is processed.", "callback"_a)
-        .def("invoke", &rs2::processing_block::invoke, "Ask processing block to process the frame", "f"_a)
+        .def("invoke", &rs2::processing_block::invoke, "Ask processing block to process the frame", "f"_a, py::call_guard<py::gil_scoped_release>())
         .def("supports", (bool (rs2::processing_block::*)(rs2_camera_info) const) &rs2::processing_block::supports, "Check if a specific camera info field is supported.")
         .def("get_info", &rs2::processing_block::get_info, "Retrieve camera specific information, like versions of various internal components.");
         /*.def("__call__", &rs2::processing_block::operator(), "f"_a)*/
@@ -81,8 +83,8 @@ void init_processing(py::module &m) {
     py::class_<rs2::pointcloud, rs2::filter> pointcloud(m, "pointcloud", "Generates 3D point clouds based on a depth frame. Can also map textures from a color frame.");
     pointcloud.def(py::init<>())
         .def(py::init<rs2_stream, int>(), "stream"_a, "index"_a = 0)
-        .def("calculate", &rs2::pointcloud::calculate, "Generate the pointcloud and texture mappings of depth map.", "depth"_a)
-        .def("map_to", &rs2::pointcloud::map_to, "Map the point cloud to the given color frame.", "mapped"_a);
+        .def("calculate", &rs2::pointcloud::calculate, "Generate the pointcloud and texture mappings of depth map.", "depth"_a, py::call_guard<py::gil_scoped_release>())
+        .def("map_to", &rs2::pointcloud::map_to, "Map the point cloud to the given color frame.", "mapped"_a, py::call_guard<py::gil_scoped_release>());
 
     py::class_<rs2::yuy_decoder, rs2::filter> yuy_decoder(m, "yuy_decoder", "Converts frames in raw YUY format to RGB. This conversion is somewhat costly, "
                                                           "but the SDK will automatically try to use SSE2, AVX, or CUDA instructions where available to "
@@ -112,14 +114,21 @@ void init_processing(py::module &m) {
             rs2::frameset fs;
             auto success = self.try_wait_for_frames(&fs, timeout_ms);
             return std::make_tuple(success, fs);
-        }, "timeout_ms"_a = 5000, py::call_guard<py::gil_scoped_release>()); // No docstring in C++
+        }, "timeout_ms"_a = 5000, py::call_guard<py::gil_scoped_release>()) // No docstring in C++
+        .def("set_latency_budget", &rs2::syncer::set_latency_budget, "Drop the matched sets by age rather than by count, "
+             "0 to return to the queue size", "max_age_ms"_a);
         /*.def("__call__", &rs2::syncer::operator(), "frame"_a)*/
 
+    py::class_<rs2::multi_device_syncer, rs2::syncer> multi_device_syncer(m, "multi_device_syncer", "Sync instance to align frames from the streams of several devices");
+    multi_device_syncer.def(py::init<float, float, int>(), "tolerance_ms"_a = 0.f, "max_latency_ms"_a = 100.f, "queue_size"_a = 1)
+        .def("get_clock_skews", &rs2::multi_device_syncer::get_clock_skews, "Get the clock of every device that sent frames "
+             "so far, where it has one, and the offset of its frames from those of the first of them in the framesets matched");
+
     py::class_<rs2::align, rs2::filter> align(m, "align", "Performs alignment between depth image and another image.");
     align.def(py::init<rs2_stream>(), "To perform alignment of a depth image to the other, set the align_to parameter with the other stream type.\n"
               "To perform alignment of a non depth image to a depth image, set the align_to parameter to RS2_STREAM_DEPTH.\n"
               "Camera calibration and frame's stream type are determined on the fly, according to the first valid frameset passed to process().", "align_to"_a)
-        .def("process", (rs2::frameset(rs2::align::*)(rs2::frameset)) &rs2::align::process, "Run thealignment process on the given frames to get an aligned set of frames", "frames"_a);
+        .def("process", (rs2::frameset(rs2::align::*)(rs2::frameset)) &rs2::align::process, "Run thealignment process on the given frames to get an aligned set of frames", "frames"_a, py::call_guard<py::gil_scoped_release>());
 
     py::class_<rs2::colorizer, rs2::filter> colorizer(m, "colorizer", "Colorizer filter generates color images based on input depth frame");
     colorizer.def(py::init<>())
@@ -133,7 +142,7 @@ void init_processing(py::module &m) {
              "6 - Warm\n"
              "7 - Quantized\n"
              "8 - Pattern", "color_scheme"_a)
-        .def("colorize", &rs2::colorizer::colorize, "Start to generate color image base on depth frame", "depth"_a)
+        .def("colorize", &rs2::colorizer::colorize, "Start to generate color image base on depth frame", "depth"_a, py::call_guard<py::gil_scoped_release>())
         /*.def("__call__", &rs2::colorizer::operator())*/;
 
     py::class_<rs2::decimation_filter, rs2::filter> decimation_filter(m, "decimation_filter", "Performs downsampling by using the median with specific kernel size.");
@@ -184,6 +193,25 @@ void init_processing(py::module &m) {
     py::class_<rs2::sequence_id_filter, rs2::filter> sequence_id_filter(m, "sequence_id_filter", "Splits depth frames with different sequence ID");
     sequence_id_filter.def(py::init<>())
         .def(py::init<float>(), "sequence_id"_a);
+
+    py::class_<rs2::depth_postprocess, rs2::filter> depth_postprocess(m, "depth_postprocess", "Applies a chain of depth post-processing filters, "
+                                                                      "fusing the recommended chain into a few passes over one frame");
+    depth_postprocess.def(py::init<const std::vector<rs2::filter*>&>(), "filters"_a);
     // rs2::rates_printer
+
+    m.def("process_frames", [](const std::vector<rs2::frame>& frames, const std::vector<rs2::filter_interface*>& filters) {
+        std::vector<rs2::frame> results;
+        results.reserve(frames.size());
+        // The whole batch runs without the GIL; Python filters take it back when invoked
+        py::gil_scoped_release release;
+        for (auto f : frames)
+        {
+            for (auto filter : filters)
+                f = filter->process(f);
+            results.push_back(f);
+        }
+        return results;
+    }, "Run every frame through the filters in order and return the results, releasing the GIL for the whole batch. "
+       "Combine with frame.get_data_array() and points.get_vertices_array() to read the results without copies.", "frames"_a, "filters"_a);
     /** end rs_processing.hpp **/
 }
@@ -17,6 +17,11 @@ void init_record_playback(py::module &m) {
         .def("get_position", &rs2::playback::get_position, "Retrieves the current position of the playback in the file in terms of time. Units are expressed in nanoseconds.")
         .def("get_duration", &rs2::playback::get_duration, "Retrieves the total duration of the file.")
         .def("seek", &rs2::playback::seek, "Sets the playback to a specified time point of the played data.", "time"_a)
+        .def("seek_to_frame", &rs2::playback::seek_to_frame, "Sets the playback to the time point of a frame of one of the played streams, "
+             "found with an index of the frames of the file.", "stream"_a, "frame_number"_a)
+        .def("get_frame_count", &rs2::playback::get_frame_count, "Retrieves the number of frames of one of the played streams in the file.", "stream"_a)
+        .def("get_frame_at", &rs2::playback::get_frame_at, "Reads a frame of one of the played streams by its position among the frames "
+             "of the stream in the file, without moving the playback.", "stream"_a, "index"_a)
         .def("is_real_time", &rs2::playback::is_real_time, "Indicates if playback is in real time mode or non real time.")
         .def("set_real_time", &rs2::playback::set_real_time, "Set the playback to work in real time or non real time. In real time mode, playback will "
              "play the same way the file was recorded. If the application takes too long to handle the callback, frames may be dropped. In non real time "
@@ -43,6 +43,13 @@ PYBIND11_MODULE(NAME, m) {
     m.def("log_to_file", &rs2::log_to_file, "min_severity"_a, "file_path"_a);
     m.def("reset_logger", &rs2::reset_logger);
     m.def("enable_rolling_log_file", &rs2::enable_rolling_log_file, "max_size"_a);
+    m.def("enable_frame_trace", &rs2::enable_frame_trace, "enable"_a);
+    m.def("dump_frame_trace", &rs2::dump_frame_trace, "file_path"_a, "chrome_trace"_a = false);
+    m.def("enable_pipeline_stats", &rs2::enable_pipeline_stats, "enable"_a);
+    m.def("reset_pipeline_stats", &rs2::reset_pipeline_stats);
+    m.def("get_pipeline_stats", &rs2::get_pipeline_stats, "stream"_a, "index"_a, "stage"_a);
+    m.def("get_pipeline_frame_drops", &rs2::get_pipeline_frame_drops, "stream"_a, "index"_a, "reason"_a);
+    m.def("get_processing_task_stats", &rs2::get_processing_task_stats);
 
     // Access to log_message is only from a callback (see log_to_callback below) and so already
     // should have the GIL acquired
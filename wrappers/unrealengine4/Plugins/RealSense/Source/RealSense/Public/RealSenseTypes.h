@@ -143,6 +143,12 @@ enum class ERealSenseOptionType : uint8
     AUTO_GAIN_LIMIT                            , /**< Set and get auto gain limits ranging from 16 to 248. Default is 0 which means full gain. If the requested gain limit is less than 16, it will be set to 16. If the requested gain limit is greater than 248, it will be set to 248. Setting will not take effect until next streaming session. */
     AUTO_RX_SENSITIVITY                        , /**< Set and get auto receiver sensitivity.*/
     TRANSMITTER_FREQUENCY                      , /**< Change transmitter frequency, increasing effective range over sharpness. */
+    CONVERSION_QUEUE_SIZE                      , /**< Number of raw frames allowed to wait for format conversion off the capture thread. */
+    MOTION_BATCH_SIZE                          , /**< Number of accel/gyro samples delivered together in one motion frame. */
+    MOTION_BATCH_INTERVAL                      , /**< Longest time, in milliseconds, a motion batch may collect samples before it is delivered. */
+    POINTS_LAYOUT                              , /**< Layout of the points produced by the pointcloud block. */
+    POINTS_TEXTURE_COORDINATES                 , /**< Texture coordinates of compact points: none, float32 or normalized uint16. */
+    FRAMES_POOL_SIZE                           , /**< Number of frames of each frame type the sensor preallocates. */
 };
 
 UENUM(Blueprintable)